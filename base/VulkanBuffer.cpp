@@ -9,6 +9,7 @@
 */
 
 #include "VulkanBuffer.h"
+#include "VulkanDebug.h"
 
 namespace vks
 {	
@@ -22,6 +23,21 @@ namespace vks
 	*/
 	VkResult Buffer::map(VkDeviceSize size, VkDeviceSize offset)
 	{
+		// Sub-allocated memory is persistently mapped by the allocator
+		if (allocation)
+		{
+			if (!allocation->mapped)
+			{
+				return VK_ERROR_MEMORY_MAP_FAILED;
+			}
+			// Same range rules as vkMapMemory, the rest of the block belongs to other resources
+			if ((offset > this->size) || ((size != VK_WHOLE_SIZE) && (size > this->size - offset)))
+			{
+				return VK_ERROR_MEMORY_MAP_FAILED;
+			}
+			mapped = static_cast<uint8_t*>(allocation->mapped) + offset;
+			return VK_SUCCESS;
+		}
 		return vkMapMemory(device, memory, offset, size, 0, &mapped);
 	}
 
@@ -34,7 +50,10 @@ namespace vks
 	{
 		if (mapped)
 		{
-			vkUnmapMemory(device, memory);
+			if (!allocation)
+			{
+				vkUnmapMemory(device, memory);
+			}
 			mapped = nullptr;
 		}
 	}
@@ -42,13 +61,13 @@ namespace vks
 	/** 
 	* Attach the allocated memory block to the buffer
 	* 
-	* @param offset (Optional) Byte offset (from the beginning) for the memory region to bind
+	* @param offset (Optional) Byte offset (from the beginning of the allocation) for the memory region to bind
 	* 
 	* @return VkResult of the bindBufferMemory call
 	*/
 	VkResult Buffer::bind(VkDeviceSize offset)
 	{
-		return vkBindBufferMemory(device, buffer, memory, offset);
+		return vkBindBufferMemory(device, buffer, memory, (allocation ? allocation->offset : 0) + offset);
 	}
 
 	/**
@@ -90,6 +109,10 @@ namespace vks
 	*/
 	VkResult Buffer::flush(VkDeviceSize size, VkDeviceSize offset)
 	{
+		if (allocation)
+		{
+			return allocation->allocator->flush(allocation, size, offset);
+		}
 		VkMappedMemoryRange mappedRange = {};
 		mappedRange.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
 		mappedRange.memory = memory;
@@ -110,6 +133,10 @@ namespace vks
 	*/
 	VkResult Buffer::invalidate(VkDeviceSize size, VkDeviceSize offset)
 	{
+		if (allocation)
+		{
+			return allocation->allocator->invalidate(allocation, size, offset);
+		}
 		VkMappedMemoryRange mappedRange = {};
 		mappedRange.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
 		mappedRange.memory = memory;
@@ -118,6 +145,20 @@ namespace vks
 		return vkInvalidateMappedMemoryRanges(device, 1, &mappedRange);
 	}
 
+	/**
+	* Set the debug name of the buffer (debug marker extension) and of it's allocation (memory tracker)
+	*
+	* @param name Name of the buffer
+	*/
+	void Buffer::setName(const char *name)
+	{
+		vks::debugmarker::setBufferName(device, buffer, name);
+		if (allocation)
+		{
+			allocation->allocator->setName(allocation, name);
+		}
+	}
+
 	/** 
 	* Release all Vulkan resources held by this buffer
 	*/
@@ -127,6 +168,12 @@ namespace vks
 		{
 			vkDestroyBuffer(device, buffer, nullptr);
 		}
+		if (allocation)
+		{
+			allocation->allocator->free(allocation);
+			allocation = nullptr;
+			memory = VK_NULL_HANDLE;
+		}
 		if (memory)
 		{
 			vkFreeMemory(device, memory, nullptr);
@@ -13,6 +13,7 @@
 #include <vector>
 
 #include "vulkan/vulkan.h"
+#include "VulkanMemoryAllocator.h"
 #include "VulkanTools.h"
 
 namespace vks
@@ -26,6 +27,8 @@ namespace vks
 		VkDevice device;
 		VkBuffer buffer = VK_NULL_HANDLE;
 		VkDeviceMemory memory = VK_NULL_HANDLE;
+		/** @brief Range of memory the buffer is bound to if it has been created with a sub-allocator (memory is shared with other resources in that case) */
+		vks::Allocation *allocation = nullptr;
 		VkDescriptorBufferInfo descriptor;
 		VkDeviceSize size = 0;
 		VkDeviceSize alignment = 0;
@@ -41,6 +44,7 @@ namespace vks
 		void copyTo(void* data, VkDeviceSize size);
 		VkResult flush(VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
 		VkResult invalidate(VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
+		void setName(const char *name);
 		void destroy();
 	};
 }
\ No newline at end of file
@@ -0,0 +1,192 @@
+/*
+* Camera path recording and replay
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "VulkanCameraPath.h"
+
+#include <string.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+namespace vks
+{
+	namespace
+	{
+		// File layout: magic, version, keyframe count, then every keyframe as seven floats (time, position, rotation)
+		const char fileMagic[4] = { 'V', 'K', 'C', 'P' };
+		const uint32_t fileVersion = 1;
+	}
+
+	void CameraPath::beginRecording()
+	{
+		keyframes.clear();
+		recording = true;
+		recordingTime = 0.0f;
+		holdPending = false;
+		replayFrame = 0;
+	}
+
+	bool CameraPath::isRecording() const
+	{
+		return recording;
+	}
+
+	void CameraPath::record(float deltaTime, const glm::vec3 &position, const glm::vec3 &rotation)
+	{
+		if (!recording) {
+			return;
+		}
+		if (!keyframes.empty()) {
+			recordingTime += deltaTime;
+		}
+		Keyframe keyframe;
+		keyframe.time = recordingTime;
+		keyframe.position = position;
+		keyframe.rotation = rotation;
+		const bool unchanged = !keyframes.empty() && (keyframes.back().position == position) && (keyframes.back().rotation == rotation);
+		if (unchanged) {
+			hold = keyframe;
+			holdPending = true;
+			return;
+		}
+		// The camera starts moving again, without the last unchanged frame the interpolation would spread the movement over the time it was standing still
+		if (holdPending) {
+			keyframes.push_back(hold);
+			holdPending = false;
+		}
+		keyframes.push_back(keyframe);
+	}
+
+	void CameraPath::endRecording()
+	{
+		if (recording && holdPending) {
+			keyframes.push_back(hold);
+		}
+		holdPending = false;
+		recording = false;
+	}
+
+	bool CameraPath::save(const std::string &filename) const
+	{
+		std::ofstream file(filename, std::ios::out | std::ios::binary);
+		if (!file.is_open()) {
+			return false;
+		}
+		const uint32_t count = static_cast<uint32_t>(keyframes.size());
+		file.write(fileMagic, sizeof(fileMagic));
+		file.write(reinterpret_cast<const char*>(&fileVersion), sizeof(fileVersion));
+		file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+		for (auto &keyframe : keyframes) {
+			const float values[7] = { keyframe.time, keyframe.position.x, keyframe.position.y, keyframe.position.z, keyframe.rotation.x, keyframe.rotation.y, keyframe.rotation.z };
+			file.write(reinterpret_cast<const char*>(values), sizeof(values));
+		}
+		return file.good();
+	}
+
+	bool CameraPath::load(const std::string &filename)
+	{
+		std::ifstream file(filename, std::ios::in | std::ios::binary);
+		if (!file.is_open()) {
+			return false;
+		}
+		char magic[4];
+		uint32_t version = 0;
+		uint32_t count = 0;
+		file.read(magic, sizeof(magic));
+		file.read(reinterpret_cast<char*>(&version), sizeof(version));
+		file.read(reinterpret_cast<char*>(&count), sizeof(count));
+		if (!file.good() || (memcmp(magic, fileMagic, sizeof(fileMagic)) != 0) || (version != fileVersion)) {
+			return false;
+		}
+		std::vector<Keyframe> loaded;
+		for (uint32_t i = 0; i < count; i++) {
+			float values[7];
+			file.read(reinterpret_cast<char*>(values), sizeof(values));
+			if (!file.good()) {
+				return false;
+			}
+			Keyframe keyframe;
+			keyframe.time = values[0];
+			keyframe.position = glm::vec3(values[1], values[2], values[3]);
+			keyframe.rotation = glm::vec3(values[4], values[5], values[6]);
+			// Keyframes must be ordered by time for sampling
+			if (!loaded.empty() && (keyframe.time < loaded.back().time)) {
+				return false;
+			}
+			loaded.push_back(keyframe);
+		}
+		keyframes.swap(loaded);
+		recording = false;
+		holdPending = false;
+		replayFrame = 0;
+		return true;
+	}
+
+	bool CameraPath::empty() const
+	{
+		return keyframes.empty();
+	}
+
+	float CameraPath::getDuration() const
+	{
+		return keyframes.empty() ? 0.0f : keyframes.back().time;
+	}
+
+	uint32_t CameraPath::getFrameCount() const
+	{
+		if (keyframes.empty()) {
+			return 0;
+		}
+		// Includes the frames at both the start and the end of the path
+		return static_cast<uint32_t>(std::floor(getDuration() / timeStep)) + 1;
+	}
+
+	void CameraPath::sample(float time, glm::vec3 &position, glm::vec3 &rotation) const
+	{
+		if (keyframes.empty()) {
+			return;
+		}
+		auto next = std::upper_bound(keyframes.begin(), keyframes.end(), time, [](float value, const Keyframe &keyframe) { return value < keyframe.time; });
+		if (next == keyframes.begin()) {
+			position = keyframes.front().position;
+			rotation = keyframes.front().rotation;
+			return;
+		}
+		if (next == keyframes.end()) {
+			position = keyframes.back().position;
+			rotation = keyframes.back().rotation;
+			return;
+		}
+		const Keyframe &previous = *(next - 1);
+		const float interval = next->time - previous.time;
+		const float factor = (interval > 0.0f) ? (time - previous.time) / interval : 1.0f;
+		position = glm::mix(previous.position, next->position, factor);
+		rotation = glm::mix(previous.rotation, next->rotation, factor);
+	}
+
+	void CameraPath::rewind()
+	{
+		replayFrame = 0;
+	}
+
+	uint32_t CameraPath::nextFrame(glm::vec3 &position, glm::vec3 &rotation)
+	{
+		const uint32_t frameCount = getFrameCount();
+		if (frameCount == 0) {
+			return 0;
+		}
+		// Times are derived from the frame index, so no error accumulates over long replays
+		sample(static_cast<float>(replayFrame % frameCount) * timeStep, position, rotation);
+		return replayFrame++;
+	}
+
+	bool CameraPath::finished() const
+	{
+		return replayFrame >= getFrameCount();
+	}
+}
@@ -0,0 +1,86 @@
+/*
+* Camera path recording and replay
+*
+* Records the camera state of every frame (only keeping keyframes where the camera moved) and replays it with a fixed time step,
+* so benchmark runs render the same views independent of the frame rate of the machine they are recorded or replayed on
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+namespace vks
+{
+	class CameraPath
+	{
+	public:
+		struct Keyframe
+		{
+			/** @brief Time in seconds since the start of the recording */
+			float time = 0.0f;
+			glm::vec3 position = glm::vec3(0.0f);
+			/** @brief Euler angles in degrees (as used by the camera) */
+			glm::vec3 rotation = glm::vec3(0.0f);
+		};
+
+		/** @brief Time step the path is replayed with in seconds */
+		float timeStep = 1.0f / 60.0f;
+
+		/** @brief Discard the current path and start recording a new one */
+		void beginRecording();
+		bool isRecording() const;
+		/**
+		* Record the camera state of a frame
+		*
+		* @param deltaTime Time in seconds since the last recorded frame (ignored for the first frame)
+		* @param position Camera position the frame is rendered with
+		* @param rotation Camera rotation the frame is rendered with
+		*/
+		void record(float deltaTime, const glm::vec3 &position, const glm::vec3 &rotation);
+		/** @brief Stop recording, the path can be saved afterwards */
+		void endRecording();
+
+		/** @brief Write the path to a binary file, returns false if it could not be written */
+		bool save(const std::string &filename) const;
+		/** @brief Load a path from a binary file written by save, returns false if it could not be read or is not a camera path */
+		bool load(const std::string &filename);
+
+		bool empty() const;
+		/** @brief Duration of the path in seconds */
+		float getDuration() const;
+		/** @brief Number of frames a single replay of the path takes with the current time step */
+		uint32_t getFrameCount() const;
+		/** @brief Camera state at the given time, linearly interpolated between the surrounding keyframes and clamped to the path's duration */
+		void sample(float time, glm::vec3 &position, glm::vec3 &rotation) const;
+
+		/** @brief Restart the replay at the beginning of the path */
+		void rewind();
+		/**
+		* Camera state of the next replayed frame, the replay starts over at the end of the path
+		*
+		* @return Index of the replayed frame since the last rewind
+		*/
+		uint32_t nextFrame(glm::vec3 &position, glm::vec3 &rotation);
+		/** @brief Whether all frames of the path have been replayed since the last rewind */
+		bool finished() const;
+
+	private:
+		std::vector<Keyframe> keyframes;
+		bool recording = false;
+		float recordingTime = 0.0f;
+		// Last frame of an unchanged camera state, only added as a keyframe once the camera moves again (or at the end of the recording)
+		bool holdPending = false;
+		Keyframe hold;
+		uint32_t replayFrame = 0;
+	};
+}
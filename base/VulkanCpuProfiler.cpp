@@ -0,0 +1,208 @@
+/*
+* CPU profiler
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "VulkanCpuProfiler.h"
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace vks
+{
+	namespace
+	{
+		struct ZoneEvent
+		{
+			const char *name;
+			uint64_t start;
+			uint64_t end;
+		};
+
+		/** @brief Block of zones, the owning thread appends to it while the trace writer may read it concurrently */
+		struct Chunk
+		{
+			// Chunks start small, as many threads (e.g. of the block compressor) only record a few zones
+			static const size_t minCapacity = 64;
+			static const size_t maxCapacity = 4096;
+			std::unique_ptr<ZoneEvent[]> zones;
+			size_t capacity;
+			// Number of zones that have been completely written (published with release semantics)
+			std::atomic<size_t> count;
+			std::atomic<Chunk*> next;
+			explicit Chunk(size_t capacity) : zones(new ZoneEvent[capacity]), capacity(capacity), count(0), next(nullptr) {}
+		};
+
+		struct ThreadBuffer
+		{
+			uint32_t id = 0;
+			// Guarded by the registry's mutex
+			std::string name;
+			Chunk *first = nullptr;
+			// Only accessed by the owning thread
+			Chunk *last = nullptr;
+			size_t zoneCount = 0;
+			std::atomic<size_t> dropped;
+			ThreadBuffer() : dropped(0) {}
+			~ThreadBuffer()
+			{
+				Chunk *chunk = first;
+				while (chunk != nullptr) {
+					Chunk *next = chunk->next.load(std::memory_order_relaxed);
+					delete chunk;
+					chunk = next;
+				}
+			}
+		};
+
+		struct Registry
+		{
+			std::mutex mutex;
+			std::vector<std::unique_ptr<ThreadBuffer>> threads;
+		};
+
+		// Never destroyed, so threads that outlive static destruction can't write to a freed buffer
+		Registry &getRegistry()
+		{
+			static Registry *registry = new Registry();
+			return *registry;
+		}
+
+		const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+		thread_local ThreadBuffer *threadBuffer = nullptr;
+
+		// The registry is only locked the first time a thread records a zone or sets it's name
+		ThreadBuffer *getThreadBuffer()
+		{
+			if (threadBuffer == nullptr) {
+				Registry &registry = getRegistry();
+				std::lock_guard<std::mutex> lock(registry.mutex);
+				std::unique_ptr<ThreadBuffer> buffer(new ThreadBuffer());
+				buffer->id = static_cast<uint32_t>(registry.threads.size() + 1);
+				buffer->name = "Thread " + std::to_string(buffer->id);
+				buffer->first = buffer->last = new Chunk(Chunk::minCapacity);
+				threadBuffer = buffer.get();
+				registry.threads.push_back(std::move(buffer));
+			}
+			return threadBuffer;
+		}
+
+		std::string escapeJson(const std::string &value)
+		{
+			std::string escaped;
+			for (char c : value) {
+				if ((c == '"') || (c == '\\')) {
+					escaped += '\\';
+					escaped += c;
+				}
+				else if (static_cast<unsigned char>(c) < 0x20) {
+					escaped += ' ';
+				}
+				else {
+					escaped += c;
+				}
+			}
+			return escaped;
+		}
+	}
+
+	std::atomic<bool> CpuProfiler::recording(false);
+
+	void CpuProfiler::start()
+	{
+		recording.store(true, std::memory_order_relaxed);
+	}
+
+	void CpuProfiler::stop()
+	{
+		recording.store(false, std::memory_order_relaxed);
+	}
+
+	bool CpuProfiler::isEnabled()
+	{
+#if defined(VKS_CPU_PROFILER_DISABLED)
+		return false;
+#else
+		return true;
+#endif
+	}
+
+	void CpuProfiler::setThreadName(const std::string &name)
+	{
+		if (!isRecording()) {
+			return;
+		}
+		ThreadBuffer *buffer = getThreadBuffer();
+		std::lock_guard<std::mutex> lock(getRegistry().mutex);
+		buffer->name = name;
+	}
+
+	uint64_t CpuProfiler::now()
+	{
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+	}
+
+	void CpuProfiler::addZone(const char *name, uint64_t start, uint64_t end)
+	{
+		if (!isRecording()) {
+			return;
+		}
+		ThreadBuffer *buffer = getThreadBuffer();
+		if (buffer->zoneCount >= maxZonesPerThread) {
+			buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		Chunk *chunk = buffer->last;
+		size_t index = chunk->count.load(std::memory_order_relaxed);
+		if (index == chunk->capacity) {
+			Chunk *next = new Chunk((chunk->capacity * 2 < Chunk::maxCapacity) ? chunk->capacity * 2 : Chunk::maxCapacity);
+			chunk->next.store(next, std::memory_order_release);
+			buffer->last = chunk = next;
+			index = 0;
+		}
+		chunk->zones[index].name = name;
+		chunk->zones[index].start = start;
+		chunk->zones[index].end = end;
+		chunk->count.store(index + 1, std::memory_order_release);
+		buffer->zoneCount++;
+	}
+
+	bool CpuProfiler::writeTrace(const std::string &filename)
+	{
+		std::ofstream file(filename);
+		if (!file.is_open()) {
+			return false;
+		}
+		file << std::fixed << std::setprecision(3);
+		file << "{\n\t\"displayTimeUnit\": \"ms\",\n\t\"traceEvents\": [\n";
+		file << "\t\t{ \"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 0, \"args\": { \"name\": \"Vulkan example\" } }";
+
+		Registry &registry = getRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		size_t dropped = 0;
+		for (auto &thread : registry.threads) {
+			file << ",\n\t\t{ \"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << thread->id << ", \"args\": { \"name\": \"" << escapeJson(thread->name) << "\" } }";
+			// Threads may still be recording, only zones that have been published so far are written
+			for (Chunk *chunk = thread->first; chunk != nullptr; chunk = chunk->next.load(std::memory_order_acquire)) {
+				const size_t count = chunk->count.load(std::memory_order_acquire);
+				for (size_t i = 0; i < count; i++) {
+					const ZoneEvent &zone = chunk->zones[i];
+					// Trace event timestamps are in microseconds
+					file << ",\n\t\t{ \"name\": \"" << escapeJson(zone.name) << "\", \"cat\": \"cpu\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << thread->id;
+					file << ", \"ts\": " << zone.start / 1000.0 << ", \"dur\": " << (zone.end - zone.start) / 1000.0 << " }";
+				}
+			}
+			dropped += thread->dropped.load(std::memory_order_relaxed);
+		}
+		file << "\n\t],\n\t\"otherData\": { \"droppedZones\": " << dropped << " }\n}\n";
+		return file.good();
+	}
+}
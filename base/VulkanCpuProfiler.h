@@ -0,0 +1,90 @@
+/*
+* CPU profiler
+*
+* Scoped zones are recorded into per-thread buffers (no locks are taken once a thread has recorded it's first zone) and can be written
+* as Chrome trace event JSON for chrome://tracing or https://ui.perfetto.dev
+* Zones are only recorded while the profiler is started (e.g. with --trace), defining VKS_CPU_PROFILER_DISABLED removes all zone macros
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <string>
+
+namespace vks
+{
+	class CpuProfiler
+	{
+	public:
+		/** @brief Records a zone from it's construction to it's destruction, use the VKS_PROFILE_* macros instead of creating zones directly */
+		class Zone
+		{
+		public:
+			/** @param name Name of the zone, only the pointer is stored so it must stay valid until the trace has been written (e.g. a string literal) */
+			explicit Zone(const char *name) : name(name), active(CpuProfiler::isRecording())
+			{
+				if (active) {
+					start = CpuProfiler::now();
+				}
+			}
+			~Zone()
+			{
+				if (active) {
+					CpuProfiler::addZone(name, start, CpuProfiler::now());
+				}
+			}
+		private:
+			const char *name;
+			bool active;
+			uint64_t start = 0;
+			Zone(const Zone&) = delete;
+			Zone &operator=(const Zone&) = delete;
+		};
+
+		/** @brief Maximum number of zones recorded per thread, further zones are dropped */
+		static const size_t maxZonesPerThread = 1 << 20;
+
+		/** @brief Start recording zones on all threads */
+		static void start();
+		/** @brief Stop recording zones, zones that have already been recorded are kept */
+		static void stop();
+		static bool isRecording()
+		{
+			return recording.load(std::memory_order_relaxed);
+		}
+		/** @brief Whether the zone macros have been compiled in */
+		static bool isEnabled();
+
+		/** @brief Name the calling thread in the trace (ignored while not recording), the name is copied */
+		static void setThreadName(const std::string &name);
+		/** @brief Nanoseconds since the start of the process */
+		static uint64_t now();
+		/** @brief Record a zone on the calling thread from explicit timestamps (taken with now()), ignored while not recording */
+		static void addZone(const char *name, uint64_t start, uint64_t end);
+
+		/** @brief Write all recorded zones of all threads as trace event JSON, returns false if the file could not be written */
+		static bool writeTrace(const std::string &filename);
+
+	private:
+		static std::atomic<bool> recording;
+	};
+}
+
+#if defined(VKS_CPU_PROFILER_DISABLED)
+#define VKS_PROFILE_ZONE(name)
+#define VKS_PROFILE_FUNCTION()
+#define VKS_PROFILE_THREAD(name)
+#else
+#define VKS_PROFILE_CONCAT_INNER(a, b) a##b
+#define VKS_PROFILE_CONCAT(a, b) VKS_PROFILE_CONCAT_INNER(a, b)
+/** @brief Record a zone from this line to the end of the enclosing scope */
+#define VKS_PROFILE_ZONE(name) vks::CpuProfiler::Zone VKS_PROFILE_CONCAT(profileZone, __LINE__)(name)
+/** @brief Record a zone named after the enclosing function */
+#define VKS_PROFILE_FUNCTION() VKS_PROFILE_ZONE(__FUNCTION__)
+#define VKS_PROFILE_THREAD(name) vks::CpuProfiler::setThreadName(name)
+#endif
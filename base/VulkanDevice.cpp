@@ -9,6 +9,9 @@
 */
 
 #include <VulkanDevice.h>
+#include "VulkanDebug.h"
+#include "VulkanCpuProfiler.h"
+#include "VulkanTransferEngine.h"
 #include <unordered_set>
 
 namespace vks
@@ -60,6 +63,8 @@ namespace vks
 	*/
 	VulkanDevice::~VulkanDevice()
 	{
+		delete memoryAllocator;
+		delete memoryTracker;
 		if (commandPool)
 		{
 			vkDestroyCommandPool(logicalDevice, commandPool, nullptr);
@@ -110,6 +115,107 @@ namespace vks
 		}
 	}
 
+	/**
+	* Get the index of the memory type that suits the intended usage of a resource best
+	*
+	* @param typeBits Bit mask with bits set for each memory type supported by the resource to request for (from VkMemoryRequirements)
+	* @param usage How the memory is going to be accessed by the host and the device
+	* @param size (Optional) Size of the allocation, used to check if a host visible device local heap still has room for it
+	* @param (Optional) memTypeFound Pointer to a bool that is set to true if a matching memory type has been found
+	*
+	* @return Index of the memory type with the highest score for the requested usage
+	*
+	* @note Heap usage is taken from the sub-allocator, memory allocated directly (e.g. with the raw createBuffer overload) is not accounted for
+	*
+	* @throw Throws an exception if memTypeFound is null and no memory type could be found that is host visible (if required by the usage)
+	*/
+	uint32_t VulkanDevice::getMemoryType(uint32_t typeBits, vks::MemoryUsage usage, VkDeviceSize size, VkBool32 *memTypeFound) const
+	{
+		// Memory already allocated from each heap, host visible device local heaps are small unless resizable BAR is enabled and shouldn't be exhausted
+		VkDeviceSize heapUsage[VK_MAX_MEMORY_HEAPS] = {};
+		if (memoryAllocator)
+		{
+			for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++)
+			{
+				heapUsage[memoryProperties.memoryTypes[i].heapIndex] += memoryAllocator->getStats(i).allocatedBytes;
+			}
+		}
+		VkDeviceSize largestDeviceLocalHeap = 0;
+		for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++)
+		{
+			if (memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)
+			{
+				largestDeviceLocalHeap = std::max(largestDeviceLocalHeap, memoryProperties.memoryHeaps[i].size);
+			}
+		}
+
+		int32_t bestScore = -1;
+		uint32_t bestIndex = 0;
+		for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++)
+		{
+			const VkMemoryPropertyFlags flags = memoryProperties.memoryTypes[i].propertyFlags;
+			if (((typeBits & (1u << i)) == 0) || (flags & (VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT | VK_MEMORY_PROPERTY_PROTECTED_BIT)))
+			{
+				continue;
+			}
+			const bool deviceLocal = (flags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) != 0;
+			const bool hostVisible = (flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
+			const bool hostCoherent = (flags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+			const bool hostCached = (flags & VK_MEMORY_PROPERTY_HOST_CACHED_BIT) != 0;
+			const VkDeviceSize heapSize = memoryProperties.memoryHeaps[memoryProperties.memoryTypes[i].heapIndex].size;
+			// Only fill up to half of a host visible device local heap, leaving room for the driver and other applications
+			const bool heapHasRoom = heapUsage[memoryProperties.memoryTypes[i].heapIndex] + size <= heapSize / 2;
+
+			int32_t score = 0;
+			switch (usage)
+			{
+			case vks::MemoryUsage::GpuOnly:
+				score = (deviceLocal ? 4 : 0) + (hostVisible ? 0 : 1);
+				break;
+			case vks::MemoryUsage::Upload:
+			case vks::MemoryUsage::Dynamic:
+				if (!hostVisible)
+				{
+					continue;
+				}
+				// Write-combined (uncached) memory is best for sequential writes from the host
+				score = (hostCoherent ? 2 : 0) + (hostCached ? 0 : 1);
+				if (deviceLocal && heapHasRoom)
+				{
+					// Static uploads only skip staging if the whole of video memory is host visible (resizable BAR or UMA), per-frame data also uses the 256 MB BAR window
+					if ((usage == vks::MemoryUsage::Dynamic) || (heapSize * 2 >= largestDeviceLocalHeap))
+					{
+						score += 4;
+					}
+				}
+				break;
+			case vks::MemoryUsage::Readback:
+				if (!hostVisible)
+				{
+					continue;
+				}
+				// Reads from uncached memory are extremely slow
+				score = (hostCached ? 4 : 0) + (hostCoherent ? 2 : 0) + (deviceLocal ? 0 : 1);
+				break;
+			}
+			if (score > bestScore)
+			{
+				bestScore = score;
+				bestIndex = i;
+			}
+		}
+
+		if (memTypeFound)
+		{
+			*memTypeFound = (bestScore >= 0);
+		}
+		else if (bestScore < 0)
+		{
+			throw std::runtime_error("Could not find a matching memory type");
+		}
+		return bestIndex;
+	}
+
 	/**
 	* Get the index of a queue family that supports the requested queue flags
 	*
@@ -264,6 +370,32 @@ namespace vks
 			deviceCreateInfo.pNext = &physicalDeviceFeatures2;
 		}
 
+		// Enable timeline semaphores if present, the transfer engine uses them to signal completed uploads
+		// The extension requires the feature to be supported, so it can be enabled without querying
+		VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timelineSemaphoreFeatures{};
+		if (extensionSupported(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME))
+		{
+			if (std::find_if(deviceExtensions.begin(), deviceExtensions.end(), [](const char* extension) { return strcmp(extension, VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME) == 0; }) == deviceExtensions.end())
+			{
+				deviceExtensions.push_back(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+			}
+			timelineSemaphoreFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+			timelineSemaphoreFeatures.timelineSemaphore = VK_TRUE;
+			timelineSemaphoreFeatures.pNext = const_cast<void*>(deviceCreateInfo.pNext);
+			deviceCreateInfo.pNext = &timelineSemaphoreFeatures;
+			enableTimelineSemaphores = true;
+		}
+
+		// Enable the memory budget extension if present, the heap usage it reports is part of the benchmark results
+		if (extensionSupported(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME))
+		{
+			if (std::find_if(deviceExtensions.begin(), deviceExtensions.end(), [](const char* extension) { return strcmp(extension, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME) == 0; }) == deviceExtensions.end())
+			{
+				deviceExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+			}
+			enableMemoryBudget = true;
+		}
+
 		// Enable the debug marker extension if it is present (likely meaning a debugging tool is present)
 		if (extensionSupported(VK_EXT_DEBUG_MARKER_EXTENSION_NAME))
 		{
@@ -295,6 +427,11 @@ namespace vks
 		// Create a default command pool for graphics command buffers
 		commandPool = createCommandPool(queueFamilyIndices.graphics);
 
+		memoryTracker = new vks::MemoryTracker();
+		memoryTracker->setMemoryProperties(memoryProperties);
+		memoryAllocator = new vks::MemoryAllocator(physicalDevice, logicalDevice);
+		memoryAllocator->tracker = memoryTracker;
+
 		return result;
 	}
 
@@ -309,6 +446,8 @@ namespace vks
 	* @param data Pointer to the data that should be copied to the buffer after creation (optional, if not set, no data is copied over)
 	*
 	* @return VK_SUCCESS if buffer handle and memory have been created and (optionally passed) data has been copied
+	*
+	* @note The memory is owned by the caller (and released with freeMemory), so it can't be sub-allocated. Prefer the vks::Buffer overload
 	*/
 	VkResult VulkanDevice::createBuffer(VkBufferUsageFlags usageFlags, VkMemoryPropertyFlags memoryPropertyFlags, VkDeviceSize size, VkBuffer *buffer, VkDeviceMemory *memory, void *data)
 	{
@@ -331,7 +470,7 @@ namespace vks
 			allocFlagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT_KHR;
 			memAlloc.pNext = &allocFlagsInfo;
 		}
-		VK_CHECK_RESULT(vkAllocateMemory(logicalDevice, &memAlloc, nullptr, memory));
+		VK_CHECK_RESULT(allocateMemory(memAlloc, memory, vks::MemoryTracker::getBufferCategory(usageFlags)));
 			
 		// If a pointer to the buffer data has been passed, map the buffer and copy over the data
 		if (data != nullptr)
@@ -378,19 +517,12 @@ namespace vks
 
 		// Create the memory backing up the buffer handle
 		VkMemoryRequirements memReqs;
-		VkMemoryAllocateInfo memAlloc = vks::initializers::memoryAllocateInfo();
 		vkGetBufferMemoryRequirements(logicalDevice, buffer->buffer, &memReqs);
-		memAlloc.allocationSize = memReqs.size;
-		// Find a memory type index that fits the properties of the buffer
-		memAlloc.memoryTypeIndex = getMemoryType(memReqs.memoryTypeBits, memoryPropertyFlags);
+		// Find a memory type index that fits the properties of the buffer and sub-allocate from a block of that type
 		// If the buffer has VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT set we also need to enable the appropriate flag during allocation
-		VkMemoryAllocateFlagsInfoKHR allocFlagsInfo{};
-		if (usageFlags & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) {
-			allocFlagsInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO_KHR;
-			allocFlagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT_KHR;
-			memAlloc.pNext = &allocFlagsInfo;
-		}
-		VK_CHECK_RESULT(vkAllocateMemory(logicalDevice, &memAlloc, nullptr, &buffer->memory));
+		const VkMemoryAllocateFlags allocateFlags = (usageFlags & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) ? VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT_KHR : 0;
+		VK_CHECK_RESULT(memoryAllocator->allocate(memReqs, getMemoryType(memReqs.memoryTypeBits, memoryPropertyFlags), vks::ResourceType::Linear, vks::MemoryTracker::getBufferCategory(usageFlags), &buffer->allocation, allocateFlags));
+		buffer->memory = buffer->allocation->memory;
 
 		buffer->alignment = memReqs.alignment;
 		buffer->size = size;
@@ -415,6 +547,119 @@ namespace vks
 		return buffer->bind();
 	}
 
+	/**
+	* Create a buffer on the device in the memory type that suits the intended usage best
+	*
+	* @param usageFlags Usage flag bit mask for the buffer (i.e. index, vertex, uniform buffer)
+	* @param memoryUsage How the buffer is going to be accessed by the host and the device
+	* @param buffer Pointer to a vk::Vulkan buffer object, memoryPropertyFlags is set to the properties of the selected memory type
+	* @param size Size of the buffer in bytes
+	* @param data Pointer to the data that should be copied to the buffer after creation (optional, if not set, no data is copied over)
+	*
+	* @note If data is passed and the selected memory type isn't host visible, the data is uploaded through a staging buffer on the graphics queue
+	*
+	* @return VK_SUCCESS if buffer handle and memory have been created and (optionally passed) data has been copied
+	*/
+	VkResult VulkanDevice::createBuffer(VkBufferUsageFlags usageFlags, vks::MemoryUsage memoryUsage, vks::Buffer *buffer, VkDeviceSize size, void *data)
+	{
+		buffer->device = logicalDevice;
+
+		// The buffer may end up in memory that isn't host visible, in which case the data is copied on the device
+		if (data != nullptr)
+		{
+			usageFlags |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+		}
+
+		// Create the buffer handle
+		VkBufferCreateInfo bufferCreateInfo = vks::initializers::bufferCreateInfo(usageFlags, size);
+		VK_CHECK_RESULT(vkCreateBuffer(logicalDevice, &bufferCreateInfo, nullptr, &buffer->buffer));
+
+		// Create the memory backing up the buffer handle
+		VkMemoryRequirements memReqs;
+		vkGetBufferMemoryRequirements(logicalDevice, buffer->buffer, &memReqs);
+		const uint32_t memoryTypeIndex = getMemoryType(memReqs.memoryTypeBits, memoryUsage, memReqs.size);
+		const VkMemoryAllocateFlags allocateFlags = (usageFlags & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) ? VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT_KHR : 0;
+		VK_CHECK_RESULT(memoryAllocator->allocate(memReqs, memoryTypeIndex, vks::ResourceType::Linear, vks::MemoryTracker::getBufferCategory(usageFlags), &buffer->allocation, allocateFlags));
+		buffer->memory = buffer->allocation->memory;
+
+		buffer->alignment = memReqs.alignment;
+		buffer->size = size;
+		buffer->usageFlags = usageFlags;
+		buffer->memoryPropertyFlags = memoryProperties.memoryTypes[memoryTypeIndex].propertyFlags;
+
+		buffer->setupDescriptor();
+		VK_CHECK_RESULT(buffer->bind());
+
+		if (data != nullptr)
+		{
+			if (buffer->memoryPropertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+			{
+				// Host visible (e.g. resizable BAR or UMA), no staging required
+				VK_CHECK_RESULT(buffer->map());
+				memcpy(buffer->mapped, data, size);
+				if ((buffer->memoryPropertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) == 0)
+					buffer->flush();
+
+				buffer->unmap();
+			}
+			else
+			{
+				vks::Buffer stagingBuffer;
+				VK_CHECK_RESULT(createBuffer(VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &stagingBuffer, size, data));
+				VkQueue queue;
+				vkGetDeviceQueue(logicalDevice, queueFamilyIndices.graphics, 0, &queue);
+				copyBuffer(&stagingBuffer, buffer, queue);
+				stagingBuffer.destroy();
+			}
+		}
+
+		return VK_SUCCESS;
+	}
+
+	/**
+	* Allocate device memory directly (without sub-allocation) and account for it with the memory tracker
+	*
+	* @param allocateInfo Allocation info as passed to vkAllocateMemory
+	* @param memory Pointer to the memory handle acquired by the function
+	* @param category Category the memory is accounted for
+	* @param (Optional) name Debug name of the memory, also set with the debug marker extension if present
+	*
+	* @return VK_SUCCESS or the error returned by vkAllocateMemory
+	*
+	* @note Memory allocated with this function has to be released with freeMemory
+	*/
+	VkResult VulkanDevice::allocateMemory(const VkMemoryAllocateInfo &allocateInfo, VkDeviceMemory *memory, vks::MemoryCategory category, const char *name)
+	{
+		VkResult result = vkAllocateMemory(logicalDevice, &allocateInfo, nullptr, memory);
+		if (result == VK_SUCCESS)
+		{
+			memoryTracker->track((uint64_t)*memory, category, allocateInfo.allocationSize, allocateInfo.memoryTypeIndex, name);
+			if (name)
+			{
+				vks::debugmarker::setDeviceMemoryName(logicalDevice, *memory, name);
+			}
+		}
+		return result;
+	}
+
+	/** @brief Free memory allocated with allocateMemory (or the raw createBuffer overload) */
+	void VulkanDevice::freeMemory(VkDeviceMemory memory)
+	{
+		if (memory == VK_NULL_HANDLE)
+		{
+			return;
+		}
+		memoryTracker->untrack((uint64_t)memory);
+		vkFreeMemory(logicalDevice, memory, nullptr);
+	}
+
+	/** @brief Set the debug name of memory allocated with allocateMemory for the memory tracker and the debug marker extension */
+	void VulkanDevice::setMemoryName(VkDeviceMemory memory, const char *name)
+	{
+		memoryTracker->setName((uint64_t)memory, name);
+		vks::debugmarker::setDeviceMemoryName(logicalDevice, memory, name);
+	}
+
 	/**
 	* Copy buffer data from src to dst using VkCmdCopyBuffer
 	* 
@@ -514,6 +759,12 @@ namespace vks
 
 		VK_CHECK_RESULT(vkEndCommandBuffer(commandBuffer));
 
+		// The command buffer may use resources with pending uploads, which the graphics queue orders before it once they're submitted
+		if (transferEngine)
+		{
+			transferEngine->submit();
+		}
+
 		VkSubmitInfo submitInfo = vks::initializers::submitInfo();
 		submitInfo.commandBufferCount = 1;
 		submitInfo.pCommandBuffers = &commandBuffer;
@@ -524,7 +775,10 @@ namespace vks
 		// Submit to the queue
 		VK_CHECK_RESULT(vkQueueSubmit(queue, 1, &submitInfo, fence));
 		// Wait for the fence to signal that command buffer has finished executing
-		VK_CHECK_RESULT(vkWaitForFences(logicalDevice, 1, &fence, VK_TRUE, DEFAULT_FENCE_TIMEOUT));
+		{
+			VKS_PROFILE_ZONE("vks::VulkanDevice::flushCommandBuffer wait");
+			VK_CHECK_RESULT(vkWaitForFences(logicalDevice, 1, &fence, VK_TRUE, DEFAULT_FENCE_TIMEOUT));
+		}
 		vkDestroyFence(logicalDevice, fence, nullptr);
 		if (free)
 		{
@@ -549,6 +803,33 @@ namespace vks
 		return (std::find(supportedExtensions.begin(), supportedExtensions.end(), extension) != supportedExtensions.end());
 	}
 
+	/**
+	* Query the current budget and usage of all memory heaps (VK_EXT_memory_budget) and update the peak usage
+	*
+	* @return True if the budget has been queried, false if the extension or the query function is not available
+	*/
+	bool VulkanDevice::updateMemoryBudget()
+	{
+		if (!enableMemoryBudget || (getMemoryProperties2 == nullptr))
+		{
+			return false;
+		}
+		VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties{};
+		budgetProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+		VkPhysicalDeviceMemoryProperties2 memoryProperties2{};
+		memoryProperties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+		memoryProperties2.pNext = &budgetProperties;
+		getMemoryProperties2(physicalDevice, &memoryProperties2);
+		heapBudgets.resize(memoryProperties2.memoryProperties.memoryHeapCount);
+		for (uint32_t i = 0; i < memoryProperties2.memoryProperties.memoryHeapCount; i++)
+		{
+			heapBudgets[i].budget = budgetProperties.heapBudget[i];
+			heapBudgets[i].usage = budgetProperties.heapUsage[i];
+			heapBudgets[i].peakUsage = std::max(heapBudgets[i].peakUsage, budgetProperties.heapUsage[i]);
+		}
+		return true;
+	}
+
 	/**
 	* Select the best-fit depth format for this device from a list of possible depth (and stencil) formats
 	*
@@ -11,6 +11,8 @@
 #pragma once
 
 #include "VulkanBuffer.h"
+#include "VulkanMemoryAllocator.h"
+#include "VulkanMemoryTracker.h"
 #include "VulkanTools.h"
 #include "vulkan/vulkan.h"
 #include <algorithm>
@@ -19,6 +21,23 @@
 
 namespace vks
 {
+class JobSystem;
+class MipGenerator;
+class TransferEngine;
+
+/** @brief How a resource's memory is going to be accessed, used to pick the best of all memory types that are compatible with a resource */
+enum class MemoryUsage
+{
+	/** @brief Only accessed by the device, filled with transfers (prefers device local memory that is not host visible) */
+	GpuOnly,
+	/** @brief Written once by the host and read by the device (prefers host visible device local memory if it's large, i.e. resizable BAR or UMA) */
+	Upload,
+	/** @brief Rewritten by the host every frame and read by the device (prefers host visible device local memory as long as the heap has room) */
+	Dynamic,
+	/** @brief Written by the device and read by the host (prefers host cached memory) */
+	Readback
+};
+
 struct VulkanDevice
 {
 	/** @brief Physical device representation */
@@ -37,10 +56,34 @@ struct VulkanDevice
 	std::vector<VkQueueFamilyProperties> queueFamilyProperties;
 	/** @brief List of extensions supported by the device */
 	std::vector<std::string> supportedExtensions;
+	/** @brief Sub-allocator for buffer and image memory, created along with the logical device */
+	vks::MemoryAllocator *memoryAllocator = nullptr;
+	/** @brief Per-category accounting of all memory allocated through the sub-allocator and allocateMemory, created along with the logical device */
+	vks::MemoryTracker *memoryTracker = nullptr;
+	/** @brief Job system for the CPU side work of resource creation (e.g. block compression), if null that work is done on the calling thread */
+	vks::JobSystem *jobSystem = nullptr;
+	/** @brief If set, uploads of resource loaders (e.g. the glTF model loader) are batched on the transfer queue instead of blocking copies on the passed queue */
+	vks::TransferEngine *transferEngine = nullptr;
+	/** @brief If set, mip chains that resource loaders generate at runtime are built with this compute mip generator instead of image blits */
+	vks::MipGenerator *mipGenerator = nullptr;
 	/** @brief Default command pool for the graphics queue family index */
 	VkCommandPool commandPool = VK_NULL_HANDLE;
 	/** @brief Set to true when the debug marker extension is detected */
 	bool enableDebugMarkers = false;
+	/** @brief Set to true when timeline semaphores have been enabled (VK_KHR_timeline_semaphore is present) */
+	bool enableTimelineSemaphores = false;
+	/** @brief Set to true when VK_EXT_memory_budget has been enabled, the budget can only be queried once getMemoryProperties2 has been set (instance level function) */
+	bool enableMemoryBudget = false;
+	PFN_vkGetPhysicalDeviceMemoryProperties2KHR getMemoryProperties2 = nullptr;
+	/** @brief Budget and usage of a memory heap as reported by VK_EXT_memory_budget (including memory allocated outside of the framework and by other processes' share of the heap) */
+	struct HeapBudget
+	{
+		VkDeviceSize budget = 0;
+		VkDeviceSize usage = 0;
+		VkDeviceSize peakUsage = 0;
+	};
+	/** @brief Per heap budgets, updated by updateMemoryBudget (empty if the budget can't be queried) */
+	std::vector<HeapBudget> heapBudgets;
 	/** @brief Contains queue family indices */
 	struct
 	{
@@ -55,10 +98,15 @@ struct VulkanDevice
 	explicit VulkanDevice(VkPhysicalDevice physicalDevice);
 	~VulkanDevice();
 	uint32_t        getMemoryType(uint32_t typeBits, VkMemoryPropertyFlags properties, VkBool32 *memTypeFound = nullptr) const;
+	uint32_t        getMemoryType(uint32_t typeBits, vks::MemoryUsage usage, VkDeviceSize size = 0, VkBool32 *memTypeFound = nullptr) const;
 	uint32_t        getQueueFamilyIndex(VkQueueFlagBits queueFlags) const;
-	VkResult        createLogicalDevice(VkPhysicalDeviceFeatures enabledFeatures, std::vector<const char *> enabledExtensions, void *pNextChain, bool useSwapChain = true, VkQueueFlags requestedQueueTypes = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
+	VkResult        createLogicalDevice(VkPhysicalDeviceFeatures enabledFeatures, std::vector<const char *> enabledExtensions, void *pNextChain, bool useSwapChain = true, VkQueueFlags requestedQueueTypes = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT);
 	VkResult        createBuffer(VkBufferUsageFlags usageFlags, VkMemoryPropertyFlags memoryPropertyFlags, VkDeviceSize size, VkBuffer *buffer, VkDeviceMemory *memory, void *data = nullptr);
 	VkResult        createBuffer(VkBufferUsageFlags usageFlags, VkMemoryPropertyFlags memoryPropertyFlags, vks::Buffer *buffer, VkDeviceSize size, void *data = nullptr);
+	VkResult        createBuffer(VkBufferUsageFlags usageFlags, vks::MemoryUsage memoryUsage, vks::Buffer *buffer, VkDeviceSize size, void *data = nullptr);
+	VkResult        allocateMemory(const VkMemoryAllocateInfo &allocateInfo, VkDeviceMemory *memory, vks::MemoryCategory category, const char *name = nullptr);
+	void            freeMemory(VkDeviceMemory memory);
+	void            setMemoryName(VkDeviceMemory memory, const char *name);
 	void            copyBuffer(vks::Buffer *src, vks::Buffer *dst, VkQueue queue, VkBufferCopy *copyRegion = nullptr);
 	VkCommandPool   createCommandPool(uint32_t queueFamilyIndex, VkCommandPoolCreateFlags createFlags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
 	VkCommandBuffer createCommandBuffer(VkCommandBufferLevel level, VkCommandPool pool, bool begin = false);
@@ -66,6 +114,7 @@ struct VulkanDevice
 	void            flushCommandBuffer(VkCommandBuffer commandBuffer, VkQueue queue, VkCommandPool pool, bool free = true);
 	void            flushCommandBuffer(VkCommandBuffer commandBuffer, VkQueue queue, bool free = true);
 	bool            extensionSupported(std::string extension);
+	bool            updateMemoryBudget();
 	VkFormat        getSupportedDepthFormat(bool checkSamplingSupport);
 };
 }        // namespace vks
@@ -0,0 +1,323 @@
+/*
+* Vulkan GPU profiler
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "VulkanGpuProfiler.h"
+#include "VulkanTools.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace vks
+{
+	const char *GpuProfiler::frameScopeName = "frame";
+
+	const char *GpuProfiler::getPipelineStatisticName(PipelineStatistic statistic)
+	{
+		switch (statistic) {
+		case PipelineStatistic::InputAssemblyVertices:
+			return "input_assembly_vertices";
+		case PipelineStatistic::InputAssemblyPrimitives:
+			return "input_assembly_primitives";
+		case PipelineStatistic::VertexShaderInvocations:
+			return "vertex_shader_invocations";
+		case PipelineStatistic::ClippingPrimitives:
+			return "clipping_primitives";
+		case PipelineStatistic::FragmentShaderInvocations:
+			return "fragment_shader_invocations";
+		default:
+			return "unknown";
+		}
+	}
+
+	GpuProfiler::~GpuProfiler()
+	{
+		destroy();
+	}
+
+	void GpuProfiler::create(vks::VulkanDevice *device, uint32_t slotCount, uint32_t maxScopes)
+	{
+		destroy();
+		this->device = device;
+		const uint32_t timestampValidBits = device->queueFamilyProperties[device->queueFamilyIndices.graphics].timestampValidBits;
+		supported = (timestampValidBits > 0) && (device->properties.limits.timestampPeriod > 0.0f);
+		if (!supported) {
+			return;
+		}
+		timestampPeriod = device->properties.limits.timestampPeriod;
+		timestampMask = (timestampValidBits >= 64) ? ~0ULL : ((1ULL << timestampValidBits) - 1);
+		pipelineStatistics = (device->enabledFeatures.pipelineStatisticsQuery == VK_TRUE);
+		// Every scope (including the frame) needs a timestamp at it's begin and end
+		maxQueries = (maxScopes + 1) * 2;
+
+		slots.resize(slotCount);
+		for (auto &slot : slots) {
+			VkQueryPoolCreateInfo queryPoolInfo{};
+			queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+			queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+			queryPoolInfo.queryCount = maxQueries;
+			VK_CHECK_RESULT(vkCreateQueryPool(device->logicalDevice, &queryPoolInfo, nullptr, &slot.timestampPool));
+			if (pipelineStatistics) {
+				// Results are written in the order of the flag bits, which matches PipelineStatistic
+				queryPoolInfo.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+				queryPoolInfo.pipelineStatistics =
+					VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT |
+					VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT |
+					VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+					VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+					VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT;
+				queryPoolInfo.queryCount = 1;
+				VK_CHECK_RESULT(vkCreateQueryPool(device->logicalDevice, &queryPoolInfo, nullptr, &slot.statisticsPool));
+			}
+		}
+	}
+
+	void GpuProfiler::destroy()
+	{
+		for (auto &slot : slots) {
+			if (slot.timestampPool != VK_NULL_HANDLE) {
+				vkDestroyQueryPool(device->logicalDevice, slot.timestampPool, nullptr);
+			}
+			if (slot.statisticsPool != VK_NULL_HANDLE) {
+				vkDestroyQueryPool(device->logicalDevice, slot.statisticsPool, nullptr);
+			}
+		}
+		slots.clear();
+		recording.clear();
+		supported = false;
+	}
+
+	bool GpuProfiler::isSupported() const
+	{
+		return supported;
+	}
+
+	bool GpuProfiler::pipelineStatisticsEnabled() const
+	{
+		return supported && pipelineStatistics;
+	}
+
+	void GpuProfiler::beginFrame(VkCommandBuffer commandBuffer, uint32_t slot)
+	{
+		if (!supported) {
+			return;
+		}
+		beginSlot(commandBuffer, slot, pipelineStatistics);
+	}
+
+	void GpuProfiler::beginScope(VkCommandBuffer commandBuffer, const std::string &name)
+	{
+		Slot *slot = getRecordingSlot(commandBuffer);
+		if ((slot == nullptr) || (slot->queryCount + 2 > maxQueries)) {
+			return;
+		}
+		RecordedScope scope;
+		scope.scope = getScope(name);
+		scope.beginQuery = slot->queryCount++;
+		scope.endQuery = slot->queryCount++;
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, slot->timestampPool, scope.beginQuery);
+		slot->openScopes.push_back(slot->scopes.size());
+		slot->scopes.push_back(scope);
+	}
+
+	void GpuProfiler::endScope(VkCommandBuffer commandBuffer)
+	{
+		Slot *slot = getRecordingSlot(commandBuffer);
+		if ((slot == nullptr) || slot->openScopes.empty()) {
+			return;
+		}
+		const RecordedScope &scope = slot->scopes[slot->openScopes.back()];
+		slot->openScopes.pop_back();
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, slot->timestampPool, scope.endQuery);
+	}
+
+	void GpuProfiler::endFrame(VkCommandBuffer commandBuffer)
+	{
+		Slot *slot = getRecordingSlot(commandBuffer);
+		if (slot == nullptr) {
+			return;
+		}
+		// Close scopes that have been left open, so every recorded query is written
+		while (!slot->openScopes.empty()) {
+			endScope(commandBuffer);
+		}
+		if (slot->statisticsRecorded) {
+			vkCmdEndQuery(commandBuffer, slot->statisticsPool, 0);
+		}
+	}
+
+	void GpuProfiler::recordFrameBoundaries(VkCommandBuffer beginCommandBuffer, VkCommandBuffer endCommandBuffer, uint32_t slot)
+	{
+		if (!supported) {
+			return;
+		}
+		beginSlot(beginCommandBuffer, slot, false);
+		setRecordingSlot(endCommandBuffer, slot);
+		endFrame(endCommandBuffer);
+	}
+
+	bool GpuProfiler::isFrameRecordedIn(uint32_t slot, VkCommandBuffer commandBuffer) const
+	{
+		return supported && (slot < slots.size()) && (slots[slot].frameCommandBuffer == commandBuffer);
+	}
+
+	void GpuProfiler::markSubmitted(uint32_t slot)
+	{
+		if (supported && (slot < slots.size())) {
+			slots[slot].submitted = true;
+		}
+	}
+
+	void GpuProfiler::resolve(uint32_t slot)
+	{
+		if (!supported || (slot >= slots.size()) || !slots[slot].submitted || slots[slot].scopes.empty()) {
+			return;
+		}
+		Slot &resolveSlot = slots[slot];
+		resolveSlot.submitted = false;
+
+		// Not waiting for results, if the device is not done with them this frame's results are skipped
+		std::vector<uint64_t> timestamps(resolveSlot.queryCount);
+		VkResult result = vkGetQueryPoolResults(device->logicalDevice, resolveSlot.timestampPool, 0, resolveSlot.queryCount, timestamps.size() * sizeof(uint64_t), timestamps.data(), sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+		if (result != VK_SUCCESS) {
+			return;
+		}
+		for (auto &recordedScope : resolveSlot.scopes) {
+			const uint64_t begin = timestamps[recordedScope.beginQuery] & timestampMask;
+			const uint64_t end = timestamps[recordedScope.endQuery] & timestampMask;
+			const double value = static_cast<double>((end - begin) & timestampMask) * timestampPeriod / 1000000.0;
+			Scope &scope = scopes[recordedScope.scope];
+			if (scope.samples.size() < maxSamples) {
+				scope.samples.push_back(value);
+			}
+			else {
+				scope.samples[scope.next] = value;
+				scope.next = (scope.next + 1) % maxSamples;
+			}
+			scope.recent = scope.resolved ? (scope.recent * 0.9 + value * 0.1) : value;
+			scope.resolved = true;
+		}
+
+		if (resolveSlot.statisticsRecorded) {
+			uint64_t statistics[static_cast<size_t>(PipelineStatistic::Count)] = {};
+			result = vkGetQueryPoolResults(device->logicalDevice, resolveSlot.statisticsPool, 0, 1, sizeof(statistics), statistics, sizeof(statistics), VK_QUERY_RESULT_64_BIT);
+			if (result == VK_SUCCESS) {
+				for (size_t i = 0; i < static_cast<size_t>(PipelineStatistic::Count); i++) {
+					statisticsSums[i] += static_cast<double>(statistics[i]);
+				}
+				statisticsCount++;
+			}
+		}
+	}
+
+	std::vector<std::pair<std::string, double>> GpuProfiler::getRecentTimes() const
+	{
+		std::vector<std::pair<std::string, double>> times;
+		for (auto &scope : scopes) {
+			if (scope.resolved) {
+				times.push_back(std::make_pair(scope.name, scope.recent));
+			}
+		}
+		return times;
+	}
+
+	std::vector<GpuProfiler::ScopeStats> GpuProfiler::getStats() const
+	{
+		std::vector<ScopeStats> stats;
+		for (auto &scope : scopes) {
+			if (scope.samples.empty()) {
+				continue;
+			}
+			std::vector<double> values = scope.samples;
+			std::sort(values.begin(), values.end());
+			ScopeStats scopeStats;
+			scopeStats.name = scope.name;
+			scopeStats.count = static_cast<uint32_t>(values.size());
+			scopeStats.min = values.front();
+			scopeStats.max = values.back();
+			scopeStats.average = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+			scopeStats.p50 = vks::tools::percentile(values, 0.50);
+			scopeStats.p90 = vks::tools::percentile(values, 0.90);
+			scopeStats.p99 = vks::tools::percentile(values, 0.99);
+			stats.push_back(scopeStats);
+		}
+		return stats;
+	}
+
+	double GpuProfiler::getPipelineStatistic(PipelineStatistic statistic) const
+	{
+		return (statisticsCount > 0) ? statisticsSums[static_cast<size_t>(statistic)] / statisticsCount : 0.0;
+	}
+
+	void GpuProfiler::reset()
+	{
+		for (auto &scope : scopes) {
+			scope.samples.clear();
+			scope.next = 0;
+		}
+		std::fill(std::begin(statisticsSums), std::end(statisticsSums), 0.0);
+		statisticsCount = 0;
+	}
+
+	void GpuProfiler::setRecordingSlot(VkCommandBuffer commandBuffer, uint32_t slot)
+	{
+		assert(slot < slots.size());
+		auto it = std::find_if(recording.begin(), recording.end(), [commandBuffer](const std::pair<VkCommandBuffer, uint32_t> &entry) { return entry.first == commandBuffer; });
+		if (it != recording.end()) {
+			it->second = slot;
+		}
+		else {
+			recording.push_back(std::make_pair(commandBuffer, slot));
+		}
+	}
+
+	void GpuProfiler::beginSlot(VkCommandBuffer commandBuffer, uint32_t slot, bool statistics)
+	{
+		setRecordingSlot(commandBuffer, slot);
+
+		// The slot's command buffer is being re-recorded, results of an earlier submission no longer match the recorded scopes
+		Slot &recordingSlot = slots[slot];
+		recordingSlot.scopes.clear();
+		recordingSlot.openScopes.clear();
+		recordingSlot.queryCount = 0;
+		recordingSlot.submitted = false;
+		recordingSlot.frameCommandBuffer = commandBuffer;
+		recordingSlot.statisticsRecorded = statistics;
+		vkCmdResetQueryPool(commandBuffer, recordingSlot.timestampPool, 0, maxQueries);
+		if (statistics) {
+			vkCmdResetQueryPool(commandBuffer, recordingSlot.statisticsPool, 0, 1);
+			vkCmdBeginQuery(commandBuffer, recordingSlot.statisticsPool, 0, 0);
+		}
+		beginScope(commandBuffer, frameScopeName);
+	}
+
+	GpuProfiler::Slot *GpuProfiler::getRecordingSlot(VkCommandBuffer commandBuffer)
+	{
+		if (!supported) {
+			return nullptr;
+		}
+		for (auto &entry : recording) {
+			if (entry.first == commandBuffer) {
+				return &slots[entry.second];
+			}
+		}
+		return nullptr;
+	}
+
+	uint32_t GpuProfiler::getScope(const std::string &name)
+	{
+		for (uint32_t i = 0; i < static_cast<uint32_t>(scopes.size()); i++) {
+			if (scopes[i].name == name) {
+				return i;
+			}
+		}
+		Scope scope;
+		scope.name = name;
+		scopes.push_back(scope);
+		return static_cast<uint32_t>(scopes.size() - 1);
+	}
+}
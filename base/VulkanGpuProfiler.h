@@ -0,0 +1,152 @@
+/*
+* Vulkan GPU profiler
+*
+* Measures named scopes of command buffers with timestamp queries (and optionally the whole frame with a pipeline statistics query)
+* Every command buffer slot (e.g. one per swap chain image) has it's own query pools, results are read back once the device is known
+* to be done with a slot, so reading them never stalls
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "vulkan/vulkan.h"
+#include "VulkanDevice.h"
+
+namespace vks
+{
+	class GpuProfiler
+	{
+	public:
+		/** @brief Device time distribution of a scope in milliseconds */
+		struct ScopeStats
+		{
+			std::string name;
+			uint32_t count = 0;
+			double min = 0.0;
+			double average = 0.0;
+			double p50 = 0.0;
+			double p90 = 0.0;
+			double p99 = 0.0;
+			double max = 0.0;
+		};
+
+		enum class PipelineStatistic
+		{
+			InputAssemblyVertices,
+			InputAssemblyPrimitives,
+			VertexShaderInvocations,
+			ClippingPrimitives,
+			FragmentShaderInvocations,
+			/** @brief Number of statistics, not a valid statistic */
+			Count
+		};
+
+		/** @brief Name of the scope spanning everything recorded between beginFrame and endFrame */
+		static const char *frameScopeName;
+		/** @brief Number of samples kept per scope, older samples are overwritten */
+		static const size_t maxSamples = 65536;
+
+		static const char *getPipelineStatisticName(PipelineStatistic statistic);
+
+		~GpuProfiler();
+
+		/**
+		* Create the query pools, does nothing if the graphics queue doesn't support timestamps
+		*
+		* @param device Device to create the query pools on, pipeline statistics are collected if pipelineStatisticsQuery has been enabled
+		* @param slotCount Number of command buffers that are profiled (e.g. one per swap chain image)
+		* @param maxScopes Maximum number of scopes recorded into a single command buffer, further scopes are ignored
+		*/
+		void create(vks::VulkanDevice *device, uint32_t slotCount, uint32_t maxScopes = 64);
+		void destroy();
+		bool isSupported() const;
+		bool pipelineStatisticsEnabled() const;
+
+		/** @brief Start profiling a command buffer, resets the slot's queries, so this needs to be recorded outside of a render pass */
+		void beginFrame(VkCommandBuffer commandBuffer, uint32_t slot);
+		/** @brief Start a scope, scopes can be nested */
+		void beginScope(VkCommandBuffer commandBuffer, const std::string &name);
+		void endScope(VkCommandBuffer commandBuffer);
+		/** @brief End profiling a command buffer, must be recorded outside of a render pass */
+		void endFrame(VkCommandBuffer commandBuffer);
+		/**
+		* Record a slot's frame scope into separate command buffers that are submitted right before and after the slot's own commands
+		* Used for slots whose command buffer isn't profiled itself, doesn't collect pipeline statistics as queries can't span command buffers
+		* A later beginFrame for the slot takes over from these command buffers
+		*/
+		void recordFrameBoundaries(VkCommandBuffer beginCommandBuffer, VkCommandBuffer endCommandBuffer, uint32_t slot);
+		/** @brief True if the slot's frame has last been begun in the given command buffer */
+		bool isFrameRecordedIn(uint32_t slot, VkCommandBuffer commandBuffer) const;
+
+		/** @brief Record that the command buffer of a slot has been submitted */
+		void markSubmitted(uint32_t slot);
+		/** @brief Read back the results of a slot, the device must be done with the slot's last submission (e.g. after waiting for it's fence) */
+		void resolve(uint32_t slot);
+
+		/** @brief Smoothed device time of every scope that has been resolved at least once, in the order they have first been recorded */
+		std::vector<std::pair<std::string, double>> getRecentTimes() const;
+		/** @brief Distribution of every scope's device time since the last reset */
+		std::vector<ScopeStats> getStats() const;
+		/** @brief Average of a frame's pipeline statistics since the last reset */
+		double getPipelineStatistic(PipelineStatistic statistic) const;
+		/** @brief Discard all samples (e.g. after a benchmark's warm up) */
+		void reset();
+
+	private:
+		struct RecordedScope
+		{
+			uint32_t scope;
+			uint32_t beginQuery;
+			uint32_t endQuery;
+		};
+
+		struct Slot
+		{
+			VkQueryPool timestampPool = VK_NULL_HANDLE;
+			VkQueryPool statisticsPool = VK_NULL_HANDLE;
+			std::vector<RecordedScope> scopes;
+			// Scopes that have been begun but not ended yet
+			std::vector<size_t> openScopes;
+			uint32_t queryCount = 0;
+			bool submitted = false;
+			// Command buffer the frame scope has been begun in
+			VkCommandBuffer frameCommandBuffer = VK_NULL_HANDLE;
+			bool statisticsRecorded = false;
+		};
+
+		struct Scope
+		{
+			std::string name;
+			std::vector<double> samples;
+			size_t next = 0;
+			double recent = 0.0;
+			bool resolved = false;
+		};
+
+		vks::VulkanDevice *device = nullptr;
+		bool supported = false;
+		bool pipelineStatistics = false;
+		uint32_t maxQueries = 0;
+		double timestampPeriod = 1.0;
+		uint64_t timestampMask = ~0ULL;
+		std::vector<Slot> slots;
+		std::vector<Scope> scopes;
+		// Slot a command buffer is recorded for, set by beginFrame
+		std::vector<std::pair<VkCommandBuffer, uint32_t>> recording;
+		double statisticsSums[static_cast<size_t>(PipelineStatistic::Count)] = {};
+		uint32_t statisticsCount = 0;
+
+		void setRecordingSlot(VkCommandBuffer commandBuffer, uint32_t slot);
+		void beginSlot(VkCommandBuffer commandBuffer, uint32_t slot, bool statistics);
+		Slot *getRecordingSlot(VkCommandBuffer commandBuffer);
+		uint32_t getScope(const std::string &name);
+	};
+}
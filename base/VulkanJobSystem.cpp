@@ -0,0 +1,393 @@
+/*
+* Work stealing job system
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "VulkanJobSystem.h"
+#include "VulkanCpuProfiler.h"
+
+#include <functional>
+#include <string>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__) && !defined(__ANDROID__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace vks
+{
+	namespace
+	{
+		// Unused jobs kept per thread for reuse, jobs freed beyond this are deleted (e.g. on threads that mostly steal)
+		const size_t maxFreeJobs = 1024;
+		// Number of times an idle worker looks for jobs again before going to sleep
+		const uint32_t idleSpinCount = 64;
+
+		thread_local const JobSystem *currentSystem = nullptr;
+		thread_local uint32_t currentThreadIndex = JobSystem::invalidThreadIndex;
+		thread_local uint32_t randomState = 0;
+
+		uint32_t nextRandom()
+		{
+			// Xorshift, only used to spread the steal attempts of the workers over the queues
+			uint32_t x = (randomState != 0) ? randomState : static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id())) | 1;
+			x ^= x << 13;
+			x ^= x >> 17;
+			x ^= x << 5;
+			randomState = x;
+			return x;
+		}
+
+		void pinThread(std::thread &thread, uint32_t core)
+		{
+#if defined(_WIN32)
+			SetThreadAffinityMask(thread.native_handle(), static_cast<DWORD_PTR>(1) << (core % (sizeof(DWORD_PTR) * 8)));
+#elif defined(__linux__) && !defined(__ANDROID__)
+			cpu_set_t cpuSet;
+			CPU_ZERO(&cpuSet);
+			CPU_SET(core, &cpuSet);
+			pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpuSet);
+#else
+			(void)thread;
+			(void)core;
+#endif
+		}
+	}
+
+	/**
+	* Chase-Lev work stealing deque with a fixed capacity
+	* Only the owning thread pushes and pops (at the bottom), any thread may steal (from the top)
+	*/
+	template<typename T>
+	class WorkQueue
+	{
+	public:
+		explicit WorkQueue(uint32_t capacity) : top(0), bottom(0), mask(capacity - 1), entries(new std::atomic<T*>[capacity])
+		{
+			for (uint32_t i = 0; i < capacity; i++) {
+				entries[i].store(nullptr, std::memory_order_relaxed);
+			}
+		}
+
+		/** @brief Returns false if the queue is full */
+		bool push(T *entry)
+		{
+			const int64_t b = bottom.load(std::memory_order_relaxed);
+			const int64_t t = top.load(std::memory_order_acquire);
+			if (b - t > static_cast<int64_t>(mask)) {
+				return false;
+			}
+			entries[b & mask].store(entry, std::memory_order_relaxed);
+			// Publishes the entry (and the job it points to) to stealing threads
+			bottom.store(b + 1, std::memory_order_release);
+			return true;
+		}
+
+		T *pop()
+		{
+			const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+			bottom.store(b, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t t = top.load(std::memory_order_relaxed);
+			if (t > b) {
+				bottom.store(b + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+			T *entry = entries[b & mask].load(std::memory_order_relaxed);
+			if (t == b) {
+				// Last entry, a thief may be taking it at the same time
+				if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+					entry = nullptr;
+				}
+				bottom.store(b + 1, std::memory_order_relaxed);
+			}
+			return entry;
+		}
+
+		/** @brief May return nullptr even if the queue isn't empty (when another thread took the entry first) */
+		T *steal()
+		{
+			int64_t t = top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			const int64_t b = bottom.load(std::memory_order_acquire);
+			if (t >= b) {
+				return nullptr;
+			}
+			T *entry = entries[t & mask].load(std::memory_order_relaxed);
+			if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+				return nullptr;
+			}
+			return entry;
+		}
+
+	private:
+		// Top and bottom are written by different threads, so they are kept on separate cache lines
+		std::atomic<int64_t> top;
+		char padding0[64 - sizeof(std::atomic<int64_t>)];
+		std::atomic<int64_t> bottom;
+		char padding1[64 - sizeof(std::atomic<int64_t>)];
+		const int64_t mask;
+		std::unique_ptr<std::atomic<T*>[]> entries;
+	};
+
+	struct JobSystem::Worker
+	{
+		WorkQueue<Job> queue;
+		// Only accessed by the thread the worker belongs to
+		std::vector<Job*> freeJobs;
+		std::thread thread;
+		Worker() : queue(queueCapacity) {}
+	};
+
+	JobSystem::JobSystem() : injectedJobs(0), pendingJobs(0), sleepingWorkers(0), stopping(false) {}
+
+	JobSystem::~JobSystem()
+	{
+		stop();
+	}
+
+	void JobSystem::start(uint32_t workerCount, bool pinThreads)
+	{
+		stop();
+		if (workerCount == 0) {
+			// The thread that starts the system executes jobs while waiting, so it takes the place of one worker
+			const uint32_t cores = std::thread::hardware_concurrency();
+			workerCount = (cores > 1) ? cores - 1 : 1;
+		}
+		ownerThreadId = std::this_thread::get_id();
+		stopping = false;
+		for (uint32_t i = 0; i <= workerCount; i++) {
+			workers.push_back(std::unique_ptr<Worker>(new Worker()));
+		}
+		// All workers have to exist before the first one starts stealing
+		for (uint32_t i = 1; i <= workerCount; i++) {
+			workers[i]->thread = std::thread(&JobSystem::workerLoop, this, i);
+			if (pinThreads) {
+				pinThread(workers[i]->thread, i);
+			}
+		}
+	}
+
+	void JobSystem::stop()
+	{
+		if (workers.empty()) {
+			return;
+		}
+		// Workers only exit once they can't find any more jobs
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+			stopping = true;
+			sleepCondition.notify_all();
+		}
+		for (size_t i = 1; i < workers.size(); i++) {
+			if (workers[i]->thread.joinable()) {
+				workers[i]->thread.join();
+			}
+		}
+		// Jobs the workers couldn't see anymore (e.g. added by the calling thread while they were exiting)
+		while (Job *job = takeJob(getThreadIndex())) {
+			execute(job);
+		}
+		for (auto &worker : workers) {
+			for (Job *job : worker->freeJobs) {
+				delete job;
+			}
+		}
+		workers.clear();
+	}
+
+	uint32_t JobSystem::getThreadCount() const
+	{
+		return workers.empty() ? 1 : static_cast<uint32_t>(workers.size());
+	}
+
+	uint32_t JobSystem::getThreadIndex() const
+	{
+		if (currentSystem == this) {
+			return currentThreadIndex;
+		}
+		if (!workers.empty() && (std::this_thread::get_id() == ownerThreadId)) {
+			return 0;
+		}
+		return invalidThreadIndex;
+	}
+
+	JobSystem::Job *JobSystem::allocateJob()
+	{
+		const uint32_t threadIndex = getThreadIndex();
+		if ((threadIndex != invalidThreadIndex) && !workers[threadIndex]->freeJobs.empty()) {
+			Job *job = workers[threadIndex]->freeJobs.back();
+			workers[threadIndex]->freeJobs.pop_back();
+			return job;
+		}
+		return new Job();
+	}
+
+	void JobSystem::freeJob(Job *job)
+	{
+		const uint32_t threadIndex = getThreadIndex();
+		if ((threadIndex != invalidThreadIndex) && (workers[threadIndex]->freeJobs.size() < maxFreeJobs)) {
+			workers[threadIndex]->freeJobs.push_back(job);
+			return;
+		}
+		delete job;
+	}
+
+	void JobSystem::submit(Job *job, Counter *dependency)
+	{
+		if (dependency) {
+			std::lock_guard<std::mutex> lock(dependency->mutex);
+			if (dependency->value.load(std::memory_order_acquire) != 0) {
+				// Queued by the thread that finishes the last job of the dependency
+				dependency->dependents.push_back(job);
+				return;
+			}
+		}
+		push(job);
+	}
+
+	void JobSystem::push(Job *job)
+	{
+		// Counted before the job becomes visible, so a worker taking it right away can't make the count wrap around
+		pendingJobs.fetch_add(1, std::memory_order_seq_cst);
+		const uint32_t threadIndex = getThreadIndex();
+		if (threadIndex != invalidThreadIndex) {
+			if (!workers[threadIndex]->queue.push(job)) {
+				pendingJobs.fetch_sub(1, std::memory_order_relaxed);
+				execute(job);
+				return;
+			}
+		}
+		else {
+			std::lock_guard<std::mutex> lock(injectionMutex);
+			injectionQueue.push_back(job);
+			injectedJobs.fetch_add(1, std::memory_order_release);
+		}
+		if (sleepingWorkers.load(std::memory_order_seq_cst) > 0) {
+			std::lock_guard<std::mutex> lock(sleepMutex);
+			sleepCondition.notify_one();
+		}
+	}
+
+	JobSystem::Job *JobSystem::takeJob(uint32_t threadIndex)
+	{
+		Job *job = nullptr;
+		if (threadIndex != invalidThreadIndex) {
+			job = workers[threadIndex]->queue.pop();
+		}
+		if ((job == nullptr) && (injectedJobs.load(std::memory_order_acquire) > 0)) {
+			std::lock_guard<std::mutex> lock(injectionMutex);
+			if (!injectionQueue.empty()) {
+				job = injectionQueue.front();
+				injectionQueue.pop_front();
+				injectedJobs.fetch_sub(1, std::memory_order_relaxed);
+			}
+		}
+		if ((job == nullptr) && !workers.empty()) {
+			// Start at a random queue, so idle workers don't all compete for the same one
+			const uint32_t count = static_cast<uint32_t>(workers.size());
+			const uint32_t first = nextRandom() % count;
+			for (uint32_t i = 0; (i < count) && (job == nullptr); i++) {
+				const uint32_t victim = (first + i) % count;
+				if (victim != threadIndex) {
+					job = workers[victim]->queue.steal();
+				}
+			}
+		}
+		if (job != nullptr) {
+			pendingJobs.fetch_sub(1, std::memory_order_relaxed);
+		}
+		return job;
+	}
+
+	void JobSystem::execute(Job *job)
+	{
+		{
+			VKS_PROFILE_ZONE("Job");
+			job->invoke(&job->storage);
+		}
+		// Captured state is destroyed before the counter is decremented, so it doesn't outlive a wait on the counter
+		job->destroy(&job->storage);
+		Counter *counter = job->counter;
+		freeJob(job);
+		if (counter) {
+			finish(counter);
+		}
+	}
+
+	void JobSystem::finish(Counter *counter)
+	{
+		// Decrements that don't reach zero don't need the lock
+		uint32_t value = counter->value.load(std::memory_order_relaxed);
+		while (value > 1) {
+			if (counter->value.compare_exchange_weak(value, value - 1, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+				return;
+			}
+		}
+		// The counter may be destroyed by a waiting thread as soon as the lock is released, so dependents are moved out first
+		std::vector<Job*> dependents;
+		{
+			std::lock_guard<std::mutex> lock(counter->mutex);
+			if (counter->value.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+				dependents.swap(counter->dependents);
+			}
+		}
+		for (Job *dependent : dependents) {
+			push(dependent);
+		}
+	}
+
+	void JobSystem::wait(Counter &counter)
+	{
+		VKS_PROFILE_ZONE("Job system wait");
+		const uint32_t threadIndex = getThreadIndex();
+		while (!counter.done()) {
+			if (Job *job = takeJob(threadIndex)) {
+				execute(job);
+			}
+			else {
+				std::this_thread::yield();
+			}
+		}
+		// The thread finishing the last job may still hold the lock, the counter must not be destroyed before it has been released
+		std::lock_guard<std::mutex> lock(counter.mutex);
+	}
+
+	void JobSystem::workerLoop(uint32_t threadIndex)
+	{
+		currentSystem = this;
+		currentThreadIndex = threadIndex;
+		VKS_PROFILE_THREAD("Job system worker " + std::to_string(threadIndex));
+		while (true) {
+			if (Job *job = takeJob(threadIndex)) {
+				execute(job);
+				continue;
+			}
+			if (stopping.load()) {
+				break;
+			}
+			// Jobs are often added in bursts, so look again for a moment before going to sleep
+			uint32_t spin = 0;
+			while ((spin < idleSpinCount) && (pendingJobs.load(std::memory_order_relaxed) == 0) && !stopping.load(std::memory_order_relaxed)) {
+				std::this_thread::yield();
+				spin++;
+			}
+			if (spin < idleSpinCount) {
+				continue;
+			}
+			sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+			{
+				std::unique_lock<std::mutex> lock(sleepMutex);
+				sleepCondition.wait(lock, [this] { return (pendingJobs.load(std::memory_order_seq_cst) > 0) || stopping.load(); });
+			}
+			sleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+		}
+		currentSystem = nullptr;
+		currentThreadIndex = invalidThreadIndex;
+	}
+}
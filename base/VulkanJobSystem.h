@@ -0,0 +1,207 @@
+/*
+* Work stealing job system
+*
+* Every thread of the system owns a lock-free queue of jobs it pushes to and pops from at one end, idle threads steal from the other end
+* Callables are stored in the job itself (no heap allocation unless they exceed inlineStorageSize) and completion is tracked with
+* counters, which can be waited on (the waiting thread executes other jobs in the meantime) and which jobs can depend on
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace vks
+{
+	class JobSystem
+	{
+	private:
+		struct Job;
+
+	public:
+		/** @brief Number of unfinished jobs added with the counter, jobs can be made to wait for a counter to reach zero */
+		class Counter
+		{
+		public:
+			Counter() : value(0) {}
+			/** @brief Whether all jobs added with the counter have finished */
+			bool done() const
+			{
+				return value.load(std::memory_order_acquire) == 0;
+			}
+		private:
+			friend class JobSystem;
+			std::atomic<uint32_t> value;
+			// Guards the dependent jobs, the counter only reaches zero while this is locked
+			std::mutex mutex;
+			std::vector<Job*> dependents;
+			Counter(const Counter&) = delete;
+			Counter &operator=(const Counter&) = delete;
+		};
+
+		/** @brief Callables up to this size in bytes are stored in the job, larger ones are allocated on the heap */
+		static const size_t inlineStorageSize = 96;
+		/** @brief Maximum number of queued jobs per thread, jobs added to a full queue are executed immediately */
+		static const uint32_t queueCapacity = 4096;
+		/** @brief Number of chunks per thread parallelFor aims for, so threads finishing early can steal some of the remaining work */
+		static const uint32_t chunksPerThread = 4;
+		/** @brief Returned by getThreadIndex for threads that don't belong to the job system */
+		static const uint32_t invalidThreadIndex = ~0u;
+
+		JobSystem();
+		~JobSystem();
+
+		/**
+		* Start the worker threads, the calling thread becomes part of the system (thread index 0) and executes jobs while waiting
+		*
+		* @param (Optional) workerCount Number of worker threads in addition to the calling thread, 0 uses one less than the number of cores (at least one), so together with the calling thread there is one thread per core
+		* @param (Optional) pinThreads Pin every worker thread to a core (only supported on Windows and Linux)
+		*/
+		void start(uint32_t workerCount = 0, bool pinThreads = false);
+		/** @brief Execute all queued jobs and stop the worker threads */
+		void stop();
+		/** @brief Number of threads executing jobs (the workers and the thread that started the system) */
+		uint32_t getThreadCount() const;
+		/** @brief Index of the calling thread in [0, getThreadCount()), e.g. to select per-thread resources from within a job */
+		uint32_t getThreadIndex() const;
+
+		/**
+		* Add a job
+		*
+		* @param func Callable executed by the job (invoked without arguments)
+		* @param (Optional) counter Counter the job is added to, the counter must stay valid until it has been waited on
+		* @param (Optional) dependency Counter that has to reach zero before the job is executed
+		*/
+		template<typename F>
+		void run(F &&func, Counter *counter = nullptr, Counter *dependency = nullptr)
+		{
+			typedef typename std::decay<F>::type Function;
+			Job *job = allocateJob();
+			storeFunction<Function>(job, std::forward<F>(func), std::integral_constant<bool, (sizeof(Function) <= inlineStorageSize) && (alignof(Function) <= alignof(std::max_align_t))>());
+			job->counter = counter;
+			if (counter) {
+				counter->value.fetch_add(1, std::memory_order_relaxed);
+			}
+			submit(job, dependency);
+		}
+
+		/** @brief Wait until all jobs added with the counter have finished, other jobs are executed while waiting */
+		void wait(Counter &counter);
+
+		/**
+		* Split the range [0, count) into chunks that are executed as jobs and wait for all of them to finish
+		*
+		* @param count Number of elements
+		* @param minChunkSize Minimum number of elements per chunk, so the job overhead is amortized for small elements
+		* @param func Called as func(begin, end) for every chunk, possibly on multiple threads at the same time
+		*/
+		template<typename F>
+		void parallelFor(uint32_t count, uint32_t minChunkSize, const F &func)
+		{
+			if (count == 0) {
+				return;
+			}
+			uint32_t chunkSize = count / (getThreadCount() * chunksPerThread);
+			if (chunkSize < minChunkSize) {
+				chunkSize = minChunkSize;
+			}
+			if (chunkSize == 0) {
+				chunkSize = 1;
+			}
+			Counter counter;
+			for (uint32_t begin = 0; begin < count; begin += chunkSize) {
+				const uint32_t end = (count - begin > chunkSize) ? begin + chunkSize : count;
+				run([&func, begin, end] { func(begin, end); }, &counter);
+				if (end == count) {
+					break;
+				}
+			}
+			wait(counter);
+		}
+
+	private:
+		struct Job
+		{
+			void (*invoke)(void *storage);
+			void (*destroy)(void *storage);
+			typename std::aligned_storage<inlineStorageSize, alignof(std::max_align_t)>::type storage;
+			Counter *counter;
+		};
+		struct Worker;
+
+		// Index 0 belongs to the thread that started the system
+		std::vector<std::unique_ptr<Worker>> workers;
+		std::thread::id ownerThreadId;
+		// Jobs added from threads that don't belong to the system
+		std::mutex injectionMutex;
+		std::deque<Job*> injectionQueue;
+		std::atomic<uint32_t> injectedJobs;
+		// Idle workers sleep until jobs are added
+		std::atomic<uint32_t> pendingJobs;
+		std::atomic<uint32_t> sleepingWorkers;
+		std::atomic<bool> stopping;
+		std::mutex sleepMutex;
+		std::condition_variable sleepCondition;
+
+		template<typename F>
+		static void invokeInline(void *storage)
+		{
+			(*static_cast<F*>(storage))();
+		}
+		template<typename F>
+		static void destroyInline(void *storage)
+		{
+			static_cast<F*>(storage)->~F();
+		}
+		template<typename F>
+		static void invokeHeap(void *storage)
+		{
+			(**static_cast<F**>(storage))();
+		}
+		template<typename F>
+		static void destroyHeap(void *storage)
+		{
+			delete *static_cast<F**>(storage);
+		}
+		template<typename F, typename Arg>
+		static void storeFunction(Job *job, Arg &&func, std::true_type)
+		{
+			new (&job->storage) F(std::forward<Arg>(func));
+			job->invoke = &invokeInline<F>;
+			job->destroy = &destroyInline<F>;
+		}
+		template<typename F, typename Arg>
+		static void storeFunction(Job *job, Arg &&func, std::false_type)
+		{
+			new (&job->storage) F*(new F(std::forward<Arg>(func)));
+			job->invoke = &invokeHeap<F>;
+			job->destroy = &destroyHeap<F>;
+		}
+
+		Job *allocateJob();
+		void freeJob(Job *job);
+		void submit(Job *job, Counter *dependency);
+		void push(Job *job);
+		Job *takeJob(uint32_t threadIndex);
+		void execute(Job *job);
+		void finish(Counter *counter);
+		void workerLoop(uint32_t threadIndex);
+
+		JobSystem(const JobSystem&) = delete;
+		JobSystem &operator=(const JobSystem&) = delete;
+	};
+}
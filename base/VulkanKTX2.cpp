@@ -0,0 +1,231 @@
+/*
+* KTX2 container reader
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "VulkanKTX2.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(VKS_KTX2_ZSTD)
+#include <zstd.h>
+#endif
+#if defined(VKS_KTX2_ZLIB)
+#include <zlib.h>
+#endif
+
+namespace vks
+{
+	namespace ktx2
+	{
+		namespace
+		{
+			const uint8_t fileIdentifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+
+			// Layout of the file header and index as defined by the KTX2 specification (all values are little endian)
+			struct Header
+			{
+				uint8_t identifier[12];
+				uint32_t vkFormat;
+				uint32_t typeSize;
+				uint32_t pixelWidth;
+				uint32_t pixelHeight;
+				uint32_t pixelDepth;
+				uint32_t layerCount;
+				uint32_t faceCount;
+				uint32_t levelCount;
+				uint32_t supercompressionScheme;
+				uint32_t dfdByteOffset;
+				uint32_t dfdByteLength;
+				uint32_t kvdByteOffset;
+				uint32_t kvdByteLength;
+				uint64_t sgdByteOffset;
+				uint64_t sgdByteLength;
+			};
+
+			struct LevelIndex
+			{
+				uint64_t byteOffset;
+				uint64_t byteLength;
+				uint64_t uncompressedByteLength;
+			};
+
+			// Buffer offsets of image copies need to be a multiple of the texel block size and four
+			const VkDeviceSize imageAlignment = 16;
+
+			VkDeviceSize alignOffset(VkDeviceSize offset)
+			{
+				return (offset + imageAlignment - 1) & ~(imageAlignment - 1);
+			}
+
+			bool inflate(SupercompressionScheme scheme, const uint8_t *src, size_t srcSize, uint8_t *dst, size_t dstSize, std::string &error)
+			{
+				switch (scheme)
+				{
+				case SupercompressionScheme::None:
+					if (srcSize != dstSize) {
+						error = "Level size does not match the uncompressed level size";
+						return false;
+					}
+					memcpy(dst, src, srcSize);
+					return true;
+				case SupercompressionScheme::Zstandard:
+				{
+#if defined(VKS_KTX2_ZSTD)
+					const size_t result = ZSTD_decompress(dst, dstSize, src, srcSize);
+					if (ZSTD_isError(result) || (result != dstSize)) {
+						error = "Zstandard decompression failed";
+						return false;
+					}
+					return true;
+#else
+					error = "Zstandard supercompression is not supported by this build (zstd was not found)";
+					return false;
+#endif
+				}
+				case SupercompressionScheme::ZLIB:
+				{
+#if defined(VKS_KTX2_ZLIB)
+					uLongf destLength = static_cast<uLongf>(dstSize);
+					if ((uncompress(dst, &destLength, src, static_cast<uLong>(srcSize)) != Z_OK) || (destLength != dstSize)) {
+						error = "ZLIB decompression failed";
+						return false;
+					}
+					return true;
+#else
+					error = "ZLIB supercompression is not supported by this build (zlib was not found)";
+					return false;
+#endif
+				}
+				case SupercompressionScheme::BasisLZ:
+					error = "BasisLZ supercompression requires the Basis Universal transcoder, which is not supported";
+					return false;
+				}
+				error = "Unknown supercompression scheme";
+				return false;
+			}
+		}
+
+		VkDeviceSize Texture::getImageOffset(uint32_t level, uint32_t layer, uint32_t face) const
+		{
+			return levelOffsets[level] + (layer * faceCount + face) * imageStrides[level];
+		}
+
+		bool isKTX2(const uint8_t *data, size_t size)
+		{
+			return (size >= sizeof(fileIdentifier)) && (memcmp(data, fileIdentifier, sizeof(fileIdentifier)) == 0);
+		}
+
+		VkFormat getFormat(const uint8_t *data, size_t size)
+		{
+			if (!isKTX2(data, size) || (size < offsetof(Header, typeSize))) {
+				return VK_FORMAT_UNDEFINED;
+			}
+			uint32_t vkFormat;
+			memcpy(&vkFormat, data + offsetof(Header, vkFormat), sizeof(vkFormat));
+			return static_cast<VkFormat>(vkFormat);
+		}
+
+		bool load(const uint8_t *data, size_t size, Texture &texture, std::string &error)
+		{
+			if (!isKTX2(data, size) || (size < sizeof(Header))) {
+				error = "Not a valid KTX2 file";
+				return false;
+			}
+
+			Header header;
+			memcpy(&header, data, sizeof(Header));
+
+			texture.format = static_cast<VkFormat>(header.vkFormat);
+			texture.width = header.pixelWidth;
+			texture.height = std::max(header.pixelHeight, 1u);
+			texture.levelCount = std::max(header.levelCount, 1u);
+			texture.layerCount = std::max(header.layerCount, 1u);
+			texture.faceCount = header.faceCount;
+			texture.supercompressionScheme = static_cast<SupercompressionScheme>(header.supercompressionScheme);
+
+			if (texture.format == VK_FORMAT_UNDEFINED) {
+				// Basis Universal payloads (ETC1S and UASTC) are stored without a Vulkan format
+				error = "Basis Universal payloads require the basisu transcoder, which is not supported";
+				return false;
+			}
+			if (header.pixelDepth > 1) {
+				error = "3D textures are not supported";
+				return false;
+			}
+			if ((texture.faceCount != 1) && (texture.faceCount != 6)) {
+				error = "Invalid face count";
+				return false;
+			}
+			// A 32 bit extent has at most 32 mip levels, this also keeps the level index size from overflowing
+			if (texture.levelCount > 32) {
+				error = "Invalid level count";
+				return false;
+			}
+			if (texture.layerCount > UINT32_MAX / texture.faceCount) {
+				error = "Invalid layer count";
+				return false;
+			}
+
+			const size_t levelIndexSize = sizeof(LevelIndex) * texture.levelCount;
+			if (size < sizeof(Header) + levelIndexSize) {
+				error = "File is truncated";
+				return false;
+			}
+			std::vector<LevelIndex> levelIndices(texture.levelCount);
+			memcpy(levelIndices.data(), data + sizeof(Header), levelIndexSize);
+
+			// Levels are stored from the smallest to the largest in the file, but uploaded starting with the base level
+			const uint32_t imageCount = texture.layerCount * texture.faceCount;
+			texture.levelOffsets.resize(texture.levelCount);
+			texture.imageStrides.resize(texture.levelCount);
+			VkDeviceSize dataSize = 0;
+			for (uint32_t level = 0; level < texture.levelCount; level++) {
+				const LevelIndex &levelIndex = levelIndices[level];
+				// Compared against the remaining size, as the sum of offset and length read from the file may overflow
+				if ((levelIndex.byteOffset > size) || (levelIndex.byteLength > size - levelIndex.byteOffset) || (levelIndex.byteLength == 0)) {
+					error = "Level " + std::to_string(level) + " is out of bounds";
+					return false;
+				}
+				const VkDeviceSize uncompressedSize = (levelIndex.uncompressedByteLength > 0) ? levelIndex.uncompressedByteLength : levelIndex.byteLength;
+				if (uncompressedSize % imageCount != 0) {
+					error = "Size of level " + std::to_string(level) + " does not match the layer and face count";
+					return false;
+				}
+				texture.levelOffsets[level] = dataSize;
+				texture.imageStrides[level] = alignOffset(uncompressedSize / imageCount);
+				dataSize += texture.imageStrides[level] * imageCount;
+			}
+
+			texture.data.resize(static_cast<size_t>(dataSize));
+			std::vector<uint8_t> levelData;
+			for (uint32_t level = 0; level < texture.levelCount; level++) {
+				const LevelIndex &levelIndex = levelIndices[level];
+				const size_t uncompressedSize = static_cast<size_t>((levelIndex.uncompressedByteLength > 0) ? levelIndex.uncompressedByteLength : levelIndex.byteLength);
+				const size_t imageSize = uncompressedSize / imageCount;
+				// Images of a level are tightly packed, so they only need to be copied individually if the stride adds padding
+				uint8_t *dst = texture.data.data() + texture.levelOffsets[level];
+				const bool packed = (texture.imageStrides[level] == imageSize);
+				if (!packed) {
+					levelData.resize(uncompressedSize);
+				}
+				if (!inflate(texture.supercompressionScheme, data + levelIndex.byteOffset, static_cast<size_t>(levelIndex.byteLength), packed ? dst : levelData.data(), uncompressedSize, error)) {
+					return false;
+				}
+				if (!packed) {
+					for (uint32_t image = 0; image < imageCount; image++) {
+						memcpy(dst + image * texture.imageStrides[level], levelData.data() + image * imageSize, imageSize);
+					}
+				}
+			}
+
+			return true;
+		}
+	}
+}
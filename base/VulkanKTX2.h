@@ -0,0 +1,70 @@
+/*
+* KTX2 container reader
+*
+* Supports uncompressed payloads as well as Zstandard and ZLIB supercompression (if the libraries were found at build time)
+* Basis Universal (BasisLZ/ETC1S and UASTC) payloads require the basisu transcoder, which is not part of this repository
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "vulkan/vulkan.h"
+
+namespace vks
+{
+	namespace ktx2
+	{
+		enum class SupercompressionScheme : uint32_t
+		{
+			None = 0,
+			BasisLZ = 1,
+			Zstandard = 2,
+			ZLIB = 3
+		};
+
+		/** @brief Texture data of a KTX2 file with all supercompression removed */
+		struct Texture
+		{
+			VkFormat format = VK_FORMAT_UNDEFINED;
+			uint32_t width = 0;
+			uint32_t height = 0;
+			uint32_t levelCount = 0;
+			uint32_t layerCount = 0;
+			uint32_t faceCount = 0;
+			SupercompressionScheme supercompressionScheme = SupercompressionScheme::None;
+			/** @brief Image data for all levels starting with the base level, each level stores all layers and faces */
+			std::vector<uint8_t> data;
+			/** @brief Offset of each level into the data */
+			std::vector<VkDeviceSize> levelOffsets;
+			/** @brief Distance between two images (layers or faces) of a level, aligned to satisfy buffer to image copy offset requirements */
+			std::vector<VkDeviceSize> imageStrides;
+
+			/** @brief Returns the offset of a single image into the data */
+			VkDeviceSize getImageOffset(uint32_t level, uint32_t layer, uint32_t face) const;
+		};
+
+		/** @brief Returns true if the data starts with the KTX2 file identifier */
+		bool isKTX2(const uint8_t *data, size_t size);
+		/** @brief Returns the format stored in a KTX2 header (requires at least the first 16 bytes of the file) */
+		VkFormat getFormat(const uint8_t *data, size_t size);
+
+		/**
+		* Read a KTX2 file from memory and remove any supercompression
+		*
+		* @param data Pointer to the file contents
+		* @param size Size of the file contents in bytes
+		* @param texture Texture to store the image data in
+		* @param error Receives a description of the problem if the file can't be loaded
+		*
+		* @return True if the file was loaded
+		*/
+		bool load(const uint8_t *data, size_t size, Texture &texture, std::string &error);
+	}
+}
@@ -0,0 +1,130 @@
+/*
+* Frame latency tracker
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "VulkanLatencyTracker.h"
+#include "VulkanTools.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace vks
+{
+	const char *LatencyTracker::getMetricName(Metric metric)
+	{
+		switch (metric) {
+		case Metric::InputToPhoton:
+			return "input_to_photon";
+		case Metric::SampleToPhoton:
+			return "sample_to_photon";
+		case Metric::SubmitToPhoton:
+			return "submit_to_photon";
+		default:
+			return "unknown";
+		}
+	}
+
+	void LatencyTracker::markInput()
+	{
+		if (!inputPending) {
+			pendingInput = Clock::now();
+			inputPending = true;
+		}
+	}
+
+	uint64_t LatencyTracker::beginFrame()
+	{
+		current = Frame();
+		current.id = nextId++;
+		current.sample = Clock::now();
+		current.submit = current.sample;
+		current.hasInput = inputPending;
+		current.input = pendingInput;
+		inputPending = false;
+		recording = true;
+		return current.id;
+	}
+
+	void LatencyTracker::markSubmit()
+	{
+		if (recording) {
+			current.submit = Clock::now();
+		}
+	}
+
+	void LatencyTracker::markPresent()
+	{
+		if (recording) {
+			presented.push_back(current);
+			recording = false;
+		}
+	}
+
+	void LatencyTracker::markDisplayed(uint64_t frameId)
+	{
+		const Clock::time_point now = Clock::now();
+		// Presents complete in order, so all older frames have been displayed (or replaced) too
+		while (!presented.empty() && (presented.front().id <= frameId)) {
+			const Frame &frame = presented.front();
+			if (frame.hasInput) {
+				addSample(Metric::InputToPhoton, frame.input, now);
+			}
+			addSample(Metric::SampleToPhoton, frame.sample, now);
+			addSample(Metric::SubmitToPhoton, frame.submit, now);
+			presented.pop_front();
+		}
+	}
+
+	uint64_t LatencyTracker::getOldestPending() const
+	{
+		return presented.empty() ? 0 : presented.front().id;
+	}
+
+	void LatencyTracker::discardPresented()
+	{
+		presented.clear();
+	}
+
+	LatencyTracker::Distribution LatencyTracker::getDistribution(Metric metric) const
+	{
+		Distribution distribution;
+		std::vector<double> values = samples[static_cast<size_t>(metric)].values;
+		if (values.empty()) {
+			return distribution;
+		}
+		std::sort(values.begin(), values.end());
+		distribution.count = static_cast<uint32_t>(values.size());
+		distribution.min = values.front();
+		distribution.max = values.back();
+		distribution.average = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+		distribution.p50 = vks::tools::percentile(values, 0.50);
+		distribution.p90 = vks::tools::percentile(values, 0.90);
+		distribution.p99 = vks::tools::percentile(values, 0.99);
+		return distribution;
+	}
+
+	void LatencyTracker::reset()
+	{
+		for (auto &metricSamples : samples) {
+			metricSamples.values.clear();
+			metricSamples.next = 0;
+		}
+	}
+
+	void LatencyTracker::addSample(Metric metric, Clock::time_point start, Clock::time_point end)
+	{
+		Samples &metricSamples = samples[static_cast<size_t>(metric)];
+		const double value = std::chrono::duration<double, std::milli>(end - start).count();
+		if (metricSamples.values.size() < maxSamples) {
+			metricSamples.values.push_back(value);
+		}
+		else {
+			metricSamples.values[metricSamples.next] = value;
+			metricSamples.next = (metricSamples.next + 1) % maxSamples;
+		}
+	}
+}
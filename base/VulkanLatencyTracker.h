@@ -0,0 +1,105 @@
+/*
+* Frame latency tracker
+*
+* Timestamps input events, the start of a frame (where input is sampled), command submission and presentation
+* The time a frame is displayed is taken from VK_KHR_present_wait if available, otherwise it's approximated by the frame's completion on the device
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <chrono>
+#include <deque>
+#include <vector>
+
+namespace vks
+{
+	class LatencyTracker
+	{
+	public:
+		enum class Metric
+		{
+			/** @brief From the first input event a frame consumed to the frame being displayed (only frames with input) */
+			InputToPhoton,
+			/** @brief From the start of a frame (input sampling) to the frame being displayed */
+			SampleToPhoton,
+			/** @brief From command submission to the frame being displayed */
+			SubmitToPhoton,
+			/** @brief Number of metrics, not a valid metric */
+			Count
+		};
+
+		/** @brief Latency distribution of a metric in milliseconds */
+		struct Distribution
+		{
+			uint32_t count = 0;
+			double min = 0.0;
+			double average = 0.0;
+			double p50 = 0.0;
+			double p90 = 0.0;
+			double p99 = 0.0;
+			double max = 0.0;
+		};
+
+		/** @brief Number of samples kept per metric, older samples are overwritten */
+		static const size_t maxSamples = 65536;
+
+		/** @brief Name of a metric as used in the benchmark output */
+		static const char *getMetricName(Metric metric);
+
+		/** @brief Record an input event, only the first event before a frame starts is kept */
+		void markInput();
+		/**
+		* Start a new frame, consuming the pending input event
+		*
+		* @return Id of the frame (starting at 1), to be used as the present id
+		*/
+		uint64_t beginFrame();
+		/** @brief Record the submission of the current frame's commands */
+		void markSubmit();
+		/** @brief Record the current frame being queued for presentation, frames that are never presented are discarded by the next beginFrame */
+		void markPresent();
+		/** @brief Record all presented frames up to and including the given id as displayed */
+		void markDisplayed(uint64_t frameId);
+		/** @brief Id of the oldest frame that has been presented but not displayed yet, 0 if there is none */
+		uint64_t getOldestPending() const;
+		/** @brief Discard frames that have been presented but not displayed yet without recording samples (e.g. when the swap chain is recreated) */
+		void discardPresented();
+
+		Distribution getDistribution(Metric metric) const;
+		/** @brief Discard all samples (e.g. after a benchmark's warm up), frames in flight are still recorded */
+		void reset();
+
+	private:
+		typedef std::chrono::high_resolution_clock Clock;
+
+		struct Frame
+		{
+			uint64_t id = 0;
+			bool hasInput = false;
+			Clock::time_point input;
+			Clock::time_point sample;
+			Clock::time_point submit;
+		};
+
+		struct Samples
+		{
+			std::vector<double> values;
+			size_t next = 0;
+		};
+
+		bool inputPending = false;
+		Clock::time_point pendingInput;
+		Frame current;
+		bool recording = false;
+		uint64_t nextId = 1;
+		std::deque<Frame> presented;
+		Samples samples[static_cast<size_t>(Metric::Count)];
+
+		void addSample(Metric metric, Clock::time_point start, Clock::time_point end);
+	};
+}
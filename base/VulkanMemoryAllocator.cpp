@@ -0,0 +1,639 @@
+/*
+* Vulkan device memory sub-allocator
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "VulkanMemoryAllocator.h"
+
+#include <algorithm>
+#include <cassert>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace vks
+{
+	namespace
+	{
+		// Free ranges are sorted into first level classes by power of two and linearly subdivided into second level classes
+		const uint32_t slCountLog2 = 5;
+		const uint32_t slCount = 1 << slCountLog2;
+		const uint32_t flCount = 64 - slCountLog2 + 1;
+		// Sizes below this all map to the first first level class
+		const VkDeviceSize smallSize = slCount;
+
+		uint32_t findMostSignificantBit(uint64_t value)
+		{
+#if defined(_MSC_VER)
+			unsigned long index;
+			_BitScanReverse64(&index, value);
+			return static_cast<uint32_t>(index);
+#else
+			return 63 - static_cast<uint32_t>(__builtin_clzll(value));
+#endif
+		}
+
+		uint32_t findLeastSignificantBit(uint64_t value)
+		{
+#if defined(_MSC_VER)
+			unsigned long index;
+			_BitScanForward64(&index, value);
+			return static_cast<uint32_t>(index);
+#else
+			return static_cast<uint32_t>(__builtin_ctzll(value));
+#endif
+		}
+
+		void mapping(VkDeviceSize size, uint32_t &fl, uint32_t &sl)
+		{
+			if (size < smallSize) {
+				fl = 0;
+				sl = static_cast<uint32_t>(size);
+			}
+			else {
+				const uint32_t msb = findMostSignificantBit(size);
+				sl = static_cast<uint32_t>(size >> (msb - slCountLog2)) ^ slCount;
+				fl = msb - slCountLog2 + 1;
+			}
+		}
+
+		// Round up to the next class, so every range in the class found is large enough
+		void mappingSearch(VkDeviceSize size, uint32_t &fl, uint32_t &sl)
+		{
+			if (size >= smallSize) {
+				size += (VkDeviceSize(1) << (findMostSignificantBit(size) - slCountLog2)) - 1;
+			}
+			mapping(size, fl, sl);
+		}
+
+		VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment)
+		{
+			return (value + alignment - 1) / alignment * alignment;
+		}
+	}
+
+	// Range of a block, either free or handed out to an allocation
+	struct MemoryAllocator::Node
+	{
+		VkDeviceSize offset = 0;
+		VkDeviceSize size = 0;
+		VkDeviceSize alignment = 1;
+		Node *prevPhysical = nullptr;
+		Node *nextPhysical = nullptr;
+		Node *prevFree = nullptr;
+		Node *nextFree = nullptr;
+		bool free = true;
+		Allocation *allocation = nullptr;
+	};
+
+	struct MemoryAllocator::Block
+	{
+		VkDeviceMemory memory = VK_NULL_HANDLE;
+		VkDeviceSize size = 0;
+		void *mapped = nullptr;
+		size_t poolIndex = 0;
+		uint32_t allocationCount = 0;
+		VkDeviceSize usedBytes = 0;
+		// Nodes in address order
+		Node *firstNode = nullptr;
+		// Bit set for every first level class with a non-empty second level class
+		uint64_t flBitmap = 0;
+		uint32_t slBitmap[flCount] = {};
+		Node *freeLists[flCount][slCount] = {};
+
+		void insertFree(Node *node)
+		{
+			uint32_t fl, sl;
+			mapping(node->size, fl, sl);
+			node->prevFree = nullptr;
+			node->nextFree = freeLists[fl][sl];
+			if (node->nextFree) {
+				node->nextFree->prevFree = node;
+			}
+			freeLists[fl][sl] = node;
+			flBitmap |= (uint64_t(1) << fl);
+			slBitmap[fl] |= (1u << sl);
+		}
+
+		void removeFree(Node *node)
+		{
+			uint32_t fl, sl;
+			mapping(node->size, fl, sl);
+			if (node->prevFree) {
+				node->prevFree->nextFree = node->nextFree;
+			}
+			else {
+				freeLists[fl][sl] = node->nextFree;
+			}
+			if (node->nextFree) {
+				node->nextFree->prevFree = node->prevFree;
+			}
+			if (!freeLists[fl][sl]) {
+				slBitmap[fl] &= ~(1u << sl);
+				if (!slBitmap[fl]) {
+					flBitmap &= ~(uint64_t(1) << fl);
+				}
+			}
+		}
+
+		Node *findFree(VkDeviceSize size)
+		{
+			uint32_t fl, sl;
+			mappingSearch(size, fl, sl);
+			if (fl >= flCount) {
+				return nullptr;
+			}
+			uint32_t slMap = slBitmap[fl] & (~0u << sl);
+			if (!slMap) {
+				const uint64_t flMap = (fl + 1 < 64) ? (flBitmap & (~uint64_t(0) << (fl + 1))) : 0;
+				if (!flMap) {
+					return nullptr;
+				}
+				fl = findLeastSignificantBit(flMap);
+				slMap = slBitmap[fl];
+			}
+			sl = findLeastSignificantBit(slMap);
+			return freeLists[fl][sl];
+		}
+	};
+
+	/**
+	* Create the allocator
+	*
+	* @param physicalDevice Physical device to get memory properties and limits from
+	* @param device Logical device to allocate memory from
+	* @param (Optional) preferredBlockSize Size of the memory blocks, if 0 the size is derived from the heap size
+	*/
+	MemoryAllocator::MemoryAllocator(VkPhysicalDevice physicalDevice, VkDevice device, VkDeviceSize preferredBlockSize)
+		: device(device)
+	{
+		vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+		VkPhysicalDeviceProperties properties;
+		vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+		bufferImageGranularity = properties.limits.bufferImageGranularity;
+		nonCoherentAtomSize = properties.limits.nonCoherentAtomSize;
+		maxMemoryAllocationCount = properties.limits.maxMemoryAllocationCount;
+
+		// Small heaps (e.g. the host visible device local heap without resizable BAR) get smaller blocks
+		const VkDeviceSize largeHeapSize = VkDeviceSize(1) << 30;
+		const VkDeviceSize largeHeapBlockSize = VkDeviceSize(256) << 20;
+		preferredBlockSizes.resize(memoryProperties.memoryHeapCount);
+		for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++) {
+			const VkDeviceSize heapSize = memoryProperties.memoryHeaps[i].size;
+			preferredBlockSizes[i] = (preferredBlockSize > 0) ? preferredBlockSize : ((heapSize <= largeHeapSize) ? heapSize / 8 : largeHeapBlockSize);
+		}
+	}
+
+	MemoryAllocator::~MemoryAllocator()
+	{
+		for (auto &pool : pools) {
+			for (auto block : pool.blocks) {
+				destroyBlock(block);
+			}
+		}
+		for (auto allocation : dedicatedAllocations) {
+			freeDeviceMemory(allocation->memory);
+			delete allocation;
+		}
+	}
+
+	VkResult MemoryAllocator::allocateDeviceMemory(VkDeviceSize size, uint32_t memoryTypeIndex, VkMemoryAllocateFlags allocateFlags, VkDeviceMemory *memory, void **mapped)
+	{
+		if (deviceAllocationCount >= maxMemoryAllocationCount) {
+			return VK_ERROR_TOO_MANY_OBJECTS;
+		}
+		VkMemoryAllocateInfo memAlloc{};
+		memAlloc.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+		memAlloc.allocationSize = size;
+		memAlloc.memoryTypeIndex = memoryTypeIndex;
+		VkMemoryAllocateFlagsInfoKHR allocFlagsInfo{};
+		if (allocateFlags != 0) {
+			allocFlagsInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO_KHR;
+			allocFlagsInfo.flags = allocateFlags;
+			memAlloc.pNext = &allocFlagsInfo;
+		}
+		VkResult result = vkAllocateMemory(device, &memAlloc, nullptr, memory);
+		if (result != VK_SUCCESS) {
+			return result;
+		}
+		deviceAllocationCount++;
+		*mapped = nullptr;
+		if (memoryProperties.memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+			// Host visible memory stays mapped for it's whole lifetime, as a memory object can only be mapped once at a time
+			result = vkMapMemory(device, *memory, 0, VK_WHOLE_SIZE, 0, mapped);
+			if (result != VK_SUCCESS) {
+				freeDeviceMemory(*memory);
+			}
+		}
+		return result;
+	}
+
+	void MemoryAllocator::freeDeviceMemory(VkDeviceMemory memory)
+	{
+		// Freeing memory implicitly unmaps it
+		vkFreeMemory(device, memory, nullptr);
+		deviceAllocationCount--;
+	}
+
+	MemoryAllocator::Pool &MemoryAllocator::getPool(uint32_t memoryTypeIndex, ResourceType resourceType, VkMemoryAllocateFlags allocateFlags)
+	{
+		// Linear and optimal resources can share blocks if the device has no granularity restrictions
+		if (bufferImageGranularity <= 1) {
+			resourceType = ResourceType::Linear;
+		}
+		for (auto &pool : pools) {
+			if ((pool.memoryTypeIndex == memoryTypeIndex) && (pool.resourceType == resourceType) && (pool.allocateFlags == allocateFlags)) {
+				return pool;
+			}
+		}
+		Pool pool;
+		pool.memoryTypeIndex = memoryTypeIndex;
+		pool.resourceType = resourceType;
+		pool.allocateFlags = allocateFlags;
+		// Blocks start at an eighth of the preferred size and grow from there, so applications with only a few resources don't reserve large amounts of memory
+		pool.nextBlockSize = preferredBlockSizes[memoryProperties.memoryTypes[memoryTypeIndex].heapIndex] / 8;
+		pools.push_back(pool);
+		return pools.back();
+	}
+
+	bool MemoryAllocator::allocateFromBlock(Block *block, VkDeviceSize size, VkDeviceSize alignment, Allocation *allocation)
+	{
+		// The range found for the size may be too small once the offset is aligned, in that case search again with room for the worst case padding
+		Node *node = nullptr;
+		for (uint32_t attempt = 0; (attempt < 2) && !node; attempt++) {
+			Node *candidate = block->findFree((attempt == 0) ? size : size + alignment - 1);
+			if (candidate && (alignUp(candidate->offset, alignment) + size <= candidate->offset + candidate->size)) {
+				node = candidate;
+			}
+		}
+		if (!node) {
+			return false;
+		}
+
+		block->removeFree(node);
+
+		// Padding in front of the aligned offset and space left behind the allocation are returned to the block as free ranges
+		// Neither can have a free neighbour, as free ranges are always merged
+		const VkDeviceSize alignedOffset = alignUp(node->offset, alignment);
+		if (alignedOffset > node->offset) {
+			Node *padding = new Node();
+			padding->offset = node->offset;
+			padding->size = alignedOffset - node->offset;
+			padding->prevPhysical = node->prevPhysical;
+			padding->nextPhysical = node;
+			if (node->prevPhysical) {
+				node->prevPhysical->nextPhysical = padding;
+			}
+			else {
+				block->firstNode = padding;
+			}
+			node->prevPhysical = padding;
+			node->offset = alignedOffset;
+			node->size -= padding->size;
+			block->insertFree(padding);
+		}
+		if (node->size > size) {
+			Node *remainder = new Node();
+			remainder->offset = node->offset + size;
+			remainder->size = node->size - size;
+			remainder->prevPhysical = node;
+			remainder->nextPhysical = node->nextPhysical;
+			if (node->nextPhysical) {
+				node->nextPhysical->prevPhysical = remainder;
+			}
+			node->nextPhysical = remainder;
+			node->size = size;
+			block->insertFree(remainder);
+		}
+
+		node->free = false;
+		node->alignment = alignment;
+		node->allocation = allocation;
+		block->allocationCount++;
+		block->usedBytes += node->size;
+
+		allocation->memory = block->memory;
+		allocation->offset = node->offset;
+		allocation->mapped = block->mapped ? static_cast<uint8_t *>(block->mapped) + node->offset : nullptr;
+		allocation->dedicated = false;
+		allocation->block = block;
+		allocation->node = node;
+		return true;
+	}
+
+	void MemoryAllocator::freeFromBlock(Block *block, Node *node)
+	{
+		block->allocationCount--;
+		block->usedBytes -= node->size;
+		node->free = true;
+		node->allocation = nullptr;
+
+		// Merge with free neighbours
+		Node *prev = node->prevPhysical;
+		if (prev && prev->free) {
+			block->removeFree(prev);
+			prev->size += node->size;
+			prev->nextPhysical = node->nextPhysical;
+			if (node->nextPhysical) {
+				node->nextPhysical->prevPhysical = prev;
+			}
+			delete node;
+			node = prev;
+		}
+		Node *next = node->nextPhysical;
+		if (next && next->free) {
+			block->removeFree(next);
+			node->size += next->size;
+			node->nextPhysical = next->nextPhysical;
+			if (next->nextPhysical) {
+				next->nextPhysical->prevPhysical = node;
+			}
+			delete next;
+		}
+		block->insertFree(node);
+	}
+
+	void MemoryAllocator::destroyBlock(Block *block)
+	{
+		Node *node = block->firstNode;
+		while (node) {
+			Node *next = node->nextPhysical;
+			if (node->allocation) {
+				// Allocations that haven't been freed by their owner
+				delete node->allocation;
+			}
+			delete node;
+			node = next;
+		}
+		freeDeviceMemory(block->memory);
+		delete block;
+	}
+
+	void MemoryAllocator::releaseEmptyBlocks(Pool &pool, bool keepOne)
+	{
+		for (auto it = pool.blocks.begin(); it != pool.blocks.end();) {
+			if (((*it)->allocationCount == 0) && (!keepOne || (pool.blocks.size() > 1))) {
+				destroyBlock(*it);
+				it = pool.blocks.erase(it);
+			}
+			else {
+				++it;
+			}
+		}
+	}
+
+	VkResult MemoryAllocator::allocate(const VkMemoryRequirements &memoryRequirements, uint32_t memoryTypeIndex, ResourceType resourceType, MemoryCategory category, Allocation **allocation, VkMemoryAllocateFlags allocateFlags, bool dedicated, const char *name)
+	{
+		std::lock_guard<std::recursive_mutex> lock(mutex);
+		VkResult res = allocateInternal(memoryRequirements, memoryTypeIndex, resourceType, allocation, allocateFlags, dedicated);
+		if ((res == VK_SUCCESS) && tracker) {
+			tracker->track(reinterpret_cast<uintptr_t>(*allocation), category, (*allocation)->size, memoryTypeIndex, name);
+		}
+		return res;
+	}
+
+	VkResult MemoryAllocator::allocateInternal(const VkMemoryRequirements &memoryRequirements, uint32_t memoryTypeIndex, ResourceType resourceType, Allocation **allocation, VkMemoryAllocateFlags allocateFlags, bool dedicated)
+	{
+
+		VkDeviceSize size = memoryRequirements.size;
+		VkDeviceSize alignment = std::max(memoryRequirements.alignment, VkDeviceSize(1));
+		// Flushes and invalidations of non-coherent memory work on whole atoms, which must not overlap other allocations
+		const VkMemoryPropertyFlags propertyFlags = memoryProperties.memoryTypes[memoryTypeIndex].propertyFlags;
+		if ((propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) && !(propertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)) {
+			alignment = std::max(alignment, nonCoherentAtomSize);
+			size = alignUp(size, nonCoherentAtomSize);
+		}
+
+		Allocation *result = new Allocation();
+		result->allocator = this;
+		result->memoryTypeIndex = memoryTypeIndex;
+		result->size = memoryRequirements.size;
+
+		const VkDeviceSize preferredBlockSize = preferredBlockSizes[memoryProperties.memoryTypes[memoryTypeIndex].heapIndex];
+		if (!dedicated && (size <= preferredBlockSize / dedicatedAllocationDivisor)) {
+			size_t poolIndex = &getPool(memoryTypeIndex, resourceType, allocateFlags) - pools.data();
+			Pool &pool = pools[poolIndex];
+			for (auto block : pool.blocks) {
+				if (allocateFromBlock(block, size, alignment, result)) {
+					*allocation = result;
+					return VK_SUCCESS;
+				}
+			}
+
+			// No block has enough space left, if the heap is running low retry with smaller blocks down to the size of the allocation
+			VkDeviceSize blockSize = std::max(pool.nextBlockSize, size);
+			VkDeviceMemory memory;
+			void *mapped;
+			VkResult res;
+			while (true) {
+				res = allocateDeviceMemory(blockSize, memoryTypeIndex, allocateFlags, &memory, &mapped);
+				if ((res == VK_SUCCESS) || (blockSize == size)) {
+					break;
+				}
+				blockSize = std::max(blockSize / 2, size);
+			}
+			if (res == VK_SUCCESS) {
+				Block *block = new Block();
+				block->memory = memory;
+				block->size = blockSize;
+				block->mapped = mapped;
+				block->poolIndex = poolIndex;
+				block->firstNode = new Node();
+				block->firstNode->size = blockSize;
+				block->insertFree(block->firstNode);
+				pool.blocks.push_back(block);
+				pool.nextBlockSize = std::min(pool.nextBlockSize * 2, preferredBlockSize);
+				const bool allocated = allocateFromBlock(block, size, alignment, result);
+				assert(allocated);
+				(void)allocated;
+				*allocation = result;
+				return VK_SUCCESS;
+			}
+			if (res != VK_ERROR_TOO_MANY_OBJECTS) {
+				delete result;
+				return res;
+			}
+		}
+
+		// Dedicated allocation for large resources or if explicitly requested
+		VkResult res = allocateDeviceMemory(size, memoryTypeIndex, allocateFlags, &result->memory, &result->mapped);
+		if (res != VK_SUCCESS) {
+			delete result;
+			return res;
+		}
+		result->size = size;
+		result->dedicated = true;
+		dedicatedAllocations.push_back(result);
+		*allocation = result;
+		return VK_SUCCESS;
+	}
+
+	void MemoryAllocator::free(Allocation *allocation)
+	{
+		if (!allocation) {
+			return;
+		}
+		std::lock_guard<std::recursive_mutex> lock(mutex);
+		if (tracker) {
+			tracker->untrack(reinterpret_cast<uintptr_t>(allocation));
+		}
+		if (allocation->dedicated) {
+			dedicatedAllocations.erase(std::remove(dedicatedAllocations.begin(), dedicatedAllocations.end(), allocation), dedicatedAllocations.end());
+			freeDeviceMemory(allocation->memory);
+		}
+		else {
+			Block *block = static_cast<Block *>(allocation->block);
+			freeFromBlock(block, static_cast<Node *>(allocation->node));
+			// Keep one empty block per pool around to avoid allocating device memory again right away
+			if (block->allocationCount == 0) {
+				releaseEmptyBlocks(pools[block->poolIndex], true);
+			}
+		}
+		delete allocation;
+	}
+
+	void MemoryAllocator::setName(const Allocation *allocation, const char *name)
+	{
+		if (allocation && tracker) {
+			tracker->setName(reinterpret_cast<uintptr_t>(allocation), name);
+		}
+	}
+
+	VkMappedMemoryRange MemoryAllocator::getMappedRange(const Allocation *allocation, VkDeviceSize size, VkDeviceSize offset) const
+	{
+		const VkDeviceSize memorySize = allocation->dedicated ? allocation->size : static_cast<const Block *>(allocation->block)->size;
+		const VkDeviceSize begin = (allocation->offset + offset) / nonCoherentAtomSize * nonCoherentAtomSize;
+		const VkDeviceSize end = alignUp(allocation->offset + ((size == VK_WHOLE_SIZE) ? allocation->size : offset + size), nonCoherentAtomSize);
+		VkMappedMemoryRange mappedRange{};
+		mappedRange.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+		mappedRange.memory = allocation->memory;
+		mappedRange.offset = begin;
+		mappedRange.size = (end >= memorySize) ? VK_WHOLE_SIZE : end - begin;
+		return mappedRange;
+	}
+
+	VkResult MemoryAllocator::flush(const Allocation *allocation, VkDeviceSize size, VkDeviceSize offset)
+	{
+		VkMappedMemoryRange mappedRange = getMappedRange(allocation, size, offset);
+		return vkFlushMappedMemoryRanges(device, 1, &mappedRange);
+	}
+
+	VkResult MemoryAllocator::invalidate(const Allocation *allocation, VkDeviceSize size, VkDeviceSize offset)
+	{
+		VkMappedMemoryRange mappedRange = getMappedRange(allocation, size, offset);
+		return vkInvalidateMappedMemoryRanges(device, 1, &mappedRange);
+	}
+
+	uint32_t MemoryAllocator::defragment(const DefragmentationCallback &callback)
+	{
+		std::lock_guard<std::recursive_mutex> lock(mutex);
+		uint32_t moveCount = 0;
+		for (auto &pool : pools) {
+			if (pool.blocks.size() < 2) {
+				continue;
+			}
+			// Empty the least used blocks into the fuller ones
+			std::vector<Block *> blocks = pool.blocks;
+			std::sort(blocks.begin(), blocks.end(), [](const Block *a, const Block *b) { return a->usedBytes < b->usedBytes; });
+			for (size_t src = 0; src < blocks.size() - 1; src++) {
+				Block *source = blocks[src];
+				std::vector<Node *> nodes;
+				for (Node *node = source->firstNode; node; node = node->nextPhysical) {
+					if (!node->free) {
+						nodes.push_back(node);
+					}
+				}
+				for (auto node : nodes) {
+					Allocation *allocation = node->allocation;
+					for (size_t dst = blocks.size() - 1; dst > src; dst--) {
+						Allocation target;
+						if (!allocateFromBlock(blocks[dst], node->size, node->alignment, &target)) {
+							continue;
+						}
+						Node *targetNode = static_cast<Node *>(target.node);
+						if (callback(allocation, target.memory, target.offset)) {
+							freeFromBlock(source, node);
+							targetNode->allocation = allocation;
+							allocation->memory = target.memory;
+							allocation->offset = target.offset;
+							allocation->mapped = target.mapped;
+							allocation->block = target.block;
+							allocation->node = targetNode;
+							moveCount++;
+						}
+						else {
+							freeFromBlock(blocks[dst], targetNode);
+						}
+						break;
+					}
+				}
+			}
+			releaseEmptyBlocks(pool, true);
+		}
+		return moveCount;
+	}
+
+	void MemoryAllocator::releaseEmptyBlocks()
+	{
+		std::lock_guard<std::recursive_mutex> lock(mutex);
+		for (auto &pool : pools) {
+			releaseEmptyBlocks(pool, false);
+		}
+	}
+
+	void MemoryAllocator::accumulateStats(Stats &stats, int64_t memoryTypeIndex) const
+	{
+		for (auto &pool : pools) {
+			if ((memoryTypeIndex >= 0) && (pool.memoryTypeIndex != memoryTypeIndex)) {
+				continue;
+			}
+			for (auto block : pool.blocks) {
+				stats.blockCount++;
+				stats.allocationCount += block->allocationCount;
+				stats.allocatedBytes += block->size;
+				stats.usedBytes += block->usedBytes;
+				for (Node *node = block->firstNode; node; node = node->nextPhysical) {
+					if (node->free) {
+						stats.freeRangeCount++;
+						stats.largestFreeRange = std::max(stats.largestFreeRange, node->size);
+					}
+				}
+			}
+		}
+		for (auto allocation : dedicatedAllocations) {
+			if ((memoryTypeIndex >= 0) && (allocation->memoryTypeIndex != memoryTypeIndex)) {
+				continue;
+			}
+			stats.allocationCount++;
+			stats.dedicatedAllocationCount++;
+			stats.allocatedBytes += allocation->size;
+			stats.usedBytes += allocation->size;
+		}
+	}
+
+	MemoryAllocator::Stats MemoryAllocator::getStats() const
+	{
+		std::lock_guard<std::recursive_mutex> lock(mutex);
+		Stats stats;
+		accumulateStats(stats, -1);
+		return stats;
+	}
+
+	MemoryAllocator::Stats MemoryAllocator::getStats(uint32_t memoryTypeIndex) const
+	{
+		std::lock_guard<std::recursive_mutex> lock(mutex);
+		Stats stats;
+		accumulateStats(stats, memoryTypeIndex);
+		return stats;
+	}
+
+	uint32_t MemoryAllocator::getDeviceAllocationCount() const
+	{
+		std::lock_guard<std::recursive_mutex> lock(mutex);
+		return deviceAllocationCount;
+	}
+}
@@ -0,0 +1,174 @@
+/*
+* Vulkan device memory sub-allocator
+*
+* Allocates large memory blocks per memory type and hands out ranges of them using a two-level segregated fit (TLSF) allocator
+* This keeps the number of vkAllocateMemory calls (and with it maxMemoryAllocationCount) low, even for scenes with thousands of resources
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "vulkan/vulkan.h"
+#include "VulkanMemoryTracker.h"
+
+namespace vks
+{
+	class MemoryAllocator;
+
+	/**
+	* @brief Kind of resource bound to an allocation
+	* @note Linear and optimal resources are placed in separate blocks, so neighbouring allocations never violate bufferImageGranularity
+	*/
+	enum class ResourceType
+	{
+		/** @brief Buffers and images with linear tiling */
+		Linear,
+		/** @brief Images with optimal tiling */
+		Optimal
+	};
+
+	/** @brief Range of device memory handed out by the allocator */
+	struct Allocation
+	{
+		MemoryAllocator *allocator = nullptr;
+		VkDeviceMemory memory = VK_NULL_HANDLE;
+		/** @brief Offset into memory, resources need to be bound at this offset */
+		VkDeviceSize offset = 0;
+		VkDeviceSize size = 0;
+		uint32_t memoryTypeIndex = 0;
+		/** @brief Host address of the allocation for host visible memory types (blocks are persistently mapped), nullptr otherwise */
+		void *mapped = nullptr;
+		/** @brief True if the allocation has it's own device memory object */
+		bool dedicated = false;
+		/** @brief Can be set by the owner to identify the resource in defragmentation callbacks */
+		void *userData = nullptr;
+
+		// Internal bookkeeping of the allocator
+		void *block = nullptr;
+		void *node = nullptr;
+	};
+
+	class MemoryAllocator
+	{
+	public:
+		struct Stats
+		{
+			uint32_t blockCount = 0;
+			uint32_t allocationCount = 0;
+			uint32_t dedicatedAllocationCount = 0;
+			/** @brief Number of free ranges inside of blocks (a high count relative to the allocation count indicates fragmentation) */
+			uint32_t freeRangeCount = 0;
+			/** @brief Size of all blocks and dedicated allocations, i.e. the memory actually allocated from the device */
+			VkDeviceSize allocatedBytes = 0;
+			/** @brief Size of all allocations handed out, including dedicated allocations */
+			VkDeviceSize usedBytes = 0;
+			VkDeviceSize largestFreeRange = 0;
+		};
+
+		/**
+		* @brief Called for every allocation that is moved during defragmentation
+		* The callback needs to copy the content of the allocation to the new location and rebind the resource owning it
+		* Returning false keeps the allocation at it's current location
+		*/
+		typedef std::function<bool(Allocation *allocation, VkDeviceMemory newMemory, VkDeviceSize newOffset)> DefragmentationCallback;
+
+		/** @brief Allocations larger than this fraction of the preferred block size get a dedicated allocation */
+		static const uint32_t dedicatedAllocationDivisor = 2;
+
+		/** @brief (Optional) Tracker that all allocations are accounted for with */
+		vks::MemoryTracker *tracker = nullptr;
+
+		MemoryAllocator(VkPhysicalDevice physicalDevice, VkDevice device, VkDeviceSize preferredBlockSize = 0);
+		~MemoryAllocator();
+
+		/**
+		* Allocate a range of device memory
+		*
+		* @param memoryRequirements Size, alignment and supported memory types of the resource
+		* @param memoryTypeIndex Index of the memory type to allocate from
+		* @param resourceType Kind of resource that will be bound to the allocation
+		* @param category Category the allocation is accounted for with the tracker
+		* @param allocation Receives the allocation
+		* @param (Optional) allocateFlags Flags for the memory allocation (e.g. device address), allocations with different flags use separate blocks
+		* @param (Optional) dedicated Always give the allocation it's own device memory object (e.g. for resources that prefer a dedicated allocation)
+		* @param (Optional) name Debug name of the allocation for the tracker
+		*
+		* @return VK_SUCCESS or the error returned by vkAllocateMemory
+		*/
+		VkResult allocate(const VkMemoryRequirements &memoryRequirements, uint32_t memoryTypeIndex, ResourceType resourceType, MemoryCategory category, Allocation **allocation, VkMemoryAllocateFlags allocateFlags = 0, bool dedicated = false, const char *name = nullptr);
+		/** @brief Return an allocation to it's block (or free it's memory if it's a dedicated allocation) */
+		void free(Allocation *allocation);
+		/** @brief Set the debug name the allocation is listed with by the tracker */
+		void setName(const Allocation *allocation, const char *name);
+
+		/** @brief Flush a range of a host visible allocation, offset and size are relative to the allocation and get aligned to nonCoherentAtomSize */
+		VkResult flush(const Allocation *allocation, VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
+		/** @brief Invalidate a range of a host visible allocation, offset and size are relative to the allocation and get aligned to nonCoherentAtomSize */
+		VkResult invalidate(const Allocation *allocation, VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
+
+		/**
+		* Move allocations out of sparsely used blocks into other blocks of the same kind and release blocks that end up empty
+		*
+		* @param callback Called for each allocation to be moved, see DefragmentationCallback
+		*
+		* @return Number of allocations that have been moved
+		*
+		* @note Must not be called while the device accesses any of the allocations
+		*/
+		uint32_t defragment(const DefragmentationCallback &callback);
+		/** @brief Release all blocks that don't contain any allocations */
+		void releaseEmptyBlocks();
+
+		/** @brief Statistics over all memory types */
+		Stats getStats() const;
+		/** @brief Statistics for a single memory type */
+		Stats getStats(uint32_t memoryTypeIndex) const;
+		/** @brief Number of device memory objects currently allocated (blocks and dedicated allocations) */
+		uint32_t getDeviceAllocationCount() const;
+
+	private:
+		struct Node;
+		struct Block;
+
+		// Blocks are grouped by everything that needs to match for a resource to be placed next to another one
+		struct Pool
+		{
+			uint32_t memoryTypeIndex;
+			ResourceType resourceType;
+			VkMemoryAllocateFlags allocateFlags;
+			std::vector<Block *> blocks;
+			VkDeviceSize nextBlockSize;
+		};
+
+		VkDevice device;
+		VkPhysicalDeviceMemoryProperties memoryProperties;
+		VkDeviceSize bufferImageGranularity;
+		VkDeviceSize nonCoherentAtomSize;
+		uint32_t maxMemoryAllocationCount;
+		std::vector<VkDeviceSize> preferredBlockSizes;
+		std::vector<Pool> pools;
+		std::vector<Allocation *> dedicatedAllocations;
+		uint32_t deviceAllocationCount = 0;
+		// Recursive, so defragmentation callbacks can create resources (e.g. staging buffers)
+		mutable std::recursive_mutex mutex;
+
+		VkResult allocateInternal(const VkMemoryRequirements &memoryRequirements, uint32_t memoryTypeIndex, ResourceType resourceType, Allocation **allocation, VkMemoryAllocateFlags allocateFlags, bool dedicated);
+		VkResult allocateDeviceMemory(VkDeviceSize size, uint32_t memoryTypeIndex, VkMemoryAllocateFlags allocateFlags, VkDeviceMemory *memory, void **mapped);
+		void freeDeviceMemory(VkDeviceMemory memory);
+		Pool &getPool(uint32_t memoryTypeIndex, ResourceType resourceType, VkMemoryAllocateFlags allocateFlags);
+		bool allocateFromBlock(Block *block, VkDeviceSize size, VkDeviceSize alignment, Allocation *allocation);
+		void freeFromBlock(Block *block, Node *node);
+		void destroyBlock(Block *block);
+		void releaseEmptyBlocks(Pool &pool, bool keepOne);
+		VkMappedMemoryRange getMappedRange(const Allocation *allocation, VkDeviceSize size, VkDeviceSize offset) const;
+		void accumulateStats(Stats &stats, int64_t memoryTypeIndex) const;
+	};
+}
@@ -0,0 +1,236 @@
+/*
+* Vulkan device memory tracker
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "VulkanMemoryTracker.h"
+#include "VulkanMemoryAllocator.h"
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+namespace vks
+{
+	namespace
+	{
+		std::string escapeJson(const std::string &value)
+		{
+			std::string result;
+			for (char c : value) {
+				switch (c) {
+				case '"':
+					result += "\\\"";
+					break;
+				case '\\':
+					result += "\\\\";
+					break;
+				case '\n':
+					result += "\\n";
+					break;
+				default:
+					// Other control characters are not expected in debug names
+					if (static_cast<unsigned char>(c) >= 0x20) {
+						result += c;
+					}
+				}
+			}
+			return result;
+		}
+
+		void addStats(MemoryTracker::CategoryStats &stats, VkDeviceSize size)
+		{
+			stats.bytes += size;
+			stats.allocationCount++;
+			stats.peakBytes = std::max(stats.peakBytes, stats.bytes);
+			stats.peakAllocationCount = std::max(stats.peakAllocationCount, stats.allocationCount);
+		}
+
+		void removeStats(MemoryTracker::CategoryStats &stats, VkDeviceSize size)
+		{
+			stats.bytes -= size;
+			stats.allocationCount--;
+		}
+	}
+
+	const char *MemoryTracker::getCategoryName(MemoryCategory category)
+	{
+		switch (category) {
+		case MemoryCategory::VertexBuffer:
+			return "vertex_buffers";
+		case MemoryCategory::IndexBuffer:
+			return "index_buffers";
+		case MemoryCategory::UniformBuffer:
+			return "uniform_buffers";
+		case MemoryCategory::StorageBuffer:
+			return "storage_buffers";
+		case MemoryCategory::Staging:
+			return "staging";
+		case MemoryCategory::Texture:
+			return "textures";
+		case MemoryCategory::RenderTarget:
+			return "render_targets";
+		case MemoryCategory::AccelerationStructure:
+			return "acceleration_structures";
+		default:
+			return "other";
+		}
+	}
+
+	MemoryCategory MemoryTracker::getBufferCategory(VkBufferUsageFlags usageFlags)
+	{
+		// Buffers with multiple usages are accounted for by the most specific one
+		if (usageFlags & VK_BUFFER_USAGE_VERTEX_BUFFER_BIT) {
+			return MemoryCategory::VertexBuffer;
+		}
+		if (usageFlags & VK_BUFFER_USAGE_INDEX_BUFFER_BIT) {
+			return MemoryCategory::IndexBuffer;
+		}
+		if (usageFlags & VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR) {
+			return MemoryCategory::AccelerationStructure;
+		}
+		if (usageFlags & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT) {
+			return MemoryCategory::UniformBuffer;
+		}
+		if (usageFlags & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT) {
+			return MemoryCategory::StorageBuffer;
+		}
+		if (usageFlags == VK_BUFFER_USAGE_TRANSFER_SRC_BIT) {
+			return MemoryCategory::Staging;
+		}
+		return MemoryCategory::Other;
+	}
+
+	MemoryCategory MemoryTracker::getImageCategory(VkImageUsageFlags usageFlags)
+	{
+		if (usageFlags & (VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT)) {
+			return MemoryCategory::RenderTarget;
+		}
+		return MemoryCategory::Texture;
+	}
+
+	void MemoryTracker::setMemoryProperties(const VkPhysicalDeviceMemoryProperties &memoryProperties)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		memoryTypeHeaps.resize(memoryProperties.memoryTypeCount);
+		for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+			memoryTypeHeaps[i] = memoryProperties.memoryTypes[i].heapIndex;
+		}
+		heapStats.assign(memoryProperties.memoryHeapCount, CategoryStats());
+	}
+
+	MemoryTracker::CategoryStats *MemoryTracker::getMemoryTypeHeapStats(uint32_t memoryTypeIndex)
+	{
+		return (memoryTypeIndex < memoryTypeHeaps.size()) ? &heapStats[memoryTypeHeaps[memoryTypeIndex]] : nullptr;
+	}
+
+	void MemoryTracker::track(uint64_t key, MemoryCategory category, VkDeviceSize size, uint32_t memoryTypeIndex, const char *name)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto it = entries.find(key);
+		if (it != entries.end()) {
+			// Key has been reused without being untracked (e.g. memory freed directly with vkFreeMemory)
+			removeStats(categoryStats[static_cast<size_t>(it->second.category)], it->second.size);
+			removeStats(totalStats, it->second.size);
+			if (CategoryStats *heap = getMemoryTypeHeapStats(it->second.memoryTypeIndex)) {
+				removeStats(*heap, it->second.size);
+			}
+			entries.erase(it);
+		}
+		Entry entry;
+		entry.category = category;
+		entry.size = size;
+		entry.memoryTypeIndex = memoryTypeIndex;
+		entry.name = name ? name : "";
+		entries[key] = entry;
+		addStats(categoryStats[static_cast<size_t>(category)], size);
+		addStats(totalStats, size);
+		if (CategoryStats *heap = getMemoryTypeHeapStats(memoryTypeIndex)) {
+			addStats(*heap, size);
+		}
+	}
+
+	void MemoryTracker::untrack(uint64_t key)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto it = entries.find(key);
+		if (it == entries.end()) {
+			return;
+		}
+		removeStats(categoryStats[static_cast<size_t>(it->second.category)], it->second.size);
+		removeStats(totalStats, it->second.size);
+		if (CategoryStats *heap = getMemoryTypeHeapStats(it->second.memoryTypeIndex)) {
+			removeStats(*heap, it->second.size);
+		}
+		entries.erase(it);
+	}
+
+	void MemoryTracker::setName(uint64_t key, const char *name)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto it = entries.find(key);
+		if (it != entries.end()) {
+			it->second.name = name ? name : "";
+		}
+	}
+
+	MemoryTracker::CategoryStats MemoryTracker::getStats(MemoryCategory category) const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return categoryStats[static_cast<size_t>(category)];
+	}
+
+	MemoryTracker::CategoryStats MemoryTracker::getTotalStats() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return totalStats;
+	}
+
+	std::vector<MemoryTracker::CategoryStats> MemoryTracker::getHeapStats() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return heapStats;
+	}
+
+	bool MemoryTracker::writeReport(const std::string &filename, const vks::MemoryAllocator *allocator) const
+	{
+		std::ofstream result(filename, std::ios::out);
+		if (!result.is_open()) {
+			return false;
+		}
+
+		std::lock_guard<std::mutex> lock(mutex);
+		result << "{\n";
+		result << "\t\"total\": { \"bytes\": " << totalStats.bytes << ", \"peakBytes\": " << totalStats.peakBytes << ", \"allocations\": " << totalStats.allocationCount << ", \"peakAllocations\": " << totalStats.peakAllocationCount << " },\n";
+		result << "\t\"categories\": {\n";
+		for (size_t i = 0; i < static_cast<size_t>(MemoryCategory::Count); i++) {
+			const CategoryStats &stats = categoryStats[i];
+			result << "\t\t\"" << getCategoryName(static_cast<MemoryCategory>(i)) << "\": { \"bytes\": " << stats.bytes << ", \"peakBytes\": " << stats.peakBytes << ", \"allocations\": " << stats.allocationCount << ", \"peakAllocations\": " << stats.peakAllocationCount << " }";
+			result << ((i + 1 < static_cast<size_t>(MemoryCategory::Count)) ? ",\n" : "\n");
+		}
+		result << "\t},\n";
+		if (allocator) {
+			const vks::MemoryAllocator::Stats allocatorStats = allocator->getStats();
+			result << "\t\"allocator\": { \"blocks\": " << allocatorStats.blockCount << ", \"dedicatedAllocations\": " << allocatorStats.dedicatedAllocationCount << ", \"allocatedBytes\": " << allocatorStats.allocatedBytes << ", \"usedBytes\": " << allocatorStats.usedBytes << ", \"freeRanges\": " << allocatorStats.freeRangeCount << " },\n";
+		}
+
+		// Largest allocations first, as these are the ones to look at when a budget is exceeded
+		std::vector<const Entry*> sorted;
+		sorted.reserve(entries.size());
+		for (auto &entry : entries) {
+			sorted.push_back(&entry.second);
+		}
+		std::sort(sorted.begin(), sorted.end(), [](const Entry *a, const Entry *b) { return a->size > b->size; });
+		result << "\t\"allocations\": [\n";
+		for (size_t i = 0; i < sorted.size(); i++) {
+			result << "\t\t{ \"category\": \"" << getCategoryName(sorted[i]->category) << "\", \"size\": " << sorted[i]->size << ", \"memoryType\": " << sorted[i]->memoryTypeIndex << ", \"name\": \"" << escapeJson(sorted[i]->name) << "\" }";
+			result << ((i + 1 < sorted.size()) ? ",\n" : "\n");
+		}
+		result << "\t]\n";
+		result << "}\n";
+		return true;
+	}
+}
@@ -0,0 +1,116 @@
+/*
+* Vulkan device memory tracker
+*
+* Keeps per-category totals and peaks of all device memory allocated through the framework (sub-allocations and direct allocations)
+* Allocations can be given a debug name, which is also used for the report written to disk
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "vulkan/vulkan.h"
+
+namespace vks
+{
+	class MemoryAllocator;
+
+	/** @brief What an allocation is used for, memory is accounted for per category */
+	enum class MemoryCategory
+	{
+		VertexBuffer,
+		IndexBuffer,
+		UniformBuffer,
+		StorageBuffer,
+		/** @brief Host visible buffers used as the source of transfers */
+		Staging,
+		/** @brief Sampled and storage images */
+		Texture,
+		/** @brief Color and depth/stencil attachments */
+		RenderTarget,
+		AccelerationStructure,
+		Other,
+		/** @brief Number of categories, not a valid category */
+		Count
+	};
+
+	class MemoryTracker
+	{
+	public:
+		struct CategoryStats
+		{
+			VkDeviceSize bytes = 0;
+			VkDeviceSize peakBytes = 0;
+			uint32_t allocationCount = 0;
+			uint32_t peakAllocationCount = 0;
+		};
+
+		/** @brief Name of a category as used in the overlay and the report */
+		static const char *getCategoryName(MemoryCategory category);
+		/** @brief Derive the category of a buffer from it's usage flags */
+		static MemoryCategory getBufferCategory(VkBufferUsageFlags usageFlags);
+		/** @brief Derive the category of an image from it's usage flags */
+		static MemoryCategory getImageCategory(VkImageUsageFlags usageFlags);
+
+		/** @brief Map memory types to heaps, so allocations are also accounted for per heap */
+		void setMemoryProperties(const VkPhysicalDeviceMemoryProperties &memoryProperties);
+
+		/**
+		* Start accounting for an allocation
+		*
+		* @param key Identifies the allocation (e.g. the address of a vks::Allocation or a VkDeviceMemory handle)
+		* @param category Category the allocation is accounted for
+		* @param size Size of the allocation in bytes
+		* @param memoryTypeIndex Memory type the allocation has been made from
+		* @param (Optional) name Debug name of the allocation
+		*/
+		void track(uint64_t key, MemoryCategory category, VkDeviceSize size, uint32_t memoryTypeIndex, const char *name = nullptr);
+		/** @brief Stop accounting for an allocation, unknown keys are ignored */
+		void untrack(uint64_t key);
+		/** @brief Set the debug name of a tracked allocation */
+		void setName(uint64_t key, const char *name);
+
+		CategoryStats getStats(MemoryCategory category) const;
+		/** @brief Current and peak bytes over all categories */
+		CategoryStats getTotalStats() const;
+		/** @brief Current and peak bytes per memory heap (empty if the memory properties have not been set) */
+		std::vector<CategoryStats> getHeapStats() const;
+
+		/**
+		* Write a JSON report with the per-category totals and peaks and a list of all live allocations (largest first)
+		*
+		* @param filename Name of the file to write the report to
+		* @param (Optional) allocator Sub-allocator to add block statistics for, so memory allocated but not handed out shows up
+		*
+		* @return True if the report has been written
+		*/
+		bool writeReport(const std::string &filename, const vks::MemoryAllocator *allocator = nullptr) const;
+
+	private:
+		struct Entry
+		{
+			MemoryCategory category;
+			VkDeviceSize size;
+			uint32_t memoryTypeIndex;
+			std::string name;
+		};
+
+		std::unordered_map<uint64_t, Entry> entries;
+		CategoryStats categoryStats[static_cast<size_t>(MemoryCategory::Count)];
+		CategoryStats totalStats;
+		// Heap of every memory type
+		std::vector<uint32_t> memoryTypeHeaps;
+		std::vector<CategoryStats> heapStats;
+		CategoryStats *getMemoryTypeHeapStats(uint32_t memoryTypeIndex);
+		// Allocations may be made from multiple threads (e.g. asset loading)
+		mutable std::mutex mutex;
+	};
+}
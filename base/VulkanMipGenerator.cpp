@@ -0,0 +1,360 @@
+/*
+* Compute shader based mip chain generation
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "VulkanMipGenerator.h"
+#include "VulkanCpuProfiler.h"
+#include "VulkanObjectCounters.h"
+
+#include <algorithm>
+
+namespace vks
+{
+	namespace
+	{
+		// Levels are written through storage views, which usually aren't supported for sRGB formats
+		VkFormat getStorageFormat(VkFormat format)
+		{
+			switch (format)
+			{
+			case VK_FORMAT_R8_SRGB:
+				return VK_FORMAT_R8_UNORM;
+			case VK_FORMAT_R8G8_SRGB:
+				return VK_FORMAT_R8G8_UNORM;
+			case VK_FORMAT_R8G8B8A8_SRGB:
+				return VK_FORMAT_R8G8B8A8_UNORM;
+			case VK_FORMAT_B8G8R8A8_SRGB:
+				return VK_FORMAT_B8G8R8A8_UNORM;
+			case VK_FORMAT_A8B8G8R8_SRGB_PACK32:
+				return VK_FORMAT_A8B8G8R8_UNORM_PACK32;
+			default:
+				return format;
+			}
+		}
+
+		void insertBarrier(VkCommandBuffer commandBuffer, VkImage image, VkImageSubresourceRange subresourceRange, VkImageLayout oldLayout, VkImageLayout newLayout, VkAccessFlags srcAccessMask, VkAccessFlags dstAccessMask, VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask, uint32_t srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED, uint32_t dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED)
+		{
+			VkImageMemoryBarrier imageMemoryBarrier = vks::initializers::imageMemoryBarrier();
+			imageMemoryBarrier.oldLayout = oldLayout;
+			imageMemoryBarrier.newLayout = newLayout;
+			imageMemoryBarrier.srcAccessMask = srcAccessMask;
+			imageMemoryBarrier.dstAccessMask = dstAccessMask;
+			imageMemoryBarrier.srcQueueFamilyIndex = srcQueueFamilyIndex;
+			imageMemoryBarrier.dstQueueFamilyIndex = dstQueueFamilyIndex;
+			imageMemoryBarrier.image = image;
+			imageMemoryBarrier.subresourceRange = subresourceRange;
+			vkCmdPipelineBarrier(commandBuffer, srcStageMask, dstStageMask, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
+		}
+
+		VkImageSubresourceRange levelRange(uint32_t baseMipLevel, uint32_t levelCount, uint32_t layerCount)
+		{
+			VkImageSubresourceRange subresourceRange = {};
+			subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+			subresourceRange.baseMipLevel = baseMipLevel;
+			subresourceRange.levelCount = levelCount;
+			subresourceRange.layerCount = layerCount;
+			return subresourceRange;
+		}
+	}
+
+	/**
+	* Create the compute pipeline
+	*
+	* @param device Device to create the pipeline on
+	* @param pipelineCache Pipeline cache to use (can be VK_NULL_HANDLE)
+	* @param shaderFile SPIR-V file of the downsampling compute shader
+	*/
+	void MipGenerator::create(vks::VulkanDevice *device, VkPipelineCache pipelineCache, const std::string &shaderFile)
+	{
+		this->device = device;
+
+		// Binding 0: Source level
+		// Binding 1: Up to six destination levels
+		std::vector<VkDescriptorSetLayoutBinding> setLayoutBindings = {
+			vks::initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, VK_SHADER_STAGE_COMPUTE_BIT, 0),
+			vks::initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, VK_SHADER_STAGE_COMPUTE_BIT, 1, levelsPerDispatch),
+		};
+		VkDescriptorSetLayoutCreateInfo descriptorLayoutCI = vks::initializers::descriptorSetLayoutCreateInfo(setLayoutBindings);
+		VK_CHECK_RESULT(vkCreateDescriptorSetLayout(device->logicalDevice, &descriptorLayoutCI, nullptr, &descriptorSetLayout));
+
+		VkPushConstantRange pushConstantRange = vks::initializers::pushConstantRange(VK_SHADER_STAGE_COMPUTE_BIT, sizeof(PushConstBlock), 0);
+		VkPipelineLayoutCreateInfo pipelineLayoutCI = vks::initializers::pipelineLayoutCreateInfo(&descriptorSetLayout, 1);
+		pipelineLayoutCI.pushConstantRangeCount = 1;
+		pipelineLayoutCI.pPushConstantRanges = &pushConstantRange;
+		VK_CHECK_RESULT(vkCreatePipelineLayout(device->logicalDevice, &pipelineLayoutCI, nullptr, &pipelineLayout));
+
+		VkPipelineShaderStageCreateInfo shaderStage = {};
+		shaderStage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		shaderStage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+#if defined(__ANDROID__)
+		shaderStage.module = vks::tools::loadShader(androidApp->activity->assetManager, shaderFile.c_str(), device->logicalDevice);
+#else
+		shaderStage.module = vks::tools::loadShader(shaderFile.c_str(), device->logicalDevice);
+#endif
+		shaderStage.pName = "main";
+		assert(shaderStage.module != VK_NULL_HANDLE);
+
+		VkComputePipelineCreateInfo computePipelineCI = vks::initializers::computePipelineCreateInfo(pipelineLayout, 0);
+		computePipelineCI.stage = shaderStage;
+		VK_CHECK_RESULT(vks::ObjectCounters::createComputePipelines(device->logicalDevice, pipelineCache, 1, &computePipelineCI, nullptr, &pipeline));
+
+		vkDestroyShaderModule(device->logicalDevice, shaderStage.module, nullptr);
+	}
+
+	void MipGenerator::destroy()
+	{
+		if (!device) {
+			return;
+		}
+		releaseResources();
+		if (computeCommandPool != VK_NULL_HANDLE) {
+			vkDestroyCommandPool(device->logicalDevice, computeCommandPool, nullptr);
+			computeCommandPool = VK_NULL_HANDLE;
+		}
+		vks::ObjectCounters::destroyPipeline(device->logicalDevice, pipeline, nullptr);
+		vkDestroyPipelineLayout(device->logicalDevice, pipelineLayout, nullptr);
+		vkDestroyDescriptorSetLayout(device->logicalDevice, descriptorSetLayout, nullptr);
+		pipeline = VK_NULL_HANDLE;
+		pipelineLayout = VK_NULL_HANDLE;
+		descriptorSetLayout = VK_NULL_HANDLE;
+	}
+
+	/**
+	* Use a dedicated compute queue for generate
+	*
+	* @param queue Queue to run the dispatches on
+	* @param queueFamilyIndex Family of the queue
+	*/
+	void MipGenerator::setComputeQueue(VkQueue queue, uint32_t queueFamilyIndex)
+	{
+		if (computeCommandPool != VK_NULL_HANDLE) {
+			vkDestroyCommandPool(device->logicalDevice, computeCommandPool, nullptr);
+			computeCommandPool = VK_NULL_HANDLE;
+		}
+		computeQueue = queue;
+		computeQueueFamilyIndex = queueFamilyIndex;
+		if (computeQueue != VK_NULL_HANDLE) {
+			computeCommandPool = device->createCommandPool(queueFamilyIndex);
+		}
+	}
+
+	bool MipGenerator::isSupported(VkFormat format) const
+	{
+		// The shader writes without a format qualifier, so it works with all color formats that support storage
+		if (!device->enabledFeatures.shaderStorageImageWriteWithoutFormat) {
+			return false;
+		}
+		VkFormatProperties formatProperties;
+		vkGetPhysicalDeviceFormatProperties(device->physicalDevice, getStorageFormat(format), &formatProperties);
+		const VkFormatFeatureFlags requiredFeatures = VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT;
+		return (formatProperties.optimalTilingFeatures & requiredFeatures) == requiredFeatures;
+	}
+
+	void MipGenerator::recordDispatches(VkCommandBuffer commandBuffer, VkImage image, VkFormat format, uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t layerCount)
+	{
+		Resources resources;
+
+		// One view per level and layer, used as the source of one dispatch and as the destination of another
+		const VkFormat viewFormat = getStorageFormat(format);
+		resources.views.resize(layerCount * mipLevels);
+		for (uint32_t layer = 0; layer < layerCount; layer++) {
+			for (uint32_t level = 0; level < mipLevels; level++) {
+				VkImageViewCreateInfo viewCI = vks::initializers::imageViewCreateInfo();
+				viewCI.image = image;
+				viewCI.viewType = VK_IMAGE_VIEW_TYPE_2D;
+				viewCI.format = viewFormat;
+				viewCI.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, level, 1, layer, 1 };
+				VK_CHECK_RESULT(vkCreateImageView(device->logicalDevice, &viewCI, nullptr, &resources.views[layer * mipLevels + level]));
+			}
+		}
+
+		const uint32_t dispatchesPerLayer = (mipLevels - 1 + levelsPerDispatch - 1) / levelsPerDispatch;
+		const uint32_t setCount = dispatchesPerLayer * layerCount;
+		std::vector<VkDescriptorPoolSize> poolSizes = {
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, setCount),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, setCount * levelsPerDispatch),
+		};
+		VkDescriptorPoolCreateInfo descriptorPoolCI = vks::initializers::descriptorPoolCreateInfo(poolSizes, setCount);
+		VK_CHECK_RESULT(vkCreateDescriptorPool(device->logicalDevice, &descriptorPoolCI, nullptr, &resources.descriptorPool));
+
+		PushConstBlock pushConstBlock;
+		pushConstBlock.filterMode = static_cast<uint32_t>(filter);
+		pushConstBlock.srgb = (srgb || (viewFormat != format)) ? 1 : 0;
+
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+
+		for (uint32_t dispatch = 0; dispatch < dispatchesPerLayer; dispatch++) {
+			const uint32_t sourceLevel = dispatch * levelsPerDispatch;
+			const uint32_t levelCount = std::min(static_cast<uint32_t>(levelsPerDispatch), mipLevels - 1 - sourceLevel);
+			const uint32_t sourceWidth = std::max(width >> sourceLevel, 1u);
+			const uint32_t sourceHeight = std::max(height >> sourceLevel, 1u);
+
+			// The levels written by the previous dispatch are read by this one, no barriers are required between the levels of a single dispatch
+			if (dispatch > 0) {
+				insertBarrier(commandBuffer, image, levelRange(sourceLevel, 1, layerCount), VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_GENERAL, VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+			}
+
+			for (uint32_t layer = 0; layer < layerCount; layer++) {
+				VkDescriptorSet descriptorSet;
+				VkDescriptorSetAllocateInfo allocInfo = vks::initializers::descriptorSetAllocateInfo(resources.descriptorPool, &descriptorSetLayout, 1);
+				VK_CHECK_RESULT(vks::ObjectCounters::allocateDescriptorSets(device->logicalDevice, &allocInfo, &descriptorSet));
+
+				const VkImageView *layerViews = &resources.views[layer * mipLevels];
+				VkDescriptorImageInfo sourceDescriptor = vks::initializers::descriptorImageInfo(VK_NULL_HANDLE, layerViews[sourceLevel], VK_IMAGE_LAYOUT_GENERAL);
+				// All array elements need a valid descriptor, unused ones repeat the last level but are never written by the shader
+				VkDescriptorImageInfo levelDescriptors[levelsPerDispatch];
+				for (uint32_t i = 0; i < levelsPerDispatch; i++) {
+					levelDescriptors[i] = vks::initializers::descriptorImageInfo(VK_NULL_HANDLE, layerViews[sourceLevel + 1 + std::min(i, levelCount - 1)], VK_IMAGE_LAYOUT_GENERAL);
+				}
+				std::vector<VkWriteDescriptorSet> writeDescriptorSets = {
+					vks::initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 0, &sourceDescriptor),
+					vks::initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1, levelDescriptors, levelsPerDispatch),
+				};
+				vkUpdateDescriptorSets(device->logicalDevice, static_cast<uint32_t>(writeDescriptorSets.size()), writeDescriptorSets.data(), 0, nullptr);
+
+				pushConstBlock.sourceSize[0] = static_cast<int32_t>(sourceWidth);
+				pushConstBlock.sourceSize[1] = static_cast<int32_t>(sourceHeight);
+				pushConstBlock.levelCount = levelCount;
+				vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
+				vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PushConstBlock), &pushConstBlock);
+
+				// Each workgroup covers a 32x32 texel tile of the first level written by this dispatch
+				const uint32_t firstWidth = std::max(sourceWidth >> 1, 1u);
+				const uint32_t firstHeight = std::max(sourceHeight >> 1, 1u);
+				vkCmdDispatch(commandBuffer, (firstWidth + 31) / 32, (firstHeight + 31) / 32, 1);
+			}
+		}
+
+		pendingResources.push_back(resources);
+	}
+
+	/**
+	* Record the generation of all mip levels from the base level into an existing command buffer
+	*
+	* @param commandBuffer Command buffer to record into
+	* @param image Image with at least the base level filled
+	* @param format Format the image was created with
+	* @param width Width of the base level
+	* @param height Height of the base level
+	* @param mipLevels Number of mip levels of the image
+	* @param layerCount Number of array layers of the image
+	* @param oldLayout Current layout of the base level
+	* @param newLayout Layout all levels will be transitioned to after generation
+	*/
+	void MipGenerator::record(VkCommandBuffer commandBuffer, VkImage image, VkFormat format, uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t layerCount, VkImageLayout oldLayout, VkImageLayout newLayout)
+	{
+		if (mipLevels < 2) {
+			insertBarrier(commandBuffer, image, levelRange(0, mipLevels, layerCount), oldLayout, newLayout, VK_ACCESS_MEMORY_WRITE_BIT, VK_ACCESS_MEMORY_READ_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+			return;
+		}
+		// The base level keeps it's content, all other levels are overwritten
+		insertBarrier(commandBuffer, image, levelRange(0, 1, layerCount), oldLayout, VK_IMAGE_LAYOUT_GENERAL, VK_ACCESS_MEMORY_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+		insertBarrier(commandBuffer, image, levelRange(1, mipLevels - 1, layerCount), VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL, 0, VK_ACCESS_SHADER_WRITE_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+		recordDispatches(commandBuffer, image, format, width, height, mipLevels, layerCount);
+		insertBarrier(commandBuffer, image, levelRange(0, mipLevels, layerCount), VK_IMAGE_LAYOUT_GENERAL, newLayout, VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_MEMORY_READ_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+	}
+
+	/**
+	* Generate all mip levels and wait for completion
+	*
+	* @param queue Graphics queue that owns the image
+	* @param image Image with at least the base level filled
+	* @param format Format the image was created with
+	* @param width Width of the base level
+	* @param height Height of the base level
+	* @param mipLevels Number of mip levels of the image
+	* @param layerCount Number of array layers of the image
+	* @param oldLayout Current layout of the base level
+	* @param newLayout Layout all levels will be transitioned to after generation
+	*/
+	void MipGenerator::generate(VkQueue queue, VkImage image, VkFormat format, uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t layerCount, VkImageLayout oldLayout, VkImageLayout newLayout)
+	{
+		VKS_PROFILE_ZONE("vks::MipGenerator::generate");
+		const uint32_t graphicsQueueFamilyIndex = device->queueFamilyIndices.graphics;
+
+		if ((computeQueue == VK_NULL_HANDLE) || (computeQueueFamilyIndex == graphicsQueueFamilyIndex) || (mipLevels < 2)) {
+			VkCommandBuffer commandBuffer = device->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+			record(commandBuffer, image, format, width, height, mipLevels, layerCount, oldLayout, newLayout);
+			device->flushCommandBuffer(commandBuffer, queue, true);
+			releaseResources();
+			return;
+		}
+
+		// Async compute: The base level is released by the graphics queue family and acquired by the compute queue family
+		// All levels are handed back once generation is done, the other levels don't need a transfer as their content is discarded
+		const VkImageSubresourceRange baseLevel = levelRange(0, 1, layerCount);
+		const VkImageSubresourceRange allLevels = levelRange(0, mipLevels, layerCount);
+
+		VkCommandBuffer releaseCmd = device->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+		insertBarrier(releaseCmd, image, baseLevel, oldLayout, VK_IMAGE_LAYOUT_GENERAL, VK_ACCESS_MEMORY_WRITE_BIT, 0, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, graphicsQueueFamilyIndex, computeQueueFamilyIndex);
+		VK_CHECK_RESULT(vkEndCommandBuffer(releaseCmd));
+
+		VkCommandBuffer computeCmd = device->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, computeCommandPool, true);
+		insertBarrier(computeCmd, image, baseLevel, oldLayout, VK_IMAGE_LAYOUT_GENERAL, 0, VK_ACCESS_SHADER_READ_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, graphicsQueueFamilyIndex, computeQueueFamilyIndex);
+		insertBarrier(computeCmd, image, levelRange(1, mipLevels - 1, layerCount), VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL, 0, VK_ACCESS_SHADER_WRITE_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+		recordDispatches(computeCmd, image, format, width, height, mipLevels, layerCount);
+		insertBarrier(computeCmd, image, allLevels, VK_IMAGE_LAYOUT_GENERAL, newLayout, VK_ACCESS_SHADER_WRITE_BIT, 0, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, computeQueueFamilyIndex, graphicsQueueFamilyIndex);
+		VK_CHECK_RESULT(vkEndCommandBuffer(computeCmd));
+
+		VkCommandBuffer acquireCmd = device->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+		insertBarrier(acquireCmd, image, allLevels, VK_IMAGE_LAYOUT_GENERAL, newLayout, 0, VK_ACCESS_MEMORY_READ_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, computeQueueFamilyIndex, graphicsQueueFamilyIndex);
+		VK_CHECK_RESULT(vkEndCommandBuffer(acquireCmd));
+
+		VkSemaphore semaphores[2];
+		VkSemaphoreCreateInfo semaphoreCI = vks::initializers::semaphoreCreateInfo();
+		VK_CHECK_RESULT(vkCreateSemaphore(device->logicalDevice, &semaphoreCI, nullptr, &semaphores[0]));
+		VK_CHECK_RESULT(vkCreateSemaphore(device->logicalDevice, &semaphoreCI, nullptr, &semaphores[1]));
+		VkFenceCreateInfo fenceCI = vks::initializers::fenceCreateInfo();
+		VkFence fence;
+		VK_CHECK_RESULT(vkCreateFence(device->logicalDevice, &fenceCI, nullptr, &fence));
+
+		const VkPipelineStageFlags computeWaitStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+		const VkPipelineStageFlags acquireWaitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+		VkSubmitInfo submitInfo = vks::initializers::submitInfo();
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers = &releaseCmd;
+		submitInfo.signalSemaphoreCount = 1;
+		submitInfo.pSignalSemaphores = &semaphores[0];
+		VK_CHECK_RESULT(vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE));
+
+		submitInfo.pCommandBuffers = &computeCmd;
+		submitInfo.waitSemaphoreCount = 1;
+		submitInfo.pWaitSemaphores = &semaphores[0];
+		submitInfo.pWaitDstStageMask = &computeWaitStage;
+		submitInfo.pSignalSemaphores = &semaphores[1];
+		VK_CHECK_RESULT(vkQueueSubmit(computeQueue, 1, &submitInfo, VK_NULL_HANDLE));
+
+		submitInfo.pCommandBuffers = &acquireCmd;
+		submitInfo.pWaitSemaphores = &semaphores[1];
+		submitInfo.pWaitDstStageMask = &acquireWaitStage;
+		submitInfo.signalSemaphoreCount = 0;
+		submitInfo.pSignalSemaphores = nullptr;
+		VK_CHECK_RESULT(vkQueueSubmit(queue, 1, &submitInfo, fence));
+
+		VK_CHECK_RESULT(vkWaitForFences(device->logicalDevice, 1, &fence, VK_TRUE, DEFAULT_FENCE_TIMEOUT));
+
+		vkDestroyFence(device->logicalDevice, fence, nullptr);
+		vkDestroySemaphore(device->logicalDevice, semaphores[0], nullptr);
+		vkDestroySemaphore(device->logicalDevice, semaphores[1], nullptr);
+		VkCommandBuffer graphicsCommandBuffers[2] = { releaseCmd, acquireCmd };
+		vkFreeCommandBuffers(device->logicalDevice, device->commandPool, 2, graphicsCommandBuffers);
+		vkFreeCommandBuffers(device->logicalDevice, computeCommandPool, 1, &computeCmd);
+		releaseResources();
+	}
+
+	void MipGenerator::releaseResources()
+	{
+		for (auto &resources : pendingResources) {
+			for (auto view : resources.views) {
+				vkDestroyImageView(device->logicalDevice, view, nullptr);
+			}
+			vkDestroyDescriptorPool(device->logicalDevice, resources.descriptorPool, nullptr);
+		}
+		pendingResources.clear();
+	}
+}
@@ -0,0 +1,128 @@
+/*
+* Compute shader based mip chain generation
+*
+* Downsamples up to six levels per dispatch using workgroup shared memory instead of blitting one level at a time
+* Images need to be created with storage and sampled usage, sRGB images also need the mutable format flag as they are written through a UNORM view
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "vulkan/vulkan.h"
+#include "VulkanDevice.h"
+#include "VulkanTools.h"
+
+#if defined(__ANDROID__)
+#include "VulkanAndroid.h"
+#endif
+
+namespace vks
+{
+	class MipGenerator
+	{
+	public:
+		enum class Filter : uint32_t
+		{
+			/** @brief Average of the four source texels */
+			Box = 0,
+			/** @brief Minimum of the four source texels (e.g. for conservative depth pyramids) */
+			Min = 1,
+			/** @brief Maximum of the four source texels */
+			Max = 2
+		};
+
+		/** @brief Number of levels generated by a single dispatch (limited by the shared memory tile size) */
+		static const uint32_t levelsPerDispatch = 6;
+
+		vks::VulkanDevice *device = nullptr;
+
+		/** @brief Reduction applied when generating the levels (for custom filters pass a shader with the same interface to create) */
+		Filter filter = Filter::Box;
+		/** @brief Filter in linear space for image data that is sRGB encoded (always done for sRGB formats) */
+		bool srgb = false;
+
+		/**
+		* Create the compute pipeline
+		*
+		* @param device Device to create the pipeline on
+		* @param pipelineCache Pipeline cache to use (can be VK_NULL_HANDLE)
+		* @param shaderFile SPIR-V file of the downsampling compute shader (usually base/mipgen.comp.spv from the shaders path)
+		*/
+		void create(vks::VulkanDevice *device, VkPipelineCache pipelineCache, const std::string &shaderFile);
+		void destroy();
+
+		/**
+		* Use a dedicated compute queue for generate, level ownership is transferred from and back to the graphics queue family
+		*
+		* @param queue Queue to run the dispatches on
+		* @param queueFamilyIndex Family of the queue, if this matches the graphics queue family no ownership transfer is done
+		*/
+		void setComputeQueue(VkQueue queue, uint32_t queueFamilyIndex);
+
+		/** @brief Returns true if mips for images of the given format can be generated on this device */
+		bool isSupported(VkFormat format) const;
+
+		/**
+		* Record the generation of all mip levels from the base level into an existing command buffer
+		* The command buffer must be executed on a queue of the family that owns the image
+		*
+		* @param commandBuffer Command buffer to record into
+		* @param image Image with at least the base level filled
+		* @param format Format the image was created with
+		* @param width Width of the base level
+		* @param height Height of the base level
+		* @param mipLevels Number of mip levels of the image
+		* @param layerCount Number of array layers of the image (each layer gets it's own mip chain)
+		* @param oldLayout Current layout of the base level (the content of all other levels is discarded)
+		* @param newLayout Layout all levels will be transitioned to after generation
+		*
+		* @note Resources used by the recorded commands are kept until releaseResources is called after the command buffer has finished execution
+		*/
+		void record(VkCommandBuffer commandBuffer, VkImage image, VkFormat format, uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t layerCount, VkImageLayout oldLayout, VkImageLayout newLayout);
+
+		/**
+		* Generate all mip levels and wait for completion
+		*
+		* @param queue Graphics queue that owns the image, also used for the dispatches unless a separate compute queue has been set
+		*
+		* @note See record for the other parameters
+		*/
+		void generate(VkQueue queue, VkImage image, VkFormat format, uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t layerCount, VkImageLayout oldLayout, VkImageLayout newLayout);
+
+		/** @brief Free image views and descriptors of previously recorded generations */
+		void releaseResources();
+
+	private:
+		struct PushConstBlock
+		{
+			int32_t sourceSize[2];
+			uint32_t levelCount;
+			uint32_t filterMode;
+			uint32_t srgb;
+		};
+
+		// Per-generation resources that need to stay alive until the commands have been executed
+		struct Resources
+		{
+			VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+			std::vector<VkImageView> views;
+		};
+
+		VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
+		VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+		VkPipeline pipeline = VK_NULL_HANDLE;
+		std::vector<Resources> pendingResources;
+
+		VkQueue computeQueue = VK_NULL_HANDLE;
+		uint32_t computeQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		VkCommandPool computeCommandPool = VK_NULL_HANDLE;
+
+		void recordDispatches(VkCommandBuffer commandBuffer, VkImage image, VkFormat format, uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t layerCount);
+	};
+}
@@ -0,0 +1,102 @@
+/*
+* Vulkan object counters
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "VulkanObjectCounters.h"
+#include "VulkanTools.h"
+
+#include <atomic>
+#include <chrono>
+
+namespace vks
+{
+	namespace
+	{
+		// Pipelines may be created from multiple threads
+		std::atomic<uint32_t> graphicsPipelines(0);
+		std::atomic<uint32_t> computePipelines(0);
+		std::atomic<uint32_t> livePipelines(0);
+		std::atomic<uint32_t> peakLivePipelines(0);
+		std::atomic<uint32_t> descriptorSets(0);
+		std::atomic<uint64_t> pipelineCreationNanoseconds(0);
+
+#if !defined(VKS_OBJECT_COUNTERS_DISABLED)
+		void addPipelines(std::atomic<uint32_t> &counter, uint32_t count, const VkPipeline *pipelines, std::chrono::steady_clock::time_point start)
+		{
+			pipelineCreationNanoseconds += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+			// Pipelines that failed to be created are set to VK_NULL_HANDLE
+			uint32_t created = 0;
+			for (uint32_t i = 0; i < count; i++) {
+				if (pipelines[i] != VK_NULL_HANDLE) {
+					created++;
+				}
+			}
+			counter += created;
+			const uint32_t live = (livePipelines += created);
+			uint32_t peak = peakLivePipelines.load();
+			while ((live > peak) && !peakLivePipelines.compare_exchange_weak(peak, live)) {}
+		}
+#endif
+	}
+
+	ObjectCounters::Counts ObjectCounters::get()
+	{
+		Counts counts;
+		counts.graphicsPipelines = graphicsPipelines.load();
+		counts.computePipelines = computePipelines.load();
+		counts.livePipelines = livePipelines.load();
+		counts.peakLivePipelines = peakLivePipelines.load();
+		counts.descriptorSets = descriptorSets.load();
+		counts.pipelineCreationTime = pipelineCreationNanoseconds.load() / 1000000.0;
+		return counts;
+	}
+
+	VkResult ObjectCounters::createGraphicsPipelines(VkDevice device, VkPipelineCache pipelineCache, uint32_t createInfoCount, const VkGraphicsPipelineCreateInfo *pCreateInfos, const VkAllocationCallbacks *pAllocator, VkPipeline *pPipelines)
+	{
+#if defined(VKS_OBJECT_COUNTERS_DISABLED)
+		return vkCreateGraphicsPipelines(device, pipelineCache, createInfoCount, pCreateInfos, pAllocator, pPipelines);
+#else
+		const auto start = std::chrono::steady_clock::now();
+		VkResult result = vkCreateGraphicsPipelines(device, pipelineCache, createInfoCount, pCreateInfos, pAllocator, pPipelines);
+		addPipelines(graphicsPipelines, createInfoCount, pPipelines, start);
+		return result;
+#endif
+	}
+
+	VkResult ObjectCounters::createComputePipelines(VkDevice device, VkPipelineCache pipelineCache, uint32_t createInfoCount, const VkComputePipelineCreateInfo *pCreateInfos, const VkAllocationCallbacks *pAllocator, VkPipeline *pPipelines)
+	{
+#if defined(VKS_OBJECT_COUNTERS_DISABLED)
+		return vkCreateComputePipelines(device, pipelineCache, createInfoCount, pCreateInfos, pAllocator, pPipelines);
+#else
+		const auto start = std::chrono::steady_clock::now();
+		VkResult result = vkCreateComputePipelines(device, pipelineCache, createInfoCount, pCreateInfos, pAllocator, pPipelines);
+		addPipelines(computePipelines, createInfoCount, pPipelines, start);
+		return result;
+#endif
+	}
+
+	void ObjectCounters::destroyPipeline(VkDevice device, VkPipeline pipeline, const VkAllocationCallbacks *pAllocator)
+	{
+#if !defined(VKS_OBJECT_COUNTERS_DISABLED)
+		if (pipeline != VK_NULL_HANDLE) {
+			livePipelines--;
+		}
+#endif
+		vkDestroyPipeline(device, pipeline, pAllocator);
+	}
+
+	VkResult ObjectCounters::allocateDescriptorSets(VkDevice device, const VkDescriptorSetAllocateInfo *pAllocateInfo, VkDescriptorSet *pDescriptorSets)
+	{
+		VkResult result = vkAllocateDescriptorSets(device, pAllocateInfo, pDescriptorSets);
+#if !defined(VKS_OBJECT_COUNTERS_DISABLED)
+		if (result == VK_SUCCESS) {
+			descriptorSets += pAllocateInfo->descriptorSetCount;
+		}
+#endif
+		return result;
+	}
+}
@@ -0,0 +1,44 @@
+/*
+* Vulkan object counters
+*
+* Counts the pipelines and descriptor sets created by the framework and the examples, along with the time spent creating pipelines
+* The framework and the examples create and destroy pipelines and allocate descriptor sets through these functions instead of the Vulkan functions,
+* defining VKS_OBJECT_COUNTERS_DISABLED makes them call the Vulkan functions without counting
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include "vulkan/vulkan.h"
+
+namespace vks
+{
+	class ObjectCounters
+	{
+	public:
+		struct Counts
+		{
+			uint32_t graphicsPipelines = 0;
+			uint32_t computePipelines = 0;
+			/** @brief Pipelines that have been created but not destroyed yet */
+			uint32_t livePipelines = 0;
+			uint32_t peakLivePipelines = 0;
+			/** @brief Descriptor sets allocated (sets are usually freed along with their pool, so there is no live count) */
+			uint32_t descriptorSets = 0;
+			/** @brief Time spent in pipeline creation in milliseconds (summed over all threads) */
+			double pipelineCreationTime = 0.0;
+		};
+
+		static Counts get();
+
+		static VkResult createGraphicsPipelines(VkDevice device, VkPipelineCache pipelineCache, uint32_t createInfoCount, const VkGraphicsPipelineCreateInfo *pCreateInfos, const VkAllocationCallbacks *pAllocator, VkPipeline *pPipelines);
+		static VkResult createComputePipelines(VkDevice device, VkPipelineCache pipelineCache, uint32_t createInfoCount, const VkComputePipelineCreateInfo *pCreateInfos, const VkAllocationCallbacks *pAllocator, VkPipeline *pPipelines);
+		static void destroyPipeline(VkDevice device, VkPipeline pipeline, const VkAllocationCallbacks *pAllocator);
+		static VkResult allocateDescriptorSets(VkDevice device, const VkDescriptorSetAllocateInfo *pAllocateInfo, VkDescriptorSet *pDescriptorSets);
+	};
+}
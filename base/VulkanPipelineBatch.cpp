@@ -0,0 +1,169 @@
+/*
+* Pipeline batch builder
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "VulkanPipelineBatch.h"
+#include "VulkanTools.h"
+#include "VulkanCpuProfiler.h"
+#include "VulkanObjectCounters.h"
+
+namespace vks
+{
+	namespace
+	{
+		template<typename T>
+		void copyArray(const T *source, uint32_t count, std::vector<T> &target)
+		{
+			if (source) {
+				target.assign(source, source + count);
+			}
+		}
+	}
+
+	PipelineBatch::PipelineBatch(VkDevice device, VkPipelineCache pipelineCache, vks::JobSystem *jobSystem) : device(device), pipelineCache(pipelineCache), jobSystem(jobSystem)
+	{
+	}
+
+	void PipelineBatch::copyShaderStage(const VkPipelineShaderStageCreateInfo &source, ShaderStage &stage)
+	{
+		stage.createInfo = source;
+		stage.name = source.pName;
+		stage.createInfo.pName = stage.name.c_str();
+		if (source.pSpecializationInfo) {
+			stage.specializationInfo = *source.pSpecializationInfo;
+			copyArray(source.pSpecializationInfo->pMapEntries, source.pSpecializationInfo->mapEntryCount, stage.mapEntries);
+			const uint8_t *data = static_cast<const uint8_t*>(source.pSpecializationInfo->pData);
+			copyArray(data, static_cast<uint32_t>(source.pSpecializationInfo->dataSize), stage.data);
+			stage.specializationInfo.pMapEntries = stage.mapEntries.data();
+			stage.specializationInfo.pData = stage.data.data();
+			stage.createInfo.pSpecializationInfo = &stage.specializationInfo;
+		}
+	}
+
+	void PipelineBatch::add(const VkGraphicsPipelineCreateInfo &createInfo, VkPipeline *pipeline)
+	{
+		std::unique_ptr<GraphicsPipeline> copy(new GraphicsPipeline());
+		GraphicsPipeline &target = *copy;
+		target.createInfo = createInfo;
+		target.pipeline = pipeline;
+		target.result = VK_NOT_READY;
+
+		// Sized up front, so the stages (and the pointers into them) don't move while copying
+		target.stages.resize(createInfo.stageCount);
+		target.stageCreateInfos.resize(createInfo.stageCount);
+		for (uint32_t i = 0; i < createInfo.stageCount; i++) {
+			copyShaderStage(createInfo.pStages[i], target.stages[i]);
+			target.stageCreateInfos[i] = target.stages[i].createInfo;
+		}
+		target.createInfo.pStages = target.stageCreateInfos.data();
+
+		if (createInfo.pVertexInputState) {
+			target.vertexInputState = *createInfo.pVertexInputState;
+			copyArray(createInfo.pVertexInputState->pVertexBindingDescriptions, createInfo.pVertexInputState->vertexBindingDescriptionCount, target.vertexBindings);
+			copyArray(createInfo.pVertexInputState->pVertexAttributeDescriptions, createInfo.pVertexInputState->vertexAttributeDescriptionCount, target.vertexAttributes);
+			target.vertexInputState.pVertexBindingDescriptions = target.vertexBindings.data();
+			target.vertexInputState.pVertexAttributeDescriptions = target.vertexAttributes.data();
+			target.createInfo.pVertexInputState = &target.vertexInputState;
+		}
+		if (createInfo.pInputAssemblyState) {
+			target.inputAssemblyState = *createInfo.pInputAssemblyState;
+			target.createInfo.pInputAssemblyState = &target.inputAssemblyState;
+		}
+		if (createInfo.pTessellationState) {
+			target.tessellationState = *createInfo.pTessellationState;
+			target.createInfo.pTessellationState = &target.tessellationState;
+		}
+		if (createInfo.pViewportState) {
+			// Viewports and scissors are usually dynamic, in which case there are no arrays to copy
+			target.viewportState = *createInfo.pViewportState;
+			copyArray(createInfo.pViewportState->pViewports, createInfo.pViewportState->viewportCount, target.viewports);
+			copyArray(createInfo.pViewportState->pScissors, createInfo.pViewportState->scissorCount, target.scissors);
+			target.viewportState.pViewports = createInfo.pViewportState->pViewports ? target.viewports.data() : nullptr;
+			target.viewportState.pScissors = createInfo.pViewportState->pScissors ? target.scissors.data() : nullptr;
+			target.createInfo.pViewportState = &target.viewportState;
+		}
+		if (createInfo.pRasterizationState) {
+			target.rasterizationState = *createInfo.pRasterizationState;
+			target.createInfo.pRasterizationState = &target.rasterizationState;
+		}
+		if (createInfo.pMultisampleState) {
+			target.multisampleState = *createInfo.pMultisampleState;
+			if (createInfo.pMultisampleState->pSampleMask) {
+				// One mask word per 32 samples
+				copyArray(createInfo.pMultisampleState->pSampleMask, (static_cast<uint32_t>(createInfo.pMultisampleState->rasterizationSamples) + 31) / 32, target.sampleMask);
+				target.multisampleState.pSampleMask = target.sampleMask.data();
+			}
+			target.createInfo.pMultisampleState = &target.multisampleState;
+		}
+		if (createInfo.pDepthStencilState) {
+			target.depthStencilState = *createInfo.pDepthStencilState;
+			target.createInfo.pDepthStencilState = &target.depthStencilState;
+		}
+		if (createInfo.pColorBlendState) {
+			target.colorBlendState = *createInfo.pColorBlendState;
+			copyArray(createInfo.pColorBlendState->pAttachments, createInfo.pColorBlendState->attachmentCount, target.blendAttachments);
+			target.colorBlendState.pAttachments = target.blendAttachments.data();
+			target.createInfo.pColorBlendState = &target.colorBlendState;
+		}
+		if (createInfo.pDynamicState) {
+			target.dynamicState = *createInfo.pDynamicState;
+			copyArray(createInfo.pDynamicState->pDynamicStates, createInfo.pDynamicState->dynamicStateCount, target.dynamicStates);
+			target.dynamicState.pDynamicStates = target.dynamicStates.data();
+			target.createInfo.pDynamicState = &target.dynamicState;
+		}
+
+		graphicsPipelines.push_back(std::move(copy));
+	}
+
+	void PipelineBatch::add(const VkComputePipelineCreateInfo &createInfo, VkPipeline *pipeline)
+	{
+		std::unique_ptr<ComputePipeline> copy(new ComputePipeline());
+		copy->createInfo = createInfo;
+		copy->pipeline = pipeline;
+		copy->result = VK_NOT_READY;
+		copyShaderStage(createInfo.stage, copy->stage);
+		copy->createInfo.stage = copy->stage.createInfo;
+		computePipelines.push_back(std::move(copy));
+	}
+
+	uint32_t PipelineBatch::size() const
+	{
+		return static_cast<uint32_t>(graphicsPipelines.size() + computePipelines.size());
+	}
+
+	void PipelineBatch::build()
+	{
+		VKS_PROFILE_ZONE("vks::PipelineBatch::build");
+		const uint32_t graphicsCount = static_cast<uint32_t>(graphicsPipelines.size());
+		// Every pipeline is a job of it's own, as a single pipeline can take several milliseconds to compile
+		auto createPipelines = [&](uint32_t begin, uint32_t end) {
+			for (uint32_t i = begin; i < end; i++) {
+				if (i < graphicsCount) {
+					GraphicsPipeline &pipeline = *graphicsPipelines[i];
+					pipeline.result = vks::ObjectCounters::createGraphicsPipelines(device, pipelineCache, 1, &pipeline.createInfo, nullptr, pipeline.pipeline);
+				} else {
+					ComputePipeline &pipeline = *computePipelines[i - graphicsCount];
+					pipeline.result = vks::ObjectCounters::createComputePipelines(device, pipelineCache, 1, &pipeline.createInfo, nullptr, pipeline.pipeline);
+				}
+			}
+		};
+		if (jobSystem) {
+			jobSystem->parallelFor(size(), 1, createPipelines);
+		} else {
+			createPipelines(0, size());
+		}
+
+		for (auto &pipeline : graphicsPipelines) {
+			VK_CHECK_RESULT(pipeline->result);
+		}
+		for (auto &pipeline : computePipelines) {
+			VK_CHECK_RESULT(pipeline->result);
+		}
+		graphicsPipelines.clear();
+		computePipelines.clear();
+	}
+}
@@ -0,0 +1,105 @@
+/*
+* Pipeline batch builder
+*
+* Collects graphics and compute pipeline create infos and creates the pipelines in parallel on a job system, sharing one pipeline cache
+* Create infos are copied when they are added, so the usual pattern of changing a few states between two pipelines works the same as with
+* vkCreateGraphicsPipelines, the handles are written once build has been called
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "vulkan/vulkan.h"
+#include "VulkanJobSystem.h"
+
+namespace vks
+{
+	class PipelineBatch
+	{
+	public:
+		/**
+		* @param device Device the pipelines are created on
+		* @param pipelineCache Pipeline cache used for all pipelines of the batch (can be VK_NULL_HANDLE)
+		* @param jobSystem Job system (already started) the pipelines are created on, if null they are created on the calling thread
+		*/
+		PipelineBatch(VkDevice device, VkPipelineCache pipelineCache, vks::JobSystem *jobSystem);
+
+		/**
+		* Add a graphics pipeline to the batch
+		*
+		* @param createInfo Create info of the pipeline, it's states, shader stages and specialization data are copied
+		* @param pipeline Handle the created pipeline is written to by build
+		*
+		* @note pNext chains are not copied and must stay valid until build, the same goes for base pipelines of derivatives (which can't be part of the same batch)
+		*/
+		void add(const VkGraphicsPipelineCreateInfo &createInfo, VkPipeline *pipeline);
+		/** @brief Add a compute pipeline to the batch, see the graphics pipeline variant for details */
+		void add(const VkComputePipelineCreateInfo &createInfo, VkPipeline *pipeline);
+
+		/** @brief Number of pipelines added since the last build */
+		uint32_t size() const;
+
+		/** @brief Create all pipelines added since the last build and wait for them, all of them are created before failures are reported */
+		void build();
+
+	private:
+		// Copy of a shader stage and the data it points to
+		struct ShaderStage
+		{
+			VkPipelineShaderStageCreateInfo createInfo;
+			std::string name;
+			VkSpecializationInfo specializationInfo;
+			std::vector<VkSpecializationMapEntry> mapEntries;
+			std::vector<uint8_t> data;
+		};
+
+		// Copy of a graphics pipeline create info and all states it points to, created on the heap so the internal pointers stay valid
+		struct GraphicsPipeline
+		{
+			VkGraphicsPipelineCreateInfo createInfo;
+			std::vector<ShaderStage> stages;
+			std::vector<VkPipelineShaderStageCreateInfo> stageCreateInfos;
+			VkPipelineVertexInputStateCreateInfo vertexInputState;
+			std::vector<VkVertexInputBindingDescription> vertexBindings;
+			std::vector<VkVertexInputAttributeDescription> vertexAttributes;
+			VkPipelineInputAssemblyStateCreateInfo inputAssemblyState;
+			VkPipelineTessellationStateCreateInfo tessellationState;
+			VkPipelineViewportStateCreateInfo viewportState;
+			std::vector<VkViewport> viewports;
+			std::vector<VkRect2D> scissors;
+			VkPipelineRasterizationStateCreateInfo rasterizationState;
+			VkPipelineMultisampleStateCreateInfo multisampleState;
+			std::vector<VkSampleMask> sampleMask;
+			VkPipelineDepthStencilStateCreateInfo depthStencilState;
+			VkPipelineColorBlendStateCreateInfo colorBlendState;
+			std::vector<VkPipelineColorBlendAttachmentState> blendAttachments;
+			VkPipelineDynamicStateCreateInfo dynamicState;
+			std::vector<VkDynamicState> dynamicStates;
+			VkPipeline *pipeline;
+			VkResult result;
+		};
+
+		struct ComputePipeline
+		{
+			VkComputePipelineCreateInfo createInfo;
+			ShaderStage stage;
+			VkPipeline *pipeline;
+			VkResult result;
+		};
+
+		VkDevice device;
+		VkPipelineCache pipelineCache;
+		vks::JobSystem *jobSystem;
+		std::vector<std::unique_ptr<GraphicsPipeline>> graphicsPipelines;
+		std::vector<std::unique_ptr<ComputePipeline>> computePipelines;
+
+		static void copyShaderStage(const VkPipelineShaderStageCreateInfo &source, ShaderStage &stage);
+	};
+}
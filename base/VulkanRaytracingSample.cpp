@@ -48,7 +48,7 @@ VulkanRaytracingSample::ScratchBuffer VulkanRaytracingSample::createScratchBuffe
 	memoryAllocateInfo.pNext = &memoryAllocateFlagsInfo;
 	memoryAllocateInfo.allocationSize = memoryRequirements.size;
 	memoryAllocateInfo.memoryTypeIndex = vulkanDevice->getMemoryType(memoryRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-	VK_CHECK_RESULT(vkAllocateMemory(vulkanDevice->logicalDevice, &memoryAllocateInfo, nullptr, &scratchBuffer.memory));
+	VK_CHECK_RESULT(vulkanDevice->allocateMemory(memoryAllocateInfo, &scratchBuffer.memory, vks::MemoryCategory::AccelerationStructure, "Acceleration structure scratch buffer"));
 	VK_CHECK_RESULT(vkBindBufferMemory(vulkanDevice->logicalDevice, scratchBuffer.handle, scratchBuffer.memory, 0));
 	// Buffer device address
 	VkBufferDeviceAddressInfoKHR bufferDeviceAddresInfo{};
@@ -61,7 +61,7 @@ VulkanRaytracingSample::ScratchBuffer VulkanRaytracingSample::createScratchBuffe
 void VulkanRaytracingSample::deleteScratchBuffer(ScratchBuffer& scratchBuffer)
 {
 	if (scratchBuffer.memory != VK_NULL_HANDLE) {
-		vkFreeMemory(vulkanDevice->logicalDevice, scratchBuffer.memory, nullptr);
+		vulkanDevice->freeMemory(scratchBuffer.memory);
 	}
 	if (scratchBuffer.handle != VK_NULL_HANDLE) {
 		vkDestroyBuffer(vulkanDevice->logicalDevice, scratchBuffer.handle, nullptr);
@@ -86,7 +86,7 @@ void VulkanRaytracingSample::createAccelerationStructure(AccelerationStructure&
 	memoryAllocateInfo.pNext = &memoryAllocateFlagsInfo;
 	memoryAllocateInfo.allocationSize = memoryRequirements.size;
 	memoryAllocateInfo.memoryTypeIndex = vulkanDevice->getMemoryType(memoryRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-	VK_CHECK_RESULT(vkAllocateMemory(vulkanDevice->logicalDevice, &memoryAllocateInfo, nullptr, &accelerationStructure.memory));
+	VK_CHECK_RESULT(vulkanDevice->allocateMemory(memoryAllocateInfo, &accelerationStructure.memory, vks::MemoryCategory::AccelerationStructure));
 	VK_CHECK_RESULT(vkBindBufferMemory(vulkanDevice->logicalDevice, accelerationStructure.buffer, accelerationStructure.memory, 0));
 	// Acceleration structure
 	VkAccelerationStructureCreateInfoKHR accelerationStructureCreate_info{};
@@ -104,7 +104,7 @@ void VulkanRaytracingSample::createAccelerationStructure(AccelerationStructure&
 
 void VulkanRaytracingSample::deleteAccelerationStructure(AccelerationStructure& accelerationStructure)
 {
-	vkFreeMemory(device, accelerationStructure.memory, nullptr);
+	vulkanDevice->freeMemory(accelerationStructure.memory);
 	vkDestroyBuffer(device, accelerationStructure.buffer, nullptr);
 	vkDestroyAccelerationStructureKHR(device, accelerationStructure.handle, nullptr);
 }
@@ -123,7 +123,7 @@ void VulkanRaytracingSample::createStorageImage(VkFormat format, VkExtent3D exte
 	if (storageImage.image != VK_NULL_HANDLE) {
 		vkDestroyImageView(device, storageImage.view, nullptr);
 		vkDestroyImage(device, storageImage.image, nullptr);
-		vkFreeMemory(device, storageImage.memory, nullptr);
+		vulkanDevice->freeMemory(storageImage.memory);
 		storageImage = {};
 	}
 
@@ -144,7 +144,7 @@ void VulkanRaytracingSample::createStorageImage(VkFormat format, VkExtent3D exte
 	VkMemoryAllocateInfo memoryAllocateInfo = vks::initializers::memoryAllocateInfo();
 	memoryAllocateInfo.allocationSize = memReqs.size;
 	memoryAllocateInfo.memoryTypeIndex = vulkanDevice->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-	VK_CHECK_RESULT(vkAllocateMemory(vulkanDevice->logicalDevice, &memoryAllocateInfo, nullptr, &storageImage.memory));
+	VK_CHECK_RESULT(vulkanDevice->allocateMemory(memoryAllocateInfo, &storageImage.memory, vks::MemoryCategory::RenderTarget, "Ray tracing storage image"));
 	VK_CHECK_RESULT(vkBindImageMemory(vulkanDevice->logicalDevice, storageImage.image, storageImage.memory, 0));
 
 	VkImageViewCreateInfo colorImageView = vks::initializers::imageViewCreateInfo();
@@ -171,7 +171,7 @@ void VulkanRaytracingSample::deleteStorageImage()
 {
 	vkDestroyImageView(vulkanDevice->logicalDevice, storageImage.view, nullptr);
 	vkDestroyImage(vulkanDevice->logicalDevice, storageImage.image, nullptr);
-	vkFreeMemory(vulkanDevice->logicalDevice, storageImage.memory, nullptr);
+	vulkanDevice->freeMemory(storageImage.memory);
 }
 
 void VulkanRaytracingSample::prepare()
@@ -0,0 +1,677 @@
+/*
+* Vulkan render graph
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "VulkanRenderGraph.h"
+#include "VulkanCpuProfiler.h"
+#include "VulkanDebug.h"
+#include "VulkanTools.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace vks
+{
+	namespace
+	{
+		const VkAccessFlags writeAccessFlags = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+
+		bool isDepthFormat(VkFormat format)
+		{
+			switch (format) {
+			case VK_FORMAT_D16_UNORM:
+			case VK_FORMAT_X8_D24_UNORM_PACK32:
+			case VK_FORMAT_D32_SFLOAT:
+			case VK_FORMAT_D16_UNORM_S8_UINT:
+			case VK_FORMAT_D24_UNORM_S8_UINT:
+			case VK_FORMAT_D32_SFLOAT_S8_UINT:
+				return true;
+			default:
+				return false;
+			}
+		}
+
+		bool isStencilFormat(VkFormat format)
+		{
+			switch (format) {
+			case VK_FORMAT_S8_UINT:
+			case VK_FORMAT_D16_UNORM_S8_UINT:
+			case VK_FORMAT_D24_UNORM_S8_UINT:
+			case VK_FORMAT_D32_SFLOAT_S8_UINT:
+				return true;
+			default:
+				return false;
+			}
+		}
+
+		VkAccessFlags colorAttachmentAccess(VkAttachmentLoadOp loadOp)
+		{
+			return VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | ((loadOp == VK_ATTACHMENT_LOAD_OP_LOAD) ? VK_ACCESS_COLOR_ATTACHMENT_READ_BIT : 0);
+		}
+
+		const VkPipelineStageFlags depthStencilStages = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+		const VkAccessFlags depthStencilAccess = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+	}
+
+	RenderGraph::RenderGraph(vks::VulkanDevice *device)
+	{
+		assert(device);
+		this->device = device;
+	}
+
+	RenderGraph::~RenderGraph()
+	{
+		release();
+	}
+
+	/**
+	* Declare an image of the graph
+	*
+	* @param name Debug name of the image
+	* @param width Width of the image
+	* @param height Height of the image
+	* @param format Format of the image, depth/stencil formats can only be used as depth/stencil attachments
+	* @param layers Number of array layers, passes render to a single layer while sampling covers all of them
+	*
+	* @return Handle of the image within the graph
+	*/
+	uint32_t RenderGraph::addImage(const std::string &name, uint32_t width, uint32_t height, VkFormat format, uint32_t layers)
+	{
+		assert(layers > 0);
+		Image image;
+		image.name = name;
+		image.width = width;
+		image.height = height;
+		image.format = format;
+		image.layers = layers;
+		images.push_back(image);
+		return static_cast<uint32_t>(images.size() - 1);
+	}
+
+	void RenderGraph::setImageExtent(uint32_t image, uint32_t width, uint32_t height)
+	{
+		assert(image < images.size());
+		images[image].width = width;
+		images[image].height = height;
+	}
+
+	uint32_t RenderGraph::addPass(const std::string &name, RecordFunction record)
+	{
+		Pass pass;
+		pass.name = name;
+		pass.record = record;
+		passes.push_back(pass);
+		return static_cast<uint32_t>(passes.size() - 1);
+	}
+
+	void RenderGraph::addColorAttachment(uint32_t pass, uint32_t image, VkAttachmentLoadOp loadOp, VkClearColorValue clearColor, uint32_t layer)
+	{
+		assert((pass < passes.size()) && (image < images.size()) && (layer < images[image].layers));
+		assert(!isDepthFormat(images[image].format) && !isStencilFormat(images[image].format));
+		Attachment attachment;
+		attachment.image = image;
+		attachment.layer = layer;
+		attachment.loadOp = loadOp;
+		attachment.clearValue.color = clearColor;
+		passes[pass].colorAttachments.push_back(attachment);
+	}
+
+	void RenderGraph::setDepthStencilAttachment(uint32_t pass, uint32_t image, VkAttachmentLoadOp loadOp, VkClearDepthStencilValue clearValue, uint32_t layer)
+	{
+		assert((pass < passes.size()) && (image < images.size()) && (layer < images[image].layers));
+		assert(isDepthFormat(images[image].format) || isStencilFormat(images[image].format));
+		passes[pass].hasDepthStencil = true;
+		passes[pass].depthStencilAttachment.image = image;
+		passes[pass].depthStencilAttachment.layer = layer;
+		passes[pass].depthStencilAttachment.loadOp = loadOp;
+		passes[pass].depthStencilAttachment.clearValue.depthStencil = clearValue;
+	}
+
+	void RenderGraph::addSampledImage(uint32_t pass, uint32_t image, VkPipelineStageFlags stageMask)
+	{
+		assert((pass < passes.size()) && (image < images.size()));
+		SampledImage sampledImage;
+		sampledImage.image = image;
+		sampledImage.stageMask = stageMask;
+		passes[pass].sampledImages.push_back(sampledImage);
+	}
+
+	void RenderGraph::addOutput(uint32_t image, VkPipelineStageFlags stageMask)
+	{
+		assert(image < images.size());
+		images[image].output = true;
+		images[image].outputStageMask |= stageMask;
+	}
+
+	void RenderGraph::compile()
+	{
+		release();
+		cullPasses();
+		createImages();
+		aliasMemory();
+		deriveBarriers();
+		createRenderPasses();
+	}
+
+	/**
+	* Record the graph's passes
+	*
+	* @param commandBuffer Command buffer to record to, must be in recording state and outside of a render pass
+	*/
+	void RenderGraph::execute(VkCommandBuffer commandBuffer) const
+	{
+		VKS_PROFILE_ZONE("vks::RenderGraph::execute");
+		for (auto &pass : passes) {
+			if (pass.culled) {
+				continue;
+			}
+			if (vks::debugmarker::active) {
+				vks::debugmarker::beginRegion(commandBuffer, pass.name.c_str(), glm::vec4(0.5f, 0.76f, 0.34f, 1.0f));
+			}
+			if (profiler) {
+				profiler->beginScope(commandBuffer, pass.name);
+			}
+			if (!pass.barriers.imageBarriers.empty()) {
+				vkCmdPipelineBarrier(commandBuffer, pass.barriers.srcStageMask, pass.barriers.dstStageMask, 0, 0, nullptr, 0, nullptr, static_cast<uint32_t>(pass.barriers.imageBarriers.size()), pass.barriers.imageBarriers.data());
+			}
+
+			VkRenderPassBeginInfo renderPassBeginInfo = vks::initializers::renderPassBeginInfo();
+			renderPassBeginInfo.renderPass = pass.renderPass;
+			renderPassBeginInfo.framebuffer = pass.frameBuffer;
+			renderPassBeginInfo.renderArea.extent.width = pass.width;
+			renderPassBeginInfo.renderArea.extent.height = pass.height;
+			renderPassBeginInfo.clearValueCount = static_cast<uint32_t>(pass.clearValues.size());
+			renderPassBeginInfo.pClearValues = pass.clearValues.data();
+			vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+			VkViewport viewport = vks::initializers::viewport((float)pass.width, (float)pass.height, 0.0f, 1.0f);
+			vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+			VkRect2D scissor = vks::initializers::rect2D(pass.width, pass.height, 0, 0);
+			vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+			if (pass.record) {
+				pass.record(commandBuffer);
+			}
+
+			vkCmdEndRenderPass(commandBuffer);
+			if (profiler) {
+				profiler->endScope(commandBuffer);
+			}
+			if (vks::debugmarker::active) {
+				vks::debugmarker::endRegion(commandBuffer);
+			}
+		}
+		if (!finalBarriers.imageBarriers.empty()) {
+			vkCmdPipelineBarrier(commandBuffer, finalBarriers.srcStageMask, finalBarriers.dstStageMask, 0, 0, nullptr, 0, nullptr, static_cast<uint32_t>(finalBarriers.imageBarriers.size()), finalBarriers.imageBarriers.data());
+		}
+	}
+
+	void RenderGraph::setProfiler(vks::GpuProfiler *profiler)
+	{
+		this->profiler = profiler;
+	}
+
+	VkImage RenderGraph::getImage(uint32_t image) const
+	{
+		assert(image < images.size());
+		return images[image].image;
+	}
+
+	VkImageView RenderGraph::getImageView(uint32_t image) const
+	{
+		assert(image < images.size());
+		return images[image].view;
+	}
+
+	VkRenderPass RenderGraph::getRenderPass(uint32_t pass) const
+	{
+		assert(pass < passes.size());
+		return passes[pass].renderPass;
+	}
+
+	bool RenderGraph::isPassCulled(uint32_t pass) const
+	{
+		assert(pass < passes.size());
+		return passes[pass].culled;
+	}
+
+	const RenderGraph::Stats &RenderGraph::getStats() const
+	{
+		return stats;
+	}
+
+	void RenderGraph::release()
+	{
+		VkDevice logicalDevice = device->logicalDevice;
+		for (auto &pass : passes) {
+			if (pass.frameBuffer != VK_NULL_HANDLE) {
+				vkDestroyFramebuffer(logicalDevice, pass.frameBuffer, nullptr);
+			}
+			if (pass.renderPass != VK_NULL_HANDLE) {
+				vkDestroyRenderPass(logicalDevice, pass.renderPass, nullptr);
+			}
+			pass.frameBuffer = VK_NULL_HANDLE;
+			pass.renderPass = VK_NULL_HANDLE;
+			pass.culled = false;
+			pass.barriers = Barriers();
+			pass.clearValues.clear();
+		}
+		for (auto &image : images) {
+			for (auto attachmentView : image.attachmentViews) {
+				if (attachmentView != image.view) {
+					vkDestroyImageView(logicalDevice, attachmentView, nullptr);
+				}
+			}
+			if (image.view != VK_NULL_HANDLE) {
+				vkDestroyImageView(logicalDevice, image.view, nullptr);
+			}
+			if (image.image != VK_NULL_HANDLE) {
+				vkDestroyImage(logicalDevice, image.image, nullptr);
+			}
+			image.view = VK_NULL_HANDLE;
+			image.attachmentViews.clear();
+			image.image = VK_NULL_HANDLE;
+			image.used = false;
+			image.usage = 0;
+		}
+		for (auto &slot : memorySlots) {
+			device->freeMemory(slot.memory);
+		}
+		memorySlots.clear();
+		finalBarriers = Barriers();
+		stats = Stats();
+	}
+
+	/** @brief Walk the passes back to front and cull those that neither write an output nor an image read by a later pass */
+	void RenderGraph::cullPasses()
+	{
+		std::vector<bool> needed(images.size(), false);
+		for (size_t i = 0; i < images.size(); i++) {
+			needed[i] = images[i].output;
+		}
+		for (size_t i = passes.size(); i-- > 0;) {
+			Pass &pass = passes[i];
+			// The extent of a pass' render area is taken from it's attachments
+			if (pass.colorAttachments.empty() && !pass.hasDepthStencil) {
+				throw std::runtime_error("Render graph pass \"" + pass.name + "\" has no attachments");
+			}
+			std::vector<const Attachment*> attachments;
+			for (auto &attachment : pass.colorAttachments) {
+				attachments.push_back(&attachment);
+			}
+			if (pass.hasDepthStencil) {
+				attachments.push_back(&pass.depthStencilAttachment);
+			}
+			pass.culled = std::none_of(attachments.begin(), attachments.end(), [&needed](const Attachment *attachment) { return needed[attachment->image]; });
+			if (pass.culled) {
+				stats.culledPassCount++;
+				continue;
+			}
+			// Contents written before this pass are only needed if it loads them or if they are in other layers of the image
+			for (auto attachment : attachments) {
+				needed[attachment->image] = (attachment->loadOp == VK_ATTACHMENT_LOAD_OP_LOAD) || (images[attachment->image].layers > 1);
+			}
+			for (auto &sampledImage : pass.sampledImages) {
+				needed[sampledImage.image] = true;
+			}
+		}
+	}
+
+	/** @brief Derive usage and lifetime of the images referenced by live passes and create them */
+	void RenderGraph::createImages()
+	{
+		auto use = [this](uint32_t image, uint32_t passIndex, VkImageUsageFlags usage) {
+			Image &graphImage = images[image];
+			if (!graphImage.used) {
+				graphImage.used = true;
+				graphImage.firstUse = passIndex;
+			}
+			graphImage.lastUse = passIndex;
+			graphImage.usage |= usage;
+		};
+		for (uint32_t i = 0; i < static_cast<uint32_t>(passes.size()); i++) {
+			Pass &pass = passes[i];
+			if (pass.culled) {
+				continue;
+			}
+			// All attachments of a pass need to have the same extent
+			const Image &first = images[pass.colorAttachments.empty() ? pass.depthStencilAttachment.image : pass.colorAttachments[0].image];
+			pass.width = first.width;
+			pass.height = first.height;
+			for (auto &sampledImage : pass.sampledImages) {
+				use(sampledImage.image, i, VK_IMAGE_USAGE_SAMPLED_BIT);
+			}
+			for (auto &attachment : pass.colorAttachments) {
+				use(attachment.image, i, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT);
+			}
+			if (pass.hasDepthStencil) {
+				use(pass.depthStencilAttachment.image, i, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT);
+			}
+			for (auto &attachment : pass.colorAttachments) {
+				if ((images[attachment.image].width != pass.width) || (images[attachment.image].height != pass.height)) {
+					throw std::runtime_error("Render graph pass \"" + pass.name + "\" has attachments with different extents");
+				}
+			}
+			if (pass.hasDepthStencil && ((images[pass.depthStencilAttachment.image].width != pass.width) || (images[pass.depthStencilAttachment.image].height != pass.height))) {
+				throw std::runtime_error("Render graph pass \"" + pass.name + "\" has attachments with different extents");
+			}
+		}
+
+		for (auto &image : images) {
+			if (image.output) {
+				if (!image.used) {
+					throw std::runtime_error("Render graph output \"" + image.name + "\" is not written by any pass");
+				}
+				// Outputs are read after the graph, so they live until the end of the frame
+				image.lastUse = static_cast<uint32_t>(passes.size());
+				image.usage |= VK_IMAGE_USAGE_SAMPLED_BIT;
+			}
+			if (!image.used) {
+				continue;
+			}
+			image.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+			if (isDepthFormat(image.format) || isStencilFormat(image.format)) {
+				image.aspectMask = (isDepthFormat(image.format) ? VK_IMAGE_ASPECT_DEPTH_BIT : 0) | (isStencilFormat(image.format) ? VK_IMAGE_ASPECT_STENCIL_BIT : 0);
+			}
+
+			VkImageCreateInfo imageCreateInfo = vks::initializers::imageCreateInfo();
+			imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
+			imageCreateInfo.format = image.format;
+			imageCreateInfo.extent = { image.width, image.height, 1 };
+			imageCreateInfo.mipLevels = 1;
+			imageCreateInfo.arrayLayers = image.layers;
+			imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+			imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+			imageCreateInfo.usage = image.usage;
+			imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			VK_CHECK_RESULT(vkCreateImage(device->logicalDevice, &imageCreateInfo, nullptr, &image.image));
+			vkGetImageMemoryRequirements(device->logicalDevice, image.image, &image.memReqs);
+			if (vks::debugmarker::active) {
+				vks::debugmarker::setImageName(device->logicalDevice, image.image, image.name.c_str());
+			}
+			stats.imageCount++;
+			stats.requiredBytes += image.memReqs.size;
+		}
+	}
+
+	/** @brief Assign images to memory slots, images only share a slot if their lifetimes don't overlap */
+	void RenderGraph::aliasMemory()
+	{
+		std::vector<uint32_t> sorted;
+		for (uint32_t i = 0; i < static_cast<uint32_t>(images.size()); i++) {
+			if (images[i].used) {
+				sorted.push_back(i);
+			}
+		}
+		// Largest images first, so every slot is sized by the first image assigned to it
+		std::stable_sort(sorted.begin(), sorted.end(), [this](uint32_t a, uint32_t b) { return images[a].memReqs.size > images[b].memReqs.size; });
+
+		for (auto index : sorted) {
+			Image &image = images[index];
+			bool assigned = false;
+			for (uint32_t s = 0; s < static_cast<uint32_t>(memorySlots.size()) && !assigned; s++) {
+				MemorySlot &slot = memorySlots[s];
+				const uint32_t memoryTypeBits = slot.memoryTypeBits & image.memReqs.memoryTypeBits;
+				VkBool32 memoryTypeFound = VK_FALSE;
+				device->getMemoryType(memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &memoryTypeFound);
+				if (!memoryTypeFound) {
+					continue;
+				}
+				const bool overlaps = std::any_of(slot.images.begin(), slot.images.end(), [this, &image](uint32_t other) {
+					return (image.firstUse <= images[other].lastUse) && (images[other].firstUse <= image.lastUse);
+				});
+				if (overlaps) {
+					continue;
+				}
+				slot.memoryTypeBits = memoryTypeBits;
+				slot.images.push_back(index);
+				image.slot = s;
+				assigned = true;
+			}
+			if (!assigned) {
+				MemorySlot slot;
+				slot.size = image.memReqs.size;
+				slot.memoryTypeBits = image.memReqs.memoryTypeBits;
+				slot.images.push_back(index);
+				image.slot = static_cast<uint32_t>(memorySlots.size());
+				memorySlots.push_back(slot);
+			}
+		}
+
+		for (auto &slot : memorySlots) {
+			std::sort(slot.images.begin(), slot.images.end(), [this](uint32_t a, uint32_t b) { return images[a].firstUse < images[b].firstUse; });
+			std::string name = "render graph:";
+			for (auto index : slot.images) {
+				name += " " + images[index].name;
+			}
+			VkMemoryAllocateInfo memAlloc = vks::initializers::memoryAllocateInfo();
+			memAlloc.allocationSize = slot.size;
+			memAlloc.memoryTypeIndex = device->getMemoryType(slot.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+			VK_CHECK_RESULT(device->allocateMemory(memAlloc, &slot.memory, vks::MemoryCategory::RenderTarget, name.c_str()));
+			for (auto index : slot.images) {
+				VK_CHECK_RESULT(vkBindImageMemory(device->logicalDevice, images[index].image, slot.memory, 0));
+			}
+			stats.allocationCount++;
+			stats.allocatedBytes += slot.size;
+		}
+
+		// Views can only be created once memory has been bound
+		for (auto &image : images) {
+			if (!image.used) {
+				continue;
+			}
+			VkImageViewCreateInfo imageView = vks::initializers::imageViewCreateInfo();
+			imageView.viewType = VK_IMAGE_VIEW_TYPE_2D;
+			imageView.format = image.format;
+			imageView.image = image.image;
+			image.attachmentViews.resize(image.layers);
+			for (uint32_t layer = 0; layer < image.layers; layer++) {
+				imageView.subresourceRange = { image.aspectMask, 0, 1, layer, 1 };
+				VK_CHECK_RESULT(vkCreateImageView(device->logicalDevice, &imageView, nullptr, &image.attachmentViews[layer]));
+			}
+			// Sampling a depth/stencil image requires a view with a single aspect, sampling a layered image a view of all layers
+			const bool depthOnly = (image.usage & VK_IMAGE_USAGE_SAMPLED_BIT) && (image.aspectMask == (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT));
+			if (depthOnly || (image.layers > 1)) {
+				imageView.viewType = (image.layers > 1) ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D;
+				imageView.subresourceRange = { depthOnly ? static_cast<VkImageAspectFlags>(VK_IMAGE_ASPECT_DEPTH_BIT) : image.aspectMask, 0, 1, 0, image.layers };
+				VK_CHECK_RESULT(vkCreateImageView(device->logicalDevice, &imageView, nullptr, &image.view));
+			}
+			else {
+				image.view = image.attachmentViews[0];
+			}
+		}
+	}
+
+	/**
+	* Add the barrier required before an access to an image, if any
+	*
+	* @param barriers Batch of barriers the barrier is added to
+	* @param image Image that is accessed
+	* @param state Current state of the image, updated to the access
+	* @param layout Layout required by the access
+	* @param stageMask Pipeline stages of the access
+	* @param accessMask Access types of the access
+	*/
+	void RenderGraph::transition(Barriers &barriers, uint32_t image, ImageState &state, VkImageLayout layout, VkPipelineStageFlags stageMask, VkAccessFlags accessMask)
+	{
+		const bool write = (accessMask & writeAccessFlags) != 0;
+		VkPipelineStageFlags srcStageMask = state.writeStageMask | state.readStageMask;
+		if (!write && (state.layout == layout)) {
+			// Read after read only needs to wait for the last write if the stage hasn't already been made to wait for it
+			if ((state.readStageMask & stageMask) == stageMask) {
+				return;
+			}
+			srcStageMask = state.writeStageMask;
+		}
+
+		VkImageMemoryBarrier imageMemoryBarrier = vks::initializers::imageMemoryBarrier();
+		imageMemoryBarrier.srcAccessMask = state.writeAccessMask;
+		imageMemoryBarrier.dstAccessMask = accessMask;
+		imageMemoryBarrier.oldLayout = state.layout;
+		imageMemoryBarrier.newLayout = layout;
+		imageMemoryBarrier.image = images[image].image;
+		imageMemoryBarrier.subresourceRange = { images[image].aspectMask, 0, 1, 0, images[image].layers };
+		barriers.imageBarriers.push_back(imageMemoryBarrier);
+		barriers.srcStageMask |= srcStageMask;
+		barriers.dstStageMask |= stageMask;
+		stats.barrierCount++;
+
+		state.layout = layout;
+		if (write) {
+			state.writeStageMask = stageMask;
+			state.writeAccessMask = accessMask & writeAccessFlags;
+			state.readStageMask = 0;
+		}
+		else {
+			state.readStageMask |= stageMask;
+		}
+	}
+
+	/** @brief Simulate the accesses of all live passes to derive the barriers recorded in front of each pass and at the end of the graph */
+	void RenderGraph::deriveBarriers()
+	{
+		std::vector<ImageState> states(images.size());
+		std::vector<bool> initialized(images.size(), false);
+
+		// The first use of an image discards it's contents, but still has to wait for the previous user of it's memory
+		// That user is only known once all passes have been simulated, so these barriers are patched afterwards
+		struct FirstUse
+		{
+			Barriers *barriers;
+			size_t index;
+			uint32_t image;
+		};
+		std::vector<FirstUse> firstUses;
+
+		auto access = [&](Barriers &barriers, uint32_t image, VkImageLayout layout, VkPipelineStageFlags stageMask, VkAccessFlags accessMask, bool discard) {
+			if (!initialized[image]) {
+				if (!discard) {
+					throw std::runtime_error("Render graph image \"" + images[image].name + "\" is read before it has been written");
+				}
+				VkImageMemoryBarrier imageMemoryBarrier = vks::initializers::imageMemoryBarrier();
+				imageMemoryBarrier.dstAccessMask = accessMask;
+				imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+				imageMemoryBarrier.newLayout = layout;
+				imageMemoryBarrier.image = images[image].image;
+				imageMemoryBarrier.subresourceRange = { images[image].aspectMask, 0, 1, 0, images[image].layers };
+				barriers.imageBarriers.push_back(imageMemoryBarrier);
+				barriers.dstStageMask |= stageMask;
+				stats.barrierCount++;
+				FirstUse firstUse = { &barriers, barriers.imageBarriers.size() - 1, image };
+				firstUses.push_back(firstUse);
+
+				initialized[image] = true;
+				states[image].layout = layout;
+				states[image].writeStageMask = stageMask;
+				states[image].writeAccessMask = accessMask & writeAccessFlags;
+				return;
+			}
+			transition(barriers, image, states[image], layout, stageMask, accessMask);
+		};
+
+		for (auto &pass : passes) {
+			if (pass.culled) {
+				continue;
+			}
+			for (auto &sampledImage : pass.sampledImages) {
+				access(pass.barriers, sampledImage.image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, sampledImage.stageMask, VK_ACCESS_SHADER_READ_BIT, false);
+			}
+			for (auto &attachment : pass.colorAttachments) {
+				access(pass.barriers, attachment.image, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, colorAttachmentAccess(attachment.loadOp), attachment.loadOp != VK_ATTACHMENT_LOAD_OP_LOAD);
+			}
+			if (pass.hasDepthStencil) {
+				const Attachment &attachment = pass.depthStencilAttachment;
+				access(pass.barriers, attachment.image, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, depthStencilStages, depthStencilAccess, attachment.loadOp != VK_ATTACHMENT_LOAD_OP_LOAD);
+			}
+		}
+		for (uint32_t i = 0; i < static_cast<uint32_t>(images.size()); i++) {
+			if (images[i].output) {
+				access(finalBarriers, i, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, images[i].outputStageMask, VK_ACCESS_SHADER_READ_BIT, false);
+			}
+		}
+
+		// Wait for the previous user of the memory: the image aliased before it in this frame, or the last one of the previous frame
+		for (auto &firstUse : firstUses) {
+			const MemorySlot &slot = memorySlots[images[firstUse.image].slot];
+			const size_t position = std::find(slot.images.begin(), slot.images.end(), firstUse.image) - slot.images.begin();
+			const uint32_t previous = (position > 0) ? slot.images[position - 1] : slot.images.back();
+			const ImageState &previousState = states[previous];
+			VkPipelineStageFlags srcStageMask = previousState.writeStageMask | previousState.readStageMask;
+			if (srcStageMask == 0) {
+				srcStageMask = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+			}
+			firstUse.barriers->imageBarriers[firstUse.index].srcAccessMask = previousState.writeAccessMask;
+			firstUse.barriers->srcStageMask |= srcStageMask;
+		}
+	}
+
+	/** @brief Create a render pass and frame buffer for each live pass */
+	void RenderGraph::createRenderPasses()
+	{
+		for (uint32_t i = 0; i < static_cast<uint32_t>(passes.size()); i++) {
+			Pass &pass = passes[i];
+			if (pass.culled) {
+				continue;
+			}
+
+			std::vector<VkAttachmentDescription> attachmentDescriptions;
+			std::vector<VkAttachmentReference> colorReferences;
+			std::vector<VkImageView> views;
+			auto addAttachment = [&](const Attachment &attachment, VkImageLayout layout) {
+				const Image &image = images[attachment.image];
+				// Contents are only kept if they are used by a later pass or after the graph
+				const VkAttachmentStoreOp storeOp = (image.lastUse > i) ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+				const bool stencil = isStencilFormat(image.format);
+				VkAttachmentDescription attachmentDescription{};
+				attachmentDescription.format = image.format;
+				attachmentDescription.samples = VK_SAMPLE_COUNT_1_BIT;
+				attachmentDescription.loadOp = attachment.loadOp;
+				attachmentDescription.storeOp = storeOp;
+				attachmentDescription.stencilLoadOp = stencil ? attachment.loadOp : VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+				attachmentDescription.stencilStoreOp = stencil ? storeOp : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+				// Layout transitions are done by the graph's barriers
+				attachmentDescription.initialLayout = layout;
+				attachmentDescription.finalLayout = layout;
+				attachmentDescriptions.push_back(attachmentDescription);
+				views.push_back(image.attachmentViews[attachment.layer]);
+				pass.clearValues.push_back(attachment.clearValue);
+				return static_cast<uint32_t>(attachmentDescriptions.size() - 1);
+			};
+
+			for (auto &attachment : pass.colorAttachments) {
+				colorReferences.push_back({ addAttachment(attachment, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL), VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL });
+			}
+			VkAttachmentReference depthReference = {};
+			if (pass.hasDepthStencil) {
+				depthReference.attachment = addAttachment(pass.depthStencilAttachment, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+				depthReference.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+			}
+
+			VkSubpassDescription subpass = {};
+			subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+			subpass.colorAttachmentCount = static_cast<uint32_t>(colorReferences.size());
+			subpass.pColorAttachments = colorReferences.data();
+			subpass.pDepthStencilAttachment = pass.hasDepthStencil ? &depthReference : nullptr;
+
+			VkRenderPassCreateInfo renderPassInfo = vks::initializers::renderPassCreateInfo();
+			renderPassInfo.attachmentCount = static_cast<uint32_t>(attachmentDescriptions.size());
+			renderPassInfo.pAttachments = attachmentDescriptions.data();
+			renderPassInfo.subpassCount = 1;
+			renderPassInfo.pSubpasses = &subpass;
+			VK_CHECK_RESULT(vkCreateRenderPass(device->logicalDevice, &renderPassInfo, nullptr, &pass.renderPass));
+
+			VkFramebufferCreateInfo frameBufferInfo = vks::initializers::framebufferCreateInfo();
+			frameBufferInfo.renderPass = pass.renderPass;
+			frameBufferInfo.attachmentCount = static_cast<uint32_t>(views.size());
+			frameBufferInfo.pAttachments = views.data();
+			frameBufferInfo.width = pass.width;
+			frameBufferInfo.height = pass.height;
+			frameBufferInfo.layers = 1;
+			VK_CHECK_RESULT(vkCreateFramebuffer(device->logicalDevice, &frameBufferInfo, nullptr, &pass.frameBuffer));
+		}
+	}
+}
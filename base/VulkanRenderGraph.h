@@ -0,0 +1,179 @@
+/*
+* Vulkan render graph
+*
+* Passes declare the images they render to and sample from, the graph derives the layout transitions and barriers between them,
+* culls passes that don't contribute to an output and aliases the memory of images whose lifetimes within a frame don't overlap
+* Layered images (e.g. shadow map cascades) are rendered to one layer per pass and sampled as a whole
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "vulkan/vulkan.h"
+#include "VulkanDevice.h"
+#include "VulkanGpuProfiler.h"
+
+namespace vks
+{
+	class RenderGraph
+	{
+	public:
+		/** @brief Records the commands of a pass, called inside the pass' render pass with viewport and scissor set to the pass extent */
+		typedef std::function<void(VkCommandBuffer)> RecordFunction;
+
+		struct Stats
+		{
+			/** @brief Device memory allocated for all images of the graph */
+			VkDeviceSize allocatedBytes = 0;
+			/** @brief Device memory the images would require without aliasing */
+			VkDeviceSize requiredBytes = 0;
+			uint32_t allocationCount = 0;
+			uint32_t imageCount = 0;
+			uint32_t culledPassCount = 0;
+			uint32_t barrierCount = 0;
+		};
+
+		explicit RenderGraph(vks::VulkanDevice *device);
+		~RenderGraph();
+
+		/** @brief Declare a 2D image (2D array image if it has more than one layer), returns it's handle within the graph */
+		uint32_t addImage(const std::string &name, uint32_t width, uint32_t height, VkFormat format, uint32_t layers = 1);
+		/** @brief Change the extent of an image (e.g. on resize), takes effect with the next compile */
+		void setImageExtent(uint32_t image, uint32_t width, uint32_t height);
+
+		/** @brief Add a pass, passes are executed in the order they have been added */
+		uint32_t addPass(const std::string &name, RecordFunction record);
+		/** @brief Render to a layer of an image, color attachments are bound in the order they have been added */
+		void addColorAttachment(uint32_t pass, uint32_t image, VkAttachmentLoadOp loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR, VkClearColorValue clearColor = {}, uint32_t layer = 0);
+		void setDepthStencilAttachment(uint32_t pass, uint32_t image, VkAttachmentLoadOp loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR, VkClearDepthStencilValue clearValue = { 1.0f, 0 }, uint32_t layer = 0);
+		/** @brief Sample an image written by an earlier pass */
+		void addSampledImage(uint32_t pass, uint32_t image, VkPipelineStageFlags stageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+		/** @brief Mark an image as sampled after the graph has been executed (e.g. by the composition in the swap chain's render pass), it's left in shader read only layout */
+		void addOutput(uint32_t image, VkPipelineStageFlags stageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+
+		/**
+		* Create the images, memory, render passes and frame buffers and derive the barriers for the declared passes
+		* Can be called again after changing image extents, resources from the previous compile are released first, so the device must be idle
+		*/
+		void compile();
+		/** @brief Record all passes that have not been culled, including the barriers between them */
+		void execute(VkCommandBuffer commandBuffer) const;
+		/** @brief Measure the device time of every pass (including it's barriers) as a scope named after the pass */
+		void setProfiler(vks::GpuProfiler *profiler);
+
+		VkImage getImage(uint32_t image) const;
+		/** @brief View used for sampling the image (depth only for depth/stencil formats, all layers of a layered image as a 2D array) */
+		VkImageView getImageView(uint32_t image) const;
+		/** @brief Render pass of a pass, used to create the pipelines drawn in it */
+		VkRenderPass getRenderPass(uint32_t pass) const;
+		bool isPassCulled(uint32_t pass) const;
+		const Stats &getStats() const;
+
+	private:
+		struct Image
+		{
+			std::string name;
+			uint32_t width;
+			uint32_t height;
+			VkFormat format;
+			uint32_t layers;
+			bool output = false;
+			VkPipelineStageFlags outputStageMask = 0;
+			// Compiled state
+			bool used = false;
+			uint32_t firstUse = 0;
+			uint32_t lastUse = 0;
+			VkImageUsageFlags usage = 0;
+			VkImageAspectFlags aspectMask = 0;
+			VkMemoryRequirements memReqs{};
+			uint32_t slot = 0;
+			VkImage image = VK_NULL_HANDLE;
+			VkImageView view = VK_NULL_HANDLE;
+			// One view per layer for rendering to it
+			std::vector<VkImageView> attachmentViews;
+		};
+
+		struct Attachment
+		{
+			uint32_t image = 0;
+			uint32_t layer = 0;
+			VkAttachmentLoadOp loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+			VkClearValue clearValue{};
+		};
+
+		struct SampledImage
+		{
+			uint32_t image;
+			VkPipelineStageFlags stageMask;
+		};
+
+		struct Barriers
+		{
+			std::vector<VkImageMemoryBarrier> imageBarriers;
+			VkPipelineStageFlags srcStageMask = 0;
+			VkPipelineStageFlags dstStageMask = 0;
+		};
+
+		struct Pass
+		{
+			std::string name;
+			RecordFunction record;
+			std::vector<Attachment> colorAttachments;
+			bool hasDepthStencil = false;
+			Attachment depthStencilAttachment;
+			std::vector<SampledImage> sampledImages;
+			// Compiled state
+			bool culled = false;
+			uint32_t width = 0;
+			uint32_t height = 0;
+			Barriers barriers;
+			std::vector<VkClearValue> clearValues;
+			VkRenderPass renderPass = VK_NULL_HANDLE;
+			VkFramebuffer frameBuffer = VK_NULL_HANDLE;
+		};
+
+		/** @brief Device memory shared by images with disjoint lifetimes, all images are bound at offset 0 */
+		struct MemorySlot
+		{
+			VkDeviceSize size;
+			uint32_t memoryTypeBits;
+			// Ordered by first use
+			std::vector<uint32_t> images;
+			VkDeviceMemory memory = VK_NULL_HANDLE;
+		};
+
+		/** @brief Layout and accesses of an image while deriving barriers, the layers of an image are tracked as a whole */
+		struct ImageState
+		{
+			VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+			VkPipelineStageFlags writeStageMask = 0;
+			VkAccessFlags writeAccessMask = 0;
+			// Stages that have read the image since the last write
+			VkPipelineStageFlags readStageMask = 0;
+		};
+
+		vks::VulkanDevice *device;
+		vks::GpuProfiler *profiler = nullptr;
+		std::vector<Image> images;
+		std::vector<Pass> passes;
+		std::vector<MemorySlot> memorySlots;
+		Barriers finalBarriers;
+		Stats stats;
+
+		void release();
+		void cullPasses();
+		void createImages();
+		void aliasMemory();
+		void deriveBarriers();
+		void createRenderPasses();
+		void transition(Barriers &barriers, uint32_t image, ImageState &state, VkImageLayout layout, VkPipelineStageFlags stageMask, VkAccessFlags accessMask);
+	};
+}
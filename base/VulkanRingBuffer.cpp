@@ -0,0 +1,116 @@
+/*
+* Vulkan ring buffer class
+*
+* Streams per-frame data (e.g. per-draw uniforms) through a single persistently mapped buffer
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "VulkanRingBuffer.h"
+#include "VulkanCpuProfiler.h"
+
+#include <algorithm>
+
+namespace vks
+{
+	void RingBuffer::create(vks::VulkanDevice *device, VkBufferUsageFlags usageFlags, VkDeviceSize size, uint32_t framesInFlight)
+	{
+		assert(framesInFlight > 0);
+		const VkPhysicalDeviceLimits &limits = device->properties.limits;
+		alignment = 1;
+		if (usageFlags & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT)
+		{
+			alignment = std::max(alignment, limits.minUniformBufferOffsetAlignment);
+		}
+		if (usageFlags & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)
+		{
+			alignment = std::max(alignment, limits.minStorageBufferOffsetAlignment);
+		}
+		// Placed in host visible device local memory if available, so the device reads per-frame data without crossing the bus
+		// Coherent memory is not required, only the slices written during a frame are flushed
+		VK_CHECK_RESULT(device->createBuffer(usageFlags, vks::MemoryUsage::Dynamic, &buffer, size));
+		VK_CHECK_RESULT(buffer.map());
+		coherent = (buffer.memoryPropertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+
+		frameUsage.assign(framesInFlight, 0);
+		frameIndex = 0;
+		head = 0;
+		used = 0;
+		frameStart = 0;
+		peakUsage = 0;
+	}
+
+	void RingBuffer::destroy()
+	{
+		buffer.destroy();
+		frameUsage.clear();
+	}
+
+	void RingBuffer::beginFrame(VkFence fence)
+	{
+		if (fence != VK_NULL_HANDLE)
+		{
+			VKS_PROFILE_ZONE("vks::RingBuffer wait for frame");
+			VK_CHECK_RESULT(vkWaitForFences(buffer.device, 1, &fence, VK_TRUE, UINT64_MAX));
+		}
+		// Frames are retired in submission order, so the oldest frame's part is always directly in front of the head
+		frameIndex = (frameIndex + 1) % static_cast<uint32_t>(frameUsage.size());
+		used -= frameUsage[frameIndex];
+		frameUsage[frameIndex] = 0;
+		frameStart = head;
+	}
+
+	void *RingBuffer::allocate(VkDeviceSize size, VkDeviceSize *offset)
+	{
+		VkDeviceSize start = (head + alignment - 1) & ~(alignment - 1);
+		if (start + size > buffer.size)
+		{
+			// Wrap around, the remainder at the end of the ring is wasted until this frame is retired
+			start = 0;
+		}
+		const VkDeviceSize consumed = (start >= head) ? (start - head + size) : (buffer.size - head + size);
+		if ((size > buffer.size) || (used + consumed > buffer.size))
+		{
+			return nullptr;
+		}
+		head = start + size;
+		used += consumed;
+		frameUsage[frameIndex] += consumed;
+		peakUsage = std::max(peakUsage, used);
+		*offset = start;
+		return static_cast<uint8_t*>(buffer.mapped) + start;
+	}
+
+	void RingBuffer::flush()
+	{
+		if (coherent || (head == frameStart))
+		{
+			return;
+		}
+		if (head > frameStart)
+		{
+			buffer.flush(head - frameStart, frameStart);
+		}
+		else
+		{
+			// This frame's part wrapped around the end of the ring
+			if (frameStart < buffer.size)
+			{
+				buffer.flush(buffer.size - frameStart, frameStart);
+			}
+			buffer.flush(head, 0);
+		}
+		frameStart = head;
+	}
+
+	VkDescriptorBufferInfo RingBuffer::getDescriptor(VkDeviceSize range) const
+	{
+		VkDescriptorBufferInfo descriptor{};
+		descriptor.buffer = buffer.buffer;
+		descriptor.offset = 0;
+		descriptor.range = range;
+		return descriptor;
+	}
+}
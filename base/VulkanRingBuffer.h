@@ -0,0 +1,91 @@
+/*
+* Vulkan ring buffer class
+*
+* Streams per-frame data (e.g. per-draw uniforms) through a single persistently mapped buffer
+* Each frame in flight gets a contiguous part of the ring that is only reused once that frame has been retired
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <string.h>
+#include <vector>
+
+#include "vulkan/vulkan.h"
+#include "VulkanBuffer.h"
+#include "VulkanDevice.h"
+
+namespace vks
+{
+	class RingBuffer
+	{
+	public:
+		vks::Buffer buffer;
+		/** @brief Alignment of all offsets handed out (minUniformBufferOffsetAlignment and/or minStorageBufferOffsetAlignment, depending on usage) */
+		VkDeviceSize alignment = 0;
+		/** @brief Highest number of bytes used by frames in flight at the same time, useful for sizing the ring */
+		VkDeviceSize peakUsage = 0;
+
+		/**
+		* Create the ring buffer in host visible memory (device local if possible) and map it persistently
+		*
+		* @param device Device to create the buffer on
+		* @param usageFlags Usage of the buffer (e.g. VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT)
+		* @param size Size of the whole ring, needs to hold the data of all frames in flight
+		* @param framesInFlight Number of frames that may be in use by the device at the same time
+		*/
+		void create(vks::VulkanDevice *device, VkBufferUsageFlags usageFlags, VkDeviceSize size, uint32_t framesInFlight);
+		void destroy();
+
+		/**
+		* Start a new frame, the part of the ring used by the oldest frame in flight becomes available again
+		*
+		* @param fence (Optional) Fence of the submission that last used this frame slot, waited on before it's memory is reused
+		*
+		* @note Without a fence, the caller needs to make sure that the device is done with the frame submitted framesInFlight frames ago
+		*/
+		void beginFrame(VkFence fence = VK_NULL_HANDLE);
+
+		/**
+		* Get an aligned slice of the current frame's part of the ring
+		*
+		* @param size Size of the slice in bytes
+		* @param offset Receives the byte offset of the slice (to be used as a dynamic offset or descriptor offset)
+		*
+		* @return Host address of the slice, nullptr if the ring can't fit the slice without overwriting data still in flight
+		*/
+		void *allocate(VkDeviceSize size, VkDeviceSize *offset);
+
+		/** @brief Copy data into a new slice and return it's offset for use as a dynamic offset */
+		template<typename T> uint32_t push(const T &data)
+		{
+			VkDeviceSize offset = 0;
+			void *slice = allocate(sizeof(T), &offset);
+			if (!slice)
+			{
+				vks::tools::exitFatal("Ring buffer is too small for the data of all frames in flight", -1);
+			}
+			memcpy(slice, &data, sizeof(T));
+			return static_cast<uint32_t>(offset);
+		}
+
+		/** @brief Flush the slices written since beginFrame, only required (and only done) for non-coherent memory */
+		void flush();
+
+		/** @brief Descriptor for binding the ring as a dynamic buffer, where range is the size of a single slice */
+		VkDescriptorBufferInfo getDescriptor(VkDeviceSize range) const;
+
+	private:
+		VkDeviceSize head = 0;
+		VkDeviceSize used = 0;
+		// Bytes (including alignment padding) consumed by each frame slot
+		std::vector<VkDeviceSize> frameUsage;
+		uint32_t frameIndex = 0;
+		// Start of the current frame's part of the ring, for flushing
+		VkDeviceSize frameStart = 0;
+		bool coherent = true;
+	};
+}
@@ -220,6 +220,11 @@ void VulkanSwapChain::connect(VkInstance instance, VkPhysicalDevice physicalDevi
 	fpGetSwapchainImagesKHR = reinterpret_cast<PFN_vkGetSwapchainImagesKHR>(vkGetDeviceProcAddr(device, "vkGetSwapchainImagesKHR"));
 	fpAcquireNextImageKHR = reinterpret_cast<PFN_vkAcquireNextImageKHR>(vkGetDeviceProcAddr(device, "vkAcquireNextImageKHR"));
 	fpQueuePresentKHR = reinterpret_cast<PFN_vkQueuePresentKHR>(vkGetDeviceProcAddr(device, "vkQueuePresentKHR"));
+#if defined(VK_KHR_present_wait)
+	if (enablePresentWait) {
+		fpWaitForPresentKHR = reinterpret_cast<PFN_vkWaitForPresentKHR>(vkGetDeviceProcAddr(device, "vkWaitForPresentKHR"));
+	}
+#endif
 }
 
 /** 
@@ -228,8 +233,9 @@ void VulkanSwapChain::connect(VkInstance instance, VkPhysicalDevice physicalDevi
 * @param width Pointer to the width of the swapchain (may be adjusted to fit the requirements of the swapchain)
 * @param height Pointer to the height of the swapchain (may be adjusted to fit the requirements of the swapchain)
 * @param vsync (Optional) Can be used to force vsync-ed rendering (by using VK_PRESENT_MODE_FIFO_KHR as presentation mode)
+* @param requestedPresentMode (Optional) Present mode to use if supported by the surface, takes precedence over vsync (VK_PRESENT_MODE_MAX_ENUM_KHR selects a mode based on vsync)
 */
-void VulkanSwapChain::create(uint32_t *width, uint32_t *height, bool vsync)
+void VulkanSwapChain::create(uint32_t *width, uint32_t *height, bool vsync, VkPresentModeKHR requestedPresentMode)
 {
 	// Store the current swap chain handle so we can use it later on to ease up recreation
 	VkSwapchainKHR oldSwapchain = swapChain;
@@ -270,9 +276,24 @@ void VulkanSwapChain::create(uint32_t *width, uint32_t *height, bool vsync)
 	// This mode waits for the vertical blank ("v-sync")
 	VkPresentModeKHR swapchainPresentMode = VK_PRESENT_MODE_FIFO_KHR;
 
+	// An explicitly requested present mode is used as is if the surface supports it
+	bool requestedPresentModeFound = false;
+	if (requestedPresentMode != VK_PRESENT_MODE_MAX_ENUM_KHR)
+	{
+		requestedPresentModeFound = std::find(presentModes.begin(), presentModes.end(), requestedPresentMode) != presentModes.end();
+		if (requestedPresentModeFound)
+		{
+			swapchainPresentMode = requestedPresentMode;
+		}
+		else
+		{
+			std::cerr << "Requested present mode " << vks::tools::presentModeString(requestedPresentMode) << " is not supported by the surface, falling back to " << (vsync ? "v-sync" : "the default mode") << "\n";
+		}
+	}
+
 	// If v-sync is not requested, try to find a mailbox mode
 	// It's the lowest latency non-tearing present mode available
-	if (!vsync)
+	if (!vsync && !requestedPresentModeFound)
 	{
 		for (size_t i = 0; i < presentModeCount; i++)
 		{
@@ -336,6 +357,7 @@ void VulkanSwapChain::create(uint32_t *width, uint32_t *height, bool vsync)
 	swapchainCI.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
 	swapchainCI.queueFamilyIndexCount = 0;
 	swapchainCI.presentMode = swapchainPresentMode;
+	presentMode = swapchainPresentMode;
 	// Setting oldSwapChain to the saved handle of the previous swapchain aids in resource reuse and makes sure that we can still present already acquired images
 	swapchainCI.oldSwapchain = oldSwapchain;
 	// Setting clipped to VK_TRUE allows the implementation to discard rendering outside of the surface area
@@ -423,10 +445,11 @@ VkResult VulkanSwapChain::acquireNextImage(VkSemaphore presentCompleteSemaphore,
 * @param queue Presentation queue for presenting the image
 * @param imageIndex Index of the swapchain image to queue for presentation
 * @param waitSemaphore (Optional) Semaphore that is waited on before the image is presented (only used if != VK_NULL_HANDLE)
+* @param presentId (Optional) Increasing id of the present that can be waited on with waitForPresent (only used if != 0 and present wait is supported)
 *
 * @return VkResult of the queue presentation
 */
-VkResult VulkanSwapChain::queuePresent(VkQueue queue, uint32_t imageIndex, VkSemaphore waitSemaphore)
+VkResult VulkanSwapChain::queuePresent(VkQueue queue, uint32_t imageIndex, VkSemaphore waitSemaphore, uint64_t presentId)
 {
 	VkPresentInfoKHR presentInfo = {};
 	presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
@@ -440,9 +463,52 @@ VkResult VulkanSwapChain::queuePresent(VkQueue queue, uint32_t imageIndex, VkSem
 		presentInfo.pWaitSemaphores = &waitSemaphore;
 		presentInfo.waitSemaphoreCount = 1;
 	}
+#if defined(VK_KHR_present_id)
+	VkPresentIdKHR presentIdInfo{};
+	if ((presentId != 0) && presentWaitSupported())
+	{
+		presentIdInfo.sType = VK_STRUCTURE_TYPE_PRESENT_ID_KHR;
+		presentIdInfo.swapchainCount = 1;
+		presentIdInfo.pPresentIds = &presentId;
+		presentInfo.pNext = &presentIdInfo;
+	}
+#else
+	(void)presentId;
+#endif
 	return fpQueuePresentKHR(queue, &presentInfo);
 }
 
+bool VulkanSwapChain::presentWaitSupported() const
+{
+#if defined(VK_KHR_present_wait)
+	return fpWaitForPresentKHR != nullptr;
+#else
+	return false;
+#endif
+}
+
+/**
+* Wait until a present has been displayed (or a later present has replaced it)
+*
+* @param presentId Id the image has been queued for presentation with
+* @param timeout Timeout in nanoseconds, 0 only checks if the present has been displayed
+*
+* @return VK_SUCCESS once displayed, VK_TIMEOUT if not displayed within the timeout, VK_ERROR_EXTENSION_NOT_PRESENT if present wait is not supported
+*/
+VkResult VulkanSwapChain::waitForPresent(uint64_t presentId, uint64_t timeout)
+{
+#if defined(VK_KHR_present_wait)
+	if (fpWaitForPresentKHR != nullptr)
+	{
+		return fpWaitForPresentKHR(device, swapChain, presentId, timeout);
+	}
+#else
+	(void)presentId;
+	(void)timeout;
+#endif
+	return VK_ERROR_EXTENSION_NOT_PRESENT;
+}
+
 
 /**
 * Destroy and free Vulkan resources used for the swapchain
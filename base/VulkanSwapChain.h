@@ -15,6 +15,8 @@
 #include <assert.h>
 #include <stdio.h>
 #include <vector>
+#include <algorithm>
+#include <iostream>
 
 #include <vulkan/vulkan.h>
 #include "VulkanTools.h"
@@ -45,6 +47,9 @@ private:
 	PFN_vkGetSwapchainImagesKHR fpGetSwapchainImagesKHR;
 	PFN_vkAcquireNextImageKHR fpAcquireNextImageKHR;
 	PFN_vkQueuePresentKHR fpQueuePresentKHR;
+#if defined(VK_KHR_present_wait)
+	PFN_vkWaitForPresentKHR fpWaitForPresentKHR = nullptr;
+#endif
 public:
 	VkFormat colorFormat;
 	VkColorSpaceKHR colorSpace;
@@ -53,6 +58,10 @@ public:
 	std::vector<VkImage> images;
 	std::vector<SwapChainBuffer> buffers;
 	uint32_t queueNodeIndex = UINT32_MAX;
+	/** @brief Present mode the swap chain has been created with */
+	VkPresentModeKHR presentMode = VK_PRESENT_MODE_FIFO_KHR;
+	/** @brief Set to true if VK_KHR_present_id and VK_KHR_present_wait have been enabled for the device (before calling connect) */
+	bool enablePresentWait = false;
 
 #if defined(VK_USE_PLATFORM_WIN32_KHR)
 	void initSurface(void* platformHandle, void* platformWindow);
@@ -73,8 +82,11 @@ public:
 #endif
 #endif
 	void connect(VkInstance instance, VkPhysicalDevice physicalDevice, VkDevice device);
-	void create(uint32_t* width, uint32_t* height, bool vsync = false);
+	void create(uint32_t* width, uint32_t* height, bool vsync = false, VkPresentModeKHR requestedPresentMode = VK_PRESENT_MODE_MAX_ENUM_KHR);
 	VkResult acquireNextImage(VkSemaphore presentCompleteSemaphore, uint32_t* imageIndex);
-	VkResult queuePresent(VkQueue queue, uint32_t imageIndex, VkSemaphore waitSemaphore = VK_NULL_HANDLE);
+	VkResult queuePresent(VkQueue queue, uint32_t imageIndex, VkSemaphore waitSemaphore = VK_NULL_HANDLE, uint64_t presentId = 0);
+	/** @brief Returns true if presents can be identified and waited for with waitForPresent */
+	bool presentWaitSupported() const;
+	VkResult waitForPresent(uint64_t presentId, uint64_t timeout);
 	void cleanup();
 };
@@ -7,9 +7,193 @@
 */
 
 #include <VulkanTexture.h>
+#include "VulkanCpuProfiler.h"
 
 namespace vks
 {
+	namespace
+	{
+		/**
+		* Get the block compressed format that 8 bit R, RG or RGBA data can be encoded to on the CPU
+		*
+		* @return False if the format has no block compressed counterpart, the device doesn't support it or the usage is not compatible
+		*/
+		bool getBlockCompressedFormat(vks::VulkanDevice *device, VkFormat format, VkImageUsageFlags imageUsageFlags, vks::bc::Format &bcFormat, VkFormat &compressedFormat, uint32_t &channels)
+		{
+			if (!device->enabledFeatures.textureCompressionBC)
+			{
+				return false;
+			}
+			// Block compressed images can't be used as attachments or storage images
+			const VkImageUsageFlags compatibleUsage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+			if ((imageUsageFlags & ~compatibleUsage) != 0)
+			{
+				return false;
+			}
+			switch (format)
+			{
+			case VK_FORMAT_R8_UNORM:
+				bcFormat = vks::bc::Format::BC4;
+				compressedFormat = VK_FORMAT_BC4_UNORM_BLOCK;
+				channels = 1;
+				break;
+			case VK_FORMAT_R8G8_UNORM:
+				bcFormat = vks::bc::Format::BC5;
+				compressedFormat = VK_FORMAT_BC5_UNORM_BLOCK;
+				channels = 2;
+				break;
+			case VK_FORMAT_R8G8B8A8_UNORM:
+				bcFormat = vks::bc::Format::BC7;
+				compressedFormat = VK_FORMAT_BC7_UNORM_BLOCK;
+				channels = 4;
+				break;
+			case VK_FORMAT_R8G8B8A8_SRGB:
+				bcFormat = vks::bc::Format::BC7;
+				compressedFormat = VK_FORMAT_BC7_SRGB_BLOCK;
+				channels = 4;
+				break;
+			default:
+				return false;
+			}
+			VkFormatProperties formatProperties;
+			vkGetPhysicalDeviceFormatProperties(device->physicalDevice, compressedFormat, &formatProperties);
+			return (formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT) != 0;
+		}
+
+		// Asset variants in order of preference, the file name is the asset name followed by the suffix
+		// sRGB variants are only considered if the caller asks for sRGB data, and are preferred over the UNORM variants in that case
+		struct AssetVariant
+		{
+			const char *suffix;
+			VkFormat format;
+			bool srgb;
+		};
+		const AssetVariant assetVariants[] = {
+			{ "_bc7_srgb.ktx", VK_FORMAT_BC7_SRGB_BLOCK, true },
+			{ "_bc3_srgb.ktx", VK_FORMAT_BC3_SRGB_BLOCK, true },
+			{ "_astc_8x8_srgb.ktx", VK_FORMAT_ASTC_8x8_SRGB_BLOCK, true },
+			{ "_astc_4x4_srgb.ktx", VK_FORMAT_ASTC_4x4_SRGB_BLOCK, true },
+			{ "_etc2_srgb.ktx", VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK, true },
+			{ "_srgba.ktx", VK_FORMAT_R8G8B8A8_SRGB, true },
+			{ "_bc7_unorm.ktx", VK_FORMAT_BC7_UNORM_BLOCK, false },
+			{ "_bc3_unorm.ktx", VK_FORMAT_BC3_UNORM_BLOCK, false },
+			{ "_astc_8x8_unorm.ktx", VK_FORMAT_ASTC_8x8_UNORM_BLOCK, false },
+			{ "_astc_4x4_unorm.ktx", VK_FORMAT_ASTC_4x4_UNORM_BLOCK, false },
+			{ "_etc2_unorm.ktx", VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK, false },
+			// KTX2 files store their format (and uncompressed payloads may be transcoded on load)
+			{ ".ktx2", VK_FORMAT_UNDEFINED, false },
+			// Uncompressed fallback
+			{ "_rgba.ktx", VK_FORMAT_R8G8B8A8_UNORM, false },
+			// Assets without a format suffix (e.g. single channel or floating point data), the format is taken from the KTX header
+			{ ".ktx", VK_FORMAT_UNDEFINED, false },
+		};
+
+		/**
+		* Get the Vulkan format of a KTX (version 1) file from the OpenGL internal format stored in its header
+		*
+		* @note Only covers the uncompressed formats used by the assets, returns VK_FORMAT_UNDEFINED for everything else
+		*/
+		VkFormat getKTXFormat(const uint8_t *data, size_t size)
+		{
+			const uint8_t fileIdentifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+			// Identifier, endianness, glType, glTypeSize and glFormat precede the internal format
+			const size_t internalFormatOffset = 28;
+			if ((size < internalFormatOffset + sizeof(uint32_t)) || (memcmp(data, fileIdentifier, sizeof(fileIdentifier)) != 0)) {
+				return VK_FORMAT_UNDEFINED;
+			}
+			uint32_t glInternalFormat;
+			memcpy(&glInternalFormat, data + internalFormatOffset, sizeof(glInternalFormat));
+			switch (glInternalFormat) {
+			case 0x8229: return VK_FORMAT_R8_UNORM;                   // GL_R8
+			case 0x822B: return VK_FORMAT_R8G8_UNORM;                 // GL_RG8
+			case 0x8058: return VK_FORMAT_R8G8B8A8_UNORM;             // GL_RGBA8
+			case 0x8C43: return VK_FORMAT_R8G8B8A8_SRGB;              // GL_SRGB8_ALPHA8
+			case 0x822D: return VK_FORMAT_R16_SFLOAT;                 // GL_R16F
+			case 0x881A: return VK_FORMAT_R16G16B16A16_SFLOAT;        // GL_RGBA16F
+			case 0x8814: return VK_FORMAT_R32G32B32A32_SFLOAT;        // GL_RGBA32F
+			default: return VK_FORMAT_UNDEFINED;
+			}
+		}
+
+		bool isBlockCompressed(VkFormat format)
+		{
+			return ((format >= VK_FORMAT_BC1_RGB_UNORM_BLOCK) && (format <= VK_FORMAT_ASTC_12x12_SRGB_BLOCK));
+		}
+
+		// Check if the format can be sampled on the device, including the texture compression features that need to be enabled for block compressed formats
+		bool isFormatSupported(vks::VulkanDevice *device, VkFormat format)
+		{
+			if ((format >= VK_FORMAT_BC1_RGB_UNORM_BLOCK) && (format <= VK_FORMAT_BC7_SRGB_BLOCK) && !device->enabledFeatures.textureCompressionBC)
+			{
+				return false;
+			}
+			if ((format >= VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK) && (format <= VK_FORMAT_EAC_R11G11_SNORM_BLOCK) && !device->enabledFeatures.textureCompressionETC2)
+			{
+				return false;
+			}
+			if ((format >= VK_FORMAT_ASTC_4x4_UNORM_BLOCK) && (format <= VK_FORMAT_ASTC_12x12_SRGB_BLOCK) && !device->enabledFeatures.textureCompressionASTC_LDR)
+			{
+				return false;
+			}
+			VkFormatProperties formatProperties;
+			vkGetPhysicalDeviceFormatProperties(device->physicalDevice, format, &formatProperties);
+			return (formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT) != 0;
+		}
+
+		// Read the start of a file, returns the number of bytes read (zero if the file does not exist)
+		size_t readFileHeader(const std::string &filename, uint8_t *data, size_t size)
+		{
+#if defined(__ANDROID__)
+			AAsset* asset = AAssetManager_open(androidApp->activity->assetManager, filename.c_str(), AASSET_MODE_STREAMING);
+			if (!asset) {
+				return 0;
+			}
+			int bytesRead = AAsset_read(asset, data, size);
+			AAsset_close(asset);
+			return (bytesRead > 0) ? static_cast<size_t>(bytesRead) : 0;
+#else
+			std::ifstream file(filename, std::ios::binary);
+			if (!file.is_open()) {
+				return 0;
+			}
+			file.read(reinterpret_cast<char*>(data), size);
+			return static_cast<size_t>(file.gcount());
+#endif
+		}
+	}
+
+	const uint8_t *TextureFile::getData() const
+	{
+		return ktx ? ktxTexture_GetData(ktx) : ktx2.data.data();
+	}
+
+	VkDeviceSize TextureFile::getSize() const
+	{
+		return ktx ? ktxTexture_GetSize(ktx) : ktx2.data.size();
+	}
+
+	VkDeviceSize TextureFile::getImageOffset(uint32_t level, uint32_t layer, uint32_t face) const
+	{
+		if (ktx)
+		{
+			ktx_size_t offset;
+			KTX_error_code result = ktxTexture_GetImageOffset(ktx, level, layer, face, &offset);
+			assert(result == KTX_SUCCESS);
+			return offset;
+		}
+		return ktx2.getImageOffset(level, layer, face);
+	}
+
+	void TextureFile::destroy()
+	{
+		if (ktx)
+		{
+			ktxTexture_Destroy(ktx);
+			ktx = nullptr;
+		}
+		ktx2 = vks::ktx2::Texture();
+	}
+
 	void Texture::updateDescriptor()
 	{
 		descriptor.sampler = sampler;
@@ -25,7 +209,16 @@ namespace vks
 		{
 			vkDestroySampler(device->logicalDevice, sampler, nullptr);
 		}
-		vkFreeMemory(device->logicalDevice, deviceMemory, nullptr);
+		// Memory allocated outside of the loaders (e.g. in the samples) isn't owned by the sub-allocator
+		if (allocation)
+		{
+			device->memoryAllocator->free(allocation);
+			allocation = nullptr;
+		}
+		else
+		{
+			device->freeMemory(deviceMemory);
+		}
 	}
 
 	ktxResult Texture::loadKTXFile(std::string filename, ktxTexture **target)
@@ -52,11 +245,177 @@ namespace vks
 		return result;
 	}
 
+	/**
+	* Load a KTX or KTX2 texture file
+	*
+	* KTX2 files may use Zstandard or ZLIB supercompression, which is removed on load
+	* Uncompressed 8 bit R, RG and RGBA KTX2 payloads are transcoded to BC4, BC5 and BC7 on the CPU if the device supports them
+	*
+	* @param filename File to load
+	* @param format Vulkan format of the image data for KTX files, KTX2 files store their own format
+	* @param imageUsageFlags Usage flags of the image the texture will be uploaded to
+	* @param textureFile Receives the image data, its layout and the format to create the image with
+	*/
+	void Texture::loadTextureFile(std::string filename, VkFormat format, VkImageUsageFlags imageUsageFlags, TextureFile &textureFile)
+	{
+		std::vector<uint8_t> fileData;
+#if defined(__ANDROID__)
+		AAsset* asset = AAssetManager_open(androidApp->activity->assetManager, filename.c_str(), AASSET_MODE_STREAMING);
+		if (!asset) {
+			vks::tools::exitFatal("Could not load texture from " + filename + "\n\nThe file may be part of the additional asset pack.\n\nRun \"download_assets.py\" in the repository root to download the latest version.", -1);
+		}
+		fileData.resize(AAsset_getLength(asset));
+		assert(fileData.size() > 0);
+		AAsset_read(asset, fileData.data(), fileData.size());
+		AAsset_close(asset);
+		const bool isKTX2 = vks::ktx2::isKTX2(fileData.data(), fileData.size());
+#else
+		if (!vks::tools::fileExists(filename)) {
+			vks::tools::exitFatal("Could not load texture from " + filename + "\n\nThe file may be part of the additional asset pack.\n\nRun \"download_assets.py\" in the repository root to download the latest version.", -1);
+		}
+		// Only read the identifier up front, KTX files are read by libktx
+		std::ifstream file(filename, std::ios::binary);
+		uint8_t identifier[12] = {};
+		file.read(reinterpret_cast<char*>(identifier), sizeof(identifier));
+		const bool isKTX2 = vks::ktx2::isKTX2(identifier, static_cast<size_t>(file.gcount()));
+		if (isKTX2) {
+			file.seekg(0, std::ios::end);
+			fileData.resize(static_cast<size_t>(file.tellg()));
+			file.seekg(0, std::ios::beg);
+			file.read(reinterpret_cast<char*>(fileData.data()), fileData.size());
+		}
+#endif
+
+		if (!isKTX2) {
+#if defined(__ANDROID__)
+			ktxResult result = ktxTexture_CreateFromMemory(fileData.data(), fileData.size(), KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT, &textureFile.ktx);
+#else
+			ktxResult result = ktxTexture_CreateFromNamedFile(filename.c_str(), KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT, &textureFile.ktx);
+#endif
+			assert(result == KTX_SUCCESS);
+			textureFile.width = textureFile.ktx->baseWidth;
+			textureFile.height = textureFile.ktx->baseHeight;
+			textureFile.mipLevels = textureFile.ktx->numLevels;
+			textureFile.layerCount = textureFile.ktx->numLayers;
+			textureFile.faceCount = textureFile.ktx->numFaces;
+			textureFile.format = format;
+			return;
+		}
+
+		vks::ktx2::Texture &ktx2 = textureFile.ktx2;
+		std::string error;
+		if (!vks::ktx2::load(fileData.data(), fileData.size(), ktx2, error)) {
+			vks::tools::exitFatal("Could not load KTX2 texture from " + filename + "\n\n" + error, -1);
+		}
+		textureFile.width = ktx2.width;
+		textureFile.height = ktx2.height;
+		textureFile.mipLevels = ktx2.levelCount;
+		textureFile.layerCount = ktx2.layerCount;
+		textureFile.faceCount = ktx2.faceCount;
+		textureFile.format = ktx2.format;
+
+		// Transcode uncompressed payloads to a block compressed format supported by the device
+		vks::bc::Format bcFormat;
+		VkFormat compressedFormat;
+		uint32_t channels;
+		if (!getBlockCompressedFormat(device, ktx2.format, imageUsageFlags, bcFormat, compressedFormat, channels)) {
+			return;
+		}
+		const uint32_t imageCount = ktx2.layerCount * ktx2.faceCount;
+		vks::ktx2::Texture transcoded = ktx2;
+		VkDeviceSize dataSize = 0;
+		for (uint32_t level = 0; level < ktx2.levelCount; level++) {
+			transcoded.levelOffsets[level] = dataSize;
+			transcoded.imageStrides[level] = vks::bc::compressedSize(bcFormat, std::max(1u, ktx2.width >> level), std::max(1u, ktx2.height >> level));
+			dataSize += transcoded.imageStrides[level] * imageCount;
+		}
+		transcoded.data.resize(static_cast<size_t>(dataSize));
+		transcoded.format = compressedFormat;
+		// Each image is split into block rows that are compressed as jobs
+		for (uint32_t level = 0; level < ktx2.levelCount; level++) {
+			for (uint32_t layer = 0; layer < ktx2.layerCount; layer++) {
+				for (uint32_t face = 0; face < ktx2.faceCount; face++) {
+					vks::bc::compress(bcFormat, ktx2.data.data() + ktx2.getImageOffset(level, layer, face), std::max(1u, ktx2.width >> level), std::max(1u, ktx2.height >> level), channels, transcoded.data.data() + transcoded.getImageOffset(level, layer, face), device->jobSystem);
+				}
+			}
+		}
+		const char* bcFormatNames[] = { "BC1", "BC4", "BC5", "BC7" };
+		std::cout << "Transcoded " << filename << " to " << bcFormatNames[static_cast<uint32_t>(bcFormat)] << std::endl;
+		ktx2 = std::move(transcoded);
+		textureFile.format = compressedFormat;
+	}
+
+	/**
+	* Find the best variant of a texture asset on disk that is supported by the device
+	*
+	* Compressed variants are preferred, the uncompressed variant is only used if no compressed variant can be used
+	*
+	* @param assetName Path of the asset without format suffix and extension (e.g. "textures/stonefloor01_color")
+	* @param device Vulkan device the texture will be created on (the enabled texture compression features are taken into account)
+	* @param imageUsageFlags Usage flags for the texture's image (block compressed formats can't be used for storage images or attachments)
+	* @param filename Receives the file name of the selected variant
+	* @param format Receives the format of the selected variant
+	* @param (Optional) srgb Prefer variants that store sRGB encoded color data, falls back to the UNORM variants if there are none (defaults to false)
+	* @param (Optional) allowKTX2 Consider KTX2 variants, set to false if the file is loaded with a KTX (version 1) only loader (defaults to true)
+	*/
+	void Texture::resolveAsset(std::string assetName, vks::VulkanDevice *device, VkImageUsageFlags imageUsageFlags, std::string &filename, VkFormat &format, bool srgb, bool allowKTX2)
+	{
+		const VkImageUsageFlags compressibleUsage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+		for (const AssetVariant &variant : assetVariants)
+		{
+			if (variant.srgb && !srgb)
+			{
+				continue;
+			}
+			const std::string variantFilename = assetName + variant.suffix;
+			uint8_t header[32];
+			const size_t headerSize = readFileHeader(variantFilename, header, sizeof(header));
+			if (headerSize == 0)
+			{
+				continue;
+			}
+			const bool isKTX2 = vks::ktx2::isKTX2(header, headerSize);
+			if (isKTX2 && !allowKTX2)
+			{
+				continue;
+			}
+			VkFormat variantFormat = variant.format;
+			if (variantFormat == VK_FORMAT_UNDEFINED)
+			{
+				// Basis Universal payloads don't have a format and can't be transcoded
+				variantFormat = isKTX2 ? vks::ktx2::getFormat(header, headerSize) : getKTXFormat(header, headerSize);
+				if (variantFormat == VK_FORMAT_UNDEFINED)
+				{
+					continue;
+				}
+				// Unsuffixed files were always loaded as UNORM, keep doing so unless the caller asks for sRGB data
+				if (!isKTX2 && !srgb && (variantFormat == VK_FORMAT_R8G8B8A8_SRGB))
+				{
+					variantFormat = VK_FORMAT_R8G8B8A8_UNORM;
+				}
+			}
+			const bool compressed = isBlockCompressed(variantFormat);
+			if ((compressed && ((imageUsageFlags & ~compressibleUsage) != 0)) || !isFormatSupported(device, variantFormat))
+			{
+				continue;
+			}
+			filename = variantFilename;
+			format = variantFormat;
+#if defined(__ANDROID__)
+			LOGD("Using \"%s\" for texture asset \"%s\"%s", filename.c_str(), assetName.c_str(), compressed ? "" : " (uncompressed)");
+#else
+			std::cout << "Using \"" << filename << "\" for texture asset \"" << assetName << "\"" << (compressed ? "" : " (uncompressed)") << std::endl;
+#endif
+			return;
+		}
+		vks::tools::exitFatal("Could not find a variant of texture asset " + assetName + " that is supported by the device\n\nThe file may be part of the additional asset pack.\n\nRun \"download_assets.py\" in the repository root to download the latest version.", -1);
+	}
+
 	/**
 	* Load a 2D texture including all mip levels
 	*
-	* @param filename File to load (supports .ktx)
-	* @param format Vulkan format of the image data stored in the file
+	* @param filename File to load (supports .ktx and .ktx2)
+	* @param format Vulkan format of the image data stored in the file (KTX2 files store their own format, which takes precedence)
 	* @param device Vulkan device to create the texture on
 	* @param copyQueue Queue used for the texture staging copy commands (must support transfer)
 	* @param (Optional) imageUsageFlags Usage flags for the texture's image (defaults to VK_IMAGE_USAGE_SAMPLED_BIT)
@@ -66,17 +425,17 @@ namespace vks
 	*/
 	void Texture2D::loadFromFile(std::string filename, VkFormat format, vks::VulkanDevice *device, VkQueue copyQueue, VkImageUsageFlags imageUsageFlags, VkImageLayout imageLayout, bool forceLinear)
 	{
-		ktxTexture* ktxTexture;
-		ktxResult result = loadKTXFile(filename, &ktxTexture);
-		assert(result == KTX_SUCCESS);
-
+		VKS_PROFILE_ZONE("vks::Texture2D::loadFromFile");
 		this->device = device;
-		width = ktxTexture->baseWidth;
-		height = ktxTexture->baseHeight;
-		mipLevels = ktxTexture->numLevels;
+		TextureFile textureFile;
+		loadTextureFile(filename, format, imageUsageFlags, textureFile);
+		format = textureFile.format;
+		width = textureFile.width;
+		height = textureFile.height;
+		mipLevels = textureFile.mipLevels;
 
-		ktx_uint8_t *ktxTextureData = ktxTexture_GetData(ktxTexture);
-		ktx_size_t ktxTextureSize = ktxTexture_GetSize(ktxTexture);
+		const uint8_t *textureData = textureFile.getData();
+		VkDeviceSize textureSize = textureFile.getSize();
 
 		// Get device properties for the requested texture format
 		VkFormatProperties formatProperties;
@@ -102,7 +461,7 @@ namespace vks
 			VkDeviceMemory stagingMemory;
 
 			VkBufferCreateInfo bufferCreateInfo = vks::initializers::bufferCreateInfo();
-			bufferCreateInfo.size = ktxTextureSize;
+			bufferCreateInfo.size = textureSize;
 			// This buffer is used as a transfer source for the buffer copy
 			bufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
 			bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
@@ -116,13 +475,13 @@ namespace vks
 			// Get memory type index for a host visible buffer
 			memAllocInfo.memoryTypeIndex = device->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
 
-			VK_CHECK_RESULT(vkAllocateMemory(device->logicalDevice, &memAllocInfo, nullptr, &stagingMemory));
+			VK_CHECK_RESULT(device->allocateMemory(memAllocInfo, &stagingMemory, vks::MemoryCategory::Staging));
 			VK_CHECK_RESULT(vkBindBufferMemory(device->logicalDevice, stagingBuffer, stagingMemory, 0));
 
 			// Copy texture data into staging buffer
 			uint8_t *data;
 			VK_CHECK_RESULT(vkMapMemory(device->logicalDevice, stagingMemory, 0, memReqs.size, 0, (void **)&data));
-			memcpy(data, ktxTextureData, ktxTextureSize);
+			memcpy(data, textureData, textureSize);
 			vkUnmapMemory(device->logicalDevice, stagingMemory);
 
 			// Setup buffer copy regions for each mip level
@@ -130,17 +489,15 @@ namespace vks
 
 			for (uint32_t i = 0; i < mipLevels; i++)
 			{
-				ktx_size_t offset;
-				KTX_error_code result = ktxTexture_GetImageOffset(ktxTexture, i, 0, 0, &offset);
-				assert(result == KTX_SUCCESS);
+				VkDeviceSize offset = textureFile.getImageOffset(i, 0, 0);
 
 				VkBufferImageCopy bufferCopyRegion = {};
 				bufferCopyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
 				bufferCopyRegion.imageSubresource.mipLevel = i;
 				bufferCopyRegion.imageSubresource.baseArrayLayer = 0;
 				bufferCopyRegion.imageSubresource.layerCount = 1;
-				bufferCopyRegion.imageExtent.width = std::max(1u, ktxTexture->baseWidth >> i);
-				bufferCopyRegion.imageExtent.height = std::max(1u, ktxTexture->baseHeight >> i);
+				bufferCopyRegion.imageExtent.width = std::max(1u, width >> i);
+				bufferCopyRegion.imageExtent.height = std::max(1u, height >> i);
 				bufferCopyRegion.imageExtent.depth = 1;
 				bufferCopyRegion.bufferOffset = offset;
 
@@ -168,11 +525,10 @@ namespace vks
 
 			vkGetImageMemoryRequirements(device->logicalDevice, image, &memReqs);
 
-			memAllocInfo.allocationSize = memReqs.size;
-
-			memAllocInfo.memoryTypeIndex = device->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-			VK_CHECK_RESULT(vkAllocateMemory(device->logicalDevice, &memAllocInfo, nullptr, &deviceMemory));
-			VK_CHECK_RESULT(vkBindImageMemory(device->logicalDevice, image, deviceMemory, 0));
+			// Image memory is sub-allocated, so the image needs to be bound at the allocation's offset
+			VK_CHECK_RESULT(device->memoryAllocator->allocate(memReqs, device->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT), vks::ResourceType::Optimal, vks::MemoryTracker::getImageCategory(imageCreateInfo.usage), &allocation, 0, false, filename.c_str()));
+			deviceMemory = allocation->memory;
+			VK_CHECK_RESULT(vkBindImageMemory(device->logicalDevice, image, deviceMemory, allocation->offset));
 
 			VkImageSubresourceRange subresourceRange = {};
 			subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
@@ -211,7 +567,7 @@ namespace vks
 			device->flushCommandBuffer(copyCmd, copyQueue);
 
 			// Clean up staging resources
-			vkFreeMemory(device->logicalDevice, stagingMemory, nullptr);
+			device->freeMemory(stagingMemory);
 			vkDestroyBuffer(device->logicalDevice, stagingBuffer, nullptr);
 		}
 		else
@@ -251,7 +607,7 @@ namespace vks
 			memAllocInfo.memoryTypeIndex = device->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
 
 			// Allocate host memory
-			VK_CHECK_RESULT(vkAllocateMemory(device->logicalDevice, &memAllocInfo, nullptr, &mappableMemory));
+			VK_CHECK_RESULT(device->allocateMemory(memAllocInfo, &mappableMemory, vks::MemoryTracker::getImageCategory(imageCreateInfo.usage), filename.c_str()));
 
 			// Bind allocated image for use
 			VK_CHECK_RESULT(vkBindImageMemory(device->logicalDevice, mappableImage, mappableMemory, 0));
@@ -273,7 +629,7 @@ namespace vks
 			VK_CHECK_RESULT(vkMapMemory(device->logicalDevice, mappableMemory, 0, memReqs.size, 0, &data));
 
 			// Copy image data into memory
-			memcpy(data, ktxTextureData, memReqs.size);
+			memcpy(data, textureData, memReqs.size);
 
 			vkUnmapMemory(device->logicalDevice, mappableMemory);
 
@@ -289,7 +645,7 @@ namespace vks
 			device->flushCommandBuffer(copyCmd, copyQueue);
 		}
 
-		ktxTexture_Destroy(ktxTexture);
+		textureFile.destroy();
 
 		// Create a default sampler
 		VkSamplerCreateInfo samplerCreateInfo = {};
@@ -331,6 +687,24 @@ namespace vks
 		updateDescriptor();
 	}
 
+	/**
+	* Load a 2D texture from the best variant of a texture asset that is supported by the device
+	*
+	* @param assetName Path of the asset without format suffix and extension (see Texture::resolveAsset)
+	* @param device Vulkan device to create the texture on
+	* @param copyQueue Queue used for the texture staging copy commands (must support transfer)
+	* @param (Optional) imageUsageFlags Usage flags for the texture's image (defaults to VK_IMAGE_USAGE_SAMPLED_BIT)
+	* @param (Optional) imageLayout Usage layout for the texture (defaults VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
+	* @param (Optional) srgb Prefer sRGB variants of the asset (defaults to false)
+	*/
+	void Texture2D::loadFromAsset(std::string assetName, vks::VulkanDevice *device, VkQueue copyQueue, VkImageUsageFlags imageUsageFlags, VkImageLayout imageLayout, bool srgb)
+	{
+		std::string filename;
+		VkFormat format;
+		resolveAsset(assetName, device, imageUsageFlags, filename, format, srgb);
+		loadFromFile(filename, format, device, copyQueue, imageUsageFlags, imageLayout);
+	}
+
 	/**
 	* Creates a 2D texture from a buffer
 	*
@@ -344,9 +718,13 @@ namespace vks
 	* @param (Optional) filter Texture filtering for the sampler (defaults to VK_FILTER_LINEAR)
 	* @param (Optional) imageUsageFlags Usage flags for the texture's image (defaults to VK_IMAGE_USAGE_SAMPLED_BIT)
 	* @param (Optional) imageLayout Usage layout for the texture (defaults VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
+	* @param (Optional) compress Block compress the data on the CPU before upload if the device supports BC formats (defaults to false)
+	*
+	* @note Compression is only applied to sampled-only textures in R8 (BC4), R8G8 (BC5) or R8G8B8A8 (BC7) formats, other textures are uploaded as-is
 	*/
-	void Texture2D::fromBuffer(void* buffer, VkDeviceSize bufferSize, VkFormat format, uint32_t texWidth, uint32_t texHeight, vks::VulkanDevice *device, VkQueue copyQueue, VkFilter filter, VkImageUsageFlags imageUsageFlags, VkImageLayout imageLayout)
+	void Texture2D::fromBuffer(void* buffer, VkDeviceSize bufferSize, VkFormat format, uint32_t texWidth, uint32_t texHeight, vks::VulkanDevice *device, VkQueue copyQueue, VkFilter filter, VkImageUsageFlags imageUsageFlags, VkImageLayout imageLayout, bool compress)
 	{
+		VKS_PROFILE_ZONE("vks::Texture2D::fromBuffer");
 		assert(buffer);
 
 		this->device = device;
@@ -354,6 +732,19 @@ namespace vks
 		height = texHeight;
 		mipLevels = 1;
 
+		std::vector<uint8_t> compressedData;
+		vks::bc::Format bcFormat;
+		VkFormat compressedFormat;
+		uint32_t channels;
+		if (compress && getBlockCompressedFormat(device, format, imageUsageFlags, bcFormat, compressedFormat, channels) && (bufferSize >= static_cast<VkDeviceSize>(width) * height * channels))
+		{
+			compressedData.resize(vks::bc::compressedSize(bcFormat, width, height));
+			vks::bc::compress(bcFormat, static_cast<const uint8_t*>(buffer), width, height, channels, compressedData.data(), device->jobSystem);
+			buffer = compressedData.data();
+			bufferSize = compressedData.size();
+			format = compressedFormat;
+		}
+
 		VkMemoryAllocateInfo memAllocInfo = vks::initializers::memoryAllocateInfo();
 		VkMemoryRequirements memReqs;
 
@@ -379,7 +770,7 @@ namespace vks
 		// Get memory type index for a host visible buffer
 		memAllocInfo.memoryTypeIndex = device->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
 
-		VK_CHECK_RESULT(vkAllocateMemory(device->logicalDevice, &memAllocInfo, nullptr, &stagingMemory));
+		VK_CHECK_RESULT(device->allocateMemory(memAllocInfo, &stagingMemory, vks::MemoryCategory::Staging));
 		VK_CHECK_RESULT(vkBindBufferMemory(device->logicalDevice, stagingBuffer, stagingMemory, 0));
 
 		// Copy texture data into staging buffer
@@ -419,11 +810,10 @@ namespace vks
 
 		vkGetImageMemoryRequirements(device->logicalDevice, image, &memReqs);
 
-		memAllocInfo.allocationSize = memReqs.size;
-
-		memAllocInfo.memoryTypeIndex = device->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-		VK_CHECK_RESULT(vkAllocateMemory(device->logicalDevice, &memAllocInfo, nullptr, &deviceMemory));
-		VK_CHECK_RESULT(vkBindImageMemory(device->logicalDevice, image, deviceMemory, 0));
+		// Image memory is sub-allocated, so the image needs to be bound at the allocation's offset
+		VK_CHECK_RESULT(device->memoryAllocator->allocate(memReqs, device->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT), vks::ResourceType::Optimal, vks::MemoryTracker::getImageCategory(imageCreateInfo.usage), &allocation));
+		deviceMemory = allocation->memory;
+		VK_CHECK_RESULT(vkBindImageMemory(device->logicalDevice, image, deviceMemory, allocation->offset));
 
 		VkImageSubresourceRange subresourceRange = {};
 		subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
@@ -462,7 +852,7 @@ namespace vks
 		device->flushCommandBuffer(copyCmd, copyQueue);
 
 		// Clean up staging resources
-		vkFreeMemory(device->logicalDevice, stagingMemory, nullptr);
+		device->freeMemory(stagingMemory);
 		vkDestroyBuffer(device->logicalDevice, stagingBuffer, nullptr);
 
 		// Create sampler
@@ -500,8 +890,8 @@ namespace vks
 	/**
 	* Load a 2D texture array including all mip levels
 	*
-	* @param filename File to load (supports .ktx)
-	* @param format Vulkan format of the image data stored in the file
+	* @param filename File to load (supports .ktx and .ktx2)
+	* @param format Vulkan format of the image data stored in the file (KTX2 files store their own format, which takes precedence)
 	* @param device Vulkan device to create the texture on
 	* @param copyQueue Queue used for the texture staging copy commands (must support transfer)
 	* @param (Optional) imageUsageFlags Usage flags for the texture's image (defaults to VK_IMAGE_USAGE_SAMPLED_BIT)
@@ -510,18 +900,18 @@ namespace vks
 	*/
 	void Texture2DArray::loadFromFile(std::string filename, VkFormat format, vks::VulkanDevice *device, VkQueue copyQueue, VkImageUsageFlags imageUsageFlags, VkImageLayout imageLayout)
 	{
-		ktxTexture* ktxTexture;
-		ktxResult result = loadKTXFile(filename, &ktxTexture);
-		assert(result == KTX_SUCCESS);
-
+		VKS_PROFILE_ZONE("vks::Texture2DArray::loadFromFile");
 		this->device = device;
-		width = ktxTexture->baseWidth;
-		height = ktxTexture->baseHeight;
-		layerCount = ktxTexture->numLayers;
-		mipLevels = ktxTexture->numLevels;
+		TextureFile textureFile;
+		loadTextureFile(filename, format, imageUsageFlags, textureFile);
+		format = textureFile.format;
+		width = textureFile.width;
+		height = textureFile.height;
+		layerCount = textureFile.layerCount;
+		mipLevels = textureFile.mipLevels;
 
-		ktx_uint8_t *ktxTextureData = ktxTexture_GetData(ktxTexture);
-		ktx_size_t ktxTextureSize = ktxTexture_GetSize(ktxTexture);
+		const uint8_t *textureData = textureFile.getData();
+		VkDeviceSize textureSize = textureFile.getSize();
 
 		VkMemoryAllocateInfo memAllocInfo = vks::initializers::memoryAllocateInfo();
 		VkMemoryRequirements memReqs;
@@ -531,7 +921,7 @@ namespace vks
 		VkDeviceMemory stagingMemory;
 
 		VkBufferCreateInfo bufferCreateInfo = vks::initializers::bufferCreateInfo();
-		bufferCreateInfo.size = ktxTextureSize;
+		bufferCreateInfo.size = textureSize;
 		// This buffer is used as a transfer source for the buffer copy
 		bufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
 		bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
@@ -545,13 +935,13 @@ namespace vks
 		// Get memory type index for a host visible buffer
 		memAllocInfo.memoryTypeIndex = device->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
 
-		VK_CHECK_RESULT(vkAllocateMemory(device->logicalDevice, &memAllocInfo, nullptr, &stagingMemory));
+		VK_CHECK_RESULT(device->allocateMemory(memAllocInfo, &stagingMemory, vks::MemoryCategory::Staging));
 		VK_CHECK_RESULT(vkBindBufferMemory(device->logicalDevice, stagingBuffer, stagingMemory, 0));
 
 		// Copy texture data into staging buffer
 		uint8_t *data;
 		VK_CHECK_RESULT(vkMapMemory(device->logicalDevice, stagingMemory, 0, memReqs.size, 0, (void **)&data));
-		memcpy(data, ktxTextureData, ktxTextureSize);
+		memcpy(data, textureData, textureSize);
 		vkUnmapMemory(device->logicalDevice, stagingMemory);
 
 		// Setup buffer copy regions for each layer including all of its miplevels
@@ -561,17 +951,15 @@ namespace vks
 		{
 			for (uint32_t level = 0; level < mipLevels; level++)
 			{
-				ktx_size_t offset;
-				KTX_error_code result = ktxTexture_GetImageOffset(ktxTexture, level, layer, 0, &offset);
-				assert(result == KTX_SUCCESS);
+				VkDeviceSize offset = textureFile.getImageOffset(level, layer, 0);
 
 				VkBufferImageCopy bufferCopyRegion = {};
 				bufferCopyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
 				bufferCopyRegion.imageSubresource.mipLevel = level;
 				bufferCopyRegion.imageSubresource.baseArrayLayer = layer;
 				bufferCopyRegion.imageSubresource.layerCount = 1;
-				bufferCopyRegion.imageExtent.width = ktxTexture->baseWidth >> level;
-				bufferCopyRegion.imageExtent.height = ktxTexture->baseHeight >> level;
+				bufferCopyRegion.imageExtent.width = std::max(1u, width >> level);
+				bufferCopyRegion.imageExtent.height = std::max(1u, height >> level);
 				bufferCopyRegion.imageExtent.depth = 1;
 				bufferCopyRegion.bufferOffset = offset;
 
@@ -601,11 +989,10 @@ namespace vks
 
 		vkGetImageMemoryRequirements(device->logicalDevice, image, &memReqs);
 
-		memAllocInfo.allocationSize = memReqs.size;
-		memAllocInfo.memoryTypeIndex = device->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-
-		VK_CHECK_RESULT(vkAllocateMemory(device->logicalDevice, &memAllocInfo, nullptr, &deviceMemory));
-		VK_CHECK_RESULT(vkBindImageMemory(device->logicalDevice, image, deviceMemory, 0));
+		// Image memory is sub-allocated, so the image needs to be bound at the allocation's offset
+		VK_CHECK_RESULT(device->memoryAllocator->allocate(memReqs, device->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT), vks::ResourceType::Optimal, vks::MemoryTracker::getImageCategory(imageCreateInfo.usage), &allocation, 0, false, filename.c_str()));
+		deviceMemory = allocation->memory;
+		VK_CHECK_RESULT(vkBindImageMemory(device->logicalDevice, image, deviceMemory, allocation->offset));
 
 		// Use a separate command buffer for texture loading
 		VkCommandBuffer copyCmd = device->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
@@ -674,19 +1061,37 @@ namespace vks
 		VK_CHECK_RESULT(vkCreateImageView(device->logicalDevice, &viewCreateInfo, nullptr, &view));
 
 		// Clean up staging resources
-		ktxTexture_Destroy(ktxTexture);
-		vkFreeMemory(device->logicalDevice, stagingMemory, nullptr);
+		textureFile.destroy();
+		device->freeMemory(stagingMemory);
 		vkDestroyBuffer(device->logicalDevice, stagingBuffer, nullptr);
 
 		// Update descriptor image info member that can be used for setting up descriptor sets
 		updateDescriptor();
 	}
 
+	/**
+	* Load a 2D texture array from the best variant of a texture asset that is supported by the device
+	*
+	* @param assetName Path of the asset without format suffix and extension (see Texture::resolveAsset)
+	* @param device Vulkan device to create the texture on
+	* @param copyQueue Queue used for the texture staging copy commands (must support transfer)
+	* @param (Optional) imageUsageFlags Usage flags for the texture's image (defaults to VK_IMAGE_USAGE_SAMPLED_BIT)
+	* @param (Optional) imageLayout Usage layout for the texture (defaults VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
+	* @param (Optional) srgb Prefer sRGB variants of the asset (defaults to false)
+	*/
+	void Texture2DArray::loadFromAsset(std::string assetName, vks::VulkanDevice *device, VkQueue copyQueue, VkImageUsageFlags imageUsageFlags, VkImageLayout imageLayout, bool srgb)
+	{
+		std::string filename;
+		VkFormat format;
+		resolveAsset(assetName, device, imageUsageFlags, filename, format, srgb);
+		loadFromFile(filename, format, device, copyQueue, imageUsageFlags, imageLayout);
+	}
+
 	/**
 	* Load a cubemap texture including all mip levels from a single file
 	*
-	* @param filename File to load (supports .ktx)
-	* @param format Vulkan format of the image data stored in the file
+	* @param filename File to load (supports .ktx and .ktx2)
+	* @param format Vulkan format of the image data stored in the file (KTX2 files store their own format, which takes precedence)
 	* @param device Vulkan device to create the texture on
 	* @param copyQueue Queue used for the texture staging copy commands (must support transfer)
 	* @param (Optional) imageUsageFlags Usage flags for the texture's image (defaults to VK_IMAGE_USAGE_SAMPLED_BIT)
@@ -695,17 +1100,17 @@ namespace vks
 	*/
 	void TextureCubeMap::loadFromFile(std::string filename, VkFormat format, vks::VulkanDevice *device, VkQueue copyQueue, VkImageUsageFlags imageUsageFlags, VkImageLayout imageLayout)
 	{
-		ktxTexture* ktxTexture;
-		ktxResult result = loadKTXFile(filename, &ktxTexture);
-		assert(result == KTX_SUCCESS);
-
+		VKS_PROFILE_ZONE("vks::TextureCubeMap::loadFromFile");
 		this->device = device;
-		width = ktxTexture->baseWidth;
-		height = ktxTexture->baseHeight;
-		mipLevels = ktxTexture->numLevels;
+		TextureFile textureFile;
+		loadTextureFile(filename, format, imageUsageFlags, textureFile);
+		format = textureFile.format;
+		width = textureFile.width;
+		height = textureFile.height;
+		mipLevels = textureFile.mipLevels;
 
-		ktx_uint8_t *ktxTextureData = ktxTexture_GetData(ktxTexture);
-		ktx_size_t ktxTextureSize = ktxTexture_GetSize(ktxTexture);
+		const uint8_t *textureData = textureFile.getData();
+		VkDeviceSize textureSize = textureFile.getSize();
 
 		VkMemoryAllocateInfo memAllocInfo = vks::initializers::memoryAllocateInfo();
 		VkMemoryRequirements memReqs;
@@ -715,7 +1120,7 @@ namespace vks
 		VkDeviceMemory stagingMemory;
 
 		VkBufferCreateInfo bufferCreateInfo = vks::initializers::bufferCreateInfo();
-		bufferCreateInfo.size = ktxTextureSize;
+		bufferCreateInfo.size = textureSize;
 		// This buffer is used as a transfer source for the buffer copy
 		bufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
 		bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
@@ -729,13 +1134,13 @@ namespace vks
 		// Get memory type index for a host visible buffer
 		memAllocInfo.memoryTypeIndex = device->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
 
-		VK_CHECK_RESULT(vkAllocateMemory(device->logicalDevice, &memAllocInfo, nullptr, &stagingMemory));
+		VK_CHECK_RESULT(device->allocateMemory(memAllocInfo, &stagingMemory, vks::MemoryCategory::Staging));
 		VK_CHECK_RESULT(vkBindBufferMemory(device->logicalDevice, stagingBuffer, stagingMemory, 0));
 
 		// Copy texture data into staging buffer
 		uint8_t *data;
 		VK_CHECK_RESULT(vkMapMemory(device->logicalDevice, stagingMemory, 0, memReqs.size, 0, (void **)&data));
-		memcpy(data, ktxTextureData, ktxTextureSize);
+		memcpy(data, textureData, textureSize);
 		vkUnmapMemory(device->logicalDevice, stagingMemory);
 
 		// Setup buffer copy regions for each face including all of its mip levels
@@ -745,17 +1150,15 @@ namespace vks
 		{
 			for (uint32_t level = 0; level < mipLevels; level++)
 			{
-				ktx_size_t offset;
-				KTX_error_code result = ktxTexture_GetImageOffset(ktxTexture, level, 0, face, &offset);
-				assert(result == KTX_SUCCESS);
+				VkDeviceSize offset = textureFile.getImageOffset(level, 0, face);
 
 				VkBufferImageCopy bufferCopyRegion = {};
 				bufferCopyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
 				bufferCopyRegion.imageSubresource.mipLevel = level;
 				bufferCopyRegion.imageSubresource.baseArrayLayer = face;
 				bufferCopyRegion.imageSubresource.layerCount = 1;
-				bufferCopyRegion.imageExtent.width = ktxTexture->baseWidth >> level;
-				bufferCopyRegion.imageExtent.height = ktxTexture->baseHeight >> level;
+				bufferCopyRegion.imageExtent.width = std::max(1u, width >> level);
+				bufferCopyRegion.imageExtent.height = std::max(1u, height >> level);
 				bufferCopyRegion.imageExtent.depth = 1;
 				bufferCopyRegion.bufferOffset = offset;
 
@@ -789,11 +1192,10 @@ namespace vks
 
 		vkGetImageMemoryRequirements(device->logicalDevice, image, &memReqs);
 
-		memAllocInfo.allocationSize = memReqs.size;
-		memAllocInfo.memoryTypeIndex = device->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-
-		VK_CHECK_RESULT(vkAllocateMemory(device->logicalDevice, &memAllocInfo, nullptr, &deviceMemory));
-		VK_CHECK_RESULT(vkBindImageMemory(device->logicalDevice, image, deviceMemory, 0));
+		// Image memory is sub-allocated, so the image needs to be bound at the allocation's offset
+		VK_CHECK_RESULT(device->memoryAllocator->allocate(memReqs, device->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT), vks::ResourceType::Optimal, vks::MemoryTracker::getImageCategory(imageCreateInfo.usage), &allocation, 0, false, filename.c_str()));
+		deviceMemory = allocation->memory;
+		VK_CHECK_RESULT(vkBindImageMemory(device->logicalDevice, image, deviceMemory, allocation->offset));
 
 		// Use a separate command buffer for texture loading
 		VkCommandBuffer copyCmd = device->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
@@ -862,12 +1264,29 @@ namespace vks
 		VK_CHECK_RESULT(vkCreateImageView(device->logicalDevice, &viewCreateInfo, nullptr, &view));
 
 		// Clean up staging resources
-		ktxTexture_Destroy(ktxTexture);
-		vkFreeMemory(device->logicalDevice, stagingMemory, nullptr);
+		textureFile.destroy();
+		device->freeMemory(stagingMemory);
 		vkDestroyBuffer(device->logicalDevice, stagingBuffer, nullptr);
 
 		// Update descriptor image info member that can be used for setting up descriptor sets
 		updateDescriptor();
 	}
 
+	/**
+	* Load a cubemap texture from the best variant of a texture asset that is supported by the device
+	*
+	* @param assetName Path of the asset without format suffix and extension (see Texture::resolveAsset)
+	* @param device Vulkan device to create the texture on
+	* @param copyQueue Queue used for the texture staging copy commands (must support transfer)
+	* @param (Optional) imageUsageFlags Usage flags for the texture's image (defaults to VK_IMAGE_USAGE_SAMPLED_BIT)
+	* @param (Optional) imageLayout Usage layout for the texture (defaults VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
+	* @param (Optional) srgb Prefer sRGB variants of the asset (defaults to false)
+	*/
+	void TextureCubeMap::loadFromAsset(std::string assetName, vks::VulkanDevice *device, VkQueue copyQueue, VkImageUsageFlags imageUsageFlags, VkImageLayout imageLayout, bool srgb)
+	{
+		std::string filename;
+		VkFormat format;
+		resolveAsset(assetName, device, imageUsageFlags, filename, format, srgb);
+		loadFromFile(filename, format, device, copyQueue, imageUsageFlags, imageLayout);
+	}
 }
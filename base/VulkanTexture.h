@@ -19,7 +19,9 @@
 #include <ktxvulkan.h>
 
 #include "VulkanBuffer.h"
+#include "blockcompression.h"
 #include "VulkanDevice.h"
+#include "VulkanKTX2.h"
 #include "VulkanTools.h"
 
 #if defined(__ANDROID__)
@@ -28,6 +30,25 @@
 
 namespace vks
 {
+/** @brief Image data of a KTX or KTX2 file */
+struct TextureFile
+{
+	uint32_t   width      = 0;
+	uint32_t   height     = 0;
+	uint32_t   mipLevels  = 0;
+	uint32_t   layerCount = 0;
+	uint32_t   faceCount  = 0;
+	/** @brief Format to create the image with (may differ from the file's format if the data was transcoded) */
+	VkFormat   format     = VK_FORMAT_UNDEFINED;
+	ktxTexture *ktx       = nullptr;
+	vks::ktx2::Texture ktx2;
+
+	const uint8_t *getData() const;
+	VkDeviceSize   getSize() const;
+	VkDeviceSize   getImageOffset(uint32_t level, uint32_t layer, uint32_t face) const;
+	void           destroy();
+};
+
 class Texture
 {
   public:
@@ -35,6 +56,7 @@ class Texture
 	VkImage               image;
 	VkImageLayout         imageLayout;
 	VkDeviceMemory        deviceMemory;
+	vks::Allocation *     allocation = nullptr;
 	VkImageView           view;
 	uint32_t              width, height;
 	uint32_t              mipLevels;
@@ -45,6 +67,8 @@ class Texture
 	void      updateDescriptor();
 	void      destroy();
 	ktxResult loadKTXFile(std::string filename, ktxTexture **target);
+	void      loadTextureFile(std::string filename, VkFormat format, VkImageUsageFlags imageUsageFlags, TextureFile &textureFile);
+	static void resolveAsset(std::string assetName, vks::VulkanDevice *device, VkImageUsageFlags imageUsageFlags, std::string &filename, VkFormat &format, bool srgb = false, bool allowKTX2 = true);
 };
 
 class Texture2D : public Texture
@@ -58,6 +82,13 @@ class Texture2D : public Texture
 	    VkImageUsageFlags  imageUsageFlags = VK_IMAGE_USAGE_SAMPLED_BIT,
 	    VkImageLayout      imageLayout     = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
 	    bool               forceLinear     = false);
+	void loadFromAsset(
+	    std::string        assetName,
+	    vks::VulkanDevice *device,
+	    VkQueue            copyQueue,
+	    VkImageUsageFlags  imageUsageFlags = VK_IMAGE_USAGE_SAMPLED_BIT,
+	    VkImageLayout      imageLayout     = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+	    bool               srgb            = false);
 	void fromBuffer(
 	    void *             buffer,
 	    VkDeviceSize       bufferSize,
@@ -68,7 +99,8 @@ class Texture2D : public Texture
 	    VkQueue            copyQueue,
 	    VkFilter           filter          = VK_FILTER_LINEAR,
 	    VkImageUsageFlags  imageUsageFlags = VK_IMAGE_USAGE_SAMPLED_BIT,
-	    VkImageLayout      imageLayout     = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+	    VkImageLayout      imageLayout     = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+	    bool               compress        = false);
 };
 
 class Texture2DArray : public Texture
@@ -81,6 +113,13 @@ class Texture2DArray : public Texture
 	    VkQueue            copyQueue,
 	    VkImageUsageFlags  imageUsageFlags = VK_IMAGE_USAGE_SAMPLED_BIT,
 	    VkImageLayout      imageLayout     = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+	void loadFromAsset(
+	    std::string        assetName,
+	    vks::VulkanDevice *device,
+	    VkQueue            copyQueue,
+	    VkImageUsageFlags  imageUsageFlags = VK_IMAGE_USAGE_SAMPLED_BIT,
+	    VkImageLayout      imageLayout     = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+	    bool               srgb            = false);
 };
 
 class TextureCubeMap : public Texture
@@ -93,5 +132,12 @@ class TextureCubeMap : public Texture
 	    VkQueue            copyQueue,
 	    VkImageUsageFlags  imageUsageFlags = VK_IMAGE_USAGE_SAMPLED_BIT,
 	    VkImageLayout      imageLayout     = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+	void loadFromAsset(
+	    std::string        assetName,
+	    vks::VulkanDevice *device,
+	    VkQueue            copyQueue,
+	    VkImageUsageFlags  imageUsageFlags = VK_IMAGE_USAGE_SAMPLED_BIT,
+	    VkImageLayout      imageLayout     = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+	    bool               srgb            = false);
 };
 }        // namespace vks
@@ -0,0 +1,78 @@
+/*
+* Per-thread command pools for parallel command buffer recording
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "VulkanThreadCommandPools.h"
+#include "VulkanTools.h"
+
+#include <stdexcept>
+
+namespace vks
+{
+	void ThreadCommandPools::create(vks::VulkanDevice *device, vks::JobSystem *jobSystem, uint32_t queueFamilyIndex, uint32_t frameCount)
+	{
+		this->device = device;
+		this->jobSystem = jobSystem;
+		threadCount = jobSystem->getThreadCount();
+		currentFrame = 0;
+		pools.resize(frameCount * threadCount);
+		for (Pool &pool : pools) {
+			// Transient as the command buffers are re-recorded every time their frame comes around
+			VkCommandPoolCreateInfo commandPoolCI = vks::initializers::commandPoolCreateInfo();
+			commandPoolCI.queueFamilyIndex = queueFamilyIndex;
+			commandPoolCI.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+			VK_CHECK_RESULT(vkCreateCommandPool(device->logicalDevice, &commandPoolCI, nullptr, &pool.commandPool));
+		}
+	}
+
+	void ThreadCommandPools::destroy()
+	{
+		for (Pool &pool : pools) {
+			// Destroying the pool frees it's command buffers
+			vkDestroyCommandPool(device->logicalDevice, pool.commandPool, nullptr);
+		}
+		pools.clear();
+	}
+
+	void ThreadCommandPools::beginFrame(uint32_t frameIndex)
+	{
+		assert(frameIndex * threadCount < pools.size());
+		currentFrame = frameIndex;
+		for (uint32_t i = 0; i < threadCount; i++) {
+			Pool &pool = pools[frameIndex * threadCount + i];
+			if (pool.usedCount > 0) {
+				VK_CHECK_RESULT(vkResetCommandPool(device->logicalDevice, pool.commandPool, 0));
+				pool.usedCount = 0;
+			}
+		}
+	}
+
+	VkCommandBuffer ThreadCommandPools::getCommandBuffer()
+	{
+		const uint32_t threadIndex = jobSystem->getThreadIndex();
+		if (threadIndex >= threadCount) {
+			throw std::runtime_error("Thread command pools can only be used from threads of the job system they were created for");
+		}
+		Pool &pool = pools[currentFrame * threadCount + threadIndex];
+		if (pool.usedCount == pool.commandBuffers.size()) {
+			VkCommandBuffer commandBuffer;
+			VkCommandBufferAllocateInfo allocateInfo = vks::initializers::commandBufferAllocateInfo(pool.commandPool, VK_COMMAND_BUFFER_LEVEL_SECONDARY, 1);
+			VK_CHECK_RESULT(vkAllocateCommandBuffers(device->logicalDevice, &allocateInfo, &commandBuffer));
+			pool.commandBuffers.push_back(commandBuffer);
+		}
+		return pool.commandBuffers[pool.usedCount++];
+	}
+
+	uint32_t ThreadCommandPools::getAllocatedCount() const
+	{
+		size_t count = 0;
+		for (const Pool &pool : pools) {
+			count += pool.commandBuffers.size();
+		}
+		return static_cast<uint32_t>(count);
+	}
+}
@@ -0,0 +1,71 @@
+/*
+* Per-thread command pools for parallel command buffer recording
+*
+* Command pools must not be used by more than one thread at a time, so every thread of a job system gets it's own pool for each frame in flight
+* Secondary command buffers are allocated from these on demand and kept, beginning a frame resets the frame's pools as a whole instead of
+* freeing and reallocating the command buffers
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <vector>
+
+#include "vulkan/vulkan.h"
+#include "VulkanDevice.h"
+#include "VulkanJobSystem.h"
+
+namespace vks
+{
+	class ThreadCommandPools
+	{
+	public:
+		vks::VulkanDevice *device = nullptr;
+		vks::JobSystem *jobSystem = nullptr;
+
+		/**
+		* Create the command pools
+		*
+		* @param device Device to create the pools on
+		* @param jobSystem Job system (already started) the command buffers are recorded on, there is one pool per thread of the system
+		* @param queueFamilyIndex Queue family the command buffers are submitted to
+		* @param frameCount Number of frames that can be in flight at the same time, each one has it's own set of pools
+		*/
+		void create(vks::VulkanDevice *device, vks::JobSystem *jobSystem, uint32_t queueFamilyIndex, uint32_t frameCount);
+		void destroy();
+
+		/**
+		* Reset the pools of a frame and make them the current ones, all command buffers previously recorded for this frame index become invalid
+		*
+		* @param frameIndex Index of the frame in [0, frameCount), its previous submission must have finished execution
+		*/
+		void beginFrame(uint32_t frameIndex);
+
+		/**
+		* Get a secondary command buffer from the calling thread's pool of the current frame (reused from an earlier frame if possible)
+		*
+		* @note Must be called from a thread of the job system, e.g. from within a job, the returned command buffer still needs to be begun
+		*/
+		VkCommandBuffer getCommandBuffer();
+
+		/** @brief Number of secondary command buffers allocated over all pools */
+		uint32_t getAllocatedCount() const;
+
+	private:
+		struct Pool
+		{
+			VkCommandPool commandPool = VK_NULL_HANDLE;
+			std::vector<VkCommandBuffer> commandBuffers;
+			// Command buffers handed out since the last reset
+			uint32_t usedCount = 0;
+		};
+
+		uint32_t threadCount = 0;
+		uint32_t currentFrame = 0;
+		// Indexed by frame * threadCount + thread
+		std::vector<Pool> pools;
+	};
+}
@@ -7,6 +7,16 @@
 */
 
 #include "VulkanTools.h"
+#include "VulkanCpuProfiler.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(_WIN32)
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
 
 const std::string getAssetPath()
 {
@@ -74,6 +84,20 @@ namespace vks
 			}
 		}
 
+		std::string presentModeString(VkPresentModeKHR presentMode)
+		{
+			switch (presentMode)
+			{
+#define STR(r) case VK_PRESENT_MODE_ ##r ##_KHR: return #r
+				STR(IMMEDIATE);
+				STR(MAILBOX);
+				STR(FIFO);
+				STR(FIFO_RELAXED);
+#undef STR
+			default: return "UNKNOWN_PRESENT_MODE";
+			}
+		}
+
 		VkBool32 getSupportedDepthFormat(VkPhysicalDevice physicalDevice, VkFormat *depthFormat)
 		{
 			// Since all depth formats may be optional, we need to find a suitable depth format to use
@@ -342,6 +366,7 @@ namespace vks
 #else
 		VkShaderModule loadShader(const char *fileName, VkDevice device)
 		{
+			VKS_PROFILE_ZONE("vks::tools::loadShader");
 			std::ifstream is(fileName, std::ios::binary | std::ios::in | std::ios::ate);
 
 			if (is.is_open())
@@ -385,5 +410,35 @@ namespace vks
 	        return (value + alignment - 1) & ~(alignment - 1);
         }
 
+		uint64_t getPeakResidentMemory()
+		{
+#if defined(_WIN32)
+			PROCESS_MEMORY_COUNTERS counters = {};
+			if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+				return static_cast<uint64_t>(counters.PeakWorkingSetSize);
+			}
+			return 0;
+#else
+			struct rusage usage = {};
+			if (getrusage(RUSAGE_SELF, &usage) != 0) {
+				return 0;
+			}
+#if defined(__APPLE__)
+			// Reported in bytes on Apple platforms
+			return static_cast<uint64_t>(usage.ru_maxrss);
+#else
+			// Reported in kilobytes on Linux and Android
+			return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+		}
+
+		double percentile(const std::vector<double> &sortedValues, double p)
+		{
+			assert(!sortedValues.empty());
+			// The smallest value that at least p of all values are less than or equal to
+			size_t rank = static_cast<size_t>(std::ceil(p * sortedValues.size()));
+			return sortedValues[std::min(std::max(rank, static_cast<size_t>(1)), sortedValues.size()) - 1];
+		}
 	}
 }
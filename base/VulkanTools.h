@@ -74,6 +74,9 @@ namespace vks
 		/** @brief Returns the device type as a string */
 		std::string physicalDeviceTypeString(VkPhysicalDeviceType type);
 
+		/** @brief Returns the present mode as a string */
+		std::string presentModeString(VkPresentModeKHR presentMode);
+
 		// Selected a suitable supported depth format starting with 32 bit down to 16 bit
 		// Returns false if none of the depth formats in the list is supported by the device
 		VkBool32 getSupportedDepthFormat(VkPhysicalDevice physicalDevice, VkFormat *depthFormat);
@@ -127,5 +130,11 @@ namespace vks
 		bool fileExists(const std::string &filename);
 
 		uint32_t alignedSize(uint32_t value, uint32_t alignment);
+
+		/** @brief Returns the peak resident memory (working set) of the process in bytes, 0 if not available on the platform */
+		uint64_t getPeakResidentMemory();
+
+		/** @brief Nearest rank percentile (p in [0, 1]) of a non-empty list of values sorted in ascending order */
+		double percentile(const std::vector<double> &sortedValues, double p);
 	}
 }
@@ -0,0 +1,440 @@
+/*
+* Vulkan transfer engine
+*
+* Coalesces buffer and image uploads into batches that are staged through a persistently mapped ring buffer and submitted on the dedicated transfer queue
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "VulkanTransferEngine.h"
+#include "VulkanCpuProfiler.h"
+
+#include <string.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace vks
+{
+#ifndef NDEBUG
+	namespace
+	{
+		// A granularity of zero only allows copies of whole subresources, which start at offset zero
+		bool isGranularityAligned(int32_t offset, uint32_t granularity)
+		{
+			return (granularity == 0) ? (offset == 0) : (static_cast<uint32_t>(offset) % granularity == 0);
+		}
+	}
+#endif
+
+	void TransferEngine::create(vks::VulkanDevice *device, VkQueue graphicsQueue, VkDeviceSize stagingSize)
+	{
+		this->device = device;
+		this->graphicsQueue = graphicsQueue;
+		submitThread = std::this_thread::get_id();
+		graphicsFamilyIndex = device->queueFamilyIndices.graphics;
+		transferFamilyIndex = device->queueFamilyIndices.transfer;
+		vkGetDeviceQueue(device->logicalDevice, transferFamilyIndex, 0, &transferQueue);
+		const bool ownershipTransfer = (transferFamilyIndex != graphicsFamilyIndex);
+
+		// Buffer offsets of image copies need to be a multiple of the texel block size (16 bytes at most), the device may prefer a larger alignment
+		const VkDeviceSize optimalAlignment = std::max<VkDeviceSize>(device->properties.limits.optimalBufferCopyOffsetAlignment, 1);
+		stagingAlignment = 16;
+		while (stagingAlignment % optimalAlignment != 0)
+		{
+			stagingAlignment += 16;
+		}
+		imageTransferGranularity = device->queueFamilyProperties[transferFamilyIndex].minImageTransferGranularity;
+
+		transferCommandPool = device->createCommandPool(transferFamilyIndex);
+		if (ownershipTransfer)
+		{
+			graphicsCommandPool = device->createCommandPool(graphicsFamilyIndex);
+		}
+
+		VkFenceCreateInfo fenceCreateInfo = vks::initializers::fenceCreateInfo();
+		VkSemaphoreCreateInfo semaphoreCreateInfo = vks::initializers::semaphoreCreateInfo();
+		for (Batch &batch : batches)
+		{
+			batch.transferCommandBuffer = device->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, transferCommandPool);
+			VK_CHECK_RESULT(vkCreateFence(device->logicalDevice, &fenceCreateInfo, nullptr, &batch.fence));
+			if (ownershipTransfer)
+			{
+				batch.graphicsCommandBuffer = device->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, graphicsCommandPool);
+				VK_CHECK_RESULT(vkCreateSemaphore(device->logicalDevice, &semaphoreCreateInfo, nullptr, &batch.ownershipSemaphore));
+			}
+		}
+
+		if (device->enableTimelineSemaphores)
+		{
+			VkSemaphoreTypeCreateInfoKHR semaphoreTypeCreateInfo{};
+			semaphoreTypeCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR;
+			semaphoreTypeCreateInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE_KHR;
+			semaphoreTypeCreateInfo.initialValue = 0;
+			semaphoreCreateInfo.pNext = &semaphoreTypeCreateInfo;
+			VK_CHECK_RESULT(vkCreateSemaphore(device->logicalDevice, &semaphoreCreateInfo, nullptr, &timelineSemaphore));
+		}
+
+		VK_CHECK_RESULT(device->createBuffer(VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &staging, stagingSize));
+		VK_CHECK_RESULT(staging.map());
+		stagingHead = 0;
+		stagingUsed = 0;
+		currentBatch = 0;
+		recording = false;
+		nextValue = 1;
+		completedValue = 0;
+	}
+
+	void TransferEngine::destroy()
+	{
+		if (!device)
+		{
+			return;
+		}
+		flush();
+		for (Batch &batch : batches)
+		{
+			vkDestroyFence(device->logicalDevice, batch.fence, nullptr);
+			if (batch.ownershipSemaphore)
+			{
+				vkDestroySemaphore(device->logicalDevice, batch.ownershipSemaphore, nullptr);
+			}
+			batch = Batch();
+		}
+		if (timelineSemaphore)
+		{
+			vkDestroySemaphore(device->logicalDevice, timelineSemaphore, nullptr);
+			timelineSemaphore = VK_NULL_HANDLE;
+		}
+		vkDestroyCommandPool(device->logicalDevice, transferCommandPool, nullptr);
+		if (graphicsCommandPool)
+		{
+			vkDestroyCommandPool(device->logicalDevice, graphicsCommandPool, nullptr);
+			graphicsCommandPool = VK_NULL_HANDLE;
+		}
+		staging.destroy();
+		device = nullptr;
+	}
+
+	void TransferEngine::beginBatch()
+	{
+		if (recording)
+		{
+			return;
+		}
+		// Recycle the resources of the oldest batch
+		Batch &batch = batches[currentBatch];
+		retireBatch(batch, true);
+		VkCommandBufferBeginInfo cmdBufInfo = vks::initializers::commandBufferBeginInfo();
+		cmdBufInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		VK_CHECK_RESULT(vkBeginCommandBuffer(batch.transferCommandBuffer, &cmdBufInfo));
+		recording = true;
+	}
+
+	void TransferEngine::retireBatch(Batch &batch, bool wait)
+	{
+		if (batch.value == 0)
+		{
+			return;
+		}
+		if (wait)
+		{
+			VKS_PROFILE_ZONE("vks::TransferEngine wait for batch");
+			VK_CHECK_RESULT(vkWaitForFences(device->logicalDevice, 1, &batch.fence, VK_TRUE, UINT64_MAX));
+		}
+		else if (vkGetFenceStatus(device->logicalDevice, batch.fence) != VK_SUCCESS)
+		{
+			return;
+		}
+		VK_CHECK_RESULT(vkResetFences(device->logicalDevice, 1, &batch.fence));
+		stagingUsed -= batch.stagingUsage;
+		batch.stagingUsage = 0;
+		for (vks::Buffer &buffer : batch.dedicatedStaging)
+		{
+			buffer.destroy();
+		}
+		batch.dedicatedStaging.clear();
+		completedValue = std::max(completedValue, batch.value);
+		batch.value = 0;
+	}
+
+	/**
+	* Retire batches in submission order, so their staging ranges are released in the order they were allocated
+	*
+	* @param waitValue Batches up to this value are waited on, later ones are only retired if they have already completed
+	*/
+	void TransferEngine::retireBatches(uint64_t waitValue)
+	{
+		for (uint32_t i = 0; i < maxBatchesInFlight; i++)
+		{
+			Batch &batch = batches[(currentBatch + i) % maxBatchesInFlight];
+			if (batch.value == 0)
+			{
+				continue;
+			}
+			retireBatch(batch, batch.value <= waitValue);
+			if (batch.value != 0)
+			{
+				break;
+			}
+		}
+	}
+
+	void *TransferEngine::allocateStaging(VkDeviceSize size, VkBuffer *buffer, VkDeviceSize *offset)
+	{
+		while (size <= staging.size)
+		{
+			VkDeviceSize start = (stagingHead + stagingAlignment - 1) / stagingAlignment * stagingAlignment;
+			if (start + size > staging.size)
+			{
+				// Wrap around, the remainder at the end of the ring is released along with this batch
+				start = 0;
+			}
+			const VkDeviceSize consumed = (start >= stagingHead) ? (start - stagingHead + size) : (staging.size - stagingHead + size);
+			if (stagingUsed + consumed <= staging.size)
+			{
+				stagingHead = start + size;
+				stagingUsed += consumed;
+				batches[currentBatch].stagingUsage += consumed;
+				*buffer = staging.buffer;
+				*offset = start;
+				return static_cast<uint8_t*>(staging.mapped) + start;
+			}
+			// The ring is full, wait for the oldest batch in flight to free up it's range
+			bool inFlight = false;
+			for (uint32_t i = 1; i < maxBatchesInFlight; i++)
+			{
+				inFlight |= (batches[(currentBatch + i) % maxBatchesInFlight].value != 0);
+			}
+			if (inFlight)
+			{
+				retireBatches(completedValue + 1);
+			}
+			else if ((batches[currentBatch].stagingUsage > 0) && isSubmitThread())
+			{
+				// Only the batch being recorded uses the ring, submit it to start a new one (other threads can't submit and use a dedicated staging buffer instead)
+				submit();
+				beginBatch();
+			}
+			else
+			{
+				break;
+			}
+		}
+		// Uploads that can't be staged through the ring get a buffer of their own, released once the batch has completed
+		Batch &batch = batches[currentBatch];
+		batch.dedicatedStaging.push_back(vks::Buffer());
+		vks::Buffer &dedicated = batch.dedicatedStaging.back();
+		VK_CHECK_RESULT(device->createBuffer(VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &dedicated, size));
+		VK_CHECK_RESULT(dedicated.map());
+		*buffer = dedicated.buffer;
+		*offset = 0;
+		return dedicated.mapped;
+	}
+
+	uint64_t TransferEngine::uploadBuffer(VkBuffer buffer, const void *data, VkDeviceSize size, VkDeviceSize dstOffset)
+	{
+		std::lock_guard<std::recursive_mutex> lock(mutex);
+		beginBatch();
+		VkBuffer stagingBuffer;
+		VkDeviceSize stagingOffset;
+		memcpy(allocateStaging(size, &stagingBuffer, &stagingOffset), data, size);
+
+		Batch &batch = batches[currentBatch];
+		VkBufferCopy copyRegion{};
+		copyRegion.srcOffset = stagingOffset;
+		copyRegion.dstOffset = dstOffset;
+		copyRegion.size = size;
+		vkCmdCopyBuffer(batch.transferCommandBuffer, stagingBuffer, buffer, 1, &copyRegion);
+
+		VkBufferMemoryBarrier barrier = vks::initializers::bufferMemoryBarrier();
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+		barrier.buffer = buffer;
+		barrier.offset = dstOffset;
+		barrier.size = size;
+		batch.bufferBarriers.push_back(barrier);
+		return nextValue;
+	}
+
+	uint64_t TransferEngine::uploadImage(VkImage image, const void *data, VkDeviceSize size, const std::vector<VkBufferImageCopy> &regions, const VkImageSubresourceRange &subresourceRange, VkImageLayout newLayout)
+	{
+		std::lock_guard<std::recursive_mutex> lock(mutex);
+		beginBatch();
+		VkBuffer stagingBuffer;
+		VkDeviceSize stagingOffset;
+		memcpy(allocateStaging(size, &stagingBuffer, &stagingOffset), data, size);
+
+		Batch &batch = batches[currentBatch];
+		VkImageMemoryBarrier barrier = vks::initializers::imageMemoryBarrier();
+		barrier.image = image;
+		barrier.subresourceRange = subresourceRange;
+		barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		barrier.srcAccessMask = 0;
+		barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		vkCmdPipelineBarrier(batch.transferCommandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+		std::vector<VkBufferImageCopy> stagedRegions(regions);
+		for (VkBufferImageCopy &region : stagedRegions)
+		{
+#ifndef NDEBUG
+			assert(isGranularityAligned(region.imageOffset.x, imageTransferGranularity.width) && isGranularityAligned(region.imageOffset.y, imageTransferGranularity.height) && isGranularityAligned(region.imageOffset.z, imageTransferGranularity.depth));
+#endif
+			region.bufferOffset += stagingOffset;
+		}
+		vkCmdCopyBufferToImage(batch.transferCommandBuffer, stagingBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<uint32_t>(stagedRegions.size()), stagedRegions.data());
+
+		// The transition to the final layout is done along with the ownership transfer
+		barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		barrier.newLayout = newLayout;
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+		batch.imageBarriers.push_back(barrier);
+		return nextValue;
+	}
+
+	void TransferEngine::submitBatch(Batch &batch, uint64_t value)
+	{
+		VkSubmitInfo submitInfo = vks::initializers::submitInfo();
+		VkTimelineSemaphoreSubmitInfoKHR timelineSubmitInfo{};
+		timelineSubmitInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+		timelineSubmitInfo.signalSemaphoreValueCount = 1;
+		timelineSubmitInfo.pSignalSemaphoreValues = &value;
+
+		if (transferFamilyIndex == graphicsFamilyIndex)
+		{
+			// Same queue family: A plain barrier makes the uploads visible to all later commands
+			vkCmdPipelineBarrier(batch.transferCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr,
+				static_cast<uint32_t>(batch.bufferBarriers.size()), batch.bufferBarriers.data(), static_cast<uint32_t>(batch.imageBarriers.size()), batch.imageBarriers.data());
+			VK_CHECK_RESULT(vkEndCommandBuffer(batch.transferCommandBuffer));
+			submitInfo.commandBufferCount = 1;
+			submitInfo.pCommandBuffers = &batch.transferCommandBuffer;
+			if (timelineSemaphore)
+			{
+				submitInfo.pNext = &timelineSubmitInfo;
+				submitInfo.signalSemaphoreCount = 1;
+				submitInfo.pSignalSemaphores = &timelineSemaphore;
+			}
+			VK_CHECK_RESULT(vkQueueSubmit(transferQueue, 1, &submitInfo, batch.fence));
+			return;
+		}
+
+		// Release ownership on the transfer queue
+		for (VkBufferMemoryBarrier &barrier : batch.bufferBarriers)
+		{
+			barrier.srcQueueFamilyIndex = transferFamilyIndex;
+			barrier.dstQueueFamilyIndex = graphicsFamilyIndex;
+			barrier.dstAccessMask = 0;
+		}
+		for (VkImageMemoryBarrier &barrier : batch.imageBarriers)
+		{
+			barrier.srcQueueFamilyIndex = transferFamilyIndex;
+			barrier.dstQueueFamilyIndex = graphicsFamilyIndex;
+			barrier.dstAccessMask = 0;
+		}
+		vkCmdPipelineBarrier(batch.transferCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr,
+			static_cast<uint32_t>(batch.bufferBarriers.size()), batch.bufferBarriers.data(), static_cast<uint32_t>(batch.imageBarriers.size()), batch.imageBarriers.data());
+		VK_CHECK_RESULT(vkEndCommandBuffer(batch.transferCommandBuffer));
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers = &batch.transferCommandBuffer;
+		submitInfo.signalSemaphoreCount = 1;
+		submitInfo.pSignalSemaphores = &batch.ownershipSemaphore;
+		VK_CHECK_RESULT(vkQueueSubmit(transferQueue, 1, &submitInfo, VK_NULL_HANDLE));
+
+		// Acquire ownership on the graphics queue (the barriers need to match the release barriers)
+		// Later submissions to the graphics queue are ordered after the acquire barrier, so the consumers of the uploads don't need to wait on the host
+		for (VkBufferMemoryBarrier &barrier : batch.bufferBarriers)
+		{
+			barrier.srcAccessMask = 0;
+			barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+		}
+		for (VkImageMemoryBarrier &barrier : batch.imageBarriers)
+		{
+			barrier.srcAccessMask = 0;
+			barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+		}
+		VkCommandBufferBeginInfo cmdBufInfo = vks::initializers::commandBufferBeginInfo();
+		cmdBufInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		VK_CHECK_RESULT(vkBeginCommandBuffer(batch.graphicsCommandBuffer, &cmdBufInfo));
+		vkCmdPipelineBarrier(batch.graphicsCommandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr,
+			static_cast<uint32_t>(batch.bufferBarriers.size()), batch.bufferBarriers.data(), static_cast<uint32_t>(batch.imageBarriers.size()), batch.imageBarriers.data());
+		VK_CHECK_RESULT(vkEndCommandBuffer(batch.graphicsCommandBuffer));
+
+		VkPipelineStageFlags waitStageMask = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+		submitInfo = vks::initializers::submitInfo();
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers = &batch.graphicsCommandBuffer;
+		submitInfo.waitSemaphoreCount = 1;
+		submitInfo.pWaitSemaphores = &batch.ownershipSemaphore;
+		submitInfo.pWaitDstStageMask = &waitStageMask;
+		if (timelineSemaphore)
+		{
+			submitInfo.pNext = &timelineSubmitInfo;
+			submitInfo.signalSemaphoreCount = 1;
+			submitInfo.pSignalSemaphores = &timelineSemaphore;
+		}
+		VK_CHECK_RESULT(vkQueueSubmit(graphicsQueue, 1, &submitInfo, batch.fence));
+	}
+
+	bool TransferEngine::isSubmitThread() const
+	{
+		return std::this_thread::get_id() == submitThread;
+	}
+
+	/**
+	* Submit all queued uploads as one batch
+	*
+	* @return Value of the submitted batch (or of the last batch if there was nothing to submit)
+	*
+	* @note Submits to the graphics queue (ownership transfers, or the transfer itself if there is no dedicated transfer family), which requires external synchronization
+	* So only the thread that created the engine and owns the graphics queue submits, on other threads this does nothing and the uploads are submitted with the next batch of that thread
+	*/
+	uint64_t TransferEngine::submit()
+	{
+		VKS_PROFILE_ZONE("vks::TransferEngine::submit");
+		std::lock_guard<std::recursive_mutex> lock(mutex);
+		if (!recording || !isSubmitThread())
+		{
+			return nextValue - 1;
+		}
+		Batch &batch = batches[currentBatch];
+		const uint64_t value = nextValue++;
+		submitBatch(batch, value);
+		batch.bufferBarriers.clear();
+		batch.imageBarriers.clear();
+		batch.value = value;
+		currentBatch = (currentBatch + 1) % maxBatchesInFlight;
+		recording = false;
+		return value;
+	}
+
+	void TransferEngine::wait(uint64_t value)
+	{
+		VKS_PROFILE_ZONE("vks::TransferEngine::wait");
+		std::lock_guard<std::recursive_mutex> lock(mutex);
+		if (recording && (value >= nextValue))
+		{
+			// Only the thread that created the engine can submit, so another thread could never see this batch complete
+			if (!isSubmitThread()) {
+				throw std::runtime_error("vks::TransferEngine::wait called for an unsubmitted batch from a thread that can't submit");
+			}
+			submit();
+		}
+		retireBatches(value);
+	}
+
+	bool TransferEngine::isComplete(uint64_t value)
+	{
+		std::lock_guard<std::recursive_mutex> lock(mutex);
+		retireBatches(0);
+		return value <= completedValue;
+	}
+
+	void TransferEngine::flush()
+	{
+		std::lock_guard<std::recursive_mutex> lock(mutex);
+		wait(submit());
+	}
+}
@@ -0,0 +1,139 @@
+/*
+* Vulkan transfer engine
+*
+* Coalesces buffer and image uploads into batches that are staged through a persistently mapped ring buffer and submitted on the dedicated transfer queue
+* Ownership of uploaded resources is transferred to the graphics queue family, completion of a batch is signaled with a timeline semaphore
+* Uploads can be queued from any thread, batches are only submitted by the thread that created the engine (which owns the graphics queue)
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "vulkan/vulkan.h"
+#include "VulkanBuffer.h"
+#include "VulkanDevice.h"
+#include "VulkanTools.h"
+
+namespace vks
+{
+	class TransferEngine
+	{
+	public:
+		/** @brief Number of submitted batches that can be in flight before the oldest one is waited on (command buffers, fences and semaphores are recycled) */
+		static const uint32_t maxBatchesInFlight = 4;
+
+		vks::VulkanDevice *device = nullptr;
+		/** @brief Alignment of uploads in the staging ring, covers the texel block sizes of all formats and the device's optimal buffer copy offset alignment */
+		VkDeviceSize stagingAlignment = 16;
+		/** @brief Granularity of image copies on the transfer queue, the offsets of image upload regions need to be a multiple of it (and the extents too, unless they reach the edge of the subresource) */
+		VkExtent3D imageTransferGranularity = { 1, 1, 1 };
+		/** @brief Queue the uploads are submitted on (a transfer-only queue if the device has one, the graphics queue otherwise) */
+		VkQueue transferQueue = VK_NULL_HANDLE;
+		/** @brief Signaled with a batch's value once it's uploads have completed and are owned by the graphics queue family, VK_NULL_HANDLE if timeline semaphores aren't supported */
+		VkSemaphore timelineSemaphore = VK_NULL_HANDLE;
+
+		/**
+		* Create the staging ring and recycled per-batch resources
+		*
+		* @param device Device to upload to (created with a transfer queue to benefit from asynchronous uploads)
+		* @param graphicsQueue Queue of the graphics family that consumes the uploads, only submitted to from the calling thread
+		* @param stagingSize (Optional) Size of the staging ring, uploads larger than this get a staging buffer of their own
+		*/
+		void create(vks::VulkanDevice *device, VkQueue graphicsQueue, VkDeviceSize stagingSize = 64 * 1024 * 1024);
+		void destroy();
+
+		/**
+		* Queue an upload to a buffer, the data is copied to the staging ring right away
+		*
+		* @param buffer Buffer created with VK_BUFFER_USAGE_TRANSFER_DST_BIT and exclusive sharing mode
+		* @param data Data to upload
+		* @param size Size of the data in bytes
+		* @param dstOffset (Optional) Offset into the buffer to upload to
+		*
+		* @return Value the timeline semaphore is signaled with once the upload has completed
+		*/
+		uint64_t uploadBuffer(VkBuffer buffer, const void *data, VkDeviceSize size, VkDeviceSize dstOffset = 0);
+
+		/**
+		* Queue an upload to an image, the data is copied to the staging ring right away
+		*
+		* @param image Image created with VK_IMAGE_USAGE_TRANSFER_DST_BIT and exclusive sharing mode, the current content of the subresources is discarded
+		* @param data Data to upload
+		* @param size Size of the data in bytes
+		* @param regions Copy regions, with bufferOffset relative to data (and image offsets and extents respecting imageTransferGranularity)
+		* @param subresourceRange Subresources touched by the regions
+		* @param newLayout Layout the subresources are in once the upload has completed
+		*
+		* @return Value the timeline semaphore is signaled with once the upload has completed
+		*/
+		uint64_t uploadImage(VkImage image, const void *data, VkDeviceSize size, const std::vector<VkBufferImageCopy> &regions, const VkImageSubresourceRange &subresourceRange, VkImageLayout newLayout);
+
+		/**
+		* Submit all queued uploads as one batch, does nothing if called from another thread than the one that created the engine
+		*
+		* @return Value of the submitted batch (or of the last batch if there was nothing to submit)
+		*/
+		uint64_t submit();
+
+		/** @brief Wait on the host until the batch with the given value has completed, submits the pending batch if required (batches that haven't been submitted yet can only be waited for on the thread that created the engine, other threads throw) */
+		void wait(uint64_t value);
+		/** @brief Returns true if the batch with the given value has completed */
+		bool isComplete(uint64_t value);
+		/** @brief Wait for all uploads, including the ones not submitted yet */
+		void flush();
+
+	private:
+		struct Batch
+		{
+			VkCommandBuffer transferCommandBuffer = VK_NULL_HANDLE;
+			VkCommandBuffer graphicsCommandBuffer = VK_NULL_HANDLE;
+			// Signaled by the transfer submission, waited on by the submission acquiring ownership on the graphics queue
+			VkSemaphore ownershipSemaphore = VK_NULL_HANDLE;
+			VkFence fence = VK_NULL_HANDLE;
+			// Value of the batch, 0 if it's not in flight
+			uint64_t value = 0;
+			// Bytes (including alignment padding) of the staging ring used by this batch
+			VkDeviceSize stagingUsage = 0;
+			// Staging buffers for uploads that don't fit into the ring
+			std::vector<vks::Buffer> dedicatedStaging;
+			// Barriers recorded on the transfer queue after the copies (releasing ownership) and on the graphics queue (acquiring ownership)
+			std::vector<VkBufferMemoryBarrier> bufferBarriers;
+			std::vector<VkImageMemoryBarrier> imageBarriers;
+		};
+
+		VkQueue graphicsQueue = VK_NULL_HANDLE;
+		uint32_t transferFamilyIndex = 0;
+		uint32_t graphicsFamilyIndex = 0;
+		VkCommandPool transferCommandPool = VK_NULL_HANDLE;
+		VkCommandPool graphicsCommandPool = VK_NULL_HANDLE;
+
+		vks::Buffer staging;
+		VkDeviceSize stagingHead = 0;
+		VkDeviceSize stagingUsed = 0;
+
+		Batch batches[maxBatchesInFlight];
+		uint32_t currentBatch = 0;
+		bool recording = false;
+		uint64_t nextValue = 1;
+		uint64_t completedValue = 0;
+		// Uploads may be queued from multiple threads
+		std::recursive_mutex mutex;
+		// Thread that created the engine, the only one submitting to the transfer and graphics queues
+		std::thread::id submitThread;
+
+		void beginBatch();
+		void retireBatch(Batch &batch, bool wait);
+		void retireBatches(uint64_t waitValue);
+		void submitBatch(Batch &batch, uint64_t value);
+		bool isSubmitThread() const;
+		void *allocateStaging(VkDeviceSize size, VkBuffer *buffer, VkDeviceSize *offset);
+	};
+}
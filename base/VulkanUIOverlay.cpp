@@ -8,9 +8,32 @@
 */
 
 #include "VulkanUIOverlay.h"
+#include "VulkanObjectCounters.h"
 
 namespace vks 
 {
+	namespace
+	{
+		// Returns true if the buffer had to be (re)created to fit the given size
+		bool growBuffer(vks::VulkanDevice *device, VkBufferUsageFlags usageFlags, vks::Buffer &buffer, VkDeviceSize size)
+		{
+			if ((buffer.buffer != VK_NULL_HANDLE) && (buffer.size >= size)) {
+				return false;
+			}
+			VkDeviceSize newSize = std::max(buffer.size * 2, static_cast<VkDeviceSize>(UIOverlay::minBufferSize));
+			while (newSize < size) {
+				newSize *= 2;
+			}
+			if (buffer.buffer != VK_NULL_HANDLE) {
+				buffer.unmap();
+				buffer.destroy();
+			}
+			VK_CHECK_RESULT(device->createBuffer(usageFlags, vks::MemoryUsage::Dynamic, &buffer, newSize));
+			VK_CHECK_RESULT(buffer.map());
+			return true;
+		}
+	}
+
 	UIOverlay::UIOverlay()
 	{
 #if defined(__ANDROID__)		
@@ -57,6 +80,9 @@ namespace vks
 	{
 		ImGuiIO& io = ImGui::GetIO();
 
+		// Vertex and index buffers are created on the first update of each frame in flight
+		frames.resize(framesInFlight);
+
 		// Create font texture
 		unsigned char* fontData;
 		int texWidth, texHeight;
@@ -99,7 +125,7 @@ namespace vks
 		VkMemoryAllocateInfo memAllocInfo = vks::initializers::memoryAllocateInfo();
 		memAllocInfo.allocationSize = memReqs.size;
 		memAllocInfo.memoryTypeIndex = device->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-		VK_CHECK_RESULT(vkAllocateMemory(device->logicalDevice, &memAllocInfo, nullptr, &fontMemory));
+		VK_CHECK_RESULT(device->allocateMemory(memAllocInfo, &fontMemory, vks::MemoryCategory::Texture, "UI overlay font"));
 		VK_CHECK_RESULT(vkBindImageMemory(device->logicalDevice, fontImage, fontMemory, 0));
 
 		// Image view
@@ -196,7 +222,7 @@ namespace vks
 
 		// Descriptor set
 		VkDescriptorSetAllocateInfo allocInfo = vks::initializers::descriptorSetAllocateInfo(descriptorPool, &descriptorSetLayout, 1);
-		VK_CHECK_RESULT(vkAllocateDescriptorSets(device->logicalDevice, &allocInfo, &descriptorSet));
+		VK_CHECK_RESULT(vks::ObjectCounters::allocateDescriptorSets(device->logicalDevice, &allocInfo, &descriptorSet));
 		VkDescriptorImageInfo fontDescriptor = vks::initializers::descriptorImageInfo(
 			sampler,
 			fontView,
@@ -247,7 +273,7 @@ namespace vks
 			vks::initializers::pipelineViewportStateCreateInfo(1, 1, 0);
 
 		VkPipelineMultisampleStateCreateInfo multisampleState =
-			vks::initializers::pipelineMultisampleStateCreateInfo(rasterizationSamples);
+			vks::initializers::pipelineMultisampleStateCreateInfo(VK_SAMPLE_COUNT_1_BIT);
 
 		std::vector<VkDynamicState> dynamicStateEnables = {
 			VK_DYNAMIC_STATE_VIEWPORT,
@@ -267,7 +293,6 @@ namespace vks
 		pipelineCreateInfo.pDynamicState = &dynamicState;
 		pipelineCreateInfo.stageCount = static_cast<uint32_t>(shaders.size());
 		pipelineCreateInfo.pStages = shaders.data();
-		pipelineCreateInfo.subpass = subpass;
 
 		// Vertex bindings an attributes based on ImGui vertex definition
 		std::vector<VkVertexInputBindingDescription> vertexInputBindings = {
@@ -286,51 +311,36 @@ namespace vks
 
 		pipelineCreateInfo.pVertexInputState = &vertexInputState;
 
-		VK_CHECK_RESULT(vkCreateGraphicsPipelines(device->logicalDevice, pipelineCache, 1, &pipelineCreateInfo, nullptr, &pipeline));
+		VK_CHECK_RESULT(vks::ObjectCounters::createGraphicsPipelines(device->logicalDevice, pipelineCache, 1, &pipelineCreateInfo, nullptr, &pipeline));
 	}
 
-	/** Update vertex and index buffer containing the imGui elements when required */
-	bool UIOverlay::update()
+	/**
+	* Upload the current ImGui draw data to the buffers of a frame in flight, growing them if required
+	*
+	* @param frameIndex Frame in flight whose buffers are updated, the device must no longer be using them
+	*
+	* @return True if the buffers have been recreated (command buffers drawing the overlay for this frame need to be re-recorded)
+	*/
+	bool UIOverlay::update(uint32_t frameIndex)
 	{
 		ImDrawData* imDrawData = ImGui::GetDrawData();
-		bool updateCmdBuffers = false;
 
 		if (!imDrawData) { return false; };
 
-		// Note: Alignment is done inside buffer creation
 		VkDeviceSize vertexBufferSize = imDrawData->TotalVtxCount * sizeof(ImDrawVert);
 		VkDeviceSize indexBufferSize = imDrawData->TotalIdxCount * sizeof(ImDrawIdx);
 
-		// Update buffers only if vertex or index count has been changed compared to current buffer size
 		if ((vertexBufferSize == 0) || (indexBufferSize == 0)) {
 			return false;
 		}
 
-		// Vertex buffer
-		if ((vertexBuffer.buffer == VK_NULL_HANDLE) || (vertexCount != imDrawData->TotalVtxCount)) {
-			vertexBuffer.unmap();
-			vertexBuffer.destroy();
-			VK_CHECK_RESULT(device->createBuffer(VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, &vertexBuffer, vertexBufferSize));
-			vertexCount = imDrawData->TotalVtxCount;
-			vertexBuffer.unmap();
-			vertexBuffer.map();
-			updateCmdBuffers = true;
-		}
-
-		// Index buffer
-		VkDeviceSize indexSize = imDrawData->TotalIdxCount * sizeof(ImDrawIdx);
-		if ((indexBuffer.buffer == VK_NULL_HANDLE) || (indexCount < imDrawData->TotalIdxCount)) {
-			indexBuffer.unmap();
-			indexBuffer.destroy();
-			VK_CHECK_RESULT(device->createBuffer(VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, &indexBuffer, indexBufferSize));
-			indexCount = imDrawData->TotalIdxCount;
-			indexBuffer.map();
-			updateCmdBuffers = true;
-		}
+		FrameBuffers &frame = frames[frameIndex];
+		bool updateCmdBuffers = growBuffer(device, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, frame.vertexBuffer, vertexBufferSize);
+		updateCmdBuffers |= growBuffer(device, VK_BUFFER_USAGE_INDEX_BUFFER_BIT, frame.indexBuffer, indexBufferSize);
 
 		// Upload data
-		ImDrawVert* vtxDst = (ImDrawVert*)vertexBuffer.mapped;
-		ImDrawIdx* idxDst = (ImDrawIdx*)indexBuffer.mapped;
+		ImDrawVert* vtxDst = (ImDrawVert*)frame.vertexBuffer.mapped;
+		ImDrawIdx* idxDst = (ImDrawIdx*)frame.indexBuffer.mapped;
 
 		for (int n = 0; n < imDrawData->CmdListsCount; n++) {
 			const ImDrawList* cmd_list = imDrawData->CmdLists[n];
@@ -341,13 +351,15 @@ namespace vks
 		}
 
 		// Flush to make writes visible to GPU
-		vertexBuffer.flush();
-		indexBuffer.flush();
+		if (!(frame.vertexBuffer.memoryPropertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)) {
+			frame.vertexBuffer.flush();
+			frame.indexBuffer.flush();
+		}
 
 		return updateCmdBuffers;
 	}
 
-	void UIOverlay::draw(const VkCommandBuffer commandBuffer)
+	void UIOverlay::draw(const VkCommandBuffer commandBuffer, uint32_t frameIndex)
 	{
 		ImDrawData* imDrawData = ImGui::GetDrawData();
 		int32_t vertexOffset = 0;
@@ -357,6 +369,11 @@ namespace vks
 			return;
 		}
 
+		const FrameBuffers &frame = frames[frameIndex];
+		if ((frame.vertexBuffer.buffer == VK_NULL_HANDLE) || (frame.indexBuffer.buffer == VK_NULL_HANDLE)) {
+			return;
+		}
+
 		ImGuiIO& io = ImGui::GetIO();
 
 		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
@@ -367,9 +384,12 @@ namespace vks
 		vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(PushConstBlock), &pushConstBlock);
 
 		VkDeviceSize offsets[1] = { 0 };
-		vkCmdBindVertexBuffers(commandBuffer, 0, 1, &vertexBuffer.buffer, offsets);
-		vkCmdBindIndexBuffer(commandBuffer, indexBuffer.buffer, 0, VK_INDEX_TYPE_UINT16);
+		vkCmdBindVertexBuffers(commandBuffer, 0, 1, &frame.vertexBuffer.buffer, offsets);
+		vkCmdBindIndexBuffer(commandBuffer, frame.indexBuffer.buffer, 0, VK_INDEX_TYPE_UINT16);
 
+		// Consecutive draw commands often share the same clip rectangle
+		VkRect2D currentScissor = {};
+		bool scissorSet = false;
 		for (int32_t i = 0; i < imDrawData->CmdListsCount; i++)
 		{
 			const ImDrawList* cmd_list = imDrawData->CmdLists[i];
@@ -381,7 +401,11 @@ namespace vks
 				scissorRect.offset.y = std::max((int32_t)(pcmd->ClipRect.y), 0);
 				scissorRect.extent.width = (uint32_t)(pcmd->ClipRect.z - pcmd->ClipRect.x);
 				scissorRect.extent.height = (uint32_t)(pcmd->ClipRect.w - pcmd->ClipRect.y);
-				vkCmdSetScissor(commandBuffer, 0, 1, &scissorRect);
+				if (!scissorSet || (memcmp(&scissorRect, &currentScissor, sizeof(VkRect2D)) != 0)) {
+					vkCmdSetScissor(commandBuffer, 0, 1, &scissorRect);
+					currentScissor = scissorRect;
+					scissorSet = true;
+				}
 				vkCmdDrawIndexed(commandBuffer, pcmd->ElemCount, 1, indexOffset, vertexOffset, 0);
 				indexOffset += pcmd->ElemCount;
 			}
@@ -398,16 +422,19 @@ namespace vks
 	void UIOverlay::freeResources()
 	{
 		ImGui::DestroyContext();
-		vertexBuffer.destroy();
-		indexBuffer.destroy();
+		for (auto& frame : frames) {
+			frame.vertexBuffer.destroy();
+			frame.indexBuffer.destroy();
+		}
+		frames.clear();
 		vkDestroyImageView(device->logicalDevice, fontView, nullptr);
 		vkDestroyImage(device->logicalDevice, fontImage, nullptr);
-		vkFreeMemory(device->logicalDevice, fontMemory, nullptr);
+		device->freeMemory(fontMemory);
 		vkDestroySampler(device->logicalDevice, sampler, nullptr);
 		vkDestroyDescriptorSetLayout(device->logicalDevice, descriptorSetLayout, nullptr);
 		vkDestroyDescriptorPool(device->logicalDevice, descriptorPool, nullptr);
 		vkDestroyPipelineLayout(device->logicalDevice, pipelineLayout, nullptr);
-		vkDestroyPipeline(device->logicalDevice, pipeline, nullptr);
+		vks::ObjectCounters::destroyPipeline(device->logicalDevice, pipeline, nullptr);
 	}
 
 	bool UIOverlay::header(const char *caption)
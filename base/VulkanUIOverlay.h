@@ -36,13 +36,16 @@ namespace vks
 		vks::VulkanDevice *device;
 		VkQueue queue;
 
-		VkSampleCountFlagBits rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
-		uint32_t subpass = 0;
-
-		vks::Buffer vertexBuffer;
-		vks::Buffer indexBuffer;
-		int32_t vertexCount = 0;
-		int32_t indexCount = 0;
+		/** @brief Vertex and index data of a single frame in flight, persistently mapped and grown geometrically (never shrunk) */
+		struct FrameBuffers {
+			vks::Buffer vertexBuffer;
+			vks::Buffer indexBuffer;
+		};
+		/** @brief Number of frames in flight the overlay is drawn for (set before calling prepareResources), each frame has buffers of it's own */
+		uint32_t framesInFlight = 1;
+		std::vector<FrameBuffers> frames;
+		/** @brief Initial size of the vertex and index buffers */
+		static const VkDeviceSize minBufferSize = 16 * 1024;
 
 		std::vector<VkPipelineShaderStageCreateInfo> shaders;
 
@@ -72,8 +75,8 @@ namespace vks
 		void preparePipeline(const VkPipelineCache pipelineCache, const VkRenderPass renderPass);
 		void prepareResources();
 
-		bool update();
-		void draw(const VkCommandBuffer commandBuffer);
+		bool update(uint32_t frameIndex = 0);
+		void draw(const VkCommandBuffer commandBuffer, uint32_t frameIndex = 0);
 		void resize(uint32_t width, uint32_t height);
 
 		void freeResources();
@@ -11,10 +11,16 @@
 #include <stdlib.h>
 #include <string>
 #include <fstream>
+#include <functional>
+#include <map>
+#include <mutex>
 #include <vector>
 
 #include "vulkan/vulkan.h"
 #include "VulkanDevice.h"
+#include "VulkanMipGenerator.h"
+#include "VulkanThreadCommandPools.h"
+#include "VulkanTransferEngine.h"
 
 #include <ktx.h>
 #include <ktxvulkan.h>
@@ -57,6 +63,7 @@ namespace vkglTF
 		VkImage image;
 		VkImageLayout imageLayout;
 		VkDeviceMemory deviceMemory;
+		vks::Allocation* allocation = nullptr;
 		VkImageView view;
 		uint32_t width, height;
 		uint32_t mipLevels;
@@ -218,14 +225,15 @@ namespace vkglTF
 		glm::vec4 joint0;
 		glm::vec4 weight0;
 		glm::vec4 tangent;
-		static VkVertexInputBindingDescription vertexInputBindingDescription;
-		static std::vector<VkVertexInputAttributeDescription> vertexInputAttributeDescriptions;
-		static VkPipelineVertexInputStateCreateInfo pipelineVertexInputStateCreateInfo;
 		static VkVertexInputBindingDescription inputBindingDescription(uint32_t binding);
 		static VkVertexInputAttributeDescription inputAttributeDescription(uint32_t binding, uint32_t location, VertexComponent component);
 		static std::vector<VkVertexInputAttributeDescription> inputAttributeDescriptions(uint32_t binding, const std::vector<VertexComponent> components);
-		/** @brief Returns the default pipeline vertex input state create info structure for the requested vertex components */
-		static VkPipelineVertexInputStateCreateInfo* getPipelineVertexInputState(const std::vector<VertexComponent> components);
+		/**
+		* Returns the default pipeline vertex input state create info structure for the requested vertex components
+		* The state is shared by all calls with the same components and stays valid until the program ends, so this can be called from multiple threads
+		* and the returned pointer can be kept, e.g. in create infos added to a vks::PipelineBatch
+		*/
+		static const VkPipelineVertexInputStateCreateInfo* getPipelineVertexInputState(const std::vector<VertexComponent> components);
 	};
 
 	enum FileLoadingFlags {
@@ -251,7 +259,14 @@ namespace vkglTF
 		vkglTF::Texture* getTexture(uint32_t index);
 		vkglTF::Texture emptyTexture;
 		void createEmptyTexture(VkQueue transferQueue);
+		// Primitives in draw order for the alpha mode render flags they were built for, built on the first parallel draw with these flags
+		std::map<uint32_t, std::vector<Primitive*>> drawLists;
+		bool isDrawn(const Primitive* primitive, uint32_t renderFlags) const;
+		void buildDrawList(Node* node, uint32_t renderFlags, std::vector<Primitive*>& drawList);
 	public:
+		/** @brief Minimum number of primitives recorded into a single secondary command buffer by drawParallel */
+		static const uint32_t parallelDrawChunkSize = 256;
+
 		vks::VulkanDevice* device;
 		VkDescriptorPool descriptorPool;
 
@@ -298,6 +313,20 @@ namespace vkglTF
 		void bindBuffers(VkCommandBuffer commandBuffer);
 		void drawNode(Node* node, VkCommandBuffer commandBuffer, uint32_t renderFlags = 0, VkPipelineLayout pipelineLayout = VK_NULL_HANDLE, uint32_t bindImageSet = 1);
 		void draw(VkCommandBuffer commandBuffer, uint32_t renderFlags = 0, VkPipelineLayout pipelineLayout = VK_NULL_HANDLE, uint32_t bindImageSet = 1);
+		/**
+		* Record the same draws as draw, split into chunks that are recorded in parallel into secondary command buffers and executed from commandBuffer
+		*
+		* @param commandBuffer Primary command buffer inside a subpass begun with VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
+		* @param commandPools Per-thread pools the secondary command buffers are taken from, beginFrame must have been called for the current frame
+		* @param inheritanceInfo Render pass, subpass (and optionally framebuffer) the secondary command buffers are executed in
+		* @param bindState Called at the start of every chunk to bind the pipeline, descriptor sets and dynamic state, as secondary command buffers don't inherit them
+		* @param (Optional) renderFlags See draw
+		* @param (Optional) pipelineLayout See draw
+		* @param (Optional) bindImageSet See draw
+		*
+		* @note bindState may be called on multiple threads at the same time
+		*/
+		void drawParallel(VkCommandBuffer commandBuffer, vks::ThreadCommandPools& commandPools, const VkCommandBufferInheritanceInfo& inheritanceInfo, const std::function<void(VkCommandBuffer)>& bindState, uint32_t renderFlags = 0, VkPipelineLayout pipelineLayout = VK_NULL_HANDLE, uint32_t bindImageSet = 1);
 		void getNodeDimensions(Node* node, glm::vec3& min, glm::vec3& max);
 		void getSceneDimensions();
 		void updateAnimation(uint32_t index, float time);
@@ -13,20 +13,267 @@
 #include <functional>
 #include <chrono>
 #include <iomanip>
+#include <numeric>
+#include <fstream>
+#include <cmath>
+
+#include "VulkanLatencyTracker.h"
+#include "VulkanGpuProfiler.h"
+#include "VulkanCameraPath.h"
+#include "VulkanObjectCounters.h"
+#include "VulkanTools.h"
 
 namespace vks
 {
 	class Benchmark {
+	public:
+		/** @brief Frame time distribution in milliseconds */
+		struct FrameTimeStats
+		{
+			uint32_t count = 0;
+			double min = 0.0;
+			double max = 0.0;
+			double average = 0.0;
+			double standardDeviation = 0.0;
+			double p50 = 0.0;
+			double p90 = 0.0;
+			double p95 = 0.0;
+			double p99 = 0.0;
+			double p999 = 0.0;
+			/** @brief Number of frames at or above each of the hitch thresholds */
+			std::vector<uint32_t> hitchCounts;
+			/** @brief Number of frames taking longer than stutterFactor times the median frame time */
+			uint32_t stutterCount = 0;
+			/** @brief Number of frames per histogram bucket, the last bucket also counts all longer frames */
+			std::vector<uint32_t> histogram;
+		};
+
+		/** @brief Memory and object usage of the example over the whole run (including startup) */
+		struct ResourceFootprint
+		{
+			/** @brief Time from the start of the example's construction to the first presented frame in milliseconds */
+			double startupTime = 0.0;
+			/** @brief Peak resident memory (working set) of the process in bytes, 0 if not available */
+			uint64_t peakResidentBytes = 0;
+			struct Heap
+			{
+				VkDeviceSize size = 0;
+				bool deviceLocal = false;
+				/** @brief Peak of the memory allocated from the heap through the framework */
+				VkDeviceSize peakBytes = 0;
+				/** @brief Budget and peak usage of the heap as reported by the driver, only valid if memoryBudget is set */
+				VkDeviceSize budget = 0;
+				VkDeviceSize peakUsage = 0;
+			};
+			std::vector<Heap> heaps;
+			/** @brief Set if the heap budgets have been queried (VK_EXT_memory_budget) */
+			bool memoryBudget = false;
+			/** @brief Peak number of allocations made through the framework (sub-allocations and direct allocations) */
+			uint32_t peakAllocationCount = 0;
+			/** @brief Device memory allocations of the sub-allocator at the end of the run (blocks and dedicated allocations) */
+			uint32_t deviceAllocationCount = 0;
+			vks::ObjectCounters::Counts objects;
+		};
+
 	private:
 		FILE *stream;
 		VkPhysicalDeviceProperties deviceProps;
+
+		static std::string escapeJson(const std::string &value) {
+			std::string result;
+			for (char c : value) {
+				if ((c == '"') || (c == '\\')) {
+					result += '\\';
+				}
+				// Control characters are not expected in device names
+				if (static_cast<unsigned char>(c) >= 0x20) {
+					result += c;
+				}
+			}
+			return result;
+		}
+
+		void computeStats() {
+			stats = FrameTimeStats();
+			stats.hitchCounts.assign(hitchThresholds.size(), 0);
+			stats.histogram.assign(histogramBucketCount, 0);
+			if (frameTimes.empty()) {
+				return;
+			}
+			std::vector<double> sorted = frameTimes;
+			std::sort(sorted.begin(), sorted.end());
+			stats.count = static_cast<uint32_t>(sorted.size());
+			stats.min = sorted.front();
+			stats.max = sorted.back();
+			stats.average = std::accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size();
+			double variance = 0.0;
+			for (double frameTime : sorted) {
+				variance += (frameTime - stats.average) * (frameTime - stats.average);
+			}
+			stats.standardDeviation = std::sqrt(variance / sorted.size());
+			stats.p50 = vks::tools::percentile(sorted, 0.50);
+			stats.p90 = vks::tools::percentile(sorted, 0.90);
+			stats.p95 = vks::tools::percentile(sorted, 0.95);
+			stats.p99 = vks::tools::percentile(sorted, 0.99);
+			stats.p999 = vks::tools::percentile(sorted, 0.999);
+			for (double frameTime : frameTimes) {
+				for (size_t i = 0; i < hitchThresholds.size(); i++) {
+					if (frameTime >= hitchThresholds[i]) {
+						stats.hitchCounts[i]++;
+					}
+				}
+				if (frameTime > stutterFactor * stats.p50) {
+					stats.stutterCount++;
+				}
+				if (histogramBucketCount > 0) {
+					const size_t bucket = static_cast<size_t>(frameTime / histogramBucketWidth);
+					stats.histogram[std::min(bucket, static_cast<size_t>(histogramBucketCount - 1))]++;
+				}
+			}
+		}
+
+		/** @brief Name of the JSON result file, the CSV file name with it's extension replaced */
+		std::string getJsonFilename() const {
+			const size_t separator = filename.find_last_of("/\\");
+			const size_t extension = filename.find_last_of('.');
+			if ((extension != std::string::npos) && ((separator == std::string::npos) || (extension > separator))) {
+				return filename.substr(0, extension) + ".json";
+			}
+			return filename + ".json";
+		}
+
+		void printFootprint() const {
+			std::cout << "startup: " << footprint.startupTime << " ms to the first presented frame" << "\n";
+			std::cout << "peak resident memory: " << footprint.peakResidentBytes / (1024.0 * 1024.0) << " MiB" << "\n";
+			for (size_t i = 0; i < footprint.heaps.size(); i++) {
+				const ResourceFootprint::Heap &heap = footprint.heaps[i];
+				std::cout << "heap " << i << (heap.deviceLocal ? " (device local)" : "") << ": peak " << heap.peakBytes / (1024.0 * 1024.0) << " MiB allocated";
+				if (footprint.memoryBudget) {
+					std::cout << ", peak " << heap.peakUsage / (1024.0 * 1024.0) << " MiB used of " << heap.budget / (1024.0 * 1024.0) << " MiB budget";
+				}
+				std::cout << "\n";
+			}
+			std::cout << "allocations: " << footprint.peakAllocationCount << " peak, " << footprint.deviceAllocationCount << " device allocations" << "\n";
+			std::cout << "pipelines: " << footprint.objects.graphicsPipelines << " graphics, " << footprint.objects.computePipelines << " compute, " << footprint.objects.peakLivePipelines << " peak live, "
+				<< footprint.objects.pipelineCreationTime << " ms creation time" << "\n";
+			std::cout << "descriptor sets: " << footprint.objects.descriptorSets << "\n";
+		}
+
+		void saveJson() {
+			std::ofstream result(getJsonFilename(), std::ios::out);
+			if (!result.is_open()) {
+				return;
+			}
+			result << std::fixed << std::setprecision(4);
+			result << "{\n";
+			result << "\t\"device\": \"" << escapeJson(deviceProps.deviceName) << "\",\n";
+			result << "\t\"driverVersion\": " << deviceProps.driverVersion << ",\n";
+			result << "\t\"runtime\": " << runtime << ",\n";
+			result << "\t\"frames\": " << frameCount << ",\n";
+			result << "\t\"fps\": " << frameCount / (runtime / 1000.0) << ",\n";
+			if (cameraPath) {
+				result << "\t\"cameraPath\": { \"duration\": " << cameraPath->getDuration() << ", \"frames\": " << cameraPath->getFrameCount() << ", \"timeStep\": " << cameraPath->timeStep << " },\n";
+			}
+			result << "\t\"frameTimes\": { \"min\": " << stats.min << ", \"max\": " << stats.max << ", \"avg\": " << stats.average << ", \"stddev\": " << stats.standardDeviation
+				<< ", \"p50\": " << stats.p50 << ", \"p90\": " << stats.p90 << ", \"p95\": " << stats.p95 << ", \"p99\": " << stats.p99 << ", \"p99.9\": " << stats.p999 << " },\n";
+			result << "\t\"hitches\": [";
+			for (size_t i = 0; i < hitchThresholds.size(); i++) {
+				result << (i > 0 ? ", " : " ") << "{ \"threshold\": " << hitchThresholds[i] << ", \"frames\": " << stats.hitchCounts[i] << " }";
+			}
+			result << " ],\n";
+			result << "\t\"stutter\": { \"factor\": " << stutterFactor << ", \"frames\": " << stats.stutterCount << " },\n";
+			result << "\t\"histogram\": { \"bucketWidth\": " << histogramBucketWidth << ", \"buckets\": [";
+			for (size_t i = 0; i < stats.histogram.size(); i++) {
+				result << (i > 0 ? ", " : " ") << stats.histogram[i];
+			}
+			result << " ] }";
+			if (collectFootprint) {
+				result << ",\n\t\"footprint\": {\n";
+				result << "\t\t\"startupTime\": " << footprint.startupTime << ",\n";
+				result << "\t\t\"peakResidentBytes\": " << footprint.peakResidentBytes << ",\n";
+				result << "\t\t\"heaps\": [";
+				for (size_t i = 0; i < footprint.heaps.size(); i++) {
+					const ResourceFootprint::Heap &heap = footprint.heaps[i];
+					result << (i > 0 ? ", " : " ") << "{ \"size\": " << heap.size << ", \"deviceLocal\": " << (heap.deviceLocal ? "true" : "false") << ", \"peakAllocatedBytes\": " << heap.peakBytes;
+					if (footprint.memoryBudget) {
+						result << ", \"budget\": " << heap.budget << ", \"peakUsage\": " << heap.peakUsage;
+					}
+					result << " }";
+				}
+				result << " ],\n";
+				result << "\t\t\"peakAllocations\": " << footprint.peakAllocationCount << ",\n";
+				result << "\t\t\"deviceAllocations\": " << footprint.deviceAllocationCount << ",\n";
+				result << "\t\t\"graphicsPipelines\": " << footprint.objects.graphicsPipelines << ",\n";
+				result << "\t\t\"computePipelines\": " << footprint.objects.computePipelines << ",\n";
+				result << "\t\t\"peakLivePipelines\": " << footprint.objects.peakLivePipelines << ",\n";
+				result << "\t\t\"pipelineCreationTime\": " << footprint.objects.pipelineCreationTime << ",\n";
+				result << "\t\t\"descriptorSets\": " << footprint.objects.descriptorSets << "\n";
+				result << "\t}";
+			}
+			if (latency) {
+				result << ",\n\t\"latency\": {\n";
+				for (uint32_t i = 0; i < static_cast<uint32_t>(vks::LatencyTracker::Metric::Count); i++) {
+					const vks::LatencyTracker::Metric metric = static_cast<vks::LatencyTracker::Metric>(i);
+					const vks::LatencyTracker::Distribution distribution = latency->getDistribution(metric);
+					result << "\t\t\"" << vks::LatencyTracker::getMetricName(metric) << "\": { \"samples\": " << distribution.count << ", \"min\": " << distribution.min << ", \"avg\": " << distribution.average
+						<< ", \"p50\": " << distribution.p50 << ", \"p90\": " << distribution.p90 << ", \"p99\": " << distribution.p99 << ", \"max\": " << distribution.max << " }";
+					result << ((i + 1 < static_cast<uint32_t>(vks::LatencyTracker::Metric::Count)) ? ",\n" : "\n");
+				}
+				result << "\t}";
+			}
+			if (gpuProfiler) {
+				const std::vector<vks::GpuProfiler::ScopeStats> scopes = gpuProfiler->getStats();
+				result << ",\n\t\"gpu\": [\n";
+				for (size_t i = 0; i < scopes.size(); i++) {
+					result << "\t\t{ \"scope\": \"" << escapeJson(scopes[i].name) << "\", \"samples\": " << scopes[i].count << ", \"min\": " << scopes[i].min << ", \"avg\": " << scopes[i].average
+						<< ", \"p50\": " << scopes[i].p50 << ", \"p90\": " << scopes[i].p90 << ", \"p99\": " << scopes[i].p99 << ", \"max\": " << scopes[i].max << " }";
+					result << ((i + 1 < scopes.size()) ? ",\n" : "\n");
+				}
+				result << "\t]";
+				if (gpuProfiler->pipelineStatisticsEnabled()) {
+					result << ",\n\t\"pipelineStatistics\": {";
+					for (uint32_t i = 0; i < static_cast<uint32_t>(vks::GpuProfiler::PipelineStatistic::Count); i++) {
+						const vks::GpuProfiler::PipelineStatistic statistic = static_cast<vks::GpuProfiler::PipelineStatistic>(i);
+						result << (i > 0 ? ", " : " ") << "\"" << vks::GpuProfiler::getPipelineStatisticName(statistic) << "\": " << gpuProfiler->getPipelineStatistic(statistic);
+					}
+					result << " }";
+				}
+			}
+			if (outputFrameTimes) {
+				result << ",\n\t\"frameTimeSamples\": [";
+				for (size_t i = 0; i < frameTimes.size(); i++) {
+					result << (i > 0 ? ", " : " ") << frameTimes[i];
+				}
+				result << " ]";
+			}
+			result << "\n}\n";
+		}
+
 	public:
 		bool active = false;
 		bool outputFrameTimes = false;
 		uint32_t warmup = 1;
 		uint32_t duration = 10;
+		/** @brief Frame times of the benchmark phase, storage is reserved up front based on the frame rate of the warm up */
 		std::vector<double> frameTimes;
 		std::string filename = "";
+		/** @brief Frame times in milliseconds at and above which a frame is counted as a hitch */
+		std::vector<double> hitchThresholds = { 1000.0 / 60.0, 1000.0 / 30.0, 100.0 };
+		/** @brief Frames taking longer than this multiple of the median frame time are counted as stutter */
+		double stutterFactor = 2.0;
+		/** @brief Width of the frame time histogram buckets in milliseconds */
+		double histogramBucketWidth = 1.0;
+		uint32_t histogramBucketCount = 64;
+		FrameTimeStats stats;
+		/** @brief Latency tracker of the example, samples are discarded after the warm up and the distributions are reported with the results */
+		vks::LatencyTracker *latency = nullptr;
+		/** @brief GPU profiler of the example, samples are discarded after the warm up and the device time of every recorded scope is reported with the results */
+		vks::GpuProfiler *gpuProfiler = nullptr;
+		/** @brief Camera path replayed by the example's frames, if set the benchmark phase renders a single replay of the path instead of running for the given duration */
+		vks::CameraPath *cameraPath = nullptr;
+		/** @brief Fills in the resource footprint of the example once the benchmark has finished, the footprint is only reported if this is set */
+		std::function<void(ResourceFootprint &footprint)> collectFootprint;
+		ResourceFootprint footprint;
 
 		double runtime = 0.0;
 		uint32_t frameCount = 0;
@@ -44,17 +291,33 @@ namespace vks
 			// Warm up phase to get more stable frame rates
 			{
 				double tMeasured = 0.0;
+				uint32_t warmupFrames = 0;
 				while (tMeasured < (warmup * 1000)) {
 					auto tStart = std::chrono::high_resolution_clock::now();
 					renderFunc();
 					auto tDiff = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
 					tMeasured += tDiff;
+					warmupFrames++;
 				};
+				// Reserve storage for the frame times with some headroom, so recording them doesn't allocate during the benchmark
+				const double estimatedFrames = (tMeasured > 0.0) ? (warmupFrames / tMeasured) * (duration * 1000.0) : 0.0;
+				frameTimes.reserve(cameraPath ? cameraPath->getFrameCount() : static_cast<size_t>(estimatedFrames * 1.5) + 1024);
+			}
+
+			if (latency) {
+				latency->reset();
+			}
+			if (gpuProfiler) {
+				gpuProfiler->reset();
+			}
+			// The warm up may have replayed parts of the path, the benchmark always starts at it's beginning
+			if (cameraPath) {
+				cameraPath->rewind();
 			}
 
 			// Benchmark phase
 			{
-				while (runtime < (duration * 1000.0)) {
+				while (cameraPath ? !cameraPath->finished() : (runtime < (duration * 1000.0))) {
 					auto tStart = std::chrono::high_resolution_clock::now();
 					renderFunc();
 					auto tDiff = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
@@ -67,6 +330,35 @@ namespace vks
 				std::cout << "runtime: " << (runtime / 1000.0) << "\n";
 				std::cout << "frames : " << frameCount << "\n";
 				std::cout << "fps    : " << frameCount / (runtime / 1000.0) << "\n";
+				if (cameraPath) {
+					std::cout << "camera path: " << cameraPath->getDuration() << " s replayed in " << cameraPath->getFrameCount() << " frames of " << cameraPath->timeStep * 1000.0f << " ms" << "\n";
+				}
+				computeStats();
+				std::cout << "frame time: avg " << stats.average << " ms, stddev " << stats.standardDeviation << " ms, min " << stats.min << " ms, max " << stats.max << " ms" << "\n";
+				std::cout << "frame time: p50 " << stats.p50 << " ms, p90 " << stats.p90 << " ms, p95 " << stats.p95 << " ms, p99 " << stats.p99 << " ms, p99.9 " << stats.p999 << " ms" << "\n";
+				for (size_t i = 0; i < hitchThresholds.size(); i++) {
+					std::cout << "hitches >= " << hitchThresholds[i] << " ms: " << stats.hitchCounts[i] << "\n";
+				}
+				std::cout << "stutter (> " << stutterFactor << "x median): " << stats.stutterCount << "\n";
+				if (latency) {
+					for (uint32_t i = 0; i < static_cast<uint32_t>(vks::LatencyTracker::Metric::Count); i++) {
+						const vks::LatencyTracker::Metric metric = static_cast<vks::LatencyTracker::Metric>(i);
+						const vks::LatencyTracker::Distribution distribution = latency->getDistribution(metric);
+						if (distribution.count > 0) {
+							std::cout << vks::LatencyTracker::getMetricName(metric) << " : avg " << distribution.average << " ms, p50 " << distribution.p50 << " ms, p90 " << distribution.p90 << " ms, p99 " << distribution.p99 << " ms, max " << distribution.max << " ms" << "\n";
+						}
+					}
+				}
+				if (gpuProfiler) {
+					for (auto &scope : gpuProfiler->getStats()) {
+						std::cout << "gpu " << scope.name << " : avg " << scope.average << " ms, p50 " << scope.p50 << " ms, p90 " << scope.p90 << " ms, p99 " << scope.p99 << " ms, max " << scope.max << " ms" << "\n";
+					}
+				}
+				if (collectFootprint) {
+					footprint = ResourceFootprint();
+					collectFootprint(footprint);
+					printFootprint();
+				}
 			}
 		}
 
@@ -78,21 +370,69 @@ namespace vks
 				result << "device,driverversion,duration (ms),frames,fps" << "\n";
 				result << deviceProps.deviceName << "," << deviceProps.driverVersion << "," << runtime << "," << frameCount << "," << frameCount / (runtime / 1000.0) << "\n";
 
+				result << "\n" << "min (ms),max (ms),avg (ms),stddev (ms),p50 (ms),p90 (ms),p95 (ms),p99 (ms),p99.9 (ms),stutter frames" << "\n";
+				result << stats.min << "," << stats.max << "," << stats.average << "," << stats.standardDeviation << "," << stats.p50 << "," << stats.p90 << "," << stats.p95 << "," << stats.p99 << "," << stats.p999 << "," << stats.stutterCount << "\n";
+
+				result << "\n" << "hitch threshold (ms),frames" << "\n";
+				for (size_t i = 0; i < hitchThresholds.size(); i++) {
+					result << hitchThresholds[i] << "," << stats.hitchCounts[i] << "\n";
+				}
+
+				result << "\n" << "histogram bucket start (ms),frames" << "\n";
+				for (size_t i = 0; i < stats.histogram.size(); i++) {
+					result << i * histogramBucketWidth << "," << stats.histogram[i] << "\n";
+				}
+
+				if (latency) {
+					result << "\n" << "latency,samples,min (ms),avg (ms),p50 (ms),p90 (ms),p99 (ms),max (ms)" << "\n";
+					for (uint32_t i = 0; i < static_cast<uint32_t>(vks::LatencyTracker::Metric::Count); i++) {
+						const vks::LatencyTracker::Metric metric = static_cast<vks::LatencyTracker::Metric>(i);
+						const vks::LatencyTracker::Distribution distribution = latency->getDistribution(metric);
+						result << vks::LatencyTracker::getMetricName(metric) << "," << distribution.count << "," << distribution.min << "," << distribution.average << "," << distribution.p50 << "," << distribution.p90 << "," << distribution.p99 << "," << distribution.max << "\n";
+					}
+				}
+
+				if (gpuProfiler) {
+					result << "\n" << "gpu scope,samples,min (ms),avg (ms),p50 (ms),p90 (ms),p99 (ms),max (ms)" << "\n";
+					for (auto &scope : gpuProfiler->getStats()) {
+						result << scope.name << "," << scope.count << "," << scope.min << "," << scope.average << "," << scope.p50 << "," << scope.p90 << "," << scope.p99 << "," << scope.max << "\n";
+					}
+					if (gpuProfiler->pipelineStatisticsEnabled()) {
+						result << "\n" << "pipeline statistic,avg per frame" << "\n";
+						for (uint32_t i = 0; i < static_cast<uint32_t>(vks::GpuProfiler::PipelineStatistic::Count); i++) {
+							const vks::GpuProfiler::PipelineStatistic statistic = static_cast<vks::GpuProfiler::PipelineStatistic>(i);
+							result << vks::GpuProfiler::getPipelineStatisticName(statistic) << "," << gpuProfiler->getPipelineStatistic(statistic) << "\n";
+						}
+					}
+				}
+
+				if (collectFootprint) {
+					result << "\n" << "startup (ms),peak resident bytes,peak allocations,device allocations,graphics pipelines,compute pipelines,peak live pipelines,pipeline creation (ms),descriptor sets" << "\n";
+					result << footprint.startupTime << "," << footprint.peakResidentBytes << "," << footprint.peakAllocationCount << "," << footprint.deviceAllocationCount << "," << footprint.objects.graphicsPipelines << ","
+						<< footprint.objects.computePipelines << "," << footprint.objects.peakLivePipelines << "," << footprint.objects.pipelineCreationTime << "," << footprint.objects.descriptorSets << "\n";
+					result << "\n" << "heap,size,device local,peak allocated bytes,budget,peak usage" << "\n";
+					for (size_t i = 0; i < footprint.heaps.size(); i++) {
+						const ResourceFootprint::Heap &heap = footprint.heaps[i];
+						result << i << "," << heap.size << "," << (heap.deviceLocal ? 1 : 0) << "," << heap.peakBytes << ",";
+						if (footprint.memoryBudget) {
+							result << heap.budget << "," << heap.peakUsage;
+						}
+						else {
+							result << ",";
+						}
+						result << "\n";
+					}
+				}
+
 				if (outputFrameTimes) {
 					result << "\n" << "frame,ms" << "\n";
 					for (size_t i = 0; i < frameTimes.size(); i++) {
 						result << i << "," << frameTimes[i] << "\n";
 					}
-					double tMin = *std::min_element(frameTimes.begin(), frameTimes.end());
-					double tMax = *std::max_element(frameTimes.begin(), frameTimes.end());
-					double tAvg = std::accumulate(frameTimes.begin(), frameTimes.end(), 0.0) / (double)frameTimes.size();
-					std::cout << "best   : " << (1000.0 / tMin) << " fps (" << tMin << " ms)" << "\n";
-					std::cout << "worst  : " << (1000.0 / tMax) << " fps (" << tMax << " ms)" << "\n";
-					std::cout << "avg    : " << (1000.0 / tAvg) << " fps (" << tAvg << " ms)" << "\n";
-					std::cout << "\n";
 				}
 
 				result.flush();
+				saveJson();
 #if defined(_WIN32)
 				FreeConsole();
 #endif
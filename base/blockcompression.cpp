@@ -0,0 +1,519 @@
+/*
+* CPU block compression (BC1, BC4, BC5, BC7) for runtime generated texture data
+*
+* Endpoints are selected along the principal axis of each block and refined with a single least squares pass
+* The per-texel loops work on fixed size planar arrays so they can be auto-vectorized by the compiler
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "blockcompression.h"
+#include "VulkanCpuProfiler.h"
+#include "VulkanJobSystem.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+namespace vks
+{
+	namespace bc
+	{
+		namespace
+		{
+			// Interpolation weights for BC7 four bit indices (in 1/64 units)
+			const int32_t bc7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+			// Writes bit fields to a block starting at the least significant bit of the first byte
+			struct BitWriter
+			{
+				uint8_t *data;
+				uint32_t position = 0;
+				BitWriter(uint8_t *data) : data(data) {}
+				void write(uint32_t value, uint32_t bitCount)
+				{
+					for (uint32_t i = 0; i < bitCount; i++) {
+						if ((value >> i) & 1) {
+							data[position >> 3] |= static_cast<uint8_t>(1 << (position & 7));
+						}
+						position++;
+					}
+				}
+			};
+
+			inline float clampf(float value, float minValue, float maxValue)
+			{
+				return std::min(std::max(value, minValue), maxValue);
+			}
+
+			// Get the mean and the dominant direction (principal axis) of the block's texels using power iteration
+			template <uint32_t N>
+			void principalAxis(const float texels[N][16], float mean[N], float axis[N])
+			{
+				for (uint32_t c = 0; c < N; c++) {
+					float sum = 0.0f;
+					for (uint32_t k = 0; k < 16; k++) {
+						sum += texels[c][k];
+					}
+					mean[c] = sum / 16.0f;
+				}
+				float covariance[N][N];
+				for (uint32_t i = 0; i < N; i++) {
+					for (uint32_t j = i; j < N; j++) {
+						float sum = 0.0f;
+						for (uint32_t k = 0; k < 16; k++) {
+							sum += (texels[i][k] - mean[i]) * (texels[j][k] - mean[j]);
+						}
+						covariance[i][j] = covariance[j][i] = sum;
+					}
+				}
+				// Start with the column of the channel with the largest variance, so the start vector is never orthogonal to the principal axis
+				uint32_t start = 0;
+				for (uint32_t c = 1; c < N; c++) {
+					if (covariance[c][c] > covariance[start][start]) {
+						start = c;
+					}
+				}
+				if (covariance[start][start] < FLT_EPSILON) {
+					// Single color block
+					for (uint32_t c = 0; c < N; c++) {
+						axis[c] = 1.0f / std::sqrt(static_cast<float>(N));
+					}
+					return;
+				}
+				for (uint32_t c = 0; c < N; c++) {
+					axis[c] = covariance[c][start];
+				}
+				for (uint32_t iteration = 0; iteration < 8; iteration++) {
+					float next[N];
+					float maxComponent = 0.0f;
+					for (uint32_t i = 0; i < N; i++) {
+						next[i] = 0.0f;
+						for (uint32_t j = 0; j < N; j++) {
+							next[i] += covariance[i][j] * axis[j];
+						}
+						maxComponent = std::max(maxComponent, std::fabs(next[i]));
+					}
+					if (maxComponent < FLT_EPSILON) {
+						break;
+					}
+					for (uint32_t c = 0; c < N; c++) {
+						axis[c] = next[c] / maxComponent;
+					}
+				}
+				float length = 0.0f;
+				for (uint32_t c = 0; c < N; c++) {
+					length += axis[c] * axis[c];
+				}
+				length = std::sqrt(length);
+				for (uint32_t c = 0; c < N; c++) {
+					axis[c] /= length;
+				}
+			}
+
+			// Get the endpoints of the block's texels projected onto the principal axis
+			template <uint32_t N>
+			void axisEndpoints(const float texels[N][16], float endpoint0[N], float endpoint1[N])
+			{
+				float mean[N], axis[N];
+				principalAxis<N>(texels, mean, axis);
+				float minT = FLT_MAX;
+				float maxT = -FLT_MAX;
+				for (uint32_t k = 0; k < 16; k++) {
+					float t = 0.0f;
+					for (uint32_t c = 0; c < N; c++) {
+						t += (texels[c][k] - mean[c]) * axis[c];
+					}
+					minT = std::min(minT, t);
+					maxT = std::max(maxT, t);
+				}
+				for (uint32_t c = 0; c < N; c++) {
+					endpoint0[c] = clampf(mean[c] + axis[c] * minT, 0.0f, 255.0f);
+					endpoint1[c] = clampf(mean[c] + axis[c] * maxT, 0.0f, 255.0f);
+				}
+			}
+
+			// Assign each texel to the closest palette entry and return the accumulated squared error
+			template <uint32_t N, uint32_t P>
+			float selectIndices(const float texels[N][16], const float palette[P][N], uint8_t indices[16])
+			{
+				float bestError[16];
+				for (uint32_t k = 0; k < 16; k++) {
+					float error = 0.0f;
+					for (uint32_t c = 0; c < N; c++) {
+						float d = texels[c][k] - palette[0][c];
+						error += d * d;
+					}
+					bestError[k] = error;
+					indices[k] = 0;
+				}
+				for (uint32_t p = 1; p < P; p++) {
+					for (uint32_t k = 0; k < 16; k++) {
+						float error = 0.0f;
+						for (uint32_t c = 0; c < N; c++) {
+							float d = texels[c][k] - palette[p][c];
+							error += d * d;
+						}
+						if (error < bestError[k]) {
+							bestError[k] = error;
+							indices[k] = static_cast<uint8_t>(p);
+						}
+					}
+				}
+				float totalError = 0.0f;
+				for (uint32_t k = 0; k < 16; k++) {
+					totalError += bestError[k];
+				}
+				return totalError;
+			}
+
+			// Solve for the endpoints that minimize the error for the given interpolation weights (0 = endpoint0, 1 = endpoint1)
+			// Returns false if the system is degenerate (e.g. all texels use the same weight)
+			template <uint32_t N>
+			bool leastSquaresEndpoints(const float texels[N][16], const float weights[16], float endpoint0[N], float endpoint1[N])
+			{
+				float a = 0.0f, b = 0.0f, c = 0.0f;
+				float x0[N], x1[N];
+				for (uint32_t ch = 0; ch < N; ch++) {
+					x0[ch] = x1[ch] = 0.0f;
+				}
+				for (uint32_t k = 0; k < 16; k++) {
+					const float w = weights[k];
+					a += (1.0f - w) * (1.0f - w);
+					b += (1.0f - w) * w;
+					c += w * w;
+					for (uint32_t ch = 0; ch < N; ch++) {
+						x0[ch] += (1.0f - w) * texels[ch][k];
+						x1[ch] += w * texels[ch][k];
+					}
+				}
+				const float determinant = a * c - b * b;
+				if (std::fabs(determinant) < FLT_EPSILON) {
+					return false;
+				}
+				for (uint32_t ch = 0; ch < N; ch++) {
+					endpoint0[ch] = clampf((c * x0[ch] - b * x1[ch]) / determinant, 0.0f, 255.0f);
+					endpoint1[ch] = clampf((a * x1[ch] - b * x0[ch]) / determinant, 0.0f, 255.0f);
+				}
+				return true;
+			}
+
+			/*
+				BC1
+			*/
+
+			inline uint16_t packRGB565(const float color[3])
+			{
+				const uint32_t r = static_cast<uint32_t>(std::round(color[0] * 31.0f / 255.0f));
+				const uint32_t g = static_cast<uint32_t>(std::round(color[1] * 63.0f / 255.0f));
+				const uint32_t b = static_cast<uint32_t>(std::round(color[2] * 31.0f / 255.0f));
+				return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+			}
+
+			inline void unpackRGB565(uint16_t packed, float color[3])
+			{
+				const uint32_t r = (packed >> 11) & 0x1F;
+				const uint32_t g = (packed >> 5) & 0x3F;
+				const uint32_t b = packed & 0x1F;
+				color[0] = static_cast<float>((r << 3) | (r >> 2));
+				color[1] = static_cast<float>((g << 2) | (g >> 4));
+				color[2] = static_cast<float>((b << 3) | (b >> 2));
+			}
+
+			// Four color mode palette: color0, color1, 2/3 color0 + 1/3 color1, 1/3 color0 + 2/3 color1
+			float fitBC1(const float texels[3][16], uint16_t color0, uint16_t color1, uint8_t indices[16])
+			{
+				float palette[4][3];
+				unpackRGB565(color0, palette[0]);
+				unpackRGB565(color1, palette[1]);
+				for (uint32_t c = 0; c < 3; c++) {
+					palette[2][c] = (2.0f * palette[0][c] + palette[1][c]) / 3.0f;
+					palette[3][c] = (palette[0][c] + 2.0f * palette[1][c]) / 3.0f;
+				}
+				return selectIndices<3, 4>(texels, palette, indices);
+			}
+
+			void compressBlockBC1(const uint8_t rgba[64], uint8_t *block)
+			{
+				float texels[3][16];
+				for (uint32_t k = 0; k < 16; k++) {
+					for (uint32_t c = 0; c < 3; c++) {
+						texels[c][k] = static_cast<float>(rgba[k * 4 + c]);
+					}
+				}
+
+				float endpoint0[3], endpoint1[3];
+				axisEndpoints<3>(texels, endpoint1, endpoint0);
+				uint16_t color0 = packRGB565(endpoint0);
+				uint16_t color1 = packRGB565(endpoint1);
+				uint8_t indices[16];
+				float error = fitBC1(texels, color0, color1, indices);
+
+				// Refine endpoints based on the initial index selection
+				const float indexWeights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+				float weights[16];
+				for (uint32_t k = 0; k < 16; k++) {
+					weights[k] = indexWeights[indices[k]];
+				}
+				if (leastSquaresEndpoints<3>(texels, weights, endpoint0, endpoint1)) {
+					const uint16_t refinedColor0 = packRGB565(endpoint0);
+					const uint16_t refinedColor1 = packRGB565(endpoint1);
+					uint8_t refinedIndices[16];
+					const float refinedError = fitBC1(texels, refinedColor0, refinedColor1, refinedIndices);
+					if (refinedError < error) {
+						color0 = refinedColor0;
+						color1 = refinedColor1;
+						memcpy(indices, refinedIndices, sizeof(indices));
+					}
+				}
+
+				// The four color mode requires color0 > color1
+				if (color0 < color1) {
+					std::swap(color0, color1);
+					for (uint32_t k = 0; k < 16; k++) {
+						indices[k] ^= 1;
+					}
+				}
+				if (color0 == color1) {
+					memset(indices, 0, sizeof(indices));
+				}
+
+				uint32_t packedIndices = 0;
+				for (uint32_t k = 0; k < 16; k++) {
+					packedIndices |= static_cast<uint32_t>(indices[k]) << (k * 2);
+				}
+				block[0] = color0 & 0xFF;
+				block[1] = color0 >> 8;
+				block[2] = color1 & 0xFF;
+				block[3] = color1 >> 8;
+				memcpy(block + 4, &packedIndices, sizeof(packedIndices));
+			}
+
+			/*
+				BC4
+			*/
+
+			// Eight value mode: red0 > red1, red0, red1 and six interpolated values
+			void compressBlockBC4(const uint8_t rgba[64], uint32_t channel, uint8_t *block)
+			{
+				float texels[1][16];
+				uint8_t minValue = 255;
+				uint8_t maxValue = 0;
+				for (uint32_t k = 0; k < 16; k++) {
+					const uint8_t value = rgba[k * 4 + channel];
+					texels[0][k] = static_cast<float>(value);
+					minValue = std::min(minValue, value);
+					maxValue = std::max(maxValue, value);
+				}
+
+				uint8_t indices[16] = {};
+				if (maxValue != minValue) {
+					float palette[8][1];
+					palette[0][0] = static_cast<float>(maxValue);
+					palette[1][0] = static_cast<float>(minValue);
+					for (uint32_t i = 2; i < 8; i++) {
+						palette[i][0] = (static_cast<float>(8 - i) * maxValue + static_cast<float>(i - 1) * minValue) / 7.0f;
+					}
+					selectIndices<1, 8>(texels, palette, indices);
+				}
+
+				uint64_t packedIndices = 0;
+				for (uint32_t k = 0; k < 16; k++) {
+					packedIndices |= static_cast<uint64_t>(indices[k]) << (k * 3);
+				}
+				block[0] = maxValue;
+				block[1] = minValue;
+				for (uint32_t i = 0; i < 6; i++) {
+					block[2 + i] = static_cast<uint8_t>(packedIndices >> (i * 8));
+				}
+			}
+
+			/*
+				BC7 (mode 6: single subset, 7 bit RGBA endpoints with unique p-bits, 4 bit indices)
+			*/
+
+			struct BC7Mode6Block
+			{
+				uint32_t endpoints[2][4];
+				uint32_t pBits[2];
+				uint8_t indices[16];
+				float error = FLT_MAX;
+			};
+
+			// Quantize both endpoints for all p-bit combinations and keep the one with the lowest error
+			void fitBC7Mode6(const float texels[4][16], const float endpoint0[4], const float endpoint1[4], BC7Mode6Block &best)
+			{
+				for (uint32_t p0 = 0; p0 < 2; p0++) {
+					for (uint32_t p1 = 0; p1 < 2; p1++) {
+						BC7Mode6Block candidate;
+						candidate.pBits[0] = p0;
+						candidate.pBits[1] = p1;
+						int32_t unquantized[2][4];
+						for (uint32_t c = 0; c < 4; c++) {
+							candidate.endpoints[0][c] = static_cast<uint32_t>(clampf(std::round((endpoint0[c] - p0) / 2.0f), 0.0f, 127.0f));
+							candidate.endpoints[1][c] = static_cast<uint32_t>(clampf(std::round((endpoint1[c] - p1) / 2.0f), 0.0f, 127.0f));
+							unquantized[0][c] = (candidate.endpoints[0][c] << 1) | p0;
+							unquantized[1][c] = (candidate.endpoints[1][c] << 1) | p1;
+						}
+						float palette[16][4];
+						for (uint32_t i = 0; i < 16; i++) {
+							for (uint32_t c = 0; c < 4; c++) {
+								palette[i][c] = static_cast<float>(((64 - bc7Weights[i]) * unquantized[0][c] + bc7Weights[i] * unquantized[1][c] + 32) >> 6);
+							}
+						}
+						// Select indices by projecting the texels onto the endpoint line instead of testing all 16 palette entries
+						float direction[4];
+						float lengthSquared = 0.0f;
+						for (uint32_t c = 0; c < 4; c++) {
+							direction[c] = static_cast<float>(unquantized[1][c] - unquantized[0][c]);
+							lengthSquared += direction[c] * direction[c];
+						}
+						const float scale = (lengthSquared > 0.0f) ? 64.0f / lengthSquared : 0.0f;
+						candidate.error = 0.0f;
+						for (uint32_t k = 0; k < 16; k++) {
+							float t = 0.0f;
+							for (uint32_t c = 0; c < 4; c++) {
+								t += (texels[c][k] - static_cast<float>(unquantized[0][c])) * direction[c];
+							}
+							const float weight = clampf(t * scale, 0.0f, 64.0f);
+							// Weights are spaced roughly 64/15 apart, so the closest one is at most one step away from the estimate
+							int32_t index = std::min(static_cast<int32_t>(weight * 15.0f / 64.0f + 0.5f), 15);
+							if (index > 0 && std::fabs(weight - bc7Weights[index - 1]) < std::fabs(weight - bc7Weights[index])) {
+								index--;
+							}
+							else if (index < 15 && std::fabs(weight - bc7Weights[index + 1]) < std::fabs(weight - bc7Weights[index])) {
+								index++;
+							}
+							candidate.indices[k] = static_cast<uint8_t>(index);
+							for (uint32_t c = 0; c < 4; c++) {
+								const float d = texels[c][k] - palette[index][c];
+								candidate.error += d * d;
+							}
+						}
+						if (candidate.error < best.error) {
+							best = candidate;
+						}
+					}
+				}
+			}
+
+			void compressBlockBC7(const uint8_t rgba[64], uint8_t *block)
+			{
+				float texels[4][16];
+				for (uint32_t k = 0; k < 16; k++) {
+					for (uint32_t c = 0; c < 4; c++) {
+						texels[c][k] = static_cast<float>(rgba[k * 4 + c]);
+					}
+				}
+
+				float endpoint0[4], endpoint1[4];
+				axisEndpoints<4>(texels, endpoint0, endpoint1);
+				BC7Mode6Block best;
+				fitBC7Mode6(texels, endpoint0, endpoint1, best);
+
+				// Refine endpoints based on the initial index selection
+				float weights[16];
+				for (uint32_t k = 0; k < 16; k++) {
+					weights[k] = static_cast<float>(bc7Weights[best.indices[k]]) / 64.0f;
+				}
+				if (leastSquaresEndpoints<4>(texels, weights, endpoint0, endpoint1)) {
+					fitBC7Mode6(texels, endpoint0, endpoint1, best);
+				}
+
+				// The most significant bit of the first (anchor) index is implicitly zero
+				if (best.indices[0] >= 8) {
+					for (uint32_t c = 0; c < 4; c++) {
+						std::swap(best.endpoints[0][c], best.endpoints[1][c]);
+					}
+					std::swap(best.pBits[0], best.pBits[1]);
+					for (uint32_t k = 0; k < 16; k++) {
+						best.indices[k] = 15 - best.indices[k];
+					}
+				}
+
+				memset(block, 0, 16);
+				BitWriter writer(block);
+				writer.write(1 << 6, 7);
+				for (uint32_t c = 0; c < 4; c++) {
+					writer.write(best.endpoints[0][c], 7);
+					writer.write(best.endpoints[1][c], 7);
+				}
+				writer.write(best.pBits[0], 1);
+				writer.write(best.pBits[1], 1);
+				writer.write(best.indices[0], 3);
+				for (uint32_t k = 1; k < 16; k++) {
+					writer.write(best.indices[k], 4);
+				}
+			}
+		}
+
+		uint32_t blockSize(Format format)
+		{
+			return (format == Format::BC1 || format == Format::BC4) ? 8 : 16;
+		}
+
+		size_t compressedSize(Format format, uint32_t width, uint32_t height)
+		{
+			return static_cast<size_t>((width + 3) / 4) * static_cast<size_t>((height + 3) / 4) * blockSize(format);
+		}
+
+		void compressBlock(Format format, const uint8_t rgba[64], uint8_t *block)
+		{
+			switch (format) {
+			case Format::BC1:
+				compressBlockBC1(rgba, block);
+				break;
+			case Format::BC4:
+				compressBlockBC4(rgba, 0, block);
+				break;
+			case Format::BC5:
+				compressBlockBC4(rgba, 0, block);
+				compressBlockBC4(rgba, 1, block + 8);
+				break;
+			case Format::BC7:
+				compressBlockBC7(rgba, block);
+				break;
+			}
+		}
+
+		void compress(Format format, const uint8_t *src, uint32_t width, uint32_t height, uint32_t srcChannels, uint8_t *dst, vks::JobSystem *jobSystem)
+		{
+			const uint32_t blocksX = (width + 3) / 4;
+			const uint32_t blocksY = (height + 3) / 4;
+			const uint32_t bytesPerBlock = blockSize(format);
+
+			auto compressRows = [=](uint32_t firstRow, uint32_t lastRow)
+			{
+				VKS_PROFILE_ZONE("blockcompression::compress rows");
+				uint8_t rgba[64];
+				for (uint32_t by = firstRow; by < lastRow; by++) {
+					for (uint32_t bx = 0; bx < blocksX; bx++) {
+						// Fetch the block, repeating edge texels for partial blocks
+						for (uint32_t y = 0; y < 4; y++) {
+							const uint32_t sy = std::min(by * 4 + y, height - 1);
+							for (uint32_t x = 0; x < 4; x++) {
+								const uint32_t sx = std::min(bx * 4 + x, width - 1);
+								const uint8_t *texel = src + (static_cast<size_t>(sy) * width + sx) * srcChannels;
+								for (uint32_t c = 0; c < 4; c++) {
+									rgba[(y * 4 + x) * 4 + c] = (c < srcChannels) ? texel[c] : (c == 3 ? 255 : 0);
+								}
+							}
+						}
+						compressBlock(format, rgba, dst + (static_cast<size_t>(by) * blocksX + bx) * bytesPerBlock);
+					}
+				}
+			};
+
+			if (jobSystem == nullptr) {
+				compressRows(0, blocksY);
+				return;
+			}
+
+			// Block rows are split into jobs of at least 64 blocks, so narrow images don't end up with a job per row
+			jobSystem->parallelFor(blocksY, std::max(64u / blocksX, 1u), compressRows);
+		}
+	}
+}
@@ -0,0 +1,61 @@
+/*
+* CPU block compression (BC1, BC4, BC5, BC7) for runtime generated texture data
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Note: This file has no Vulkan dependencies so the encoder can be built and benchmarked on it's own
+
+namespace vks
+{
+	class JobSystem;
+
+	namespace bc
+	{
+		enum class Format
+		{
+			/** @brief RGB, 4 bits per texel (alpha is ignored) */
+			BC1,
+			/** @brief Single channel, 4 bits per texel */
+			BC4,
+			/** @brief Two channels, 8 bits per texel */
+			BC5,
+			/** @brief RGBA, 8 bits per texel (encoded using mode 6) */
+			BC7
+		};
+
+		/** @brief Size in bytes of a single 4x4 block for the given format */
+		uint32_t blockSize(Format format);
+		/** @brief Size in bytes required to store an image of the given dimensions in the given format */
+		size_t compressedSize(Format format, uint32_t width, uint32_t height);
+
+		/**
+		* @brief Compress a single 4x4 block
+		*
+		* @param format Target block format
+		* @param rgba 16 texels with 4 channels each in row-major order (channels not used by the format are ignored)
+		* @param block Destination for the encoded block, must hold blockSize(format) bytes
+		*/
+		void compressBlock(Format format, const uint8_t rgba[64], uint8_t *block);
+
+		/**
+		* @brief Compress a tightly packed 8 bit per channel image
+		*
+		* @param format Target block format
+		* @param src Source texels
+		* @param width Width of the source image (does not need to be a multiple of four, edge texels are repeated)
+		* @param height Height of the source image
+		* @param srcChannels Number of channels per source texel (1 - 4), missing channels are read as 0 (alpha as 255)
+		* @param dst Destination buffer, must hold compressedSize(format, width, height) bytes
+		* @param (Optional) jobSystem Job system the block rows are split across, if null the image is compressed on the calling thread
+		*/
+		void compress(Format format, const uint8_t *src, uint32_t width, uint32_t height, uint32_t srcChannels, uint8_t *dst, vks::JobSystem *jobSystem = nullptr);
+	}
+}
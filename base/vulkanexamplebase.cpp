@@ -84,6 +84,14 @@ VkResult VulkanExampleBase::createInstance(bool enableValidation)
 		}
 	}
 
+	// Device extensions enabled by the base when present (e.g. timeline semaphores) depend on this one
+	const char* physicalDeviceProperties2Extension = VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME;
+	if ((std::find(supportedInstanceExtensions.begin(), supportedInstanceExtensions.end(), physicalDeviceProperties2Extension) != supportedInstanceExtensions.end()) &&
+		(std::find_if(instanceExtensions.begin(), instanceExtensions.end(), [physicalDeviceProperties2Extension](const char* extension) { return strcmp(extension, physicalDeviceProperties2Extension) == 0; }) == instanceExtensions.end()))
+	{
+		instanceExtensions.push_back(physicalDeviceProperties2Extension);
+	}
+
 	VkInstanceCreateInfo instanceCreateInfo = {};
 	instanceCreateInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
 	instanceCreateInfo.pNext = NULL;
@@ -157,11 +165,37 @@ void VulkanExampleBase::createCommandBuffers()
 			static_cast<uint32_t>(drawCmdBuffers.size()));
 
 	VK_CHECK_RESULT(vkAllocateCommandBuffers(device, &cmdBufAllocateInfo, drawCmdBuffers.data()));
+
+	profilerCmdBuffers.resize(swapChain.imageCount);
+	cmdBufAllocateInfo.commandBufferCount = 1;
+	for (auto& profilerCmdBuffer : profilerCmdBuffers) {
+		VK_CHECK_RESULT(vkAllocateCommandBuffers(device, &cmdBufAllocateInfo, &profilerCmdBuffer.begin));
+		VK_CHECK_RESULT(vkAllocateCommandBuffers(device, &cmdBufAllocateInfo, &profilerCmdBuffer.end));
+	}
 }
 
 void VulkanExampleBase::destroyCommandBuffers()
 {
 	vkFreeCommandBuffers(device, cmdPool, static_cast<uint32_t>(drawCmdBuffers.size()), drawCmdBuffers.data());
+	for (auto& profilerCmdBuffer : profilerCmdBuffers) {
+		vkFreeCommandBuffers(device, cmdPool, 1, &profilerCmdBuffer.begin);
+		vkFreeCommandBuffers(device, cmdPool, 1, &profilerCmdBuffer.end);
+	}
+	profilerCmdBuffers.clear();
+}
+
+void VulkanExampleBase::createGpuProfiler()
+{
+	gpuProfiler.create(vulkanDevice, static_cast<uint32_t>(drawCmdBuffers.size()));
+	// Every image's frame is measured by the base, examples that call beginFrame for their command buffers take over the image's frame scope with their own scopes
+	VkCommandBufferBeginInfo cmdBufInfo = vks::initializers::commandBufferBeginInfo();
+	for (uint32_t i = 0; i < static_cast<uint32_t>(profilerCmdBuffers.size()); i++) {
+		VK_CHECK_RESULT(vkBeginCommandBuffer(profilerCmdBuffers[i].begin, &cmdBufInfo));
+		VK_CHECK_RESULT(vkBeginCommandBuffer(profilerCmdBuffers[i].end, &cmdBufInfo));
+		gpuProfiler.recordFrameBoundaries(profilerCmdBuffers[i].begin, profilerCmdBuffers[i].end, i);
+		VK_CHECK_RESULT(vkEndCommandBuffer(profilerCmdBuffers[i].begin));
+		VK_CHECK_RESULT(vkEndCommandBuffer(profilerCmdBuffers[i].end));
+	}
 }
 
 std::string VulkanExampleBase::getShadersPath() const
@@ -178,6 +212,7 @@ void VulkanExampleBase::createPipelineCache()
 
 void VulkanExampleBase::prepare()
 {
+	VKS_PROFILE_FUNCTION();
 	if (vulkanDevice->enableDebugMarkers) {
 		vks::debugmarker::setup(device);
 	}
@@ -185,6 +220,7 @@ void VulkanExampleBase::prepare()
 	createCommandPool();
 	setupSwapChain();
 	createCommandBuffers();
+	createGpuProfiler();
 	createSynchronizationPrimitives();
 	setupDepthStencil();
 	setupRenderPass();
@@ -198,8 +234,11 @@ void VulkanExampleBase::prepare()
 			loadShader(getShadersPath() + "base/uioverlay.vert.spv", VK_SHADER_STAGE_VERTEX_BIT),
 			loadShader(getShadersPath() + "base/uioverlay.frag.spv", VK_SHADER_STAGE_FRAGMENT_BIT),
 		};
+		UIOverlay.framesInFlight = maxFramesInFlight;
 		UIOverlay.prepareResources();
-		UIOverlay.preparePipeline(pipelineCache, renderPass);
+		setupOverlayRenderPass();
+		setupOverlayFrameBuffers();
+		UIOverlay.preparePipeline(pipelineCache, overlayRenderPass);
 	}
 }
 
@@ -221,6 +260,7 @@ VkPipelineShaderStageCreateInfo VulkanExampleBase::loadShader(std::string fileNa
 
 void VulkanExampleBase::nextFrame()
 {
+	VKS_PROFILE_ZONE("Frame");
 	auto tStart = std::chrono::high_resolution_clock::now();
 	if (viewUpdated)
 	{
@@ -228,6 +268,11 @@ void VulkanExampleBase::nextFrame()
 		viewChanged();
 	}
 
+	// The state the frame is rendered with, advanced by the time of the previous frame
+	if (cameraPath.isRecording()) {
+		cameraPath.record(frameTimer, camera.position, camera.rotation);
+	}
+
 	render();
 	frameCounter++;
 	auto tEnd = std::chrono::high_resolution_clock::now();
@@ -260,18 +305,69 @@ void VulkanExampleBase::nextFrame()
 		frameCounter = 0;
 		lastTimestamp = tEnd;
 	}
-	// TODO: Cap UI overlay update rates
 	updateOverlay();
 }
 
+// Apply the camera state of the next frame of the replayed camera path, startTimer is the animation timer at the path's first frame
+void VulkanExampleBase::replayCameraPathFrame(float startTimer)
+{
+	glm::vec3 position = camera.position;
+	glm::vec3 rotation = camera.rotation;
+	const uint32_t frame = cameraPath.nextFrame(position, rotation);
+	camera.setPosition(position);
+	camera.setRotation(rotation);
+	// Animations advance with the path's fixed time step instead of the measured frame time, so every replay renders the same frames
+	frameTimer = cameraPath.timeStep;
+	if (!paused) {
+		timer = fmod(startTimer + timerSpeed * cameraPath.timeStep * frame, 1.0f);
+	}
+	viewChanged();
+}
+
+void VulkanExampleBase::collectResourceFootprint(vks::Benchmark::ResourceFootprint &footprint)
+{
+	footprint.startupTime = startupTime;
+	footprint.peakResidentBytes = vks::tools::getPeakResidentMemory();
+	const std::vector<vks::MemoryTracker::CategoryStats> heapStats = vulkanDevice->memoryTracker->getHeapStats();
+	footprint.memoryBudget = !vulkanDevice->heapBudgets.empty();
+	footprint.heaps.resize(vulkanDevice->memoryProperties.memoryHeapCount);
+	for (uint32_t i = 0; i < vulkanDevice->memoryProperties.memoryHeapCount; i++) {
+		footprint.heaps[i].size = vulkanDevice->memoryProperties.memoryHeaps[i].size;
+		footprint.heaps[i].deviceLocal = (vulkanDevice->memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+		if (i < heapStats.size()) {
+			footprint.heaps[i].peakBytes = heapStats[i].peakBytes;
+		}
+		if (i < vulkanDevice->heapBudgets.size()) {
+			footprint.heaps[i].budget = vulkanDevice->heapBudgets[i].budget;
+			footprint.heaps[i].peakUsage = vulkanDevice->heapBudgets[i].peakUsage;
+		}
+	}
+	footprint.peakAllocationCount = vulkanDevice->memoryTracker->getTotalStats().peakAllocationCount;
+	footprint.deviceAllocationCount = vulkanDevice->memoryAllocator->getDeviceAllocationCount();
+	footprint.objects = vks::ObjectCounters::get();
+}
+
 void VulkanExampleBase::renderLoop()
 {
+	// Construction, initialization and preparation of the example (including the derived class' parts) up to the first frame
+	vks::CpuProfiler::addZone("Startup", startupTimestamp, vks::CpuProfiler::now());
+
 	if (benchmark.active) {
-		benchmark.run([=] { render(); }, vulkanDevice->properties);
+		const float startTimer = timer;
+		benchmark.run([=] {
+			VKS_PROFILE_ZONE("Frame");
+			if (benchmark.cameraPath) {
+				replayCameraPathFrame(startTimer);
+			}
+			render();
+		}, vulkanDevice->properties);
 		vkDeviceWaitIdle(device);
 		if (benchmark.filename != "") {
 			benchmark.saveResults();
 		}
+		if (memoryReportFilename != "") {
+			vulkanDevice->memoryTracker->writeReport(memoryReportFilename, vulkanDevice->memoryAllocator);
+		}
 		return;
 	}
 
@@ -626,6 +722,9 @@ void VulkanExampleBase::renderLoop()
 	// Flush device to make sure all resources can be freed
 	if (device != VK_NULL_HANDLE) {
 		vkDeviceWaitIdle(device);
+		if (memoryReportFilename != "") {
+			vulkanDevice->memoryTracker->writeReport(memoryReportFilename, vulkanDevice->memoryAllocator);
+		}
 	}
 }
 
@@ -634,10 +733,18 @@ void VulkanExampleBase::updateOverlay()
 	if (!settings.overlay)
 		return;
 
+	// Cap the update rate, in between updates the overlay recorded last is drawn again
+	overlayTimer += frameTimer;
+	if ((settings.overlayUpdateRate > 0) && (overlayTimer < 1.0f / settings.overlayUpdateRate)) {
+		return;
+	}
+	VKS_PROFILE_FUNCTION();
+
 	ImGuiIO& io = ImGui::GetIO();
 
 	io.DisplaySize = ImVec2((float)width, (float)height);
-	io.DeltaTime = frameTimer;
+	io.DeltaTime = overlayTimer;
+	overlayTimer = 0.0f;
 
 	io.MousePos = ImVec2(mousePos.x, mousePos.y);
 	io.MouseDown[0] = mouseButtons.left;
@@ -659,6 +766,35 @@ void VulkanExampleBase::updateOverlay()
 	ImGui::PushItemWidth(110.0f * UIOverlay.scale);
 	OnUpdateUIOverlay(&UIOverlay);
 	ImGui::PopItemWidth();
+
+	// Live device memory usage per category, collapsed by default to not get in the way of the sample's settings
+	if (ImGui::CollapsingHeader("Device memory")) {
+		const float toMB = 1.0f / (1024.0f * 1024.0f);
+		for (uint32_t i = 0; i < static_cast<uint32_t>(vks::MemoryCategory::Count); i++) {
+			const vks::MemoryTracker::CategoryStats stats = vulkanDevice->memoryTracker->getStats(static_cast<vks::MemoryCategory>(i));
+			if (stats.peakBytes > 0) {
+				ImGui::Text("%s: %.1f MB (peak %.1f MB)", vks::MemoryTracker::getCategoryName(static_cast<vks::MemoryCategory>(i)), stats.bytes * toMB, stats.peakBytes * toMB);
+			}
+		}
+		const vks::MemoryTracker::CategoryStats total = vulkanDevice->memoryTracker->getTotalStats();
+		ImGui::Text("total: %.1f MB (peak %.1f MB)", total.bytes * toMB, total.peakBytes * toMB);
+		if (UIOverlay.button("Save report")) {
+			vulkanDevice->memoryTracker->writeReport((memoryReportFilename != "") ? memoryReportFilename : "memory_report.json", vulkanDevice->memoryAllocator);
+		}
+	}
+	// Device timings of the scopes recorded by the example
+	const std::vector<std::pair<std::string, double>> gpuTimes = gpuProfiler.getRecentTimes();
+	if (!gpuTimes.empty() && ImGui::CollapsingHeader("GPU timings")) {
+		for (auto &gpuTime : gpuTimes) {
+			ImGui::Text("%s: %.3f ms", gpuTime.first.c_str(), gpuTime.second);
+		}
+		if (gpuProfiler.pipelineStatisticsEnabled()) {
+			for (uint32_t i = 0; i < static_cast<uint32_t>(vks::GpuProfiler::PipelineStatistic::Count); i++) {
+				const vks::GpuProfiler::PipelineStatistic statistic = static_cast<vks::GpuProfiler::PipelineStatistic>(i);
+				ImGui::Text("%s: %.0f", vks::GpuProfiler::getPipelineStatisticName(statistic), gpuProfiler.getPipelineStatistic(statistic));
+			}
+		}
+	}
 #if defined(VK_USE_PLATFORM_ANDROID_KHR)
 	ImGui::PopStyleVar();
 #endif
@@ -667,7 +803,18 @@ void VulkanExampleBase::updateOverlay()
 	ImGui::PopStyleVar();
 	ImGui::Render();
 
-	if (UIOverlay.update() || UIOverlay.updated) {
+	// The overlay is drawn in a pass of it's own, so new draw data only requires re-recording the overlay's command buffers
+	// The draw data is uploaded to a frame's buffers once it's re-recorded
+	overlayVersion++;
+
+	// Widgets set updated when a value that affects the example's command buffers has changed
+	if (UIOverlay.updated) {
+		// Command buffers of other frames in flight may still be pending
+		if (maxFramesInFlight > 1) {
+			VKS_PROFILE_ZONE("Wait for device idle");
+			vkDeviceWaitIdle(device);
+		}
+		VKS_PROFILE_ZONE("buildCommandBuffers");
 		buildCommandBuffers();
 		UIOverlay.updated = false;
 	}
@@ -679,34 +826,182 @@ void VulkanExampleBase::updateOverlay()
 #endif
 }
 
-void VulkanExampleBase::drawUI(const VkCommandBuffer commandBuffer)
+VkSemaphore VulkanExampleBase::submitOverlay()
 {
-	if (settings.overlay) {
+	FrameResources &frame = frames[currentFrame];
+
+	// The secondary command buffer with the overlay's draw commands is only re-recorded if the overlay has been updated since it was last recorded
+	// It's not pending, as the frame's fence has been waited for in prepareFrame
+	if (frame.overlayVersion != overlayVersion) {
+		VkCommandBufferInheritanceInfo inheritanceInfo = vks::initializers::commandBufferInheritanceInfo();
+		inheritanceInfo.renderPass = overlayRenderPass;
+		inheritanceInfo.subpass = 0;
+		VkCommandBufferBeginInfo secondaryBeginInfo = vks::initializers::commandBufferBeginInfo();
+		secondaryBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+		secondaryBeginInfo.pInheritanceInfo = &inheritanceInfo;
+		VK_CHECK_RESULT(vkBeginCommandBuffer(frame.overlaySecondaryCommandBuffer, &secondaryBeginInfo));
 		const VkViewport viewport = vks::initializers::viewport((float)width, (float)height, 0.0f, 1.0f);
 		const VkRect2D scissor = vks::initializers::rect2D(width, height, 0, 0);
-		vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
-		vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
-
-		UIOverlay.draw(commandBuffer);
-	}
+		vkCmdSetViewport(frame.overlaySecondaryCommandBuffer, 0, 1, &viewport);
+		vkCmdSetScissor(frame.overlaySecondaryCommandBuffer, 0, 1, &scissor);
+		UIOverlay.update(currentFrame);
+		UIOverlay.draw(frame.overlaySecondaryCommandBuffer, currentFrame);
+		VK_CHECK_RESULT(vkEndCommandBuffer(frame.overlaySecondaryCommandBuffer));
+		frame.overlayVersion = overlayVersion;
+	}
+
+	// The primary command buffer only begins the overlay pass on the current swap chain image and executes the secondary command buffer
+	VkCommandBufferBeginInfo cmdBufInfo = vks::initializers::commandBufferBeginInfo();
+	VK_CHECK_RESULT(vkBeginCommandBuffer(frame.overlayCommandBuffer, &cmdBufInfo));
+	VkRenderPassBeginInfo renderPassBeginInfo = vks::initializers::renderPassBeginInfo();
+	renderPassBeginInfo.renderPass = overlayRenderPass;
+	renderPassBeginInfo.framebuffer = overlayFrameBuffers[currentBuffer];
+	renderPassBeginInfo.renderArea.extent.width = width;
+	renderPassBeginInfo.renderArea.extent.height = height;
+	vkCmdBeginRenderPass(frame.overlayCommandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+	vkCmdExecuteCommands(frame.overlayCommandBuffer, 1, &frame.overlaySecondaryCommandBuffer);
+	vkCmdEndRenderPass(frame.overlayCommandBuffer);
+	VK_CHECK_RESULT(vkEndCommandBuffer(frame.overlayCommandBuffer));
+
+	// Executed after the example's commands for this frame, presentation waits for the overlay instead
+	const VkPipelineStageFlags waitStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+	VkSubmitInfo overlaySubmitInfo = vks::initializers::submitInfo();
+	overlaySubmitInfo.waitSemaphoreCount = 1;
+	overlaySubmitInfo.pWaitSemaphores = &semaphores.renderComplete;
+	overlaySubmitInfo.pWaitDstStageMask = &waitStageMask;
+	overlaySubmitInfo.commandBufferCount = 1;
+	overlaySubmitInfo.pCommandBuffers = &frame.overlayCommandBuffer;
+	overlaySubmitInfo.signalSemaphoreCount = 1;
+	overlaySubmitInfo.pSignalSemaphores = &frame.overlayComplete;
+	VK_CHECK_RESULT(vkQueueSubmit(queue, 1, &overlaySubmitInfo, VK_NULL_HANDLE));
+	return frame.overlayComplete;
 }
 
 void VulkanExampleBase::prepareFrame()
 {
+	// Cap the frame rate before the frame starts rather than after it has been submitted, so input is sampled as late as possible
+	if (settings.frameRateLimit > 0) {
+		VKS_PROFILE_ZONE("Frame rate limit");
+		const auto frameDuration = std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(std::chrono::duration<double>(1.0 / settings.frameRateLimit));
+		const auto frameStart = frameLimiterTimestamp + frameDuration;
+		if (std::chrono::high_resolution_clock::now() < frameStart) {
+			std::this_thread::sleep_until(frameStart);
+		}
+		// Frames that took longer than the limit don't let the following frames catch up
+		frameLimiterTimestamp = std::max(frameStart, std::chrono::high_resolution_clock::now());
+	}
+
+	// The device must be done with the frame that last used this frame's resources (usually already waited for in submitFrame)
+	FrameResources &frame = frames[currentFrame];
+	{
+		VKS_PROFILE_ZONE("Wait for frame fence");
+		VK_CHECK_RESULT(vkWaitForFences(device, 1, &frame.fence, VK_TRUE, UINT64_MAX));
+	}
+	semaphores.presentComplete = frame.presentComplete;
+	semaphores.renderComplete = frame.renderComplete;
+	frame.frameId = latency.beginFrame();
+
+	// Uploads queued by other threads are submitted before the frame's commands, which the graphics queue orders after them
+	transferEngine.submit();
+
 	// Acquire the next image from the swap chain
-	VkResult result = swapChain.acquireNextImage(semaphores.presentComplete, &currentBuffer);
+	VkResult result;
+	{
+		VKS_PROFILE_ZONE("Acquire image");
+		result = swapChain.acquireNextImage(semaphores.presentComplete, &currentBuffer);
+	}
 	// Recreate the swapchain if it's no longer compatible with the surface (OUT_OF_DATE) or no longer optimal for presentation (SUBOPTIMAL)
 	if ((result == VK_ERROR_OUT_OF_DATE_KHR) || (result == VK_SUBOPTIMAL_KHR)) {
 		windowResize();
+		return;
 	}
 	else {
 		VK_CHECK_RESULT(result);
 	}
+
+	// With more frames in flight than swap chain images, the image's command buffer may still be pending from another frame
+	if ((imageFences[currentBuffer] != VK_NULL_HANDLE) && (imageFences[currentBuffer] != frame.fence)) {
+		VKS_PROFILE_ZONE("Wait for image fence");
+		VK_CHECK_RESULT(vkWaitForFences(device, 1, &imageFences[currentBuffer], VK_TRUE, UINT64_MAX));
+	}
+	imageFences[currentBuffer] = frame.fence;
+
+	// The device is done with the last submission of this image's command buffer, so it's timings can be read without waiting
+	gpuProfiler.resolve(currentBuffer);
+
+	// Begin the frame scope of images the example doesn't profile itself, the example's submission then waits for this one instead of the image acquisition
+	if (gpuProfiler.isFrameRecordedIn(currentBuffer, profilerCmdBuffers[currentBuffer].begin)) {
+		VkPipelineStageFlags waitStageMask = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+		VkSubmitInfo profilerSubmitInfo = vks::initializers::submitInfo();
+		profilerSubmitInfo.waitSemaphoreCount = 1;
+		profilerSubmitInfo.pWaitSemaphores = &frame.presentComplete;
+		profilerSubmitInfo.pWaitDstStageMask = &waitStageMask;
+		profilerSubmitInfo.commandBufferCount = 1;
+		profilerSubmitInfo.pCommandBuffers = &profilerCmdBuffers[currentBuffer].begin;
+		profilerSubmitInfo.signalSemaphoreCount = 1;
+		profilerSubmitInfo.pSignalSemaphores = &frame.profilerBegun;
+		VK_CHECK_RESULT(vkQueueSubmit(queue, 1, &profilerSubmitInfo, VK_NULL_HANDLE));
+		semaphores.presentComplete = frame.profilerBegun;
+	}
 }
 
 void VulkanExampleBase::submitFrame()
 {
-	VkResult result = swapChain.queuePresent(queue, currentBuffer, semaphores.renderComplete);
+	// Signal the frame's fence once all work submitted for this frame so far has completed
+	// Examples submit without a fence, so this is done with a separate submission that completes after all previous ones on the queue
+	FrameResources &frame = frames[currentFrame];
+	// Ends the frame scope begun in prepareFrame (after the overlay), empty if the example profiles it's command buffer itself
+	const bool profilerEnd = gpuProfiler.isFrameRecordedIn(currentBuffer, profilerCmdBuffers[currentBuffer].begin);
+	latency.markSubmit();
+	gpuProfiler.markSubmitted(currentBuffer);
+	VkSemaphore presentWaitSemaphore = semaphores.renderComplete;
+	if (settings.overlay && UIOverlay.visible) {
+		VKS_PROFILE_ZONE("Submit overlay");
+		presentWaitSemaphore = submitOverlay();
+	}
+	VK_CHECK_RESULT(vkResetFences(device, 1, &frame.fence));
+	VkSubmitInfo fenceSubmitInfo = vks::initializers::submitInfo();
+	fenceSubmitInfo.commandBufferCount = profilerEnd ? 1 : 0;
+	fenceSubmitInfo.pCommandBuffers = &profilerCmdBuffers[currentBuffer].end;
+	VK_CHECK_RESULT(vkQueueSubmit(queue, 1, &fenceSubmitInfo, frame.fence));
+
+	VkResult result;
+	{
+		VKS_PROFILE_ZONE("Present");
+		result = swapChain.queuePresent(queue, currentBuffer, presentWaitSemaphore, frame.frameId);
+	}
+	if ((result == VK_SUCCESS) || (result == VK_SUBOPTIMAL_KHR)) {
+		latency.markPresent();
+		if (startupTime == 0.0) {
+			startupTime = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - constructionTimestamp).count();
+		}
+	}
+
+	// Wait until the resources of the next frame in flight are no longer in use by the device, so the host is free to update them once this returns
+	// With a single frame in flight this waits for the frame that was just submitted
+	currentFrame = (currentFrame + 1) % maxFramesInFlight;
+	{
+		VKS_PROFILE_ZONE("Wait for next frame fence");
+		VK_CHECK_RESULT(vkWaitForFences(device, 1, &frames[currentFrame].fence, VK_TRUE, UINT64_MAX));
+	}
+
+	// The peak heap usage reported by the driver is part of the benchmark results, so it's only sampled in benchmark mode
+	if (benchmark.active) {
+		vulkanDevice->updateMemoryBudget();
+	}
+
+	if (swapChain.presentWaitSupported()) {
+		// Check (without blocking) which presents have been displayed since the last frame, so the timestamps have a granularity of one frame
+		uint64_t frameId;
+		while (((frameId = latency.getOldestPending()) != 0) && (swapChain.waitForPresent(frameId, 0) == VK_SUCCESS)) {
+			latency.markDisplayed(frameId);
+		}
+	}
+	else if (frames[currentFrame].frameId != 0) {
+		// Without present wait, the completion of the frame on the device is used as an approximation of it being displayed
+		latency.markDisplayed(frames[currentFrame].frameId);
+	}
+
 	if (!((result == VK_SUCCESS) || (result == VK_SUBOPTIMAL_KHR))) {
 		if (result == VK_ERROR_OUT_OF_DATE_KHR) {
 			// Swap chain is no longer compatible with the surface and needs to be recreated
@@ -716,7 +1011,6 @@ void VulkanExampleBase::submitFrame()
 			VK_CHECK_RESULT(result);
 		}
 	}
-	VK_CHECK_RESULT(vkQueueWaitIdle(queue));
 }
 
 VulkanExampleBase::VulkanExampleBase(bool enableValidation)
@@ -754,6 +1048,25 @@ VulkanExampleBase::VulkanExampleBase(bool enableValidation)
 	if (commandLineParser.isSet("vsync")) {
 		settings.vsync = true;
 	}
+	if (commandLineParser.isSet("presentmode")) {
+		std::string value = commandLineParser.getValueAsString("presentmode", "fifo");
+		const std::unordered_map<std::string, VkPresentModeKHR> presentModes = {
+			{ "immediate", VK_PRESENT_MODE_IMMEDIATE_KHR },
+			{ "mailbox", VK_PRESENT_MODE_MAILBOX_KHR },
+			{ "fifo", VK_PRESENT_MODE_FIFO_KHR },
+			{ "fifo_relaxed", VK_PRESENT_MODE_FIFO_RELAXED_KHR },
+		};
+		auto presentMode = presentModes.find(value);
+		if (presentMode == presentModes.end()) {
+			std::cerr << "Present mode must be one of 'immediate', 'mailbox', 'fifo' or 'fifo_relaxed'\n";
+		}
+		else {
+			settings.presentMode = presentMode->second;
+		}
+	}
+	if (commandLineParser.isSet("framelimit")) {
+		settings.frameRateLimit = commandLineParser.getValueAsInt("framelimit", 0);
+	}
 	if (commandLineParser.isSet("height")) {
 		height = commandLineParser.getValueAsInt("height", width);
 	}
@@ -774,6 +1087,9 @@ VulkanExampleBase::VulkanExampleBase(bool enableValidation)
 	}
 	if (commandLineParser.isSet("benchmark")) {
 		benchmark.active = true;
+		benchmark.latency = &latency;
+		benchmark.gpuProfiler = &gpuProfiler;
+		benchmark.collectFootprint = [this](vks::Benchmark::ResourceFootprint &footprint) { collectResourceFootprint(footprint); };
 		vks::tools::errorModeSilent = true;
 	}
 	if (commandLineParser.isSet("benchmarkwarmup")) {
@@ -785,9 +1101,50 @@ VulkanExampleBase::VulkanExampleBase(bool enableValidation)
 	if (commandLineParser.isSet("benchmarkresultfile")) {
 		benchmark.filename = commandLineParser.getValueAsString("benchmarkresultfile", benchmark.filename);
 	}	
+	if (commandLineParser.isSet("memoryreport")) {
+		memoryReportFilename = commandLineParser.getValueAsString("memoryreport", "memory_report.json");
+	}
+	if (commandLineParser.isSet("benchmarkcamerapath")) {
+		const std::string filename = commandLineParser.getValueAsString("benchmarkcamerapath", "");
+		if (!cameraPath.load(filename) || cameraPath.empty()) {
+			vks::tools::exitFatal("Could not load camera path from \"" + filename + "\"", -1);
+		}
+		if (benchmark.active) {
+			benchmark.cameraPath = &cameraPath;
+		}
+		else {
+			std::cerr << "Camera paths are only replayed in benchmark mode (--benchmark)\n";
+		}
+	}
+	if (commandLineParser.isSet("recordcamerapath") && !benchmark.cameraPath) {
+		cameraPathFilename = commandLineParser.getValueAsString("recordcamerapath", "camera_path.bin");
+		cameraPath.beginRecording();
+	}
+	if (commandLineParser.isSet("trace")) {
+		if (vks::CpuProfiler::isEnabled()) {
+			traceFilename = commandLineParser.getValueAsString("trace", "trace.json");
+			vks::CpuProfiler::start();
+			vks::CpuProfiler::setThreadName("Main thread");
+			startupTimestamp = vks::CpuProfiler::now();
+		}
+		else {
+			std::cerr << "CPU profiling zones have been disabled at compile time (USE_CPU_PROFILER), no trace will be written\n";
+		}
+	}
 	if (commandLineParser.isSet("benchmarkresultframes")) {
 		benchmark.outputFrameTimes = true;
 	}
+	if (commandLineParser.isSet("benchmarkhitchthresholds")) {
+		// Comma separated list of frame times in milliseconds
+		std::stringstream thresholds(commandLineParser.getValueAsString("benchmarkhitchthresholds", ""));
+		std::string threshold;
+		benchmark.hitchThresholds.clear();
+		while (std::getline(thresholds, threshold, ',')) {
+			benchmark.hitchThresholds.push_back(atof(threshold.c_str()));
+		}
+	}
+	// Started after the trace, so the worker threads show up with their names
+	jobSystem.start(static_cast<uint32_t>(commandLineParser.getValueAsInt("jobthreads", 0)), commandLineParser.isSet("pinthreads"));
 
 #if defined(VK_USE_PLATFORM_ANDROID_KHR)
 	// Vulkan library is loaded dynamically on Android
@@ -813,6 +1170,27 @@ VulkanExampleBase::VulkanExampleBase(bool enableValidation)
 
 VulkanExampleBase::~VulkanExampleBase()
 {
+	if (cameraPath.isRecording()) {
+		cameraPath.endRecording();
+		if (cameraPath.save(cameraPathFilename)) {
+			std::cout << "Camera path (" << cameraPath.getDuration() << " s) written to " << cameraPathFilename << "\n";
+		}
+		else {
+			std::cerr << "Could not write camera path to " << cameraPathFilename << "\n";
+		}
+	}
+
+	// Written before the base class' clean up, which is not instrumented, but after the derived class' destructor
+	if (traceFilename != "") {
+		vks::CpuProfiler::stop();
+		if (vks::CpuProfiler::writeTrace(traceFilename)) {
+			std::cout << "CPU trace written to " << traceFilename << "\n";
+		}
+		else {
+			std::cerr << "Could not write CPU trace to " << traceFilename << "\n";
+		}
+	}
+
 	// Clean up Vulkan resources
 	swapChain.cleanup();
 	if (descriptorPool != VK_NULL_HANDLE)
@@ -825,6 +1203,14 @@ VulkanExampleBase::~VulkanExampleBase()
 	{
 		vkDestroyFramebuffer(device, frameBuffers[i], nullptr);
 	}
+	if (overlayRenderPass != VK_NULL_HANDLE)
+	{
+		vkDestroyRenderPass(device, overlayRenderPass, nullptr);
+	}
+	for (auto& overlayFrameBuffer : overlayFrameBuffers)
+	{
+		vkDestroyFramebuffer(device, overlayFrameBuffer, nullptr);
+	}
 
 	for (auto& shaderModule : shaderModules)
 	{
@@ -832,22 +1218,23 @@ VulkanExampleBase::~VulkanExampleBase()
 	}
 	vkDestroyImageView(device, depthStencil.view, nullptr);
 	vkDestroyImage(device, depthStencil.image, nullptr);
-	vkFreeMemory(device, depthStencil.mem, nullptr);
+	vulkanDevice->freeMemory(depthStencil.mem);
 
 	vkDestroyPipelineCache(device, pipelineCache, nullptr);
 
 	vkDestroyCommandPool(device, cmdPool, nullptr);
 
-	vkDestroySemaphore(device, semaphores.presentComplete, nullptr);
-	vkDestroySemaphore(device, semaphores.renderComplete, nullptr);
-	for (auto& fence : waitFences) {
-		vkDestroyFence(device, fence, nullptr);
-	}
+	destroySynchronizationPrimitives();
+
+	gpuProfiler.destroy();
 
 	if (settings.overlay) {
 		UIOverlay.freeResources();
 	}
 
+	vulkanDevice->transferEngine = nullptr;
+	transferEngine.destroy();
+
 	delete vulkanDevice;
 
 	if (settings.validation)
@@ -894,6 +1281,7 @@ VulkanExampleBase::~VulkanExampleBase()
 
 bool VulkanExampleBase::initVulkan()
 {
+	VKS_PROFILE_FUNCTION();
 	VkResult err;
 
 	// Vulkan instance
@@ -971,37 +1359,70 @@ bool VulkanExampleBase::initVulkan()
 	// Derived examples can override this to set actual features (based on above readings) to enable for logical device creation
 	getEnabledFeatures();
 
+	// Enable all supported texture compression formats, so the texture loaders can select compressed asset variants
+	enabledFeatures.textureCompressionBC |= deviceFeatures.textureCompressionBC;
+	enabledFeatures.textureCompressionASTC_LDR |= deviceFeatures.textureCompressionASTC_LDR;
+	enabledFeatures.textureCompressionETC2 |= deviceFeatures.textureCompressionETC2;
+	// Required by the compute mip generator, which writes to storage images without a format qualifier
+	enabledFeatures.shaderStorageImageWriteWithoutFormat |= deviceFeatures.shaderStorageImageWriteWithoutFormat;
+
 	// Vulkan device creation
 	// This is handled by a separate class that gets a logical device representation
 	// and encapsulates functions related to a device
 	vulkanDevice = new vks::VulkanDevice(physicalDevice);
-	VkResult res = vulkanDevice->createLogicalDevice(enabledFeatures, enabledDeviceExtensions, deviceCreatepNextChain);
+	vulkanDevice->jobSystem = &jobSystem;
+
+	void *pNextChain = deviceCreatepNextChain;
+#if defined(VK_KHR_present_wait) && defined(VK_KHR_present_id)
+	// Present wait is used to timestamp when frames are displayed for latency measurements
+	// The features are optional, so they need to be queried (which requires Vulkan 1.1)
+	VkPhysicalDevicePresentIdFeaturesKHR presentIdFeatures{};
+	presentIdFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+	VkPhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures{};
+	presentWaitFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+	if ((apiVersion >= VK_API_VERSION_1_1) && (deviceProperties.apiVersion >= VK_API_VERSION_1_1) && vulkanDevice->extensionSupported(VK_KHR_PRESENT_ID_EXTENSION_NAME) && vulkanDevice->extensionSupported(VK_KHR_PRESENT_WAIT_EXTENSION_NAME)) {
+		presentIdFeatures.pNext = &presentWaitFeatures;
+		VkPhysicalDeviceFeatures2 deviceFeatures2{};
+		deviceFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+		deviceFeatures2.pNext = &presentIdFeatures;
+		vkGetPhysicalDeviceFeatures2(physicalDevice, &deviceFeatures2);
+		if (presentIdFeatures.presentId && presentWaitFeatures.presentWait) {
+			enabledDeviceExtensions.push_back(VK_KHR_PRESENT_ID_EXTENSION_NAME);
+			enabledDeviceExtensions.push_back(VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+			presentWaitFeatures.pNext = pNextChain;
+			pNextChain = &presentIdFeatures;
+			swapChain.enablePresentWait = true;
+		}
+	}
+#endif
+
+	VkResult res = vulkanDevice->createLogicalDevice(enabledFeatures, enabledDeviceExtensions, pNextChain);
 	if (res != VK_SUCCESS) {
 		vks::tools::exitFatal("Could not create Vulkan device: \n" + vks::tools::errorString(res), res);
 		return false;
 	}
 	device = vulkanDevice->logicalDevice;
 
+	// The heap budgets are queried with an instance level function
+	if (vulkanDevice->enableMemoryBudget) {
+		vulkanDevice->getMemoryProperties2 = reinterpret_cast<PFN_vkGetPhysicalDeviceMemoryProperties2KHR>(vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceMemoryProperties2KHR"));
+	}
+
 	// Get a graphics queue from the device
 	vkGetDeviceQueue(device, vulkanDevice->queueFamilyIndices.graphics, 0, &queue);
 
+	// Uploads of the glTF model loader are batched on the transfer queue
+	transferEngine.create(vulkanDevice, queue);
+	vulkanDevice->transferEngine = &transferEngine;
+
 	// Find a suitable depth format
 	VkBool32 validDepthFormat = vks::tools::getSupportedDepthFormat(physicalDevice, &depthFormat);
 	assert(validDepthFormat);
 
 	swapChain.connect(instance, physicalDevice, device);
 
-	// Create synchronization objects
-	VkSemaphoreCreateInfo semaphoreCreateInfo = vks::initializers::semaphoreCreateInfo();
-	// Create a semaphore used to synchronize image presentation
-	// Ensures that the image is displayed before we start submitting new commands to the queue
-	VK_CHECK_RESULT(vkCreateSemaphore(device, &semaphoreCreateInfo, nullptr, &semaphores.presentComplete));
-	// Create a semaphore used to synchronize command submission
-	// Ensures that the image is not presented until all commands have been submitted and executed
-	VK_CHECK_RESULT(vkCreateSemaphore(device, &semaphoreCreateInfo, nullptr, &semaphores.renderComplete));
-
 	// Set up submit info structure
-	// Semaphores will stay the same during application lifetime
+	// Points at the semaphores of the current frame in flight, which are switched by prepareFrame
 	// Command buffer submission info is set by each example
 	submitInfo = vks::initializers::submitInfo();
 	submitInfo.pWaitDstStageMask = &submitPipelineStages;
@@ -1207,6 +1628,7 @@ void VulkanExampleBase::handleMessages(HWND hWnd, UINT uMsg, WPARAM wParam, LPAR
 			}
 		}
 
+		latency.markInput();
 		keyPressed((uint32_t)wParam);
 		break;
 	case WM_KEYUP:
@@ -1908,6 +2330,7 @@ void VulkanExampleBase::handleEvent(const DFBWindowEvent *event)
 			default:
 				break;
 		}
+		latency.markInput();
 		keyPressed(event->key_symbol);
 		break;
 	case DWET_SIZE:
@@ -2062,8 +2485,10 @@ void VulkanExampleBase::keyboardKey(struct wl_keyboard *keyboard,
 		break;
 	}
 
-	if (state)
+	if (state) {
+		latency.markInput();
 		keyPressed(key);
+	}
 }
 
 /*static*/void VulkanExampleBase::keyboardModifiersCb(void *data,
@@ -2443,6 +2868,7 @@ void VulkanExampleBase::handleEvent(const xcb_generic_event_t *event)
 				quit = true;
 				break;
 		}
+		latency.markInput();
 		keyPressed(keyEvent->detail);
 	}
 	break;
@@ -2489,6 +2915,56 @@ void VulkanExampleBase::createSynchronizationPrimitives()
 	for (auto& fence : waitFences) {
 		VK_CHECK_RESULT(vkCreateFence(device, &fenceCreateInfo, nullptr, &fence));
 	}
+
+	// Per-frame objects, so the host can prepare a frame while the device still works on previous ones
+	assert(maxFramesInFlight > 0);
+	frames.resize(maxFramesInFlight);
+	VkSemaphoreCreateInfo semaphoreCreateInfo = vks::initializers::semaphoreCreateInfo();
+	VkCommandBufferAllocateInfo cmdBufAllocateInfo = vks::initializers::commandBufferAllocateInfo(cmdPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, 1);
+	VkCommandBufferAllocateInfo secondaryCmdBufAllocateInfo = vks::initializers::commandBufferAllocateInfo(cmdPool, VK_COMMAND_BUFFER_LEVEL_SECONDARY, 1);
+	for (auto& frame : frames) {
+		// Created signaled, as the first wait for each frame has nothing to wait for
+		VK_CHECK_RESULT(vkCreateFence(device, &fenceCreateInfo, nullptr, &frame.fence));
+		// Ensures that the image is displayed before we start submitting new commands to the queue
+		VK_CHECK_RESULT(vkCreateSemaphore(device, &semaphoreCreateInfo, nullptr, &frame.presentComplete));
+		// Ensures that the image is not presented until all commands have been submitted and executed
+		VK_CHECK_RESULT(vkCreateSemaphore(device, &semaphoreCreateInfo, nullptr, &frame.renderComplete));
+		VK_CHECK_RESULT(vkCreateSemaphore(device, &semaphoreCreateInfo, nullptr, &frame.profilerBegun));
+		VK_CHECK_RESULT(vkAllocateCommandBuffers(device, &cmdBufAllocateInfo, &frame.commandBuffer));
+		// UI overlay, drawn on top of the example's output
+		VK_CHECK_RESULT(vkCreateSemaphore(device, &semaphoreCreateInfo, nullptr, &frame.overlayComplete));
+		VK_CHECK_RESULT(vkAllocateCommandBuffers(device, &cmdBufAllocateInfo, &frame.overlayCommandBuffer));
+		VK_CHECK_RESULT(vkAllocateCommandBuffers(device, &secondaryCmdBufAllocateInfo, &frame.overlaySecondaryCommandBuffer));
+	}
+	currentFrame = 0;
+	semaphores.presentComplete = frames[0].presentComplete;
+	semaphores.renderComplete = frames[0].renderComplete;
+	imageFences.assign(swapChain.imageCount, VK_NULL_HANDLE);
+}
+
+void VulkanExampleBase::destroySynchronizationPrimitives()
+{
+	for (auto& fence : waitFences) {
+		vkDestroyFence(device, fence, nullptr);
+	}
+	// Per-frame command buffers are freed along with the command pool
+	for (auto& frame : frames) {
+		vkDestroyFence(device, frame.fence, nullptr);
+		vkDestroySemaphore(device, frame.presentComplete, nullptr);
+		vkDestroySemaphore(device, frame.renderComplete, nullptr);
+		vkDestroySemaphore(device, frame.profilerBegun, nullptr);
+		vkDestroySemaphore(device, frame.overlayComplete, nullptr);
+	}
+	frames.clear();
+}
+
+void VulkanExampleBase::createPerFrameUniformBuffers(std::vector<vks::Buffer> &buffers, VkDeviceSize size)
+{
+	buffers.resize(maxFramesInFlight);
+	for (auto& buffer : buffers) {
+		VK_CHECK_RESULT(vulkanDevice->createBuffer(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, vks::MemoryUsage::Dynamic, &buffer, size));
+		VK_CHECK_RESULT(buffer.map());
+	}
 }
 
 void VulkanExampleBase::createCommandPool()
@@ -2521,7 +2997,7 @@ void VulkanExampleBase::setupDepthStencil()
 	memAllloc.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
 	memAllloc.allocationSize = memReqs.size;
 	memAllloc.memoryTypeIndex = vulkanDevice->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-	VK_CHECK_RESULT(vkAllocateMemory(device, &memAllloc, nullptr, &depthStencil.mem));
+	VK_CHECK_RESULT(vulkanDevice->allocateMemory(memAllloc, &depthStencil.mem, vks::MemoryCategory::RenderTarget, "Depth stencil"));
 	VK_CHECK_RESULT(vkBindImageMemory(device, depthStencil.image, depthStencil.mem, 0));
 
 	VkImageViewCreateInfo imageViewCI{};
@@ -2639,6 +3115,77 @@ void VulkanExampleBase::setupRenderPass()
 	VK_CHECK_RESULT(vkCreateRenderPass(device, &renderPassInfo, nullptr, &renderPass));
 }
 
+void VulkanExampleBase::setupOverlayRenderPass()
+{
+	// Color only, the overlay is drawn on top of the example's output that is already in the present layout
+	VkAttachmentDescription attachment = {};
+	attachment.format = swapChain.colorFormat;
+	attachment.samples = VK_SAMPLE_COUNT_1_BIT;
+	attachment.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+	attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+	attachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+	attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+	attachment.initialLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+	attachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+
+	VkAttachmentReference colorReference = {};
+	colorReference.attachment = 0;
+	colorReference.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+	VkSubpassDescription subpassDescription = {};
+	subpassDescription.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+	subpassDescription.colorAttachmentCount = 1;
+	subpassDescription.pColorAttachments = &colorReference;
+
+	// Subpass dependencies for layout transitions
+	std::array<VkSubpassDependency, 2> dependencies;
+
+	// The example's writes to the image have to be finished before the overlay is blended on top
+	dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+	dependencies[0].dstSubpass = 0;
+	dependencies[0].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+	dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+	dependencies[0].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+	dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+	dependencies[0].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
+
+	dependencies[1].srcSubpass = 0;
+	dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+	dependencies[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+	dependencies[1].dstStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+	dependencies[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+	dependencies[1].dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+	dependencies[1].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
+
+	VkRenderPassCreateInfo renderPassInfo = {};
+	renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+	renderPassInfo.attachmentCount = 1;
+	renderPassInfo.pAttachments = &attachment;
+	renderPassInfo.subpassCount = 1;
+	renderPassInfo.pSubpasses = &subpassDescription;
+	renderPassInfo.dependencyCount = static_cast<uint32_t>(dependencies.size());
+	renderPassInfo.pDependencies = dependencies.data();
+
+	VK_CHECK_RESULT(vkCreateRenderPass(device, &renderPassInfo, nullptr, &overlayRenderPass));
+}
+
+void VulkanExampleBase::setupOverlayFrameBuffers()
+{
+	VkFramebufferCreateInfo frameBufferCreateInfo = vks::initializers::framebufferCreateInfo();
+	frameBufferCreateInfo.renderPass = overlayRenderPass;
+	frameBufferCreateInfo.attachmentCount = 1;
+	frameBufferCreateInfo.width = width;
+	frameBufferCreateInfo.height = height;
+	frameBufferCreateInfo.layers = 1;
+
+	overlayFrameBuffers.resize(swapChain.imageCount);
+	for (uint32_t i = 0; i < overlayFrameBuffers.size(); i++)
+	{
+		frameBufferCreateInfo.pAttachments = &swapChain.buffers[i].view;
+		VK_CHECK_RESULT(vkCreateFramebuffer(device, &frameBufferCreateInfo, nullptr, &overlayFrameBuffers[i]));
+	}
+}
+
 void VulkanExampleBase::getEnabledFeatures() {}
 
 void VulkanExampleBase::windowResize()
@@ -2647,6 +3194,7 @@ void VulkanExampleBase::windowResize()
 	{
 		return;
 	}
+	VKS_PROFILE_FUNCTION();
 	prepared = false;
 	resized = true;
 
@@ -2657,16 +3205,28 @@ void VulkanExampleBase::windowResize()
 	width = destWidth;
 	height = destHeight;
 	setupSwapChain();
+	// The number of swap chain images may have changed, all frames have completed after the wait above
+	imageFences.assign(swapChain.imageCount, VK_NULL_HANDLE);
+	// Present ids are per swap chain, presents to the old one can no longer be waited for
+	latency.discardPresented();
 
 	// Recreate the frame buffers
 	vkDestroyImageView(device, depthStencil.view, nullptr);
 	vkDestroyImage(device, depthStencil.image, nullptr);
-	vkFreeMemory(device, depthStencil.mem, nullptr);
+	vulkanDevice->freeMemory(depthStencil.mem);
 	setupDepthStencil();
 	for (uint32_t i = 0; i < frameBuffers.size(); i++) {
 		vkDestroyFramebuffer(device, frameBuffers[i], nullptr);
 	}
 	setupFrameBuffer();
+	if (settings.overlay) {
+		for (auto& overlayFrameBuffer : overlayFrameBuffers) {
+			vkDestroyFramebuffer(device, overlayFrameBuffer, nullptr);
+		}
+		setupOverlayFrameBuffers();
+		// The viewport is part of the overlay's recorded command buffers
+		overlayVersion++;
+	}
 
 	if ((width > 0.0f) && (height > 0.0f)) {
 		if (settings.overlay) {
@@ -2678,7 +3238,12 @@ void VulkanExampleBase::windowResize()
 	// references to the recreated frame buffer
 	destroyCommandBuffers();
 	createCommandBuffers();
-	buildCommandBuffers();
+	// The number of swap chain images may have changed
+	createGpuProfiler();
+	{
+		VKS_PROFILE_ZONE("buildCommandBuffers");
+		buildCommandBuffers();
+	}
 
 	vkDeviceWaitIdle(device);
 
@@ -2695,6 +3260,8 @@ void VulkanExampleBase::windowResize()
 
 void VulkanExampleBase::handleMouseMove(int32_t x, int32_t y)
 {
+	latency.markInput();
+
 	int32_t dx = (int32_t)mousePos.x - x;
 	int32_t dy = (int32_t)mousePos.y - y;
 
@@ -2749,7 +3316,7 @@ void VulkanExampleBase::initSwapchain()
 
 void VulkanExampleBase::setupSwapChain()
 {
-	swapChain.create(&width, &height, settings.vsync);
+	swapChain.create(&width, &height, settings.vsync, settings.presentMode);
 }
 
 void VulkanExampleBase::OnUpdateUIOverlay(vks::UIOverlay *overlay) {}
@@ -2761,6 +3328,8 @@ CommandLineParser::CommandLineParser()
 	add("help", { "--help" }, 0, "Show help");
 	add("validation", {"-v", "--validation"}, 0, "Enable validation layers");
 	add("vsync", {"-vs", "--vsync"}, 0, "Enable V-Sync");
+	add("presentmode", { "-pm", "--presentmode" }, 1, "Select present mode (immediate, mailbox, fifo or fifo_relaxed), takes precedence over V-Sync");
+	add("framelimit", { "-fl", "--framelimit" }, 1, "Limit the frame rate to the given number of frames per second");
 	add("fullscreen", { "-f", "--fullscreen" }, 0, "Start in fullscreen mode");
 	add("width", { "-w", "--width" }, 1, "Set window width");
 	add("height", { "-h", "--height" }, 1, "Set window height");
@@ -2772,6 +3341,13 @@ CommandLineParser::CommandLineParser()
 	add("benchmarkruntime", { "-br", "--benchruntime" }, 1, "Set duration time for benchmark mode in seconds");
 	add("benchmarkresultfile", { "-bf", "--benchfilename" }, 1, "Set file name for benchmark results");
 	add("benchmarkresultframes", { "-bt", "--benchframetimes" }, 0, "Save frame times to benchmark results file");
+	add("benchmarkhitchthresholds", { "-bh", "--benchhitches" }, 1, "Set frame time thresholds in ms for benchmark hitch counts (comma separated)");
+	add("memoryreport", { "-mr", "--memoryreport" }, 1, "Write a JSON report of the device memory usage per category to the given file on exit");
+	add("trace", { "-tr", "--trace" }, 1, "Record CPU profiling zones of all threads and write them as Chrome trace event JSON to the given file on exit");
+	add("recordcamerapath", { "-rcp", "--recordcamerapath" }, 1, "Record the camera path and write it to the given file on exit");
+	add("benchmarkcamerapath", { "-bcp", "--benchcamerapath" }, 1, "Replay a recorded camera path with a fixed time step in benchmark mode, the benchmark renders the whole path once");
+	add("jobthreads", { "-jt", "--jobthreads" }, 1, "Set the number of job system worker threads (in addition to the main thread), defaults to one less than the number of cores");
+	add("pinthreads", { "-pt", "--pinthreads" }, 0, "Pin the job system worker threads to cores");
 }
 
 void CommandLineParser::add(std::string name, std::vector<std::string> commands, bool hasValue, std::string help)
@@ -45,6 +45,7 @@
 #include <random>
 #include <algorithm>
 #include <sys/stat.h>
+#include <thread>
 
 #define GLM_FORCE_RADIANS
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
@@ -67,6 +68,14 @@
 #include "VulkanBuffer.h"
 #include "VulkanDevice.h"
 #include "VulkanTexture.h"
+#include "VulkanTransferEngine.h"
+#include "VulkanLatencyTracker.h"
+#include "VulkanGpuProfiler.h"
+#include "VulkanCpuProfiler.h"
+#include "VulkanCameraPath.h"
+#include "VulkanJobSystem.h"
+#include "VulkanPipelineBatch.h"
+#include "VulkanObjectCounters.h"
 
 #include "VulkanInitializers.hpp"
 #include "camera.hpp"
@@ -107,11 +116,40 @@ private:
 	void createPipelineCache();
 	void createCommandPool();
 	void createSynchronizationPrimitives();
+	void destroySynchronizationPrimitives();
+	// Submitted right before and after an image's command buffer to measure the whole frame on the device, unless the example profiles it's command buffers itself
+	struct ProfilerCommandBuffers {
+		VkCommandBuffer begin = VK_NULL_HANDLE;
+		VkCommandBuffer end = VK_NULL_HANDLE;
+	};
+	std::vector<ProfilerCommandBuffers> profilerCmdBuffers;
+	void createGpuProfiler();
+	// Fence of the frame in flight that last rendered to each swap chain image, to not record or submit an image's command buffer while it's still pending
+	std::vector<VkFence> imageFences;
+	// Start of the example's construction, the startup zone ends with the first frame
+	uint64_t startupTimestamp = 0;
+	void replayCameraPathFrame(float startTimer);
+	// Start of the example's construction and the time it took to present the first frame in milliseconds (reported with the benchmark results)
+	std::chrono::time_point<std::chrono::high_resolution_clock> constructionTimestamp = std::chrono::high_resolution_clock::now();
+	double startupTime = 0.0;
+	void collectResourceFootprint(vks::Benchmark::ResourceFootprint &footprint);
 	void initSwapchain();
 	void setupSwapChain();
 	void createCommandBuffers();
 	void destroyCommandBuffers();
 	std::string shaderDir = "glsl";
+	// Start of the last frame, used by the frame rate limiter
+	std::chrono::time_point<std::chrono::high_resolution_clock> frameLimiterTimestamp;
+	// The UI overlay is drawn in a render pass of it's own on top of the example's output, so UI changes never require re-recording the example's command buffers
+	VkRenderPass overlayRenderPass = VK_NULL_HANDLE;
+	std::vector<VkFramebuffer> overlayFrameBuffers;
+	// Incremented whenever the overlay's draw data changes, a frame's secondary command buffer is re-recorded if it's outdated
+	uint64_t overlayVersion = 0;
+	// Time since the last overlay update (for the update rate cap)
+	float overlayTimer = 0.0f;
+	void setupOverlayRenderPass();
+	void setupOverlayFrameBuffers();
+	VkSemaphore submitOverlay();
 protected:
 	// Returns the path to the root of the glsl or hlsl shader directory.
 	std::string getShadersPath() const;
@@ -166,7 +204,7 @@ protected:
 	VkPipelineCache pipelineCache;
 	// Wraps the swap chain to present images (framebuffers) to the windowing system
 	VulkanSwapChain swapChain;
-	// Synchronization semaphores
+	// Synchronization semaphores of the current frame in flight (switched by prepareFrame)
 	struct {
 		// Swap chain image presentation
 		VkSemaphore presentComplete;
@@ -174,6 +212,29 @@ protected:
 		VkSemaphore renderComplete;
 	} semaphores;
 	std::vector<VkFence> waitFences;
+	/** @brief Number of frames the host may prepare ahead of the device (set in the derived constructor), above 1 all data written by the host per frame needs one copy per frame in flight */
+	uint32_t maxFramesInFlight = 1;
+	/** @brief Index of the frame in flight that is being prepared, selects the per-frame resources the host may write to */
+	uint32_t currentFrame = 0;
+	/** @brief Synchronization objects and command buffer owned by a single frame in flight */
+	struct FrameResources {
+		// Signaled once all of the frame's submissions have completed
+		VkFence fence = VK_NULL_HANDLE;
+		VkSemaphore presentComplete = VK_NULL_HANDLE;
+		VkSemaphore renderComplete = VK_NULL_HANDLE;
+		// Signaled by the submission that begins the frame's profiler scope, which waits for presentComplete in place of the example
+		VkSemaphore profilerBegun = VK_NULL_HANDLE;
+		// For examples recording their commands every frame
+		VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+		// Latency tracker id of the frame that last used these resources (also used as the present id)
+		uint64_t frameId = 0;
+		// Draws the UI overlay on top of the frame, the secondary command buffer is only re-recorded when the overlay changed
+		VkCommandBuffer overlayCommandBuffer = VK_NULL_HANDLE;
+		VkCommandBuffer overlaySecondaryCommandBuffer = VK_NULL_HANDLE;
+		VkSemaphore overlayComplete = VK_NULL_HANDLE;
+		uint64_t overlayVersion = 0;
+	};
+	std::vector<FrameResources> frames;
 public:
 	bool prepared = false;
 	bool resized = false;
@@ -187,10 +248,27 @@ public:
 	float frameTimer = 1.0f;
 
 	vks::Benchmark benchmark;
+	/** @brief Timestamps input, submission and presentation of frames, the latency distributions are part of the benchmark results */
+	vks::LatencyTracker latency;
+	/** @brief Device timings of named scopes, examples record them into their command buffers with the command buffer's index as the slot */
+	vks::GpuProfiler gpuProfiler;
+	/** @brief File the device memory report is written to when the render loop exits (set with --memoryreport), no report is written if empty */
+	std::string memoryReportFilename;
+	/** @brief File the CPU profiling zones of all threads are written to as trace event JSON on exit (set with --trace), nothing is recorded if empty */
+	std::string traceFilename;
+	/** @brief Camera path recorded (set with --recordcamerapath) or replayed in benchmark mode (set with --benchcamerapath) */
+	vks::CameraPath cameraPath;
+	/** @brief File the recorded camera path is written to on exit */
+	std::string cameraPathFilename;
+	/** @brief Work stealing job system shared by the example and the framework (worker count set with --jobthreads) */
+	vks::JobSystem jobSystem;
 
 	/** @brief Encapsulated physical and logical vulkan device */
 	vks::VulkanDevice *vulkanDevice;
 
+	/** @brief Batched uploads on the dedicated transfer queue (also used by the glTF model loader) */
+	vks::TransferEngine transferEngine;
+
 	/** @brief Example settings that can be changed e.g. by command line arguments */
 	struct Settings {
 		/** @brief Activates validation layers (and message output) when set to true */
@@ -199,8 +277,14 @@ public:
 		bool fullscreen = false;
 		/** @brief Set to true if v-sync will be forced for the swapchain */
 		bool vsync = false;
+		/** @brief Present mode requested for the swapchain (set with --presentmode), VK_PRESENT_MODE_MAX_ENUM_KHR selects one based on vsync */
+		VkPresentModeKHR presentMode = VK_PRESENT_MODE_MAX_ENUM_KHR;
+		/** @brief Maximum number of frames per second (set with --framelimit), 0 for no limit */
+		uint32_t frameRateLimit = 0;
 		/** @brief Enable UI overlay */
 		bool overlay = false;
+		/** @brief Maximum number of UI overlay updates per second, the last update is drawn again in between (0 updates the overlay every frame) */
+		uint32_t overlayUpdateRate = 30;
 	} settings;
 
 	VkClearColorValue defaultClearColor = { { 0.025f, 0.025f, 0.025f, 1.0f } };
@@ -393,13 +477,12 @@ public:
 	/** @brief Entry point for the main render loop */
 	void renderLoop();
 
-	/** @brief Adds the drawing commands for the ImGui overlay to the given command buffer */
-	void drawUI(const VkCommandBuffer commandBuffer);
-
-	/** Prepare the next frame for workload submission by acquiring the next swap chain image */
+	/** Prepare the next frame for workload submission by waiting for the frame in flight at currentFrame and acquiring the next swap chain image */
 	void prepareFrame();
-	/** @brief Presents the current image to the swap chain */
+	/** @brief Presents the current image to the swap chain and advances to the next frame in flight */
 	void submitFrame();
+	/** @brief Create one persistently mapped, host coherent uniform buffer per frame in flight (to be written for the frame at currentFrame) */
+	void createPerFrameUniformBuffers(std::vector<vks::Buffer> &buffers, VkDeviceSize size);
 	/** @brief (Virtual) Default image acquire + submission and command buffer submission function */
 	virtual void renderFrame();
 
@@ -0,0 +1,238 @@
+/*
+* Standalone CPU benchmark for the block compression encoder (no Vulkan device required)
+*
+* Compresses a synthetic RGBA image to all supported formats, on the calling thread and split across the job system,
+* and reports the throughput along with the PSNR of the decoded result
+*
+* Usage: blockcompression-benchmark [-s size] [-i iterations] [-t threads]
+*
+* Copyright (C) by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "blockcompression.h"
+#include "VulkanJobSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+	// Reads bit fields from a block starting at the least significant bit of the first byte
+	struct BitReader
+	{
+		const uint8_t *data;
+		uint32_t position = 0;
+		BitReader(const uint8_t *data) : data(data) {}
+		uint32_t read(uint32_t bitCount)
+		{
+			uint32_t value = 0;
+			for (uint32_t i = 0; i < bitCount; i++, position++) {
+				value |= ((data[position >> 3] >> (position & 7)) & 1) << i;
+			}
+			return value;
+		}
+	};
+
+	void decodeBC1(const uint8_t *block, uint8_t rgba[64])
+	{
+		const uint32_t c0 = block[0] | (block[1] << 8);
+		const uint32_t c1 = block[2] | (block[3] << 8);
+		uint8_t palette[4][4];
+		const uint32_t colors[2] = { c0, c1 };
+		for (uint32_t i = 0; i < 2; i++) {
+			palette[i][0] = static_cast<uint8_t>(((colors[i] >> 11) & 31) * 255 / 31);
+			palette[i][1] = static_cast<uint8_t>(((colors[i] >> 5) & 63) * 255 / 63);
+			palette[i][2] = static_cast<uint8_t>((colors[i] & 31) * 255 / 31);
+			palette[i][3] = 255;
+		}
+		for (uint32_t c = 0; c < 4; c++) {
+			if (c0 > c1) {
+				palette[2][c] = static_cast<uint8_t>((2 * palette[0][c] + palette[1][c]) / 3);
+				palette[3][c] = static_cast<uint8_t>((palette[0][c] + 2 * palette[1][c]) / 3);
+			}
+			else {
+				palette[2][c] = static_cast<uint8_t>((palette[0][c] + palette[1][c]) / 2);
+				palette[3][c] = 0;
+			}
+		}
+		const uint32_t indices = block[4] | (block[5] << 8) | (block[6] << 16) | (static_cast<uint32_t>(block[7]) << 24);
+		for (uint32_t i = 0; i < 16; i++) {
+			memcpy(&rgba[i * 4], palette[(indices >> (i * 2)) & 3], 4);
+		}
+	}
+
+	void decodeBC4(const uint8_t *block, uint8_t rgba[64], uint32_t channel)
+	{
+		const uint32_t r0 = block[0];
+		const uint32_t r1 = block[1];
+		uint32_t palette[8] = { r0, r1 };
+		if (r0 > r1) {
+			for (uint32_t i = 1; i < 7; i++) {
+				palette[i + 1] = ((7 - i) * r0 + i * r1) / 7;
+			}
+		}
+		else {
+			for (uint32_t i = 1; i < 5; i++) {
+				palette[i + 1] = ((5 - i) * r0 + i * r1) / 5;
+			}
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+		BitReader reader(block + 2);
+		for (uint32_t i = 0; i < 16; i++) {
+			rgba[i * 4 + channel] = static_cast<uint8_t>(palette[reader.read(3)]);
+		}
+	}
+
+	// Mode 6 only, as that's the only mode written by the encoder
+	bool decodeBC7(const uint8_t *block, uint8_t rgba[64])
+	{
+		static const uint32_t weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+		BitReader reader(block);
+		if (reader.read(7) != 64) {
+			return false;
+		}
+		uint32_t endpoints[2][4];
+		for (uint32_t c = 0; c < 4; c++) {
+			endpoints[0][c] = reader.read(7) << 1;
+			endpoints[1][c] = reader.read(7) << 1;
+		}
+		for (uint32_t e = 0; e < 2; e++) {
+			const uint32_t pBit = reader.read(1);
+			for (uint32_t c = 0; c < 4; c++) {
+				endpoints[e][c] |= pBit;
+			}
+		}
+		for (uint32_t i = 0; i < 16; i++) {
+			// The anchor index has an implicit most significant bit of zero
+			const uint32_t index = reader.read(i == 0 ? 3 : 4);
+			for (uint32_t c = 0; c < 4; c++) {
+				rgba[i * 4 + c] = static_cast<uint8_t>(((64 - weights[index]) * endpoints[0][c] + weights[index] * endpoints[1][c] + 32) >> 6);
+			}
+		}
+		return true;
+	}
+
+	// Smooth gradients with some noise and a few hard edges, similar to what runtime generated textures look like
+	std::vector<uint8_t> generateImage(uint32_t size)
+	{
+		std::vector<uint8_t> image(static_cast<size_t>(size) * size * 4);
+		uint32_t seed = 1;
+		for (uint32_t y = 0; y < size; y++) {
+			for (uint32_t x = 0; x < size; x++) {
+				seed = seed * 1664525u + 1013904223u;
+				const float fx = static_cast<float>(x) / size;
+				const float fy = static_cast<float>(y) / size;
+				const float noise = static_cast<float>(seed >> 24) / 255.0f - 0.5f;
+				const bool checker = (((x / 64) + (y / 64)) & 1) != 0;
+				uint8_t *texel = &image[(static_cast<size_t>(y) * size + x) * 4];
+				texel[0] = static_cast<uint8_t>(std::min(std::max((0.5f + 0.5f * std::sin(fx * 12.0f)) * 255.0f + noise * 16.0f, 0.0f), 255.0f));
+				texel[1] = static_cast<uint8_t>(std::min(std::max(fy * 255.0f + noise * 8.0f, 0.0f), 255.0f));
+				texel[2] = checker ? 200 : 40;
+				texel[3] = static_cast<uint8_t>(255.0f * (0.5f + 0.5f * std::cos((fx + fy) * 8.0f)));
+			}
+		}
+		return image;
+	}
+
+	// PSNR over the channels that are stored by the format
+	double psnr(vks::bc::Format format, const std::vector<uint8_t> &image, const std::vector<uint8_t> &compressed, uint32_t size)
+	{
+		const uint32_t blocksPerRow = (size + 3) / 4;
+		const uint32_t blockSize = vks::bc::blockSize(format);
+		uint32_t channelCount = 4;
+		switch (format) {
+		case vks::bc::Format::BC1: channelCount = 3; break;
+		case vks::bc::Format::BC4: channelCount = 1; break;
+		case vks::bc::Format::BC5: channelCount = 2; break;
+		case vks::bc::Format::BC7: channelCount = 4; break;
+		}
+		double squaredError = 0.0;
+		uint8_t rgba[64];
+		for (uint32_t by = 0; by < blocksPerRow; by++) {
+			for (uint32_t bx = 0; bx < blocksPerRow; bx++) {
+				const uint8_t *block = &compressed[(static_cast<size_t>(by) * blocksPerRow + bx) * blockSize];
+				memset(rgba, 0, sizeof(rgba));
+				switch (format) {
+				case vks::bc::Format::BC1: decodeBC1(block, rgba); break;
+				case vks::bc::Format::BC4: decodeBC4(block, rgba, 0); break;
+				case vks::bc::Format::BC5: decodeBC4(block, rgba, 0); decodeBC4(block + 8, rgba, 1); break;
+				case vks::bc::Format::BC7:
+					if (!decodeBC7(block, rgba)) {
+						return 0.0;
+					}
+					break;
+				}
+				for (uint32_t i = 0; i < 16; i++) {
+					const uint32_t x = std::min(bx * 4 + (i % 4), size - 1);
+					const uint32_t y = std::min(by * 4 + (i / 4), size - 1);
+					for (uint32_t c = 0; c < channelCount; c++) {
+						const double diff = static_cast<double>(rgba[i * 4 + c]) - image[(static_cast<size_t>(y) * size + x) * 4 + c];
+						squaredError += diff * diff;
+					}
+				}
+			}
+		}
+		const double meanSquaredError = squaredError / (static_cast<double>(blocksPerRow) * blocksPerRow * 16 * channelCount);
+		return (meanSquaredError > 0.0) ? 10.0 * std::log10(255.0 * 255.0 / meanSquaredError) : 99.0;
+	}
+
+	// Fastest of all iterations in milliseconds
+	template<typename F>
+	double measure(uint32_t iterations, const F &func)
+	{
+		double best = 0.0;
+		for (uint32_t i = 0; i < iterations; i++) {
+			const auto start = std::chrono::high_resolution_clock::now();
+			func();
+			const double duration = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+			best = (i == 0) ? duration : std::min(best, duration);
+		}
+		return best;
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	uint32_t size = 2048;
+	uint32_t iterations = 5;
+	uint32_t threadCount = 0;
+	for (int i = 1; i + 1 < argc; i += 2) {
+		if (strcmp(argv[i], "-s") == 0) {
+			size = static_cast<uint32_t>(std::max(atoi(argv[i + 1]), 4));
+		}
+		else if (strcmp(argv[i], "-i") == 0) {
+			iterations = static_cast<uint32_t>(std::max(atoi(argv[i + 1]), 1));
+		}
+		else if (strcmp(argv[i], "-t") == 0) {
+			threadCount = static_cast<uint32_t>(std::max(atoi(argv[i + 1]), 0));
+		}
+	}
+
+	vks::JobSystem jobSystem;
+	jobSystem.start(threadCount);
+
+	const std::vector<uint8_t> image = generateImage(size);
+	const double megaTexels = static_cast<double>(size) * size / 1000000.0;
+	printf("Block compression of a %u x %u image, best of %u iterations, %u threads\n", size, size, iterations, jobSystem.getThreadCount());
+	printf("%-6s %14s %14s %10s %10s\n", "Format", "1 thread (ms)", "jobs (ms)", "MTexel/s", "PSNR (dB)");
+
+	const vks::bc::Format formats[] = { vks::bc::Format::BC1, vks::bc::Format::BC4, vks::bc::Format::BC5, vks::bc::Format::BC7 };
+	const char *formatNames[] = { "BC1", "BC4", "BC5", "BC7" };
+	for (uint32_t i = 0; i < 4; i++) {
+		std::vector<uint8_t> compressed(vks::bc::compressedSize(formats[i], size, size));
+		const double singleThreaded = measure(iterations, [&] { vks::bc::compress(formats[i], image.data(), size, size, 4, compressed.data()); });
+		const double jobs = measure(iterations, [&] { vks::bc::compress(formats[i], image.data(), size, size, 4, compressed.data(), &jobSystem); });
+		printf("%-6s %14.2f %14.2f %10.1f %10.2f\n", formatNames[i], singleThreaded, jobs, megaTexels / (jobs / 1000.0), psnr(formats[i], image, compressed, size));
+	}
+
+	jobSystem.stop();
+	return 0;
+}
@@ -0,0 +1,199 @@
+#!/usr/bin/env python3
+# Run all examples in benchmark mode and compare the results against a stored baseline
+#
+# Every example is started with fixed warm up and duration (random seeds are fixed in benchmark mode) and writes a JSON result
+# including all frame times. Frame times are compared to the baseline's with a one-sided Mann-Whitney U test, an example is
+# flagged as a regression if the test is significant and the median frame time increased by more than the threshold
+#
+# Works with all window system integrations, for machines without a display (or GPU) build with -DUSE_HEADLESS=ON and run on a
+# software implementation (e.g. lavapipe or SwiftShader)
+#
+# Exits with a non-zero code if any example regressed or an example with a baseline failed to run
+import argparse
+import json
+import math
+import os
+import shutil
+import subprocess
+import sys
+
+# Examples that don't use the example base class and have no benchmark mode
+SKIP = [
+	"computeheadless",
+	"renderheadless"
+]
+
+def list_examples(bin_dir):
+	examples_dir = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "examples")
+	examples = []
+	for name in sorted(os.listdir(examples_dir)):
+		if name in SKIP or not os.path.isdir(os.path.join(examples_dir, name)):
+			continue
+		if os.path.isfile(executable_path(bin_dir, name)):
+			examples.append(name)
+	return examples
+
+def executable_path(bin_dir, example):
+	return os.path.join(bin_dir, example + (".exe" if sys.platform == "win32" else ""))
+
+def run_example(args, example):
+	result_file = os.path.join(args.results_dir, example + ".csv")
+	json_file = os.path.join(args.results_dir, example + ".json")
+	if os.path.isfile(json_file):
+		os.remove(json_file)
+	command = [executable_path(args.bin_dir, example), "-b", "-bw", str(args.warmup), "-br", str(args.duration), "-bf", result_file, "-bt"] + args.example_args
+	try:
+		result_code = subprocess.call(command, cwd=args.bin_dir, timeout=args.warmup + args.duration + args.timeout)
+	except subprocess.TimeoutExpired:
+		print("Error, %s timed out" % example)
+		return None
+	if result_code != 0 or not os.path.isfile(json_file):
+		print("Error, %s exited with result code %d" % (example, result_code))
+		return None
+	with open(json_file) as file:
+		return json.load(file)
+
+def median(values):
+	values = sorted(values)
+	middle = len(values) // 2
+	return values[middle] if len(values) % 2 else (values[middle - 1] + values[middle]) / 2.0
+
+def percentile(values, p):
+	values = sorted(values)
+	rank = max(1, min(len(values), int(math.ceil(p * len(values)))))
+	return values[rank - 1]
+
+def mann_whitney_u(current, baseline):
+	"""One-sided Mann-Whitney U test for current frame times being larger than the baseline's (normal approximation with tie correction), returns the p-value"""
+	n1 = len(current)
+	n2 = len(baseline)
+	if n1 == 0 or n2 == 0:
+		return 1.0
+	combined = sorted([(value, 0) for value in current] + [(value, 1) for value in baseline])
+	n = n1 + n2
+	rank_sum = 0.0
+	tie_sum = 0.0
+	i = 0
+	while i < n:
+		j = i
+		while j + 1 < n and combined[j + 1][0] == combined[i][0]:
+			j += 1
+		# Tied values get the average of their ranks
+		rank = (i + j) / 2.0 + 1.0
+		ties = j - i + 1
+		tie_sum += ties ** 3 - ties
+		for k in range(i, j + 1):
+			if combined[k][1] == 0:
+				rank_sum += rank
+		i = j + 1
+	u = rank_sum - n1 * (n1 + 1) / 2.0
+	mean = n1 * n2 / 2.0
+	variance = n1 * n2 / 12.0 * ((n + 1) - tie_sum / (n * (n - 1)))
+	if variance <= 0.0:
+		return 1.0
+	z = (u - mean - 0.5) / math.sqrt(variance)
+	return 0.5 * math.erfc(z / math.sqrt(2.0))
+
+def compare(args, example, current, baseline):
+	row = { "example": example, "status": "ok" }
+	if current is None:
+		row["status"] = "failed" if baseline is not None else "skipped"
+		return row
+	current_times = current.get("frameTimeSamples", [])
+	row["median"] = median(current_times) if current_times else current["frameTimes"]["p50"]
+	row["p99"] = current["frameTimes"]["p99"]
+	row["fps"] = current["fps"]
+	if baseline is None:
+		row["status"] = "new"
+		return row
+	baseline_times = baseline.get("frameTimeSamples", [])
+	row["baselineMedian"] = median(baseline_times) if baseline_times else baseline["frameTimes"]["p50"]
+	row["baselineP99"] = baseline["frameTimes"]["p99"]
+	row["change"] = (row["median"] / row["baselineMedian"] - 1.0) * 100.0 if row["baselineMedian"] > 0.0 else 0.0
+	row["p99Change"] = (row["p99"] / row["baselineP99"] - 1.0) * 100.0 if row["baselineP99"] > 0.0 else 0.0
+	# Raw frame times are only part of the results if they have been requested, without them only the median is compared
+	if current_times and baseline_times:
+		row["pSlower"] = mann_whitney_u(current_times, baseline_times)
+		row["pFaster"] = mann_whitney_u(baseline_times, current_times)
+	else:
+		row["pSlower"] = 0.0 if row["change"] > 0.0 else 1.0
+		row["pFaster"] = 0.0 if row["change"] < 0.0 else 1.0
+	if row["pSlower"] < args.alpha and row["change"] > args.threshold:
+		row["status"] = "REGRESSION"
+	elif row["pFaster"] < args.alpha and row["change"] < -args.threshold:
+		row["status"] = "improved"
+	return row
+
+def print_summary(rows):
+	header = "%-28s %12s %12s %9s %9s %10s  %s" % ("example", "base (ms)", "median (ms)", "change", "p99 chg", "p-value", "status")
+	print(header)
+	print("-" * len(header))
+	for row in rows:
+		if "median" not in row:
+			print("%-28s %12s %12s %9s %9s %10s  %s" % (row["example"], "-", "-", "-", "-", "-", row["status"]))
+		elif "baselineMedian" not in row:
+			print("%-28s %12s %12.3f %9s %9s %10s  %s" % (row["example"], "-", row["median"], "-", "-", "-", row["status"]))
+		else:
+			p_value = row["pSlower"] if row["change"] >= 0.0 else row["pFaster"]
+			print("%-28s %12.3f %12.3f %8.1f%% %8.1f%% %10.2e  %s" % (row["example"], row["baselineMedian"], row["median"], row["change"], row["p99Change"], p_value, row["status"]))
+
+def main():
+	parser = argparse.ArgumentParser(description="Run all examples in benchmark mode and compare the results against a baseline")
+	parser.add_argument("--bin-dir", default=os.getcwd(), help="Directory containing the example executables")
+	parser.add_argument("--results-dir", default="./benchmark", help="Directory the results are written to")
+	parser.add_argument("--baseline", default="", help="Directory containing the baseline results to compare against")
+	parser.add_argument("--update-baseline", action="store_true", help="Copy the results of all examples that ran successfully to the baseline directory")
+	parser.add_argument("--examples", default="", help="Comma separated list of examples to run (default: all)")
+	parser.add_argument("--warmup", type=int, default=2, help="Warm up time per example in seconds")
+	parser.add_argument("--duration", type=int, default=10, help="Benchmark duration per example in seconds")
+	parser.add_argument("--timeout", type=int, default=120, help="Time in seconds an example may take to start and shut down")
+	parser.add_argument("--threshold", type=float, default=5.0, help="Minimum increase of the median frame time in percent to flag a regression")
+	parser.add_argument("--alpha", type=float, default=0.01, help="Significance level of the Mann-Whitney U test")
+	parser.add_argument("example_args", nargs=argparse.REMAINDER, help="Additional arguments passed to every example (after --)")
+	args = parser.parse_args()
+	args.bin_dir = os.path.abspath(args.bin_dir)
+	args.results_dir = os.path.abspath(args.results_dir)
+	args.example_args = [arg for arg in args.example_args if arg != "--"]
+
+	examples = args.examples.split(",") if args.examples else list_examples(args.bin_dir)
+	if not examples:
+		print("No examples found in %s" % args.bin_dir)
+		return 1
+	os.makedirs(args.results_dir, exist_ok=True)
+
+	rows = []
+	for index, example in enumerate(examples):
+		print("---- (%d/%d) Running %s in benchmark mode ----" % (index + 1, len(examples), example))
+		current = run_example(args, example)
+		baseline = None
+		baseline_file = os.path.join(args.baseline, example + ".json") if args.baseline else ""
+		if baseline_file and os.path.isfile(baseline_file):
+			with open(baseline_file) as file:
+				baseline = json.load(file)
+		rows.append(compare(args, example, current, baseline))
+
+	print("")
+	print_summary(rows)
+	with open(os.path.join(args.results_dir, "summary.json"), "w") as file:
+		json.dump(rows, file, indent="\t")
+
+	if args.update_baseline:
+		if not args.baseline:
+			print("No baseline directory given")
+			return 1
+		os.makedirs(args.baseline, exist_ok=True)
+		for row in rows:
+			if row["status"] not in ("failed", "skipped"):
+				shutil.copy(os.path.join(args.results_dir, row["example"] + ".json"), args.baseline)
+		print("Baseline updated in %s" % args.baseline)
+		return 0
+
+	regressions = [row["example"] for row in rows if row["status"] in ("REGRESSION", "failed")]
+	if regressions:
+		print("Regressions or failures: %s" % ", ".join(regressions))
+		return 1
+	print("No regressions")
+	return 0
+
+if __name__ == "__main__":
+	sys.exit(main())
@@ -4,11 +4,17 @@ layout (location = 0) in vec3 inPos;
 layout (location = 1) in vec3 inNormal;
 layout (location = 2) in vec3 inColor;
 
-layout (std140, push_constant) uniform PushConsts 
+struct Instance
 {
 	mat4 mvp;
-	vec3 color;
-} pushConsts;
+	vec4 color;
+};
+
+// Per object parameters, selected by the first instance of the draw
+layout (std430, binding = 0) readonly buffer Instances 
+{
+	Instance instances[];
+};
 
 layout (location = 0) out vec3 outNormal;
 layout (location = 1) out vec3 outColor;
@@ -17,21 +23,22 @@ layout (location = 4) out vec3 outLightVec;
 
 void main() 
 {
+	Instance instance = instances[gl_InstanceIndex];
 	outNormal = inNormal;
 
 	if ( (inColor.r == 1.0) && (inColor.g == 0.0) && (inColor.b == 0.0))
 	{	
-		outColor = pushConsts.color;
+		outColor = instance.color.rgb;
 	}
 	else
 	{
 		outColor = inColor;
 	}
 	
-	gl_Position = pushConsts.mvp * vec4(inPos.xyz, 1.0);
+	gl_Position = instance.mvp * vec4(inPos.xyz, 1.0);
 	
-    vec4 pos = pushConsts.mvp * vec4(inPos, 1.0);
-    outNormal = mat3(pushConsts.mvp) * inNormal;
+    vec4 pos = instance.mvp * vec4(inPos, 1.0);
+    outNormal = mat3(instance.mvp) * inNormal;
 //	vec3 lPos = ubo.lightPos.xyz;
 vec3 lPos = vec3(0.0);
     outLightVec = lPos - pos.xyz;
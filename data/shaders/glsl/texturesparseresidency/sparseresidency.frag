@@ -5,35 +5,72 @@
 
 layout (binding = 1) uniform sampler2D samplerColor;
 
+layout (binding = 2) uniform UBOFeedback 
+{
+	// x = page granularity width, y = page granularity height, z = first mip level in mip tail, w = frame index
+	uvec4 pageInfo;
+	// Per mip level: x = index of first page, y = pages in x, z = pages in y
+	uvec4 mips[16];
+} feedbackInfo;
+
+layout (std430, binding = 3) buffer Feedback 
+{
+	uint requestCount;
+	uint maxRequests;
+	uint padding[2];
+	uint requests[];
+} feedback;
+
 layout (location = 0) in vec2 inUV;
 layout (location = 1) in float inLodBias;
 
 layout (location = 0) out vec4 outFragColor;
 
+// Write the page covering the current texel at the sampled mip level to the feedback buffer
+void writeFeedback()
+{
+	// Only one pixel out of every 4x4 block writes feedback per frame, rotating with the frame index
+	uvec2 pixel = uvec2(gl_FragCoord.xy) & uvec2(3);
+	if (pixel.x + pixel.y * 4 != (feedbackInfo.pageInfo.w & 15)) {
+		return;
+	}
+
+	// Mip level selected by the (nearest mip mode) sampler
+	float lod = max(textureQueryLod(samplerColor, inUV).x + inLodBias, 0.0);
+	uint mipLevel = uint(lod + 0.5);
+	// Mip tail is always resident
+	if (mipLevel >= feedbackInfo.pageInfo.z) {
+		return;
+	}
+
+	uvec4 mip = feedbackInfo.mips[mipLevel];
+	ivec2 mipSize = textureSize(samplerColor, int(mipLevel));
+	uvec2 texel = uvec2(clamp(inUV, vec2(0.0), vec2(1.0)) * vec2(mipSize - 1));
+	uvec2 page = min(texel / feedbackInfo.pageInfo.xy, mip.yz - 1);
+
+	uint index = atomicAdd(feedback.requestCount, 1);
+	if (index < feedback.maxRequests) {
+		feedback.requests[index] = mip.x + page.y * mip.y + page.x;
+	}
+}
+
 void main() 
 {
 	vec4 color = vec4(0.0);
 
+	writeFeedback();
+
 	// Get residency code for current texel
 	int residencyCode = sparseTextureARB(samplerColor, inUV, color, inLodBias);
 
 	// Fetch sparse until we get a valid texel
-	/*
+	// Non-resident pages fall back to coarser mip levels, the mip tail is always resident
 	float minLod = 1.0;
 	while (!sparseTexelsResidentARB(residencyCode)) 
 	{
 		residencyCode = sparseTextureClampARB(samplerColor, inUV, minLod, color);
 		minLod += 1.0f;
 	}
-	*/
-
-	// Check if texel is resident
-	bool texelResident = sparseTexelsResidentARB(residencyCode);
-
-	if (!texelResident)
-	{
-		color = vec4(0.0, 0.0, 0.0, 0.0);
-	}
 
 	outFragColor = color;
-}
\ No newline at end of file
+}
@@ -7,12 +7,13 @@ struct VSInput
 [[vk::location(2)]] float3 Color : COLOR0;
 };
 
-struct PushConsts
+struct Instance
 {
 	float4x4 mvp;
-	float3 color;
+	float4 color;
 };
-[[vk::push_constant]]PushConsts pushConsts;
+// Per object parameters, selected by the first instance of the draw
+StructuredBuffer<Instance> instances : register(t0);
 
 struct VSOutput
 {
@@ -23,24 +24,25 @@ struct VSOutput
 [[vk::location(4)]] float3 LightVec : TEXCOORD2;
 };
 
-VSOutput main(VSInput input)
+VSOutput main(VSInput input, uint InstanceIndex : SV_InstanceID)
 {
+	Instance instance = instances[InstanceIndex];
 	VSOutput output = (VSOutput)0;
 	output.Normal = input.Normal;
 
 	if ( (input.Color.r == 1.0) && (input.Color.g == 0.0) && (input.Color.b == 0.0))
 	{
-		output.Color = pushConsts.color;
+		output.Color = instance.color.rgb;
 	}
 	else
 	{
 		output.Color = input.Color;
 	}
 
-	output.Pos = mul(pushConsts.mvp, float4(input.Pos.xyz, 1.0));
+	output.Pos = mul(instance.mvp, float4(input.Pos.xyz, 1.0));
 
-    float4 pos = mul(pushConsts.mvp, float4(input.Pos, 1.0));
-    output.Normal = mul((float3x3)pushConsts.mvp, input.Normal);
+    float4 pos = mul(instance.mvp, float4(input.Pos, 1.0));
+    output.Normal = mul((float3x3)instance.mvp, input.Normal);
 //	float3 lPos = ubo.lightPos.xyz;
 float3 lPos = float3(0.0, 0.0, 0.0);
     output.LightVec = lPos - pos.xyz;
@@ -3,8 +3,22 @@
 Texture2D textureColor : register(t1);
 SamplerState samplerColor : register(s1);
 
+struct UBOFeedback
+{
+	// x = page granularity width, y = page granularity height, z = first mip level in mip tail, w = frame index
+	uint4 pageInfo;
+	// Per mip level: x = index of first page, y = pages in x, z = pages in y
+	uint4 mips[16];
+};
+
+cbuffer feedbackInfo : register(b2) { UBOFeedback feedbackInfo; }
+
+// First four uints are the request count, the max. number of requests and padding
+RWByteAddressBuffer feedback : register(u3);
+
 struct VSOutput
 {
+	float4 Pos : SV_POSITION;
 [[vk::location(0)]] float2 UV : TEXCOORD0;
 [[vk::location(1)]] float LodBias : TEXCOORD3;
 [[vk::location(2)]] float3 Normal : NORMAL0;
@@ -12,11 +26,44 @@ struct VSOutput
 [[vk::location(4)]] float3 LightVec : TEXCOORD2;
 };
 
+// Write the page covering the current texel at the sampled mip level to the feedback buffer
+void writeFeedback(float4 fragCoord, float2 uv, float lodBias)
+{
+	// Only one pixel out of every 4x4 block writes feedback per frame, rotating with the frame index
+	uint2 pixel = uint2(fragCoord.xy) & uint2(3, 3);
+	if (pixel.x + pixel.y * 4 != (feedbackInfo.pageInfo.w & 15)) {
+		return;
+	}
+
+	// Mip level selected by the (nearest mip mode) sampler
+	float lod = max(textureColor.CalculateLevelOfDetailUnclamped(samplerColor, uv) + lodBias, 0.0);
+	uint mipLevel = uint(lod + 0.5);
+	// Mip tail is always resident
+	if (mipLevel >= feedbackInfo.pageInfo.z) {
+		return;
+	}
+
+	uint4 mip = feedbackInfo.mips[mipLevel];
+	uint mipWidth, mipHeight, mipCount;
+	textureColor.GetDimensions(mipLevel, mipWidth, mipHeight, mipCount);
+	uint2 texel = uint2(saturate(uv) * float2(mipWidth - 1, mipHeight - 1));
+	uint2 page = min(texel / feedbackInfo.pageInfo.xy, mip.yz - 1);
+
+	uint index;
+	feedback.InterlockedAdd(0, 1, index);
+	if (index < feedback.Load(4)) {
+		feedback.Store(16 + index * 4, mip.x + page.y * mip.y + page.x);
+	}
+}
+
 float4 main(VSOutput input) : SV_TARGET
 {
 	float4 color = float4(0.0, 0.0, 0.0, 0.0);
 
+	writeFeedback(input.Pos, input.UV, input.LodBias);
+
 	// Fetch sparse until we get a valid texel
+	// Non-resident pages fall back to coarser mip levels, the mip tail is always resident
 	uint status;
 	float minLod = input.LodBias;
 	do
@@ -33,4 +80,4 @@ float4 main(VSOutput input) : SV_TARGET
 	float3 R = reflect(-L, N);
 	float3 diffuse = max(dot(N, L), 0.25) * color.rgb;
 	return float4(diffuse, 1.0);
-}
\ No newline at end of file
+}
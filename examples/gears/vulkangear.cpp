@@ -228,10 +228,8 @@ void VulkanGear::generate(GearInfo *gearinfo, VkQueue queue)
 
 		vulkanDevice->flushCommandBuffer(copyCmd, queue, true);
 
-		vkDestroyBuffer(vulkanDevice->logicalDevice, vertexStaging.buffer, nullptr);
-		vkFreeMemory(vulkanDevice->logicalDevice, vertexStaging.memory, nullptr);
-		vkDestroyBuffer(vulkanDevice->logicalDevice, indexStaging.buffer, nullptr);
-		vkFreeMemory(vulkanDevice->logicalDevice, indexStaging.memory, nullptr);
+		vertexStaging.destroy();
+		indexStaging.destroy();
 	}
 	else
 	{
@@ -287,7 +285,7 @@ void VulkanGear::setupDescriptorSet(VkDescriptorPool pool, VkDescriptorSetLayout
 			&descriptorSetLayout,
 			1);
 
-	VK_CHECK_RESULT(vkAllocateDescriptorSets(vulkanDevice->logicalDevice, &allocInfo, &descriptorSet));
+	VK_CHECK_RESULT(vks::ObjectCounters::allocateDescriptorSets(vulkanDevice->logicalDevice, &allocInfo, &descriptorSet));
 
 	// Binding 0 : Vertex shader uniform buffer
 	VkWriteDescriptorSet writeDescriptorSet =
@@ -23,6 +23,7 @@
 #include "VulkanTools.h"
 #include "VulkanBuffer.h"
 #include "VulkanDevice.h"
+#include "VulkanObjectCounters.h"
 
 struct Vertex
 {
@@ -22,17 +22,14 @@ VulkanglTFScene::~VulkanglTFScene()
 {
 	// Release all Vulkan resources allocated for the model
 	vkDestroyBuffer(vulkanDevice->logicalDevice, vertices.buffer, nullptr);
-	vkFreeMemory(vulkanDevice->logicalDevice, vertices.memory, nullptr);
+	vulkanDevice->freeMemory(vertices.memory);
 	vkDestroyBuffer(vulkanDevice->logicalDevice, indices.buffer, nullptr);
-	vkFreeMemory(vulkanDevice->logicalDevice, indices.memory, nullptr);
+	vulkanDevice->freeMemory(indices.memory);
 	for (Image image : images) {
-		vkDestroyImageView(vulkanDevice->logicalDevice, image.texture.view, nullptr);
-		vkDestroyImage(vulkanDevice->logicalDevice, image.texture.image, nullptr);
-		vkDestroySampler(vulkanDevice->logicalDevice, image.texture.sampler, nullptr);
-		vkFreeMemory(vulkanDevice->logicalDevice, image.texture.deviceMemory, nullptr);
+		image.texture.destroy();
 	}
 	for (Material material : materials) {
-		vkDestroyPipeline(vulkanDevice->logicalDevice, material.pipeline, nullptr);
+		vks::ObjectCounters::destroyPipeline(vulkanDevice->logicalDevice, material.pipeline, nullptr);
 	}
 }
 
@@ -341,7 +338,6 @@ void VulkanExample::buildCommandBuffers()
 		// POI: Draw the glTF scene
 		glTFScene.draw(drawCmdBuffers[i], pipelineLayout);
 
-		drawUI(drawCmdBuffers[i]);
 		vkCmdEndRenderPass(drawCmdBuffers[i]);
 		VK_CHECK_RESULT(vkEndCommandBuffer(drawCmdBuffers[i]));
 	}
@@ -455,9 +451,9 @@ void VulkanExample::loadglTFFile(std::string filename)
 
 	// Free staging resources
 	vkDestroyBuffer(device, vertexStaging.buffer, nullptr);
-	vkFreeMemory(device, vertexStaging.memory, nullptr);
+	vulkanDevice->freeMemory(vertexStaging.memory);
 	vkDestroyBuffer(device, indexStaging.buffer, nullptr);
-	vkFreeMemory(device, indexStaging.memory, nullptr);
+	vulkanDevice->freeMemory(indexStaging.memory);
 }
 
 void VulkanExample::loadAssets()
@@ -513,14 +509,14 @@ void VulkanExample::setupDescriptors()
 
 	// Descriptor set for scene matrices
 	VkDescriptorSetAllocateInfo allocInfo = vks::initializers::descriptorSetAllocateInfo(descriptorPool, &descriptorSetLayouts.matrices, 1);
-	VK_CHECK_RESULT(vkAllocateDescriptorSets(device, &allocInfo, &descriptorSet));
+	VK_CHECK_RESULT(vks::ObjectCounters::allocateDescriptorSets(device, &allocInfo, &descriptorSet));
 	VkWriteDescriptorSet writeDescriptorSet = vks::initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 0, &shaderData.buffer.descriptor);
 	vkUpdateDescriptorSets(device, 1, &writeDescriptorSet, 0, nullptr);
 
 	// Descriptor sets for materials
 	for (auto& material : glTFScene.materials) {
 		const VkDescriptorSetAllocateInfo allocInfo = vks::initializers::descriptorSetAllocateInfo(descriptorPool, &descriptorSetLayouts.textures, 1);
-		VK_CHECK_RESULT(vkAllocateDescriptorSets(device, &allocInfo, &material.descriptorSet));
+		VK_CHECK_RESULT(vks::ObjectCounters::allocateDescriptorSets(device, &allocInfo, &material.descriptorSet));
 		VkDescriptorImageInfo colorMap = glTFScene.getTextureDescriptor(material.baseColorTextureIndex);
 		VkDescriptorImageInfo normalMap = glTFScene.getTextureDescriptor(material.normalTextureIndex);
 		std::vector<VkWriteDescriptorSet> writeDescriptorSets = {
@@ -572,6 +568,8 @@ void VulkanExample::preparePipelines()
 	shaderStages[1] = loadShader(getShadersPath() + "gltfscenerendering/scene.frag.spv", VK_SHADER_STAGE_FRAGMENT_BIT);
 
 	// POI: Instead if using a few fixed pipelines, we create one pipeline for each material using the properties of that material
+	// The create infos are copied into a batch (along with the per-material specialization data) and the pipelines are created in parallel on the job system
+	vks::PipelineBatch pipelineBatch(device, pipelineCache, &jobSystem);
 	for (auto &material : glTFScene.materials) {
 
 		struct MaterialSpecializationData {
@@ -593,8 +591,9 @@ void VulkanExample::preparePipelines()
 		// For double sided materials, culling will be disabled
 		rasterizationStateCI.cullMode = material.doubleSided ? VK_CULL_MODE_NONE : VK_CULL_MODE_BACK_BIT;
 
-		VK_CHECK_RESULT(vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &material.pipeline));
+		pipelineBatch.add(pipelineCI, &material.pipeline);
 	}
+	pipelineBatch.build();
 }
 
 void VulkanExample::prepareUniformBuffers()
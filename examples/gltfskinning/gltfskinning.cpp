@@ -41,15 +41,12 @@ glm::mat4 VulkanglTFModel::Node::getLocalMatrix()
 VulkanglTFModel::~VulkanglTFModel()
 {
 	vkDestroyBuffer(vulkanDevice->logicalDevice, vertices.buffer, nullptr);
-	vkFreeMemory(vulkanDevice->logicalDevice, vertices.memory, nullptr);
+	vulkanDevice->freeMemory(vertices.memory);
 	vkDestroyBuffer(vulkanDevice->logicalDevice, indices.buffer, nullptr);
-	vkFreeMemory(vulkanDevice->logicalDevice, indices.memory, nullptr);
+	vulkanDevice->freeMemory(indices.memory);
 	for (Image image : images)
 	{
-		vkDestroyImageView(vulkanDevice->logicalDevice, image.texture.view, nullptr);
-		vkDestroyImage(vulkanDevice->logicalDevice, image.texture.image, nullptr);
-		vkDestroySampler(vulkanDevice->logicalDevice, image.texture.sampler, nullptr);
-		vkFreeMemory(vulkanDevice->logicalDevice, image.texture.deviceMemory, nullptr);
+		image.texture.destroy();
 	}
 	for (Skin skin : skins)
 	{
@@ -95,8 +92,8 @@ void VulkanglTFModel::loadImages(tinygltf::Model &input)
 			buffer     = &glTFImage.image[0];
 			bufferSize = glTFImage.image.size();
 		}
-		// Load texture from image buffer
-		images[i].texture.fromBuffer(buffer, bufferSize, VK_FORMAT_R8G8B8A8_UNORM, glTFImage.width, glTFImage.height, vulkanDevice, copyQueue);
+		// Load texture from image buffer, compressed to BC7 on the CPU if the device supports it
+		images[i].texture.fromBuffer(buffer, bufferSize, VK_FORMAT_R8G8B8A8_UNORM, glTFImage.width, glTFImage.height, vulkanDevice, copyQueue, VK_FILTER_LINEAR, VK_IMAGE_USAGE_SAMPLED_BIT, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, true);
 		if (deleteBuffer)
 		{
 			delete[] buffer;
@@ -654,10 +651,10 @@ VulkanExample::VulkanExample() :
 
 VulkanExample::~VulkanExample()
 {
-	vkDestroyPipeline(device, pipelines.solid, nullptr);
+	vks::ObjectCounters::destroyPipeline(device, pipelines.solid, nullptr);
 	if (pipelines.wireframe != VK_NULL_HANDLE)
 	{
-		vkDestroyPipeline(device, pipelines.wireframe, nullptr);
+		vks::ObjectCounters::destroyPipeline(device, pipelines.wireframe, nullptr);
 	}
 
 	vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
@@ -709,7 +706,6 @@ void VulkanExample::buildCommandBuffers()
 		vkCmdBindDescriptorSets(drawCmdBuffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
 		vkCmdBindPipeline(drawCmdBuffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, wireframe ? pipelines.wireframe : pipelines.solid);
 		glTFModel.draw(drawCmdBuffers[i], pipelineLayout);
-		drawUI(drawCmdBuffers[i]);
 		vkCmdEndRenderPass(drawCmdBuffers[i]);
 		VK_CHECK_RESULT(vkEndCommandBuffer(drawCmdBuffers[i]));
 	}
@@ -815,9 +811,9 @@ void VulkanExample::loadglTFFile(std::string filename)
 
 	// Free staging resources
 	vkDestroyBuffer(device, vertexStaging.buffer, nullptr);
-	vkFreeMemory(device, vertexStaging.memory, nullptr);
+	vulkanDevice->freeMemory(vertexStaging.memory);
 	vkDestroyBuffer(device, indexStaging.buffer, nullptr);
-	vkFreeMemory(device, indexStaging.memory, nullptr);
+	vulkanDevice->freeMemory(indexStaging.memory);
 }
 
 void VulkanExample::setupDescriptors()
@@ -873,7 +869,7 @@ void VulkanExample::setupDescriptors()
 
 	// Descriptor set for scene matrices
 	VkDescriptorSetAllocateInfo allocInfo = vks::initializers::descriptorSetAllocateInfo(descriptorPool, &descriptorSetLayouts.matrices, 1);
-	VK_CHECK_RESULT(vkAllocateDescriptorSets(device, &allocInfo, &descriptorSet));
+	VK_CHECK_RESULT(vks::ObjectCounters::allocateDescriptorSets(device, &allocInfo, &descriptorSet));
 	VkWriteDescriptorSet writeDescriptorSet = vks::initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 0, &shaderData.buffer.descriptor);
 	vkUpdateDescriptorSets(device, 1, &writeDescriptorSet, 0, nullptr);
 
@@ -881,7 +877,7 @@ void VulkanExample::setupDescriptors()
 	for (auto &skin : glTFModel.skins)
 	{
 		const VkDescriptorSetAllocateInfo allocInfo = vks::initializers::descriptorSetAllocateInfo(descriptorPool, &descriptorSetLayouts.jointMatrices, 1);
-		VK_CHECK_RESULT(vkAllocateDescriptorSets(device, &allocInfo, &skin.descriptorSet));
+		VK_CHECK_RESULT(vks::ObjectCounters::allocateDescriptorSets(device, &allocInfo, &skin.descriptorSet));
 		VkWriteDescriptorSet writeDescriptorSet = vks::initializers::writeDescriptorSet(skin.descriptorSet, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 0, &skin.ssbo.descriptor);
 		vkUpdateDescriptorSets(device, 1, &writeDescriptorSet, 0, nullptr);
 	}
@@ -890,7 +886,7 @@ void VulkanExample::setupDescriptors()
 	for (auto &image : glTFModel.images)
 	{
 		const VkDescriptorSetAllocateInfo allocInfo = vks::initializers::descriptorSetAllocateInfo(descriptorPool, &descriptorSetLayouts.textures, 1);
-		VK_CHECK_RESULT(vkAllocateDescriptorSets(device, &allocInfo, &image.descriptorSet));
+		VK_CHECK_RESULT(vks::ObjectCounters::allocateDescriptorSets(device, &allocInfo, &image.descriptorSet));
 		VkWriteDescriptorSet writeDescriptorSet = vks::initializers::writeDescriptorSet(image.descriptorSet, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 0, &image.texture.descriptor);
 		vkUpdateDescriptorSets(device, 1, &writeDescriptorSet, 0, nullptr);
 	}
@@ -944,14 +940,14 @@ void VulkanExample::preparePipelines()
 	pipelineCI.pStages                      = shaderStages.data();
 
 	// Solid rendering pipeline
-	VK_CHECK_RESULT(vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &pipelines.solid));
+	VK_CHECK_RESULT(vks::ObjectCounters::createGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &pipelines.solid));
 
 	// Wire frame rendering pipeline
 	if (deviceFeatures.fillModeNonSolid)
 	{
 		rasterizationStateCI.polygonMode = VK_POLYGON_MODE_LINE;
 		rasterizationStateCI.lineWidth   = 1.0f;
-		VK_CHECK_RESULT(vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &pipelines.wireframe));
+		VK_CHECK_RESULT(vks::ObjectCounters::createGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &pipelines.wireframe));
 	}
 }
 
@@ -8,7 +8,6 @@
 
 #include "vulkanexamplebase.h"
 
-#include "threadpool.hpp"
 #include "frustum.hpp"
 
 #include "VulkanglTFModel.h"
@@ -25,7 +24,7 @@ public:
 		vkglTF::Model starSphere;
 	} models;
 
-	// Shared matrices used for thread push constant blocks
+	// Shared matrices used to calculate the per object transformations
 	struct {
 		glm::mat4 projection;
 		glm::mat4 view;
@@ -37,29 +36,33 @@ public:
 	} pipelines;
 
 	VkPipelineLayout pipelineLayout;
+	VkDescriptorPool descriptorPool;
+	VkDescriptorSetLayout descriptorSetLayout;
+	VkDescriptorSet descriptorSet;
 
 	VkCommandBuffer primaryCommandBuffer;
 
-	// Secondary scene command buffers used to store backdrop and user interface
+	// Secondary scene command buffers used to store the backdrop (the user interface is drawn by the base class)
 	struct SecondaryCommandBuffers {
 		VkCommandBuffer background;
-		VkCommandBuffer ui;
 	} secondaryCommandBuffers;
 
-	// Number of animated objects to be renderer
+	// Number of animated objects to be rendered
 	// by using threads and secondary command buffers
-	uint32_t numObjectsPerThread;
-
-	// Multi threaded stuff
-	// Max. number of concurrent threads
-	uint32_t numThreads;
-
-	// Use push constants to update shader
-	// parameters on a per-thread base
-	struct ThreadPushConstantBlock {
+	static const uint32_t objectCount = 512;
+	// Objects are handed to the threads of the job system in chunks (idle threads steal the chunks of busy ones)
+	// Each chunk records the draws of its visible objects into a secondary command buffer
+	static const uint32_t objectsPerChunk = 32;
+	static const uint32_t chunkCount = objectCount / objectsPerChunk;
+	static_assert(objectsPerChunk <= 32, "The visibility of a chunk's objects is stored as a 32 bit mask");
+
+	// Per object shader parameters, stored in a buffer that's indexed by the instance index
+	// As the draws don't contain any per object data, the command buffers only need to be recorded again when the visibility of an object changes
+	struct ObjectInstance {
 		glm::mat4 mvp;
-		glm::vec3 color;
+		glm::vec4 color;
 	};
+	vks::Buffer instanceBuffer;
 
 	struct ObjectData {
 		glm::mat4 model;
@@ -73,18 +76,22 @@ public:
 		bool visible = true;
 	};
 
-	struct ThreadData {
+	// Per object information (position, rotation, etc.)
+	std::vector<ObjectData> objectData;
+
+	struct ChunkData {
+		// A chunk may be recorded on a different thread every frame, so each chunk has its own command pool
 		VkCommandPool commandPool;
-		// One command buffer per render object
-		std::vector<VkCommandBuffer> commandBuffer;
-		// One push constant block per render object
-		std::vector<ThreadPushConstantBlock> pushConstBlock;
-		// Per object information (position, rotation, etc.)
-		std::vector<ObjectData> objectData;
+		VkCommandBuffer commandBuffer;
+		// Visible objects of the chunk (one bit per object) the command buffer has been recorded for
+		uint32_t recordedVisibility = 0;
+		bool recorded = false;
 	};
-	std::vector<ThreadData> threadData;
-
-	vks::ThreadPool threadPool;
+	std::vector<ChunkData> chunks;
+	// Set when all command buffers need to be recorded again (e.g. after a resize)
+	bool invalidateChunks = false;
+	// Number of chunks recorded in the last frame
+	std::atomic<uint32_t> recordedChunks;
 
 	// Fence to wait for all command buffers to finish before
 	// presenting to the swap chain
@@ -104,16 +111,13 @@ public:
 		camera.setRotationSpeed(0.5f);
 		camera.setPerspective(60.0f, (float)width / (float)height, 0.1f, 256.0f);
 		settings.overlay = true;
-		// Get number of max. concurrent threads
-		numThreads = std::thread::hardware_concurrency();
-		assert(numThreads > 0);
+		// The number of threads can be set with --jobthreads
 #if defined(__ANDROID__)
-		LOGD("numThreads = %d", numThreads);
+		LOGD("numThreads = %d", jobSystem.getThreadCount());
 #else
-		std::cout << "numThreads = " << numThreads << std::endl;
+		std::cout << "numThreads = " << jobSystem.getThreadCount() << std::endl;
 #endif
-		threadPool.setThreadCount(numThreads);
-		numObjectsPerThread = 512 / numThreads;
+		recordedChunks = 0;
 		rndEngine.seed(benchmark.active ? 0 : (unsigned)time(nullptr));
 	}
 
@@ -121,16 +125,20 @@ public:
 	{
 		// Clean up used Vulkan resources
 		// Note : Inherited destructor cleans up resources stored in base class
-		vkDestroyPipeline(device, pipelines.phong, nullptr);
-		vkDestroyPipeline(device, pipelines.starsphere, nullptr);
+		vks::ObjectCounters::destroyPipeline(device, pipelines.phong, nullptr);
+		vks::ObjectCounters::destroyPipeline(device, pipelines.starsphere, nullptr);
 
 		vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+		vkDestroyDescriptorSetLayout(device, descriptorSetLayout, nullptr);
+		vkDestroyDescriptorPool(device, descriptorPool, nullptr);
 
-		for (auto& thread : threadData) {
-			vkFreeCommandBuffers(device, thread.commandPool, thread.commandBuffer.size(), thread.commandBuffer.data());
-			vkDestroyCommandPool(device, thread.commandPool, nullptr);
+		for (auto& chunk : chunks) {
+			vkFreeCommandBuffers(device, chunk.commandPool, 1, &chunk.commandBuffer);
+			vkDestroyCommandPool(device, chunk.commandPool, nullptr);
 		}
 
+		instanceBuffer.destroy();
+
 		vkDestroyFence(device, renderFence, nullptr);
 	}
 
@@ -140,7 +148,7 @@ public:
 		return rndDist(rndEngine);
 	}
 
-	// Create all threads and initialize shader push constants
+	// Create the per chunk command buffers and initialize the objects
 	void prepareMultiThreadedRenderer()
 	{
 		// Since this demo updates the command buffers on each frame
@@ -153,67 +161,87 @@ public:
 				1);
 		VK_CHECK_RESULT(vkAllocateCommandBuffers(device, &cmdBufAllocateInfo, &primaryCommandBuffer));
 
-		// Create additional secondary CBs for background and ui
+		// Create an additional secondary CB for the background
 		cmdBufAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
 		VK_CHECK_RESULT(vkAllocateCommandBuffers(device, &cmdBufAllocateInfo, &secondaryCommandBuffers.background));
-		VK_CHECK_RESULT(vkAllocateCommandBuffers(device, &cmdBufAllocateInfo, &secondaryCommandBuffers.ui));
-
-		threadData.resize(numThreads);
-
-		float maxX = std::floor(std::sqrt(numThreads * numObjectsPerThread));
-		uint32_t posX = 0;
-		uint32_t posZ = 0;
-
-		for (uint32_t i = 0; i < numThreads; i++) {
-			ThreadData *thread = &threadData[i];
 
-			// Create one command pool for each thread
+		chunks.resize(chunkCount);
+		for (auto& chunk : chunks) {
 			VkCommandPoolCreateInfo cmdPoolInfo = vks::initializers::commandPoolCreateInfo();
 			cmdPoolInfo.queueFamilyIndex = swapChain.queueNodeIndex;
 			cmdPoolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-			VK_CHECK_RESULT(vkCreateCommandPool(device, &cmdPoolInfo, nullptr, &thread->commandPool));
-
-			// One secondary command buffer per object that is updated by this thread
-			thread->commandBuffer.resize(numObjectsPerThread);
-			// Generate secondary command buffers for each thread
+			VK_CHECK_RESULT(vkCreateCommandPool(device, &cmdPoolInfo, nullptr, &chunk.commandPool));
 			VkCommandBufferAllocateInfo secondaryCmdBufAllocateInfo =
 				vks::initializers::commandBufferAllocateInfo(
-					thread->commandPool,
+					chunk.commandPool,
 					VK_COMMAND_BUFFER_LEVEL_SECONDARY,
-					thread->commandBuffer.size());
-			VK_CHECK_RESULT(vkAllocateCommandBuffers(device, &secondaryCmdBufAllocateInfo, thread->commandBuffer.data()));
-
-			thread->pushConstBlock.resize(numObjectsPerThread);
-			thread->objectData.resize(numObjectsPerThread);
+					1);
+			VK_CHECK_RESULT(vkAllocateCommandBuffers(device, &secondaryCmdBufAllocateInfo, &chunk.commandBuffer));
+		}
 
-			for (uint32_t j = 0; j < numObjectsPerThread; j++) {
-				float theta = 2.0f * float(M_PI) * rnd(1.0f);
-				float phi = acos(1.0f - 2.0f * rnd(1.0f));
-				thread->objectData[j].pos = glm::vec3(sin(phi) * cos(theta), 0.0f, cos(phi)) * 35.0f;
+		ObjectInstance* instances = static_cast<ObjectInstance*>(instanceBuffer.mapped);
+		objectData.resize(objectCount);
+		for (uint32_t i = 0; i < objectCount; i++) {
+			float theta = 2.0f * float(M_PI) * rnd(1.0f);
+			float phi = acos(1.0f - 2.0f * rnd(1.0f));
+			objectData[i].pos = glm::vec3(sin(phi) * cos(theta), 0.0f, cos(phi)) * 35.0f;
 
-				thread->objectData[j].rotation = glm::vec3(0.0f, rnd(360.0f), 0.0f);
-				thread->objectData[j].deltaT = rnd(1.0f);
-				thread->objectData[j].rotationDir = (rnd(100.0f) < 50.0f) ? 1.0f : -1.0f;
-				thread->objectData[j].rotationSpeed = (2.0f + rnd(4.0f)) * thread->objectData[j].rotationDir;
-				thread->objectData[j].scale = 0.75f + rnd(0.5f);
+			objectData[i].rotation = glm::vec3(0.0f, rnd(360.0f), 0.0f);
+			objectData[i].deltaT = rnd(1.0f);
+			objectData[i].rotationDir = (rnd(100.0f) < 50.0f) ? 1.0f : -1.0f;
+			objectData[i].rotationSpeed = (2.0f + rnd(4.0f)) * objectData[i].rotationDir;
+			objectData[i].scale = 0.75f + rnd(0.5f);
 
-				thread->pushConstBlock[j].color = glm::vec3(rnd(1.0f), rnd(1.0f), rnd(1.0f));
-			}
+			instances[i].color = glm::vec4(rnd(1.0f), rnd(1.0f), rnd(1.0f), 1.0f);
 		}
-
 	}
 
-	// Builds the secondary command buffer for each thread
-	void threadRenderCode(uint32_t threadIndex, uint32_t cmdBufferIndex, VkCommandBufferInheritanceInfo inheritanceInfo)
+	// Updates the objects of a chunk and records the chunk's secondary command buffer if the visible objects have changed
+	void updateChunk(uint32_t chunkIndex, const VkCommandBufferInheritanceInfo &inheritanceInfo)
 	{
-		ThreadData *thread = &threadData[threadIndex];
-		ObjectData *objectData = &thread->objectData[cmdBufferIndex];
+		ChunkData *chunk = &chunks[chunkIndex];
+		ObjectInstance* instances = static_cast<ObjectInstance*>(instanceBuffer.mapped);
+		const uint32_t firstObject = chunkIndex * objectsPerChunk;
+
+		uint32_t visibility = 0;
+		for (uint32_t i = 0; i < objectsPerChunk; i++) {
+			ObjectData *object = &objectData[firstObject + i];
+
+			// Update
+			if (!paused) {
+				object->rotation.y += 2.5f * object->rotationSpeed * frameTimer;
+				if (object->rotation.y > 360.0f) {
+					object->rotation.y -= 360.0f;
+				}
+				object->deltaT += 0.15f * frameTimer;
+				if (object->deltaT > 1.0f)
+					object->deltaT -= 1.0f;
+				object->pos.y = sin(glm::radians(object->deltaT * 360.0f)) * 2.5f;
+			}
 
-		// Check visibility against view frustum using a simple sphere check based on the radius of the mesh
-		objectData->visible = frustum.checkSphere(objectData->pos, models.ufo.dimensions.radius * 0.5f);
+			// Check visibility against view frustum using a simple sphere check based on the radius of the mesh
+			object->visible = frustum.checkSphere(object->pos, models.ufo.dimensions.radius * 0.5f);
+			if (!object->visible) {
+				continue;
+			}
+			visibility |= 1u << i;
 
-		if (!objectData->visible)
-		{
+			object->model = glm::translate(glm::mat4(1.0f), object->pos);
+			object->model = glm::rotate(object->model, -sinf(glm::radians(object->deltaT * 360.0f)) * 0.25f, glm::vec3(object->rotationDir, 0.0f, 0.0f));
+			object->model = glm::rotate(object->model, glm::radians(object->rotation.y), glm::vec3(0.0f, object->rotationDir, 0.0f));
+			object->model = glm::rotate(object->model, glm::radians(object->deltaT * 360.0f), glm::vec3(0.0f, object->rotationDir, 0.0f));
+			object->model = glm::scale(object->model, glm::vec3(object->scale));
+
+			instances[firstObject + i].mvp = matrices.projection * matrices.view * object->model;
+		}
+
+		// The command buffer from the last frame can be reused as long as the same objects are visible
+		if (chunk->recorded && (chunk->recordedVisibility == visibility)) {
+			return;
+		}
+		chunk->recorded = true;
+		chunk->recordedVisibility = visibility;
+		if (visibility == 0) {
 			return;
 		}
 
@@ -221,7 +249,7 @@ public:
 		commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
 		commandBufferBeginInfo.pInheritanceInfo = &inheritanceInfo;
 
-		VkCommandBuffer cmdBuffer = thread->commandBuffer[cmdBufferIndex];
+		VkCommandBuffer cmdBuffer = chunk->commandBuffer;
 
 		VK_CHECK_RESULT(vkBeginCommandBuffer(cmdBuffer, &commandBufferBeginInfo));
 
@@ -232,43 +260,29 @@ public:
 		vkCmdSetScissor(cmdBuffer, 0, 1, &scissor);
 
 		vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelines.phong);
-
-		// Update
-		if (!paused) {
-			objectData->rotation.y += 2.5f * objectData->rotationSpeed * frameTimer;
-			if (objectData->rotation.y > 360.0f) {
-				objectData->rotation.y -= 360.0f;
-			}
-			objectData->deltaT += 0.15f * frameTimer;
-			if (objectData->deltaT > 1.0f)
-				objectData->deltaT -= 1.0f;
-			objectData->pos.y = sin(glm::radians(objectData->deltaT * 360.0f)) * 2.5f;
-		}
-
-		objectData->model = glm::translate(glm::mat4(1.0f), objectData->pos);
-		objectData->model = glm::rotate(objectData->model, -sinf(glm::radians(objectData->deltaT * 360.0f)) * 0.25f, glm::vec3(objectData->rotationDir, 0.0f, 0.0f));
-		objectData->model = glm::rotate(objectData->model, glm::radians(objectData->rotation.y), glm::vec3(0.0f, objectData->rotationDir, 0.0f));
-		objectData->model = glm::rotate(objectData->model, glm::radians(objectData->deltaT * 360.0f), glm::vec3(0.0f, objectData->rotationDir, 0.0f));
-		objectData->model = glm::scale(objectData->model, glm::vec3(objectData->scale));
-
-		thread->pushConstBlock[cmdBufferIndex].mvp = matrices.projection * matrices.view * objectData->model;
-
-		// Update shader push constant block
-		// Contains model view matrix
-		vkCmdPushConstants(
-			cmdBuffer,
-			pipelineLayout,
-			VK_SHADER_STAGE_VERTEX_BIT,
-			0,
-			sizeof(ThreadPushConstantBlock),
-			&thread->pushConstBlock[cmdBufferIndex]);
+		vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
 
 		VkDeviceSize offsets[1] = { 0 };
 		vkCmdBindVertexBuffers(cmdBuffer, 0, 1, &models.ufo.vertices.buffer, offsets);
 		vkCmdBindIndexBuffer(cmdBuffer, models.ufo.indices.buffer, 0, VK_INDEX_TYPE_UINT32);
-		vkCmdDrawIndexed(cmdBuffer, models.ufo.indices.count, 1, 0, 0, 0);
+
+		// Consecutive visible objects are drawn with a single instanced draw, the first instance selects the object's parameters
+		uint32_t i = 0;
+		while (i < objectsPerChunk) {
+			if ((visibility & (1u << i)) == 0) {
+				i++;
+				continue;
+			}
+			uint32_t end = i + 1;
+			while ((end < objectsPerChunk) && (visibility & (1u << end))) {
+				end++;
+			}
+			vkCmdDrawIndexed(cmdBuffer, models.ufo.indices.count, end - i, 0, 0, firstObject + i);
+			i = end;
+		}
 
 		VK_CHECK_RESULT(vkEndCommandBuffer(cmdBuffer));
+		recordedChunks++;
 	}
 
 	void updateSecondaryCommandBuffers(VkCommandBufferInheritanceInfo inheritanceInfo)
@@ -307,31 +321,11 @@ public:
 		models.starSphere.draw(secondaryCommandBuffers.background);
 		
 		VK_CHECK_RESULT(vkEndCommandBuffer(secondaryCommandBuffers.background));
-
-		/*
-			User interface
-
-			With VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS, the primary command buffer's content has to be defined
-			by secondary command buffers, which also applies to the UI overlay command buffer
-		*/
-
-		VK_CHECK_RESULT(vkBeginCommandBuffer(secondaryCommandBuffers.ui, &commandBufferBeginInfo));
-
-		vkCmdSetViewport(secondaryCommandBuffers.ui, 0, 1, &viewport);
-		vkCmdSetScissor(secondaryCommandBuffers.ui, 0, 1, &scissor);
-
-		vkCmdBindPipeline(secondaryCommandBuffers.ui, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelines.starsphere);
-
-		if (settings.overlay) {
-			drawUI(secondaryCommandBuffers.ui);
-		}
-
-		VK_CHECK_RESULT(vkEndCommandBuffer(secondaryCommandBuffers.ui));
 	}
 
-	// Updates the secondary command buffers using a thread pool
+	// Updates the objects and (if required) the secondary command buffers using the job system
 	// and puts them into the primary command buffer that's
-	// lat submitted to the queue for rendering
+	// later submitted to the queue for rendering
 	void updateCommandBuffers(VkFramebuffer frameBuffer)
 	{
 		// Contains the list of secondary command buffers to be submitted
@@ -364,8 +358,7 @@ public:
 		// Inheritance info for the secondary command buffers
 		VkCommandBufferInheritanceInfo inheritanceInfo = vks::initializers::commandBufferInheritanceInfo();
 		inheritanceInfo.renderPass = renderPass;
-		// Secondary command buffer also use the currently active framebuffer
-		inheritanceInfo.framebuffer = frameBuffer;
+		// The framebuffer is left undefined, so the object command buffers can be reused with all framebuffers
 
 		// Update secondary sene command buffers
 		updateSecondaryCommandBuffers(inheritanceInfo);
@@ -374,32 +367,33 @@ public:
 			commandBuffers.push_back(secondaryCommandBuffers.background);
 		}
 
-		// Add a job to the thread's queue for each object to be rendered
-		for (uint32_t t = 0; t < numThreads; t++)
-		{
-			for (uint32_t i = 0; i < numObjectsPerThread; i++)
-			{
-				threadPool.threads[t]->addJob([=] { threadRenderCode(t, i, inheritanceInfo); });
+		if (invalidateChunks) {
+			for (auto& chunk : chunks) {
+				chunk.recorded = false;
 			}
+			invalidateChunks = false;
 		}
 
-		threadPool.wait();
-
-		// Only submit if object is within the current view frustum
-		for (uint32_t t = 0; t < numThreads; t++)
+		// Chunks are distributed dynamically, so threads that get chunks with few visible objects pick up more of them
+		recordedChunks = 0;
+		jobSystem.parallelFor(chunkCount, 1, [&](uint32_t begin, uint32_t end)
 		{
-			for (uint32_t i = 0; i < numObjectsPerThread; i++)
+			for (uint32_t c = begin; c < end; c++)
 			{
-				if (threadData[t].objectData[i].visible)
-				{
-					commandBuffers.push_back(threadData[t].commandBuffer[i]);
-				}
+				updateChunk(c, inheritanceInfo);
 			}
+		});
+		if ((instanceBuffer.memoryPropertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) == 0) {
+			instanceBuffer.flush();
 		}
 
-		// Render ui last
-		if (UIOverlay.visible) {
-			commandBuffers.push_back(secondaryCommandBuffers.ui);
+		// Only submit chunks with objects within the current view frustum
+		for (auto& chunk : chunks)
+		{
+			if (chunk.recordedVisibility != 0)
+			{
+				commandBuffers.push_back(chunk.commandBuffer);
+			}
 		}
 
 		// Execute render commands from the secondary command buffer
@@ -417,16 +411,43 @@ public:
 		models.starSphere.loadFromFile(getAssetPath() + "models/sphere.gltf", vulkanDevice, queue, glTFLoadingFlags);
 	}
 
+	void prepareInstanceBuffer()
+	{
+		VK_CHECK_RESULT(vulkanDevice->createBuffer(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, vks::MemoryUsage::Dynamic, &instanceBuffer, objectCount * sizeof(ObjectInstance)));
+		VK_CHECK_RESULT(instanceBuffer.map());
+	}
+
+	void setupDescriptors()
+	{
+		std::vector<VkDescriptorPoolSize> poolSizes = {
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1)
+		};
+		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, 1);
+		VK_CHECK_RESULT(vkCreateDescriptorPool(device, &descriptorPoolInfo, nullptr, &descriptorPool));
+
+		// Binding 0 : Per object parameters (vertex shader)
+		std::vector<VkDescriptorSetLayoutBinding> setLayoutBindings = {
+			vks::initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT, 0)
+		};
+		VkDescriptorSetLayoutCreateInfo descriptorLayout = vks::initializers::descriptorSetLayoutCreateInfo(setLayoutBindings);
+		VK_CHECK_RESULT(vkCreateDescriptorSetLayout(device, &descriptorLayout, nullptr, &descriptorSetLayout));
+
+		VkDescriptorSetAllocateInfo allocInfo = vks::initializers::descriptorSetAllocateInfo(descriptorPool, &descriptorSetLayout, 1);
+		VK_CHECK_RESULT(vks::ObjectCounters::allocateDescriptorSets(device, &allocInfo, &descriptorSet));
+		VkWriteDescriptorSet writeDescriptorSet = vks::initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 0, &instanceBuffer.descriptor);
+		vkUpdateDescriptorSets(device, 1, &writeDescriptorSet, 0, nullptr);
+	}
+
 	void setupPipelineLayout()
 	{
 		VkPipelineLayoutCreateInfo pPipelineLayoutCreateInfo =
-			vks::initializers::pipelineLayoutCreateInfo(nullptr, 0);
+			vks::initializers::pipelineLayoutCreateInfo(&descriptorSetLayout, 1);
 
-		// Push constants for model matrices
+		// Push constants for the star sphere's matrix
 		VkPushConstantRange pushConstantRange =
 			vks::initializers::pushConstantRange(
 				VK_SHADER_STAGE_VERTEX_BIT,
-				sizeof(ThreadPushConstantBlock),
+				sizeof(glm::mat4),
 				0);
 
 		// Push constant ranges are part of the pipeline layout
@@ -464,14 +485,14 @@ public:
 		// Object rendering pipeline
 		shaderStages[0] = loadShader(getShadersPath() + "multithreading/phong.vert.spv", VK_SHADER_STAGE_VERTEX_BIT);
 		shaderStages[1] = loadShader(getShadersPath() + "multithreading/phong.frag.spv", VK_SHADER_STAGE_FRAGMENT_BIT);
-		VK_CHECK_RESULT(vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &pipelines.phong));
+		VK_CHECK_RESULT(vks::ObjectCounters::createGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &pipelines.phong));
 
 		// Star sphere rendering pipeline
 		rasterizationState.cullMode = VK_CULL_MODE_FRONT_BIT;
 		depthStencilState.depthWriteEnable = VK_FALSE;
 		shaderStages[0] = loadShader(getShadersPath() + "multithreading/starsphere.vert.spv", VK_SHADER_STAGE_VERTEX_BIT);
 		shaderStages[1] = loadShader(getShadersPath() + "multithreading/starsphere.frag.spv", VK_SHADER_STAGE_FRAGMENT_BIT);
-		VK_CHECK_RESULT(vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &pipelines.starsphere));
+		VK_CHECK_RESULT(vks::ObjectCounters::createGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &pipelines.starsphere));
 	}
 
 	void updateMatrices()
@@ -510,6 +531,8 @@ public:
 		VkFenceCreateInfo fenceCreateInfo = vks::initializers::fenceCreateInfo(VK_FENCE_CREATE_SIGNALED_BIT);
 		vkCreateFence(device, &fenceCreateInfo, nullptr, &renderFence);
 		loadAssets();
+		prepareInstanceBuffer();
+		setupDescriptors();
 		setupPipelineLayout();
 		preparePipelines();
 		prepareMultiThreadedRenderer();
@@ -528,10 +551,17 @@ public:
 		}
 	}
 
+	virtual void windowResized()
+	{
+		// The viewport and scissor recorded into the object command buffers depend on the window size
+		invalidateChunks = true;
+	}
+
 	virtual void OnUpdateUIOverlay(vks::UIOverlay *overlay)
 	{
 		if (overlay->header("Statistics")) {
-			overlay->text("Active threads: %d", numThreads);
+			overlay->text("Active threads: %d", jobSystem.getThreadCount());
+			overlay->text("Recorded chunks: %d / %d", recordedChunks.load(), chunkCount);
 		}
 		if (overlay->header("Settings")) {
 			overlay->checkBox("Stars", &displayStarSphere);
@@ -69,7 +69,7 @@ public:
 		vkDestroyBuffer(device, uniBuf.buffer, nullptr);
 		
 		vkDestroyRenderPass(device, graphics.renderPass, nullptr);
-		vkDestroyPipeline(device, graphics.pipe, nullptr);
+		vks::ObjectCounters::destroyPipeline(device, graphics.pipe, nullptr);
 		vkDestroyPipelineLayout(device, graphics.pipeLayout, nullptr);
 	}
 
@@ -217,7 +217,7 @@ public:
 			&graphics.descSetLayout,
 			1);
 		
-		VK_CHECK_RESULT(vkAllocateDescriptorSets(device, &descSetAllocInfo, &graphics.descSet));
+		VK_CHECK_RESULT(vks::ObjectCounters::allocateDescriptorSets(device, &descSetAllocInfo, &graphics.descSet));
 
 		VkWriteDescriptorSet writeSet = vks::initializers::writeDescriptorSet(
 			graphics.descSet,
@@ -345,7 +345,7 @@ public:
 
 		pipeInfo.subpass = 0;
 		
-		VK_CHECK_RESULT( vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipeInfo, nullptr, &graphics.pipe));
+		VK_CHECK_RESULT( vks::ObjectCounters::createGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipeInfo, nullptr, &graphics.pipe));
 		
 		//-----------------------------------
 		vkDestroyShaderModule(device, fragShaderModule, nullptr);
@@ -377,7 +377,6 @@ public:
 			vkCmdBindVertexBuffers(drawCmdBuffers[i], 0, 1, &storageBuffer.buffer, offsets);
 			vkCmdBindDescriptorSets(drawCmdBuffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, graphics.pipeLayout, 0, 1, &graphics.descSet, 0, nullptr);
 			vkCmdDraw(drawCmdBuffers[i], PARTICLE_COUNT, 1, 0, 0);
-			drawUI(drawCmdBuffers[i]);
 			vkCmdEndRenderPass(drawCmdBuffers[i]);
 
 			VK_CHECK_RESULT(vkEndCommandBuffer(drawCmdBuffers[i]));
@@ -91,17 +91,23 @@ public:
 
 	VkDebugReportCallbackEXT debugReportCallback{};
 
-	uint32_t getMemoryTypeIndex(uint32_t typeBits, VkMemoryPropertyFlags properties) {
+	uint32_t getMemoryTypeIndex(uint32_t typeBits, VkMemoryPropertyFlags properties, VkBool32 *memTypeFound = nullptr) {
 		VkPhysicalDeviceMemoryProperties deviceMemoryProperties;
 		vkGetPhysicalDeviceMemoryProperties(physicalDevice, &deviceMemoryProperties);
 		for (uint32_t i = 0; i < deviceMemoryProperties.memoryTypeCount; i++) {
 			if ((typeBits & 1) == 1) {
 				if ((deviceMemoryProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+					if (memTypeFound) {
+						*memTypeFound = VK_TRUE;
+					}
 					return i;
 				}
 			}
 			typeBits >>= 1;
 		}
+		if (memTypeFound) {
+			*memTypeFound = VK_FALSE;
+		}
 		return 0;
 	}
 
@@ -711,7 +717,12 @@ public:
 			vkGetImageMemoryRequirements(device, dstImage, &memRequirements);
 			memAllocInfo.allocationSize = memRequirements.size;
 			// Memory must be host visible to copy from
-			memAllocInfo.memoryTypeIndex = getMemoryTypeIndex(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+			// Host cached memory is preferred, as reading the whole image from uncached memory is very slow
+			VkBool32 dstImageCached = VK_FALSE;
+			memAllocInfo.memoryTypeIndex = getMemoryTypeIndex(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT, &dstImageCached);
+			if (!dstImageCached) {
+				memAllocInfo.memoryTypeIndex = getMemoryTypeIndex(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+			}
 			VK_CHECK_RESULT(vkAllocateMemory(device, &memAllocInfo, nullptr, &dstImageMemory));
 			VK_CHECK_RESULT(vkBindImageMemory(device, dstImage, dstImageMemory, 0));
 
@@ -777,6 +788,13 @@ public:
 
 			// Map image memory so we can start copying from it
 			vkMapMemory(device, dstImageMemory, 0, VK_WHOLE_SIZE, 0, (void**)&imagedata);
+			// Cached memory isn't necessarily coherent, make the device writes visible to the host
+			if (dstImageCached) {
+				VkMappedMemoryRange mappedRange = vks::initializers::mappedMemoryRange();
+				mappedRange.memory = dstImageMemory;
+				mappedRange.size = VK_WHOLE_SIZE;
+				VK_CHECK_RESULT(vkInvalidateMappedMemoryRanges(device, 1, &mappedRange));
+			}
 			imagedata += subResourceLayout.offset;
 
 		/*
@@ -19,6 +19,7 @@
 
 #include "vulkanexamplebase.h"
 #include "VulkanglTFModel.h"
+#include "VulkanRenderGraph.h"
 
 #define ENABLE_VALIDATION false
 
@@ -91,7 +92,6 @@ public:
 
 	// Resources of the depth map generation pass
 	struct DepthPass {
-		VkRenderPass renderPass;
 		VkPipelineLayout pipelineLayout;
 		VkPipeline pipeline;
 		vks::Buffer uniformBuffer;
@@ -102,33 +102,24 @@ public:
 
 	} depthPass;
 
-	// Layered depth image containing the shadow cascade depths
-	struct DepthImage {
-		VkImage image;
-		VkDeviceMemory mem;
-		VkImageView view;
-		VkSampler sampler;
-		void destroy(VkDevice device) {
-			vkDestroyImageView(device, view, nullptr);
-			vkDestroyImage(device, image, nullptr);
-			vkFreeMemory(device, mem, nullptr);
-			vkDestroySampler(device, sampler, nullptr);
-		}
-	} depth;
+	// The cascade passes and the layered depth image containing the shadow cascade depths are managed by a render graph
+	// Each cascade is rendered by a separate pass to it's layer of the image, the scene pass samples all layers
+	vks::RenderGraph *renderGraph = nullptr;
+	struct {
+		uint32_t depth;
+	} graphImages;
+	struct {
+		std::array<uint32_t, SHADOW_MAP_CASCADE_COUNT> cascades;
+	} graphPasses;
+
+	VkSampler depthSampler;
 
 	// Contains all resources required for a single shadow map cascade
 	struct Cascade {
-		VkFramebuffer frameBuffer;
 		VkDescriptorSet descriptorSet;
-		VkImageView view;
 
 		float splitDepth;
 		glm::mat4 viewProjMatrix;
-
-		void destroy(VkDevice device) {
-			vkDestroyImageView(device, view, nullptr);
-			vkDestroyFramebuffer(device, frameBuffer, nullptr);
-		}
 	};
 	std::array<Cascade, SHADOW_MAP_CASCADE_COUNT> cascades;
 
@@ -147,17 +138,14 @@ public:
 
 	~VulkanExample()
 	{
-		for (auto cascade : cascades) {
-			cascade.destroy(device);
-		}
-		depth.destroy(device);
+		vkDestroySampler(device, depthSampler, nullptr);
 
-		vkDestroyRenderPass(device, depthPass.renderPass, nullptr);
+		delete renderGraph;
 
-		vkDestroyPipeline(device, pipelines.debugShadowMap, nullptr);
-		vkDestroyPipeline(device, depthPass.pipeline, nullptr);
-		vkDestroyPipeline(device, pipelines.sceneShadow, nullptr);
-		vkDestroyPipeline(device, pipelines.sceneShadowPCF, nullptr);
+		vks::ObjectCounters::destroyPipeline(device, pipelines.debugShadowMap, nullptr);
+		vks::ObjectCounters::destroyPipeline(device, depthPass.pipeline, nullptr);
+		vks::ObjectCounters::destroyPipeline(device, pipelines.sceneShadow, nullptr);
+		vks::ObjectCounters::destroyPipeline(device, pipelines.sceneShadowPCF, nullptr);
 
 		vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
 		vkDestroyPipelineLayout(device, depthPass.pipelineLayout, nullptr);
@@ -209,127 +197,36 @@ public:
 	}
 
 	/*
-		Setup resources used by the depth pass
+		Setup the depth pass
 		The depth image is layered with each layer storing one shadow map cascade
 	*/
-	void prepareDepthPass()
+	void prepareRenderGraph()
 	{
+		renderGraph = new vks::RenderGraph(vulkanDevice);
+		renderGraph->setProfiler(&gpuProfiler);
+
 		VkFormat depthFormat = vulkanDevice->getSupportedDepthFormat(true);
+		graphImages.depth = renderGraph->addImage("shadow map", SHADOWMAP_DIM, SHADOWMAP_DIM, depthFormat, SHADOW_MAP_CASCADE_COUNT);
 
 		/*
-			Depth map renderpass
-		*/
+			Generate depth map cascades
 
-		VkAttachmentDescription attachmentDescription{};
-		attachmentDescription.format = depthFormat;
-		attachmentDescription.samples = VK_SAMPLE_COUNT_1_BIT;
-		attachmentDescription.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-		attachmentDescription.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-		attachmentDescription.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-		attachmentDescription.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-		attachmentDescription.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-		attachmentDescription.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
-
-		VkAttachmentReference depthReference = {};
-		depthReference.attachment = 0;
-		depthReference.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-
-		VkSubpassDescription subpass = {};
-		subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-		subpass.colorAttachmentCount = 0;
-		subpass.pDepthStencilAttachment = &depthReference;
-
-		// Use subpass dependencies for layout transitions
-		std::array<VkSubpassDependency, 2> dependencies;
-
-		dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
-		dependencies[0].dstSubpass = 0;
-		dependencies[0].srcStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-		dependencies[0].dstStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
-		dependencies[0].srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
-		dependencies[0].dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-		dependencies[0].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
-
-		dependencies[1].srcSubpass = 0;
-		dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
-		dependencies[1].srcStageMask = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-		dependencies[1].dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-		dependencies[1].srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-		dependencies[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-		dependencies[1].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
-
-		VkRenderPassCreateInfo renderPassCreateInfo = vks::initializers::renderPassCreateInfo();
-		renderPassCreateInfo.attachmentCount = 1;
-		renderPassCreateInfo.pAttachments = &attachmentDescription;
-		renderPassCreateInfo.subpassCount = 1;
-		renderPassCreateInfo.pSubpasses = &subpass;
-		renderPassCreateInfo.dependencyCount = static_cast<uint32_t>(dependencies.size());
-		renderPassCreateInfo.pDependencies = dependencies.data();
-
-		VK_CHECK_RESULT(vkCreateRenderPass(device, &renderPassCreateInfo, nullptr, &depthPass.renderPass));
-
-		/*
-			Layered depth image and views
+			Uses multiple passes with each pass rendering the scene to the cascade's depth image layer
+			Could be optimized using a geometry shader (and layered frame buffer) on devices that support geometry shaders
 		*/
-
-		VkImageCreateInfo imageInfo = vks::initializers::imageCreateInfo();
-		imageInfo.imageType = VK_IMAGE_TYPE_2D;
-		imageInfo.extent.width = SHADOWMAP_DIM;
-		imageInfo.extent.height = SHADOWMAP_DIM;
-		imageInfo.extent.depth = 1;
-		imageInfo.mipLevels = 1;
-		imageInfo.arrayLayers = SHADOW_MAP_CASCADE_COUNT;
-		imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
-		imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
-		imageInfo.format = depthFormat;
-		imageInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
-		VK_CHECK_RESULT(vkCreateImage(device, &imageInfo, nullptr, &depth.image));
-		VkMemoryAllocateInfo memAlloc = vks::initializers::memoryAllocateInfo();
-		VkMemoryRequirements memReqs;
-		vkGetImageMemoryRequirements(device, depth.image, &memReqs);
-		memAlloc.allocationSize = memReqs.size;
-		memAlloc.memoryTypeIndex = vulkanDevice->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-		VK_CHECK_RESULT(vkAllocateMemory(device, &memAlloc, nullptr, &depth.mem));
-		VK_CHECK_RESULT(vkBindImageMemory(device, depth.image, depth.mem, 0));
-		// Full depth map view (all layers)
-		VkImageViewCreateInfo viewInfo = vks::initializers::imageViewCreateInfo();
-		viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
-		viewInfo.format = depthFormat;
-		viewInfo.subresourceRange = {};
-		viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
-		viewInfo.subresourceRange.baseMipLevel = 0;
-		viewInfo.subresourceRange.levelCount = 1;
-		viewInfo.subresourceRange.baseArrayLayer = 0;
-		viewInfo.subresourceRange.layerCount = SHADOW_MAP_CASCADE_COUNT;
-		viewInfo.image = depth.image;
-		VK_CHECK_RESULT(vkCreateImageView(device, &viewInfo, nullptr, &depth.view));
-
-		// One image and framebuffer per cascade
 		for (uint32_t i = 0; i < SHADOW_MAP_CASCADE_COUNT; i++) {
-			// Image view for this cascade's layer (inside the depth map)
-			// This view is used to render to that specific depth image layer
-			VkImageViewCreateInfo viewInfo = vks::initializers::imageViewCreateInfo();
-			viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
-			viewInfo.format = depthFormat;
-			viewInfo.subresourceRange = {};
-			viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
-			viewInfo.subresourceRange.baseMipLevel = 0;
-			viewInfo.subresourceRange.levelCount = 1;
-			viewInfo.subresourceRange.baseArrayLayer = i;
-			viewInfo.subresourceRange.layerCount = 1;
-			viewInfo.image = depth.image;
-			VK_CHECK_RESULT(vkCreateImageView(device, &viewInfo, nullptr, &cascades[i].view));
-			// Framebuffer
-			VkFramebufferCreateInfo framebufferInfo = vks::initializers::framebufferCreateInfo();
-			framebufferInfo.renderPass = depthPass.renderPass;
-			framebufferInfo.attachmentCount = 1;
-			framebufferInfo.pAttachments = &cascades[i].view;
-			framebufferInfo.width = SHADOWMAP_DIM;
-			framebufferInfo.height = SHADOWMAP_DIM;
-			framebufferInfo.layers = 1;
-			VK_CHECK_RESULT(vkCreateFramebuffer(device, &framebufferInfo, nullptr, &cascades[i].frameBuffer));
+			graphPasses.cascades[i] = renderGraph->addPass("Cascade " + std::to_string(i), [this, i](VkCommandBuffer commandBuffer) {
+				vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, depthPass.pipeline);
+				renderScene(commandBuffer, depthPass.pipelineLayout, cascades[i].descriptorSet, i);
+			});
+			renderGraph->setDepthStencilAttachment(graphPasses.cascades[i], graphImages.depth, VK_ATTACHMENT_LOAD_OP_CLEAR, { 1.0f, 0 }, i);
 		}
 
+		// Sampled by the scene rendering in the swap chain's render pass
+		renderGraph->addOutput(graphImages.depth);
+
+		renderGraph->compile();
+
 		// Shared sampler for cascade depth reads
 		VkSamplerCreateInfo sampler = vks::initializers::samplerCreateInfo();
 		sampler.magFilter = VK_FILTER_LINEAR;
@@ -343,57 +240,21 @@ public:
 		sampler.minLod = 0.0f;
 		sampler.maxLod = 1.0f;
 		sampler.borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
-		VK_CHECK_RESULT(vkCreateSampler(device, &sampler, nullptr, &depth.sampler));
+		VK_CHECK_RESULT(vkCreateSampler(device, &sampler, nullptr, &depthSampler));
 	}
+
 	void buildCommandBuffers()
 	{
 		VkCommandBufferBeginInfo cmdBufInfo = vks::initializers::commandBufferBeginInfo();
 
-		VkDeviceSize offsets[1] = { 0 };
-
 		for (int32_t i = 0; i < drawCmdBuffers.size(); i++) {
 
 			VK_CHECK_RESULT(vkBeginCommandBuffer(drawCmdBuffers[i], &cmdBufInfo));
 
-			/*
-				Generate depth map cascades
-
-				Uses multiple passes with each pass rendering the scene to the cascade's depth image layer
-				Could be optimized using a geometry shader (and layered frame buffer) on devices that support geometry shaders
-			*/
-			{
-				VkClearValue clearValues[1];
-				clearValues[0].depthStencil = { 1.0f, 0 };
-
-				VkRenderPassBeginInfo renderPassBeginInfo = vks::initializers::renderPassBeginInfo();
-				renderPassBeginInfo.renderPass = depthPass.renderPass;
-				renderPassBeginInfo.renderArea.offset.x = 0;
-				renderPassBeginInfo.renderArea.offset.y = 0;
-				renderPassBeginInfo.renderArea.extent.width = SHADOWMAP_DIM;
-				renderPassBeginInfo.renderArea.extent.height = SHADOWMAP_DIM;
-				renderPassBeginInfo.clearValueCount = 1;
-				renderPassBeginInfo.pClearValues = clearValues;
-
-				VkViewport viewport = vks::initializers::viewport((float)SHADOWMAP_DIM, (float)SHADOWMAP_DIM, 0.0f, 1.0f);
-				vkCmdSetViewport(drawCmdBuffers[i], 0, 1, &viewport);
+			gpuProfiler.beginFrame(drawCmdBuffers[i], i);
 
-				VkRect2D scissor = vks::initializers::rect2D(SHADOWMAP_DIM, SHADOWMAP_DIM, 0, 0);
-				vkCmdSetScissor(drawCmdBuffers[i], 0, 1, &scissor);
-
-				// One pass per cascade
-				// The layer that this pass renders to is defined by the cascade's image view (selected via the cascade's descriptor set)
-				for (uint32_t j = 0; j < SHADOW_MAP_CASCADE_COUNT; j++) {
-					renderPassBeginInfo.framebuffer = cascades[j].frameBuffer;
-					vkCmdBeginRenderPass(drawCmdBuffers[i], &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
-					vkCmdBindPipeline(drawCmdBuffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, depthPass.pipeline);
-					renderScene(drawCmdBuffers[i], depthPass.pipelineLayout, cascades[j].descriptorSet, j);
-					vkCmdEndRenderPass(drawCmdBuffers[i]);
-				}
-			}
-
-			/*
-				Note: Explicit synchronization is not required between the render pass, as this is done implicit via sub pass dependencies
-			*/
+			// Depth map cascades, the render graph makes the shadow map available to the scene rendering
+			renderGraph->execute(drawCmdBuffers[i]);
 
 			/*
 				Scene rendering using depth cascades for shadow mapping
@@ -414,6 +275,7 @@ public:
 				renderPassBeginInfo.clearValueCount = 2;
 				renderPassBeginInfo.pClearValues = clearValues;
 
+				gpuProfiler.beginScope(drawCmdBuffers[i], "Scene");
 				vkCmdBeginRenderPass(drawCmdBuffers[i], &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
 
 				VkViewport viewport = vks::initializers::viewport((float)width, (float)height, 0.0f, 1.0f);
@@ -436,11 +298,11 @@ public:
 				vkCmdBindPipeline(drawCmdBuffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, (filterPCF) ? pipelines.sceneShadowPCF : pipelines.sceneShadow);
 				renderScene(drawCmdBuffers[i], pipelineLayout, descriptorSet);
 
-				drawUI(drawCmdBuffers[i]);
-
 				vkCmdEndRenderPass(drawCmdBuffers[i]);
+				gpuProfiler.endScope(drawCmdBuffers[i]);
 			}
 
+			gpuProfiler.endFrame(drawCmdBuffers[i]);
 			VK_CHECK_RESULT(vkEndCommandBuffer(drawCmdBuffers[i]));
 		}
 	}
@@ -486,13 +348,13 @@ public:
 		std::vector<VkWriteDescriptorSet> writeDescriptorSets;
 
 		VkDescriptorImageInfo depthMapDescriptor =
-			vks::initializers::descriptorImageInfo(depth.sampler, depth.view, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL);
+			vks::initializers::descriptorImageInfo(depthSampler, renderGraph->getImageView(graphImages.depth), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 
 		VkDescriptorSetAllocateInfo allocInfo =
 			vks::initializers::descriptorSetAllocateInfo(descriptorPool, &descriptorSetLayouts.base, 1);
 
 		// Scene rendering / debug display
-		VK_CHECK_RESULT(vkAllocateDescriptorSets(device, &allocInfo, &descriptorSet));
+		VK_CHECK_RESULT(vks::ObjectCounters::allocateDescriptorSets(device, &allocInfo, &descriptorSet));
 		writeDescriptorSets = {
 			vks::initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 0, &uniformBuffers.VS.descriptor),
 			vks::initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, &depthMapDescriptor),
@@ -503,8 +365,8 @@ public:
 		// Per-cascade descriptor sets
 		// Each descriptor set represents a single layer of the array texture
 		for (uint32_t i = 0; i < SHADOW_MAP_CASCADE_COUNT; i++) {
-			VK_CHECK_RESULT(vkAllocateDescriptorSets(device, &allocInfo, &cascades[i].descriptorSet));
-			VkDescriptorImageInfo cascadeImageInfo = vks::initializers::descriptorImageInfo(depth.sampler, depth.view, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL);
+			VK_CHECK_RESULT(vks::ObjectCounters::allocateDescriptorSets(device, &allocInfo, &cascades[i].descriptorSet));
+			VkDescriptorImageInfo cascadeImageInfo = vks::initializers::descriptorImageInfo(depthSampler, renderGraph->getImageView(graphImages.depth), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 			writeDescriptorSets = {
 				vks::initializers::writeDescriptorSet(cascades[i].descriptorSet, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 0, &depthPass.uniformBuffer.descriptor),
 				vks::initializers::writeDescriptorSet(cascades[i].descriptorSet, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, &cascadeImageInfo)
@@ -568,7 +430,7 @@ public:
 		// Empty vertex input state
 		VkPipelineVertexInputStateCreateInfo emptyInputState = vks::initializers::pipelineVertexInputStateCreateInfo();
 		pipelineCI.pVertexInputState = &emptyInputState;
-		VK_CHECK_RESULT(vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &pipelines.debugShadowMap));
+		VK_CHECK_RESULT(vks::ObjectCounters::createGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &pipelines.debugShadowMap));
 
 		pipelineCI.pVertexInputState = vkglTF::Vertex::getPipelineVertexInputState({ vkglTF::VertexComponent::Position, vkglTF::VertexComponent::UV, vkglTF::VertexComponent::Color, vkglTF::VertexComponent::Normal });
 		/*
@@ -582,9 +444,9 @@ public:
 		VkSpecializationMapEntry specializationMapEntry = vks::initializers::specializationMapEntry(0, 0, sizeof(uint32_t));
 		VkSpecializationInfo specializationInfo = vks::initializers::specializationInfo(1, &specializationMapEntry, sizeof(uint32_t), &enablePCF);
 		shaderStages[1].pSpecializationInfo = &specializationInfo;
-		VK_CHECK_RESULT(vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &pipelines.sceneShadow));
+		VK_CHECK_RESULT(vks::ObjectCounters::createGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &pipelines.sceneShadow));
 		enablePCF = 1;
-		VK_CHECK_RESULT(vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &pipelines.sceneShadowPCF));
+		VK_CHECK_RESULT(vks::ObjectCounters::createGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &pipelines.sceneShadowPCF));
 
 		/*
 			Depth map generation
@@ -597,8 +459,8 @@ public:
 		// Enable depth clamp (if available)
 		rasterizationState.depthClampEnable = deviceFeatures.depthClamp;
 		pipelineCI.layout = depthPass.pipelineLayout;
-		pipelineCI.renderPass = depthPass.renderPass;
-		VK_CHECK_RESULT(vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &depthPass.pipeline));
+		pipelineCI.renderPass = renderGraph->getRenderPass(graphPasses.cascades[0]);
+		VK_CHECK_RESULT(vks::ObjectCounters::createGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &depthPass.pipeline));
 	}
 
 	void prepareUniformBuffers()
@@ -770,7 +632,7 @@ public:
 		loadAssets();
 		updateLight();
 		updateCascades();
-		prepareDepthPass();
+		prepareRenderGraph();
 		prepareUniformBuffers();
 		setupLayoutsAndDescriptors();
 		preparePipelines();
@@ -812,6 +674,12 @@ public:
 				buildCommandBuffers();
 			}
 		}
+		if (overlay->header("Render graph")) {
+			const vks::RenderGraph::Stats &stats = renderGraph->getStats();
+			overlay->text("Images: %d in %d allocations", stats.imageCount, stats.allocationCount);
+			overlay->text("Memory: %.1f MB (%.1f MB without aliasing)", (float)stats.allocatedBytes / (1024.0f * 1024.0f), (float)stats.requiredBytes / (1024.0f * 1024.0f));
+			overlay->text("Barriers: %d", stats.barrierCount);
+		}
 	}
 };
 
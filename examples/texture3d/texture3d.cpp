@@ -41,13 +41,12 @@ private:
 		return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
 	}
 public:
-	PerlinNoise()
+	PerlinNoise(std::default_random_engine &rndEngine)
 	{
 		// Generate random lookup for permutations containing all numbers from 0..255
 		std::vector<uint8_t> plookup;
 		plookup.resize(256);
 		std::iota(plookup.begin(), plookup.end(), 0);
-		std::default_random_engine rndEngine(std::random_device{}());
 		std::shuffle(plookup.begin(), plookup.end(), rndEngine);
 
 		for (uint32_t i = 0; i < 256; i++)
@@ -99,9 +98,8 @@ private:
 	T persistence;
 public:
 
-	FractalNoise(const PerlinNoise<T> &perlinNoise)
+	FractalNoise(const PerlinNoise<T> &perlinNoise) : perlinNoise(perlinNoise)
 	{
-		this->perlinNoise = perlinNoise;
 		octaves = 6;
 		persistence = (T)0.5;
 	}
@@ -168,6 +166,9 @@ public:
 	VkDescriptorSet descriptorSet;
 	VkDescriptorSetLayout descriptorSetLayout;
 
+	// Seeded with a fixed value in benchmark mode, so every run generates the same noise
+	std::default_random_engine rndEngine;
+
 	VulkanExample() : VulkanExampleBase(ENABLE_VALIDATION)
 	{
 		title = "3D textures";
@@ -176,7 +177,7 @@ public:
 		camera.setRotation(glm::vec3(0.0f, 15.0f, 0.0f));
 		camera.setPerspective(60.0f, (float)width / (float)height, 0.1f, 256.0f);
 		settings.overlay = true;
-		srand((unsigned int)time(NULL));
+		rndEngine.seed(benchmark.active ? 0 : (unsigned)time(nullptr));
 	}
 
 	~VulkanExample()
@@ -186,7 +187,7 @@ public:
 
 		destroyTextureImage(texture);
 
-		vkDestroyPipeline(device, pipelines.solid, nullptr);
+		vks::ObjectCounters::destroyPipeline(device, pipelines.solid, nullptr);
 
 		vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
 		vkDestroyDescriptorSetLayout(device, descriptorSetLayout, nullptr);
@@ -207,6 +208,17 @@ public:
 		texture.mipLevels = 1;
 		texture.format = VK_FORMAT_R8_UNORM;
 
+		// Store the noise as BC4 (a quarter of the size) if the device supports block compressed 3D images
+		if (vulkanDevice->enabledFeatures.textureCompressionBC && (width % 4 == 0) && (height % 4 == 0))
+		{
+			VkImageFormatProperties imageFormatProperties;
+			VkResult result = vkGetPhysicalDeviceImageFormatProperties(physicalDevice, VK_FORMAT_BC4_UNORM_BLOCK, VK_IMAGE_TYPE_3D, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, 0, &imageFormatProperties);
+			if ((result == VK_SUCCESS) && (width <= imageFormatProperties.maxExtent.width) && (height <= imageFormatProperties.maxExtent.height) && (depth <= imageFormatProperties.maxExtent.depth))
+			{
+				texture.format = VK_FORMAT_BC4_UNORM_BLOCK;
+			}
+		}
+
 		// Format support check
 		// 3D texture support in Vulkan is mandatory (in contrast to OpenGL) so no need to check if it's supported
 		VkFormatProperties formatProperties;
@@ -302,10 +314,11 @@ public:
 
 		auto tStart = std::chrono::high_resolution_clock::now();
 
-		PerlinNoise<float> perlinNoise;
+		PerlinNoise<float> perlinNoise(rndEngine);
 		FractalNoise<float> fractalNoise(perlinNoise);
 
-		const float noiseScale = static_cast<float>(rand() % 10) + 4.0f;
+		std::uniform_int_distribution<int32_t> rndDist(4, 13);
+		const float noiseScale = static_cast<float>(rndDist(rndEngine));
 
 #pragma omp parallel for
 		for (int32_t z = 0; z < texture.depth; z++)
@@ -335,13 +348,33 @@ public:
 
 		std::cout << "Done in " << tDiff << "ms" << std::endl;
 
+		// Compress the noise slice by slice, blocks of 3D images cover 4x4x1 texels
+		VkDeviceSize uploadSize = texMemSize;
+		uint8_t *uploadData = data;
+		std::vector<uint8_t> compressedData;
+		if (texture.format == VK_FORMAT_BC4_UNORM_BLOCK)
+		{
+			tStart = std::chrono::high_resolution_clock::now();
+			const size_t sliceSize = vks::bc::compressedSize(vks::bc::Format::BC4, texture.width, texture.height);
+			compressedData.resize(sliceSize * texture.depth);
+			for (uint32_t z = 0; z < texture.depth; z++)
+			{
+				vks::bc::compress(vks::bc::Format::BC4, data + z * texture.width * texture.height, texture.width, texture.height, 1, compressedData.data() + z * sliceSize, &jobSystem);
+			}
+			uploadSize = compressedData.size();
+			uploadData = compressedData.data();
+			tEnd = std::chrono::high_resolution_clock::now();
+			tDiff = std::chrono::duration<double, std::milli>(tEnd - tStart).count();
+			std::cout << "Compressed to BC4 (" << uploadSize / 1024 << " KiB) in " << tDiff << "ms" << std::endl;
+		}
+
 		// Create a host-visible staging buffer that contains the raw image data
 		VkBuffer stagingBuffer;
 		VkDeviceMemory stagingMemory;
 
 		// Buffer object
 		VkBufferCreateInfo bufferCreateInfo = vks::initializers::bufferCreateInfo();
-		bufferCreateInfo.size = texMemSize;
+		bufferCreateInfo.size = uploadSize;
 		bufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
 		bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 		VK_CHECK_RESULT(vkCreateBuffer(device, &bufferCreateInfo, nullptr, &stagingBuffer));
@@ -358,7 +391,7 @@ public:
 		// Copy texture data into staging buffer
 		uint8_t *mapped;
 		VK_CHECK_RESULT(vkMapMemory(device, stagingMemory, 0, memReqs.size, 0, (void **)&mapped));
-		memcpy(mapped, data, texMemSize);
+		memcpy(mapped, uploadData, uploadSize);
 		vkUnmapMemory(device, stagingMemory);
 
 		VkCommandBuffer copyCmd = vulkanDevice->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
@@ -469,8 +502,6 @@ public:
 			vkCmdBindIndexBuffer(drawCmdBuffers[i], indexBuffer.buffer, 0, VK_INDEX_TYPE_UINT32);
 			vkCmdDrawIndexed(drawCmdBuffers[i], indexCount, 1, 0, 0, 0);
 
-			drawUI(drawCmdBuffers[i]);
-
 			vkCmdEndRenderPass(drawCmdBuffers[i]);
 
 			VK_CHECK_RESULT(vkEndCommandBuffer(drawCmdBuffers[i]));
@@ -623,7 +654,7 @@ public:
 				&descriptorSetLayout,
 				1);
 
-		VK_CHECK_RESULT(vkAllocateDescriptorSets(device, &allocInfo, &descriptorSet));
+		VK_CHECK_RESULT(vks::ObjectCounters::allocateDescriptorSets(device, &allocInfo, &descriptorSet));
 
 		std::vector<VkWriteDescriptorSet> writeDescriptorSets =
 		{
@@ -716,7 +747,7 @@ public:
 		pipelineCreateInfo.stageCount = static_cast<uint32_t>(shaderStages.size());
 		pipelineCreateInfo.pStages = shaderStages.data();
 
-		VK_CHECK_RESULT(vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineCreateInfo, nullptr, &pipelines.solid));
+		VK_CHECK_RESULT(vks::ObjectCounters::createGraphicsPipelines(device, pipelineCache, 1, &pipelineCreateInfo, nullptr, &pipelines.solid));
 	}
 
 	// Prepare and initialize uniform buffer containing shader uniforms
@@ -76,7 +76,7 @@ public:
 		vkDestroySampler(device, textureArray.sampler, nullptr);
 		vkFreeMemory(device, textureArray.deviceMemory, nullptr);
 
-		vkDestroyPipeline(device, pipeline, nullptr);
+		vks::ObjectCounters::destroyPipeline(device, pipeline, nullptr);
 
 		vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
 		vkDestroyDescriptorSetLayout(device, descriptorSetLayout, nullptr);
@@ -274,7 +274,11 @@ public:
 
 	void loadAssets()
 	{
-		loadTextureArray(getAssetPath() + "textures/texturearray_rgba.ktx", VK_FORMAT_R8G8B8A8_UNORM);
+		// Pick the best variant of the texture array the device supports, loadTextureArray uses libktx, which only supports KTX (version 1) files
+		std::string filename;
+		VkFormat format;
+		vks::Texture::resolveAsset(getAssetPath() + "textures/texturearray", vulkanDevice, VK_IMAGE_USAGE_SAMPLED_BIT, filename, format, false, false);
+		loadTextureArray(filename, format);
 	}
 
 	void buildCommandBuffers()
@@ -318,8 +322,6 @@ public:
 
 			vkCmdDrawIndexed(drawCmdBuffers[i], indexCount, layerCount, 0, 0, 0);
 
-			drawUI(drawCmdBuffers[i]);
-
 			vkCmdEndRenderPass(drawCmdBuffers[i]);
 
 			VK_CHECK_RESULT(vkEndCommandBuffer(drawCmdBuffers[i]));
@@ -409,7 +411,7 @@ public:
 	void setupDescriptorSet()
 	{
 		VkDescriptorSetAllocateInfo allocInfo = vks::initializers::descriptorSetAllocateInfo(descriptorPool, &descriptorSetLayout, 1);
-		VK_CHECK_RESULT(vkAllocateDescriptorSets(device, &allocInfo, &descriptorSet));
+		VK_CHECK_RESULT(vks::ObjectCounters::allocateDescriptorSets(device, &allocInfo, &descriptorSet));
 
 		// Image descriptor for the texture array
 		VkDescriptorImageInfo textureDescriptor =
@@ -469,7 +471,7 @@ public:
 		pipelineCI.stageCount = shaderStages.size();
 		pipelineCI.pStages = shaderStages.data();
 
-		VK_CHECK_RESULT(vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &pipeline));
+		VK_CHECK_RESULT(vks::ObjectCounters::createGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &pipeline));
 	}
 
 	void prepareUniformBuffers()
@@ -496,16 +498,13 @@ public:
 			uboVS.instance[i].arrayIndex.x = (float)i;
 		}
 
+		// Map persistent
+		VK_CHECK_RESULT(uniformBufferVS.map());
+
 		// Update instanced part of the uniform buffer
-		uint8_t *pData;
 		uint32_t dataOffset = sizeof(uboVS.matrices);
 		uint32_t dataSize = layerCount * sizeof(UboInstanceData);
-		VK_CHECK_RESULT(vkMapMemory(device, uniformBufferVS.memory, dataOffset, dataSize, 0, (void **)&pData));
-		memcpy(pData, uboVS.instance, dataSize);
-		vkUnmapMemory(device, uniformBufferVS.memory);
-
-		// Map persistent
-		VK_CHECK_RESULT(uniformBufferVS.map());
+		memcpy((uint8_t *)uniformBufferVS.mapped + dataOffset, uboVS.instance, dataSize);
 
 		updateUniformBuffersCamera();
 	}
@@ -8,6 +8,7 @@
 
 #include "vulkanexamplebase.h"
 #include "VulkanglTFModel.h"
+#include "VulkanMipGenerator.h"
 #include <ktx.h>
 #include <ktxvulkan.h>
 
@@ -22,8 +23,20 @@ public:
 		VkImageView view;
 		uint32_t width, height;
 		uint32_t mipLevels;
+		VkFormat format;
 	} texture;
 
+	// The mip chain can either be generated with image blits (one per level) or with the base library's compute mip generator
+	enum MipGenerationMethod { Blit = 0, Compute = 1 };
+	int32_t mipGenerationMethod = MipGenerationMethod::Compute;
+	std::vector<std::string> mipGenerationNames{ "Blit", "Compute" };
+	std::vector<std::string> mipFilterNames{ "Box", "Min", "Max" };
+	int32_t mipFilter = 0;
+	bool srgbFiltering = false;
+	bool asyncCompute = false;
+	vks::MipGenerator mipGenerator;
+	VkQueue computeQueue;
+
 	// To demonstrate mip mapping and filtering this example uses separate samplers
 	std::vector<std::string> samplerNames{ "No mip maps" , "Mip maps (bilinear)" , "Mip maps (anisotropic)" };
 	std::vector<VkSampler> samplers;
@@ -62,7 +75,8 @@ public:
 	~VulkanExample()
 	{
 		destroyTextureImage(texture);
-		vkDestroyPipeline(device, pipeline, nullptr);
+		mipGenerator.destroy();
+		vks::ObjectCounters::destroyPipeline(device, pipeline, nullptr);
 		vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
 		vkDestroyDescriptorSetLayout(device, descriptorSetLayout, nullptr);
 		uniformBufferVS.destroy();
@@ -109,6 +123,7 @@ public:
 
 		texture.width = ktxTexture->baseWidth;
 		texture.height = ktxTexture->baseHeight;
+		texture.format = format;
 		ktx_uint8_t *ktxTextureData = ktxTexture_GetData(ktxTexture);
 		ktx_size_t ktxTextureSize = ktxTexture_GetImageSize(ktxTexture, 0);
 
@@ -161,6 +176,13 @@ public:
 		imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 		imageCreateInfo.extent = { texture.width, texture.height, 1 };
 		imageCreateInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+		// Storage usage is required for generating the mip chain in a compute shader
+		if (mipGenerator.isSupported(format)) {
+			imageCreateInfo.usage |= VK_IMAGE_USAGE_STORAGE_BIT;
+		}
+		else {
+			mipGenerationMethod = MipGenerationMethod::Blit;
+		}
 		VK_CHECK_RESULT(vkCreateImage(device, &imageCreateInfo, nullptr, &texture.image));
 		vkGetImageMemoryRequirements(device, texture.image, &memReqs);
 		memAllocInfo.allocationSize = memReqs.size;
@@ -199,16 +221,16 @@ public:
 
 		vkCmdCopyBufferToImage(copyCmd, stagingBuffer, texture.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &bufferCopyRegion);
 
-		// Transition first mip level to transfer source for read during blit
+		// Transition first mip level to shader read, the remaining mips will be generated from it
 		vks::tools::insertImageMemoryBarrier(
 			copyCmd,
 			texture.image,
 			VK_ACCESS_TRANSFER_WRITE_BIT,
-			VK_ACCESS_TRANSFER_READ_BIT,
+			VK_ACCESS_SHADER_READ_BIT,
 			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-			VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
 			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
 			subresourceRange);
 
 		vulkanDevice->flushCommandBuffer(copyCmd, queue, true);
@@ -218,12 +240,88 @@ public:
 		vkDestroyBuffer(device, stagingBuffer, nullptr);
 		ktxTexture_Destroy(ktxTexture);
 
-		// Generate the mip chain
-		// ---------------------------------------------------------------
+		generateMipmaps();
+
+		// Create samplers
+		samplers.resize(3);
+		VkSamplerCreateInfo sampler = vks::initializers::samplerCreateInfo();
+		sampler.magFilter = VK_FILTER_LINEAR;
+		sampler.minFilter = VK_FILTER_LINEAR;
+		sampler.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+		sampler.addressModeU = VK_SAMPLER_ADDRESS_MODE_MIRRORED_REPEAT;
+		sampler.addressModeV = VK_SAMPLER_ADDRESS_MODE_MIRRORED_REPEAT;
+		sampler.addressModeW = VK_SAMPLER_ADDRESS_MODE_MIRRORED_REPEAT;
+		sampler.mipLodBias = 0.0f;
+		sampler.compareOp = VK_COMPARE_OP_NEVER;
+		sampler.minLod = 0.0f;
+		sampler.maxLod = 0.0f;
+		sampler.borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
+		sampler.maxAnisotropy = 1.0;
+		sampler.anisotropyEnable = VK_FALSE;
+
+		// Without mip mapping
+		VK_CHECK_RESULT(vkCreateSampler(device, &sampler, nullptr, &samplers[0]));
+
+		// With mip mapping
+		sampler.maxLod = (float)texture.mipLevels;
+		VK_CHECK_RESULT(vkCreateSampler(device, &sampler, nullptr, &samplers[1]));
+
+		// With mip mapping and anisotropic filtering
+		if (vulkanDevice->features.samplerAnisotropy)
+		{
+			sampler.maxAnisotropy = vulkanDevice->properties.limits.maxSamplerAnisotropy;
+			sampler.anisotropyEnable = VK_TRUE;
+		}
+		VK_CHECK_RESULT(vkCreateSampler(device, &sampler, nullptr, &samplers[2]));
+
+		// Create image view
+		VkImageViewCreateInfo view = vks::initializers::imageViewCreateInfo();
+		view.image = texture.image;
+		view.viewType = VK_IMAGE_VIEW_TYPE_2D;
+		view.format = format;
+		view.components = { VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_G, VK_COMPONENT_SWIZZLE_B, VK_COMPONENT_SWIZZLE_A };
+		view.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		view.subresourceRange.baseMipLevel = 0;
+		view.subresourceRange.baseArrayLayer = 0;
+		view.subresourceRange.layerCount = 1;
+		view.subresourceRange.levelCount = texture.mipLevels;
+		VK_CHECK_RESULT(vkCreateImageView(device, &view, nullptr, &texture.view));
+	}
+
+	// Generate the mip chain from the first level, which is expected to be in shader read layout
+	void generateMipmaps()
+	{
+		if (mipGenerationMethod == MipGenerationMethod::Compute)
+		{
+			// All levels are generated by a few compute dispatches (up to six levels per dispatch) using the base library mip generator
+			mipGenerator.filter = static_cast<vks::MipGenerator::Filter>(mipFilter);
+			mipGenerator.srgb = srgbFiltering;
+			mipGenerator.setComputeQueue(asyncCompute ? computeQueue : VK_NULL_HANDLE, vulkanDevice->queueFamilyIndices.compute);
+			mipGenerator.generate(queue, texture.image, texture.format, texture.width, texture.height, texture.mipLevels, 1, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+			return;
+		}
+
 		// We copy down the whole mip chain doing a blit from mip-1 to mip
 		// An alternative way would be to always blit from the first mip level and sample that one down
 		VkCommandBuffer blitCmd = vulkanDevice->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
 
+		VkImageSubresourceRange subresourceRange = {};
+		subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		subresourceRange.levelCount = 1;
+		subresourceRange.layerCount = 1;
+
+		// Transition first mip level to transfer source for read during blit
+		vks::tools::insertImageMemoryBarrier(
+			blitCmd,
+			texture.image,
+			VK_ACCESS_SHADER_READ_BIT,
+			VK_ACCESS_TRANSFER_READ_BIT,
+			VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+			VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+			VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			subresourceRange);
+
 		// Copy down mips from n-1 to n
 		for (int32_t i = 1; i < texture.mipLevels; i++)
 		{
@@ -301,52 +399,6 @@ public:
 			subresourceRange);
 
 		vulkanDevice->flushCommandBuffer(blitCmd, queue, true);
-		// ---------------------------------------------------------------
-
-		// Create samplers
-		samplers.resize(3);
-		VkSamplerCreateInfo sampler = vks::initializers::samplerCreateInfo();
-		sampler.magFilter = VK_FILTER_LINEAR;
-		sampler.minFilter = VK_FILTER_LINEAR;
-		sampler.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
-		sampler.addressModeU = VK_SAMPLER_ADDRESS_MODE_MIRRORED_REPEAT;
-		sampler.addressModeV = VK_SAMPLER_ADDRESS_MODE_MIRRORED_REPEAT;
-		sampler.addressModeW = VK_SAMPLER_ADDRESS_MODE_MIRRORED_REPEAT;
-		sampler.mipLodBias = 0.0f;
-		sampler.compareOp = VK_COMPARE_OP_NEVER;
-		sampler.minLod = 0.0f;
-		sampler.maxLod = 0.0f;
-		sampler.borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
-		sampler.maxAnisotropy = 1.0;
-		sampler.anisotropyEnable = VK_FALSE;
-
-		// Without mip mapping
-		VK_CHECK_RESULT(vkCreateSampler(device, &sampler, nullptr, &samplers[0]));
-
-		// With mip mapping
-		sampler.maxLod = (float)texture.mipLevels;
-		VK_CHECK_RESULT(vkCreateSampler(device, &sampler, nullptr, &samplers[1]));
-
-		// With mip mapping and anisotropic filtering
-		if (vulkanDevice->features.samplerAnisotropy)
-		{
-			sampler.maxAnisotropy = vulkanDevice->properties.limits.maxSamplerAnisotropy;
-			sampler.anisotropyEnable = VK_TRUE;
-		}
-		VK_CHECK_RESULT(vkCreateSampler(device, &sampler, nullptr, &samplers[2]));
-
-		// Create image view
-		VkImageViewCreateInfo view = vks::initializers::imageViewCreateInfo();
-		view.image = texture.image;
-		view.viewType = VK_IMAGE_VIEW_TYPE_2D;
-		view.format = format;
-		view.components = { VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_G, VK_COMPONENT_SWIZZLE_B, VK_COMPONENT_SWIZZLE_A };
-		view.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-		view.subresourceRange.baseMipLevel = 0;
-		view.subresourceRange.baseArrayLayer = 0;
-		view.subresourceRange.layerCount = 1;
-		view.subresourceRange.levelCount = texture.mipLevels;
-		VK_CHECK_RESULT(vkCreateImageView(device, &view, nullptr, &texture.view));
 	}
 
 	// Free all Vulkan resources used a texture object
@@ -394,8 +446,6 @@ public:
 
 			model.draw(drawCmdBuffers[i]);
 
-			drawUI(drawCmdBuffers[i]);
-
 			vkCmdEndRenderPass(drawCmdBuffers[i]);
 
 			VK_CHECK_RESULT(vkEndCommandBuffer(drawCmdBuffers[i]));
@@ -461,7 +511,7 @@ public:
 	void setupDescriptorSet()
 	{
 		VkDescriptorSetAllocateInfo allocInfo = vks::initializers::descriptorSetAllocateInfo(descriptorPool, &descriptorSetLayout,1);
-		VK_CHECK_RESULT(vkAllocateDescriptorSets(device, &allocInfo, &descriptorSet));
+		VK_CHECK_RESULT(vks::ObjectCounters::allocateDescriptorSets(device, &allocInfo, &descriptorSet));
 
 		VkDescriptorImageInfo textureDescriptor = vks::initializers::descriptorImageInfo(VK_NULL_HANDLE, texture.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 		std::vector<VkWriteDescriptorSet> writeDescriptorSets = {
@@ -517,7 +567,7 @@ public:
 		pipelineCI.stageCount = static_cast<uint32_t>(shaderStages.size());
 		pipelineCI.pStages = shaderStages.data();
 		pipelineCI.pVertexInputState = vkglTF::Vertex::getPipelineVertexInputState({ vkglTF::VertexComponent::Position, vkglTF::VertexComponent::UV, vkglTF::VertexComponent::Normal });
-		VK_CHECK_RESULT(vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &pipeline));
+		VK_CHECK_RESULT(vks::ObjectCounters::createGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &pipeline));
 	}
 
 	// Prepare and initialize uniform buffer containing shader uniforms
@@ -548,6 +598,8 @@ public:
 	void prepare()
 	{
 		VulkanExampleBase::prepare();
+		mipGenerator.create(vulkanDevice, pipelineCache, getShadersPath() + "base/mipgen.comp.spv");
+		vkGetDeviceQueue(device, vulkanDevice->queueFamilyIndices.compute, 0, &computeQueue);
 		loadAssets();
 		prepareUniformBuffers();
 		setupDescriptorSetLayout();
@@ -579,6 +631,23 @@ public:
 				updateUniformBuffers();
 			}
 		}
+		if (overlay->header("Mip generation")) {
+			bool regenerate = false;
+			if (mipGenerator.isSupported(texture.format)) {
+				regenerate |= overlay->comboBox("Method", &mipGenerationMethod, mipGenerationNames);
+			}
+			if (mipGenerationMethod == MipGenerationMethod::Compute) {
+				regenerate |= overlay->comboBox("Filter", &mipFilter, mipFilterNames);
+				regenerate |= overlay->checkBox("sRGB correct", &srgbFiltering);
+				if (vulkanDevice->queueFamilyIndices.compute != vulkanDevice->queueFamilyIndices.graphics) {
+					regenerate |= overlay->checkBox("Async compute queue", &asyncCompute);
+				}
+			}
+			if (regenerate) {
+				vkDeviceWaitIdle(device);
+				generateMipmaps();
+			}
+		}
 	}
 };
 
@@ -21,6 +21,8 @@ VirtualTexturePage::VirtualTexturePage()
 {
 	// Pages are initially not backed up by memory (non-resident)
 	imageMemoryBind.memory = VK_NULL_HANDLE;
+	poolSlot = 0;
+	lastRequested = 0;
 }
 
 bool VirtualTexturePage::resident()
@@ -28,40 +30,70 @@ bool VirtualTexturePage::resident()
 	return (imageMemoryBind.memory != VK_NULL_HANDLE);
 }
 
-// Allocate Vulkan memory for the virtual page
-void VirtualTexturePage::allocate(VkDevice device, uint32_t memoryTypeIndex)
-{
-	if (imageMemoryBind.memory != VK_NULL_HANDLE)
-	{
-		return;
-	};
+/*
+	Page memory pool
+	Hands out page sized slots from a small number of larger memory allocations
+ */
 
-	imageMemoryBind = {};
+void PageMemoryPool::create(VkDevice device, uint32_t memoryTypeIndex, VkDeviceSize pageSize, uint32_t capacity, uint32_t pagesPerBlock)
+{
+	this->device = device;
+	this->memoryTypeIndex = memoryTypeIndex;
+	this->pageSize = pageSize;
+	this->capacity = capacity;
+	this->pagesPerBlock = pagesPerBlock;
+}
 
-	VkMemoryAllocateInfo allocInfo = vks::initializers::memoryAllocateInfo();
-	allocInfo.allocationSize = size;
-	allocInfo.memoryTypeIndex = memoryTypeIndex;
-	VK_CHECK_RESULT(vkAllocateMemory(device, &allocInfo, nullptr, &imageMemoryBind.memory));
+// Get a free slot, allocates a new memory block if all slots of the current blocks are in use
+// Returns false if the pool is at capacity
+bool PageMemoryPool::allocate(uint32_t &slot, VkDeviceMemory &memory, VkDeviceSize &memoryOffset)
+{
+	if (!freeSlots.empty())
+	{
+		slot = freeSlots.back();
+		freeSlots.pop_back();
+	}
+	else
+	{
+		if (slotCount >= capacity)
+		{
+			return false;
+		}
+		if (slotCount == blocks.size() * pagesPerBlock)
+		{
+			VkMemoryAllocateInfo allocInfo = vks::initializers::memoryAllocateInfo();
+			allocInfo.allocationSize = pageSize * pagesPerBlock;
+			allocInfo.memoryTypeIndex = memoryTypeIndex;
+			VkDeviceMemory block;
+			VK_CHECK_RESULT(vkAllocateMemory(device, &allocInfo, nullptr, &block));
+			blocks.push_back(block);
+		}
+		slot = slotCount++;
+	}
+	memory = blocks[slot / pagesPerBlock];
+	memoryOffset = (slot % pagesPerBlock) * pageSize;
+	return true;
+}
 
-	VkImageSubresource subResource{};
-	subResource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-	subResource.mipLevel = mipLevel;
-	subResource.arrayLayer = layer;
+void PageMemoryPool::release(uint32_t slot)
+{
+	freeSlots.push_back(slot);
+}
 
-	// Sparse image memory binding
-	imageMemoryBind.subresource = subResource;
-	imageMemoryBind.extent = extent;
-	imageMemoryBind.offset = offset;
+uint32_t PageMemoryPool::usedSlots()
+{
+	return slotCount - static_cast<uint32_t>(freeSlots.size());
 }
 
-// Release Vulkan memory allocated for this page
-void VirtualTexturePage::release(VkDevice device)
+void PageMemoryPool::destroy()
 {
-	if (imageMemoryBind.memory != VK_NULL_HANDLE)
+	for (auto block : blocks)
 	{
-		vkFreeMemory(device, imageMemoryBind.memory, nullptr);
-		imageMemoryBind.memory = VK_NULL_HANDLE;
+		vkFreeMemory(device, block, nullptr);
 	}
+	blocks.clear();
+	freeSlots.clear();
+	slotCount = 0;
 }
 
 /*
@@ -85,21 +117,61 @@ VirtualTexturePage* VirtualTexture::addPage(VkOffset3D offset, VkExtent3D extent
 	return &pages.back();
 }
 
+// Back the page with a slot from the page memory pool
+// Returns false if the pool is exhausted (the caller needs to evict a page first)
+bool VirtualTexture::makeResident(VirtualTexturePage &page)
+{
+	if (page.resident())
+	{
+		return true;
+	}
+	VkDeviceMemory memory;
+	VkDeviceSize memoryOffset;
+	if (!pagePool.allocate(page.poolSlot, memory, memoryOffset))
+	{
+		return false;
+	}
+	page.imageMemoryBind.memory = memory;
+	page.imageMemoryBind.memoryOffset = memoryOffset;
+	lruPages.push_front(page.index);
+	page.lruPosition = lruPages.begin();
+	return true;
+}
+
+// Return the page's memory to the pool, the page needs to be unbound with the next sparse bind
+void VirtualTexture::evict(VirtualTexturePage &page)
+{
+	if (!page.resident())
+	{
+		return;
+	}
+	pagePool.release(page.poolSlot);
+	lruPages.erase(page.lruPosition);
+	page.imageMemoryBind.memory = VK_NULL_HANDLE;
+	page.imageMemoryBind.memoryOffset = 0;
+}
+
+// Mark a resident page as most recently used
+void VirtualTexture::touch(VirtualTexturePage &page)
+{
+	if (page.resident())
+	{
+		lruPages.splice(lruPages.begin(), lruPages, page.lruPosition);
+	}
+}
+
 // Call before sparse binding to update memory bind list etc.
-void VirtualTexture::updateSparseBindInfo()
+// Only pages whose residency changed are (re)bound, evicted pages are unbound with a null memory handle
+void VirtualTexture::updateSparseBindInfo(const std::vector<VirtualTexturePage*> &bindingChangedPages, bool bindMipTail)
 {
-	// Update list of memory-backed sparse image memory binds
-	//sparseImageMemoryBinds.resize(pages.size());
+	// Update list of changed sparse image memory binds
 	sparseImageMemoryBinds.clear();
-	for (auto page : pages)
+	for (auto page : bindingChangedPages)
 	{
-		sparseImageMemoryBinds.push_back(page.imageMemoryBind);
+		sparseImageMemoryBinds.push_back(page->imageMemoryBind);
 	}
 	// Update sparse bind info
 	bindSparseInfo = vks::initializers::bindSparseInfo();
-	// todo: Semaphore for queue submission
-	// bindSparseInfo.signalSemaphoreCount = 1;
-	// bindSparseInfo.pSignalSemaphores = &bindSparseSemaphore;
 
 	// Image memory binds
 	imageMemoryBindInfo = {};
@@ -110,8 +182,9 @@ void VirtualTexture::updateSparseBindInfo()
 	bindSparseInfo.pImageBinds = &imageMemoryBindInfo;
 
 	// Opaque image memory binds for the mip tail
+	// The mip tail stays resident for the lifetime of the texture, so it's only bound once
 	opaqueMemoryBindInfo.image = image;
-	opaqueMemoryBindInfo.bindCount = static_cast<uint32_t>(opaqueMemoryBinds.size());
+	opaqueMemoryBindInfo.bindCount = bindMipTail ? static_cast<uint32_t>(opaqueMemoryBinds.size()) : 0;
 	opaqueMemoryBindInfo.pBinds = opaqueMemoryBinds.data();
 	bindSparseInfo.imageOpaqueBindCount = (opaqueMemoryBindInfo.bindCount > 0) ? 1 : 0;
 	bindSparseInfo.pImageOpaqueBinds = &opaqueMemoryBindInfo;
@@ -120,10 +193,7 @@ void VirtualTexture::updateSparseBindInfo()
 // Release all Vulkan resources
 void VirtualTexture::destroy()
 {
-	for (auto page : pages)
-	{
-		page.release(device);
-	}
+	pagePool.destroy();
 	for (auto bind : opaqueMemoryBinds)
 	{
 		vkFreeMemory(device, bind.memory, nullptr);
@@ -142,6 +212,8 @@ VulkanExample::VulkanExample() : VulkanExampleBase(ENABLE_VALIDATION)
 	camera.setRotation(glm::vec3(-90.0f, 0.0f, 0.0f));
 	camera.setPerspective(60.0f, (float)width / (float)height, 0.1f, 256.0f);
 	settings.overlay = true;
+	// The feedback buffer is read back and reset by the host after every frame, which requires the frame to have finished on the device
+	assert(maxFramesInFlight == 1);
 }
 
 VulkanExample::~VulkanExample()
@@ -150,10 +222,14 @@ VulkanExample::~VulkanExample()
 	// Note : Inherited destructor cleans up resources stored in base class
 	destroyTextureImage(texture);
 	vkDestroySemaphore(device, bindSparseSemaphore, nullptr);
-	vkDestroyPipeline(device, pipeline, nullptr);
+	vkDestroyFence(device, pageUploadFence, nullptr);
+	vks::ObjectCounters::destroyPipeline(device, pipeline, nullptr);
 	vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
 	vkDestroyDescriptorSetLayout(device, descriptorSetLayout, nullptr);
 	uniformBufferVS.destroy();
+	uniformBufferFeedback.destroy();
+	feedbackBuffer.destroy();
+	pageStagingBuffer.destroy();
 }
 
 void VulkanExample::getEnabledFeatures()
@@ -167,6 +243,13 @@ void VulkanExample::getEnabledFeatures()
 	else {
 		std::cout << "Sparse binding not supported" << std::endl;
 	}
+	// Required for writing page requests to the feedback buffer from the fragment shader
+	// Pages are only ever made resident based on that feedback, so there is no way to stream the texture without it
+	if (deviceFeatures.fragmentStoresAndAtomics) {
+		enabledFeatures.fragmentStoresAndAtomics = VK_TRUE;
+	} else {
+		vks::tools::exitFatal("Selected GPU does not support stores and atomic operations in the fragment stage, which are required for the page feedback", VK_ERROR_FEATURE_NOT_PRESENT);
+	}
 }
 
 glm::uvec3 VulkanExample::alignedDivision(const VkExtent3D& extent, const VkExtent3D& granularity)
@@ -322,6 +405,8 @@ void VulkanExample::prepareSparseTexture(uint32_t width, uint32_t height, uint32
 		// sparseMemoryReq.imageMipTailFirstLod is the first mip level that's stored inside the mip tail
 		for (uint32_t mipLevel = 0; mipLevel < sparseMemoryReq.imageMipTailFirstLod; mipLevel++)
 		{
+			// Page layout of this mip level is passed to the feedback pass for calculating requested page indices
+			const bool storePageLayout = (layer == 0);
 			VkExtent3D extent;
 			extent.width = std::max(sparseImageCreateInfo.extent.width >> mipLevel, 1u);
 			extent.height = std::max(sparseImageCreateInfo.extent.height >> mipLevel, 1u);
@@ -340,6 +425,11 @@ void VulkanExample::prepareSparseTexture(uint32_t width, uint32_t height, uint32
 			lastBlockExtent.y = (extent.height % imageGranularity.height) ? extent.height % imageGranularity.height : imageGranularity.height;
 			lastBlockExtent.z = (extent.depth % imageGranularity.depth) ? extent.depth % imageGranularity.depth : imageGranularity.depth;
 
+			if (storePageLayout)
+			{
+				texture.mipPageInfo.push_back(glm::uvec4(static_cast<uint32_t>(texture.pages.size()), sparseBindCounts.x, sparseBindCounts.y, 0));
+			}
+
 			// @todo: Comment
 			uint32_t index = 0;
 			for (uint32_t z = 0; z < sparseBindCounts.z; z++)
@@ -416,18 +506,32 @@ void VulkanExample::prepareSparseTexture(uint32_t width, uint32_t height, uint32
 		texture.opaqueMemoryBinds.push_back(sparseMemoryBind);
 	}
 
+	// Pages are backed by a pool that only holds a fraction of the virtual texture's pages
+	// Pages are streamed in on demand based on the feedback written by the fragment shader
+	streaming.maxResidentPages = std::min(streaming.maxResidentPages, static_cast<uint32_t>(texture.pages.size()));
+	texture.pagePool.create(device, texture.memoryTypeIndex, sparseImageMemoryReqs.alignment, streaming.maxResidentPages, 64);
+	std::cout << "\tPage pool capacity: " << streaming.maxResidentPages << " pages" << std::endl;
+
 	// Create signal semaphore for sparse binding
+	// Page uploads wait on this semaphore, so they're only executed after the pages have been bound
 	VkSemaphoreCreateInfo semaphoreCreateInfo = vks::initializers::semaphoreCreateInfo();
 	VK_CHECK_RESULT(vkCreateSemaphore(device, &semaphoreCreateInfo, nullptr, &bindSparseSemaphore));
+	VkFenceCreateInfo fenceCreateInfo = vks::initializers::fenceCreateInfo(VK_FLAGS_NONE);
+	VK_CHECK_RESULT(vkCreateFence(device, &fenceCreateInfo, nullptr, &pageUploadFence));
 
-	// Prepare bind sparse info for reuse in queue submission
-	texture.updateSparseBindInfo();
+	// Staging buffer large enough for the max. number of page uploads per frame (RGBA8)
+	const VkExtent3D imageGranularity = sparseMemoryReq.formatProperties.imageGranularity;
+	VK_CHECK_RESULT(vulkanDevice->createBuffer(
+		VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+		&pageStagingBuffer,
+		static_cast<VkDeviceSize>(4 * imageGranularity.width * imageGranularity.height * imageGranularity.depth) * maxPageUploadsLimit));
+	VK_CHECK_RESULT(pageStagingBuffer.map());
 
-	// Bind to queue
-	// todo: in draw?
-	vkQueueBindSparse(queue, 1, &texture.bindSparseInfo, VK_NULL_HANDLE);
-	//todo: use sparse bind semaphore
-	vkQueueWaitIdle(queue);
+	// Initial bind only binds the mip tail, all other pages start non-resident
+	texture.updateSparseBindInfo({}, true);
+	VK_CHECK_RESULT(vkQueueBindSparse(queue, 1, &texture.bindSparseInfo, VK_NULL_HANDLE));
+	VK_CHECK_RESULT(vkQueueWaitIdle(queue));
 
 	// Create sampler
 	VkSamplerCreateInfo sampler = vks::initializers::samplerCreateInfo();
@@ -510,8 +614,6 @@ void VulkanExample::buildCommandBuffers()
 		vkCmdBindPipeline(drawCmdBuffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
 		plane.draw(drawCmdBuffers[i]);
 
-		drawUI(drawCmdBuffers[i]);
-
 		vkCmdEndRenderPass(drawCmdBuffers[i]);
 
 		VK_CHECK_RESULT(vkEndCommandBuffer(drawCmdBuffers[i]));
@@ -535,11 +637,12 @@ void VulkanExample::loadAssets()
 
 void VulkanExample::setupDescriptorPool()
 {
-	// Example uses one ubo and one image sampler
+	// Example uses two ubos, one image sampler and the feedback storage buffer
 	std::vector<VkDescriptorPoolSize> poolSizes =
 	{
-		vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1),
-		vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1)
+		vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 2),
+		vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1),
+		vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1)
 	};
 
 	VkDescriptorPoolCreateInfo descriptorPoolInfo =
@@ -564,7 +667,17 @@ void VulkanExample::setupDescriptorSetLayout()
 		vks::initializers::descriptorSetLayoutBinding(
 			VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
 			VK_SHADER_STAGE_FRAGMENT_BIT,
-			1)
+			1),
+		// Binding 2 : Fragment shader uniform buffer with the virtual texture's page layout
+		vks::initializers::descriptorSetLayoutBinding(
+			VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+			VK_SHADER_STAGE_FRAGMENT_BIT,
+			2),
+		// Binding 3 : Fragment shader storage buffer for page requests
+		vks::initializers::descriptorSetLayoutBinding(
+			VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+			VK_SHADER_STAGE_FRAGMENT_BIT,
+			3)
 	};
 
 	VkDescriptorSetLayoutCreateInfo descriptorLayout =
@@ -590,7 +703,7 @@ void VulkanExample::setupDescriptorSet()
 			&descriptorSetLayout,
 			1);
 
-	VK_CHECK_RESULT(vkAllocateDescriptorSets(device, &allocInfo, &descriptorSet));
+	VK_CHECK_RESULT(vks::ObjectCounters::allocateDescriptorSets(device, &allocInfo, &descriptorSet));
 
 	std::vector<VkWriteDescriptorSet> writeDescriptorSets =
 	{
@@ -605,7 +718,19 @@ void VulkanExample::setupDescriptorSet()
 			descriptorSet,
 			VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
 			1,
-			&texture.descriptor)
+			&texture.descriptor),
+		// Binding 2 : Fragment shader page layout uniform buffer
+		vks::initializers::writeDescriptorSet(
+			descriptorSet,
+			VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+			2,
+			&uniformBufferFeedback.descriptor),
+		// Binding 3 : Fragment shader feedback storage buffer
+		vks::initializers::writeDescriptorSet(
+			descriptorSet,
+			VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+			3,
+			&feedbackBuffer.descriptor)
 	};
 
 	vkUpdateDescriptorSets(device, static_cast<uint32_t>(writeDescriptorSets.size()), writeDescriptorSets.data(), 0, NULL);
@@ -638,7 +763,7 @@ void VulkanExample::preparePipelines()
 
 	shaderStages[0] = loadShader(getShadersPath() + "texturesparseresidency/sparseresidency.vert.spv", VK_SHADER_STAGE_VERTEX_BIT);
 	shaderStages[1] = loadShader(getShadersPath() + "texturesparseresidency/sparseresidency.frag.spv", VK_SHADER_STAGE_FRAGMENT_BIT);
-	VK_CHECK_RESULT(vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &pipeline));
+	VK_CHECK_RESULT(vks::ObjectCounters::createGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &pipeline));
 }
 
 // Prepare and initialize uniform buffer containing shader uniforms
@@ -652,6 +777,25 @@ void VulkanExample::prepareUniformBuffers()
 		sizeof(uboVS),
 		&uboVS));
 
+	// Fragment shader page layout uniform buffer block
+	VK_CHECK_RESULT(vulkanDevice->createBuffer(
+		VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+		&uniformBufferFeedback,
+		sizeof(uboFeedback)));
+	VK_CHECK_RESULT(uniformBufferFeedback.map());
+
+	// Feedback buffer is read back by the host after each frame
+	VK_CHECK_RESULT(vulkanDevice->createBuffer(
+		VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+		&feedbackBuffer,
+		sizeof(FeedbackHeader) + maxFeedbackRequests * sizeof(uint32_t)));
+	VK_CHECK_RESULT(feedbackBuffer.map());
+	FeedbackHeader* feedbackHeader = (FeedbackHeader*)feedbackBuffer.mapped;
+	feedbackHeader->requestCount = 0;
+	feedbackHeader->maxRequests = maxFeedbackRequests;
+
 	updateUniformBuffers();
 }
 
@@ -666,6 +810,19 @@ void VulkanExample::updateUniformBuffers()
 	uniformBufferVS.unmap();
 }
 
+// Updates the page layout and the frame index used by the fragment shader to select the pixels that write feedback
+void VulkanExample::updateFeedbackUniformBuffer()
+{
+	const VkExtent3D imageGranularity = texture.sparseImageMemoryRequirements.formatProperties.imageGranularity;
+	const uint32_t mipCount = std::min(static_cast<uint32_t>(texture.mipPageInfo.size()), static_cast<uint32_t>(maxFeedbackMipLevels));
+	uboFeedback.pageInfo = glm::uvec4(imageGranularity.width, imageGranularity.height, std::min(texture.mipTailStart, mipCount), static_cast<uint32_t>(feedbackFrame));
+	for (uint32_t i = 0; i < mipCount; i++)
+	{
+		uboFeedback.mips[i] = texture.mipPageInfo[i];
+	}
+	memcpy(uniformBufferFeedback.mapped, &uboFeedback, sizeof(uboFeedback));
+}
+
 void VulkanExample::prepare()
 {
 	VulkanExampleBase::prepare();
@@ -674,9 +831,12 @@ void VulkanExample::prepare()
 		vks::tools::exitFatal("Device does not support sparse residency for 2D images!", VK_ERROR_FEATURE_NOT_PRESENT);
 	}
 	loadAssets();
-	prepareUniformBuffers();
 	// Create a virtual texture with max. possible dimension (does not take up any VRAM yet)
 	prepareSparseTexture(4096, 4096, 1, VK_FORMAT_R8G8B8A8_UNORM);
+	prepareUniformBuffers();
+	updateFeedbackUniformBuffer();
+	// The mip tail is always resident and used as the fallback for non-resident pages
+	fillMipTail();
 	setupDescriptorSetLayout();
 	preparePipelines();
 	setupDescriptorPool();
@@ -690,111 +850,194 @@ void VulkanExample::render()
 	if (!prepared)
 		return;
 	draw();
+	// With a single frame in flight, submitFrame waits for the fence of the frame it just submitted, so the feedback buffer can be read and reset
+	if (streaming.enabled) {
+		processFeedback();
+	}
+	feedbackFrame++;
+	updateFeedbackUniformBuffer();
 	if (camera.updated) {
 		updateUniformBuffers();
 	}
 }
 
-void VulkanExample::uploadContent(VirtualTexturePage page, VkImage image)
+// Upload contents for a batch of newly resident pages with a single command buffer
+// The submission waits on the sparse binding semaphore, so the pages are guaranteed to be backed by memory
+void VulkanExample::uploadPages(const std::vector<VirtualTexturePage*> &pages)
 {
-	// Generate some random image data and upload as a buffer
-	const size_t bufferSize = 4 * page.extent.width * page.extent.height;
-
-	vks::Buffer imageBuffer;
-	VK_CHECK_RESULT(vulkanDevice->createBuffer(
-		VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-		&imageBuffer,
-		bufferSize));
-	imageBuffer.map();
-
-	// Fill buffer with random colors
-	std::random_device rd;
-	std::mt19937 rndEngine(rd());
-	std::uniform_int_distribution<uint32_t> rndDist(0, 255);
-	uint8_t* data = (uint8_t*)imageBuffer.mapped;
-	uint8_t rndVal[4] = { 0, 0, 0, 0 };
-	while (rndVal[0] + rndVal[1] + rndVal[2] < 10) {
-		rndVal[0] = (uint8_t)rndDist(rndEngine);
-		rndVal[1] = (uint8_t)rndDist(rndEngine);
-		rndVal[2] = (uint8_t)rndDist(rndEngine);
-	}
-	rndVal[3] = 255;
+	const VkExtent3D imageGranularity = texture.sparseImageMemoryRequirements.formatProperties.imageGranularity;
+	const VkDeviceSize pageStagingSize = 4 * imageGranularity.width * imageGranularity.height * imageGranularity.depth;
 
-	for (uint32_t y = 0; y < page.extent.height; y++)
+	// Generate page contents into the staging buffer
+	// Each page gets a color derived from its index, darkened with increasing mip level so mip transitions are visible
+	std::vector<VkBufferImageCopy> regions;
+	for (size_t i = 0; i < pages.size(); i++)
 	{
-		for (uint32_t x = 0; x < page.extent.width; x++)
+		const VirtualTexturePage* page = pages[i];
+		uint32_t hash = page->index * 2654435761u;
+		const float mipScale = 1.0f - 0.6f * (float)page->mipLevel / (float)std::max(texture.mipTailStart, 1u);
+		uint8_t color[4] = {
+			(uint8_t)((64 + ((hash >> 8) & 0xbf)) * mipScale),
+			(uint8_t)((64 + ((hash >> 16) & 0xbf)) * mipScale),
+			(uint8_t)((64 + ((hash >> 24) & 0xbf)) * mipScale),
+			255 };
+		uint8_t* data = (uint8_t*)pageStagingBuffer.mapped + i * pageStagingSize;
+		for (uint32_t y = 0; y < page->extent.height; y++)
 		{
-			for (uint32_t c = 0; c < 4; c++, ++data)
+			for (uint32_t x = 0; x < page->extent.width; x++)
 			{
-				*data = rndVal[c];
+				// Darken page borders to visualize the page layout
+				const bool border = (x == 0) || (y == 0);
+				for (uint32_t c = 0; c < 4; c++, ++data)
+				{
+					*data = (border && c < 3) ? color[c] / 2 : color[c];
+				}
 			}
 		}
+
+		VkBufferImageCopy region{};
+		region.bufferOffset = i * pageStagingSize;
+		region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		region.imageSubresource.layerCount = 1;
+		region.imageSubresource.baseArrayLayer = page->layer;
+		region.imageSubresource.mipLevel = page->mipLevel;
+		region.imageOffset = page->offset;
+		region.imageExtent = page->extent;
+		regions.push_back(region);
 	}
 
 	VkCommandBuffer copyCmd = vulkanDevice->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
-	vks::tools::setImageLayout(copyCmd, image, VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
-	VkBufferImageCopy region{};
-	region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-	region.imageSubresource.layerCount = 1;
-	region.imageSubresource.mipLevel = page.mipLevel;
-	region.imageOffset = page.offset;
-	region.imageExtent = page.extent;
-	vkCmdCopyBufferToImage(copyCmd, imageBuffer.buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-	vks::tools::setImageLayout(copyCmd, image, VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
-	vulkanDevice->flushCommandBuffer(copyCmd, queue);
-
-	imageBuffer.destroy();
+	vks::tools::setImageLayout(copyCmd, texture.image, VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+	vkCmdCopyBufferToImage(copyCmd, pageStagingBuffer.buffer, texture.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<uint32_t>(regions.size()), regions.data());
+	vks::tools::setImageLayout(copyCmd, texture.image, VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+	VK_CHECK_RESULT(vkEndCommandBuffer(copyCmd));
+
+	const VkPipelineStageFlags waitStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+	VkSubmitInfo uploadSubmitInfo = vks::initializers::submitInfo();
+	uploadSubmitInfo.waitSemaphoreCount = 1;
+	uploadSubmitInfo.pWaitSemaphores = &bindSparseSemaphore;
+	uploadSubmitInfo.pWaitDstStageMask = &waitStageMask;
+	uploadSubmitInfo.commandBufferCount = 1;
+	uploadSubmitInfo.pCommandBuffers = &copyCmd;
+	VK_CHECK_RESULT(vkQueueSubmit(queue, 1, &uploadSubmitInfo, pageUploadFence));
+	// The staging buffer is reused for the next batch, so wait until the copies have finished
+	VK_CHECK_RESULT(vkWaitForFences(device, 1, &pageUploadFence, VK_TRUE, UINT64_MAX));
+	VK_CHECK_RESULT(vkResetFences(device, 1, &pageUploadFence));
+	vkFreeCommandBuffers(device, vulkanDevice->commandPool, 1, &copyCmd);
 }
-	
-void VulkanExample::fillRandomPages()
+
+// Read back the page requests written by the fragment shader and update page residency accordingly
+// Requested pages are made resident from the page pool (evicting the least recently used pages if the pool is full)
+// and only the pages whose residency changed are passed to the sparse binding
+void VulkanExample::processFeedback()
 {
-	vkDeviceWaitIdle(device);
+	FeedbackHeader* feedbackHeader = (FeedbackHeader*)feedbackBuffer.mapped;
+	const uint32_t* requests = (uint32_t*)((uint8_t*)feedbackBuffer.mapped + sizeof(FeedbackHeader));
+	const uint32_t requestCount = std::min(feedbackHeader->requestCount, static_cast<uint32_t>(maxFeedbackRequests));
+	// Frame indices start at one, so pages that have never been requested (lastRequested = 0) are always evictable
+	const uint64_t currentFrame = feedbackFrame + 1;
+
+	feedbackStats.requests = feedbackHeader->requestCount;
+	feedbackStats.uniqueRequests = 0;
+	feedbackStats.pagesBound = 0;
+	feedbackStats.pagesEvicted = 0;
+
+	// Deduplicate requests and refresh the LRU position of requested pages that are already resident
+	std::vector<VirtualTexturePage*> missingPages;
+	for (uint32_t i = 0; i < requestCount; i++)
+	{
+		if (requests[i] >= texture.pages.size())
+		{
+			continue;
+		}
+		VirtualTexturePage& page = texture.pages[requests[i]];
+		if (page.lastRequested == currentFrame)
+		{
+			continue;
+		}
+		page.lastRequested = currentFrame;
+		feedbackStats.uniqueRequests++;
+		if (page.resident())
+		{
+			texture.touch(page);
+		}
+		else
+		{
+			missingPages.push_back(&page);
+		}
+	}
 
-	std::default_random_engine rndEngine(std::random_device{}());
-	std::uniform_real_distribution<float> rndDist(0.0f, 1.0f);
+	// Reset the feedback buffer for the next frame
+	feedbackHeader->requestCount = 0;
 
-	std::vector<VirtualTexturePage> updatedPages;
-	for (auto& page : texture.pages) {
-		if (rndDist(rndEngine) < 0.5f) {
-			continue;
+	if (missingPages.empty())
+	{
+		return;
+	}
+
+	// Coarser mip levels are streamed in first as they cover a larger area of the texture
+	std::sort(missingPages.begin(), missingPages.end(), [](const VirtualTexturePage* a, const VirtualTexturePage* b) { return a->mipLevel > b->mipLevel; });
+	const size_t maxUploads = std::min(static_cast<size_t>(streaming.maxPageUploadsPerFrame), static_cast<size_t>(maxPageUploadsLimit));
+	if (missingPages.size() > maxUploads)
+	{
+		missingPages.resize(maxUploads);
+	}
+
+	std::vector<VirtualTexturePage*> bindingChangedPages;
+	std::vector<VirtualTexturePage*> uploadPageList;
+	for (auto page : missingPages)
+	{
+		if (!texture.makeResident(*page))
+		{
+			// Pool is exhausted, evict the least recently used page unless it's still in use by the current frame
+			// If no page is resident the pool can't provide memory at all, so there is nothing to evict
+			if (texture.lruPages.empty())
+			{
+				break;
+			}
+			VirtualTexturePage& lruPage = texture.pages[texture.lruPages.back()];
+			if (lruPage.lastRequested == currentFrame)
+			{
+				break;
+			}
+			texture.evict(lruPage);
+			bindingChangedPages.push_back(&lruPage);
+			feedbackStats.pagesEvicted++;
+			if (!texture.makeResident(*page))
+			{
+				break;
+			}
 		}
-		page.allocate(device, texture.memoryTypeIndex);
-		updatedPages.push_back(page);
+		bindingChangedPages.push_back(page);
+		uploadPageList.push_back(page);
+		feedbackStats.pagesBound++;
 	}
 
-	// Update sparse queue binding
-	texture.updateSparseBindInfo();
-	VkFenceCreateInfo fenceInfo = vks::initializers::fenceCreateInfo(VK_FLAGS_NONE);
-	VkFence fence;
-	VK_CHECK_RESULT(vkCreateFence(device, &fenceInfo, nullptr, &fence));
-	vkQueueBindSparse(queue, 1, &texture.bindSparseInfo, fence);
-	vkWaitForFences(device, 1, &fence, VK_TRUE, UINT64_MAX);
+	if (bindingChangedPages.empty())
+	{
+		return;
+	}
 
-	for (auto &page: updatedPages) {
-		uploadContent(page, texture.image);
+	// Incremental sparse binding for only the changed pages, signals the semaphore the page upload waits on
+	texture.updateSparseBindInfo(bindingChangedPages);
+	if (!uploadPageList.empty())
+	{
+		texture.bindSparseInfo.signalSemaphoreCount = 1;
+		texture.bindSparseInfo.pSignalSemaphores = &bindSparseSemaphore;
+	}
+	VK_CHECK_RESULT(vkQueueBindSparse(queue, 1, &texture.bindSparseInfo, VK_NULL_HANDLE));
+
+	if (!uploadPageList.empty())
+	{
+		uploadPages(uploadPageList);
 	}
 }
 
 void VulkanExample::fillMipTail()
 {
-	//@todo: WIP
-	VkDeviceSize imageMipTailSize = texture.sparseImageMemoryRequirements.imageMipTailSize;
-	VkDeviceSize imageMipTailOffset = texture.sparseImageMemoryRequirements.imageMipTailOffset;
-	// Stride between memory bindings for each mip level if not single mip tail (VK_SPARSE_IMAGE_FORMAT_SINGLE_MIPTAIL_BIT not set)
-	VkDeviceSize imageMipTailStride = texture.sparseImageMemoryRequirements.imageMipTailStride;
-
-	VkSparseImageMemoryBind mipTailimageMemoryBind{};
-
-	VkMemoryAllocateInfo allocInfo = vks::initializers::memoryAllocateInfo();
-	allocInfo.allocationSize = imageMipTailSize;
-	allocInfo.memoryTypeIndex = texture.memoryTypeIndex;
-	VK_CHECK_RESULT(vkAllocateMemory(device, &allocInfo, nullptr, &mipTailimageMemoryBind.memory));
-
-	uint32_t mipLevel = texture.sparseImageMemoryRequirements.imageMipTailFirstLod;
-	uint32_t width = std::max(texture.width >> texture.sparseImageMemoryRequirements.imageMipTailFirstLod, 1u);
-	uint32_t height = std::max(texture.height >> texture.sparseImageMemoryRequirements.imageMipTailFirstLod, 1u);
-	uint32_t depth = 1;
+	// Memory for the mip tail has already been allocated and bound at texture creation
+	std::mt19937 rndEngine(benchmark.active ? 0 : (unsigned)time(nullptr));
+	std::uniform_int_distribution<uint32_t> rndDist(0, 255);
 
 	for (uint32_t i = texture.mipTailStart; i < texture.mipLevels; i++) {
 
@@ -814,9 +1057,6 @@ void VulkanExample::fillMipTail()
 		imageBuffer.map();
 
 		// Fill buffer with random colors
-		std::random_device rd;
-		std::mt19937 rndEngine(rd());
-		std::uniform_int_distribution<uint32_t> rndDist(0, 255);
 		uint8_t* data = (uint8_t*)imageBuffer.mapped;
 		uint8_t rndVal[4] = { 0, 0, 0, 0 };
 		while (rndVal[0] + rndVal[1] + rndVal[2] < 10) {
@@ -826,7 +1066,7 @@ void VulkanExample::fillMipTail()
 		}
 		rndVal[3] = 255;
 
-		switch (mipLevel) {
+		switch (i) {
 		case 0:
 			rndVal[0] = rndVal[1] = rndVal[2] = 255;
 			break;
@@ -865,29 +1105,31 @@ void VulkanExample::fillMipTail()
 	}
 }
 
-void VulkanExample::flushRandomPages()
+// Evict all resident pages, they'll be streamed in again based on the feedback of the next frames
+void VulkanExample::flushAllPages()
 {
 	vkDeviceWaitIdle(device);
 
-	std::default_random_engine rndEngine(std::random_device{}());
-	std::uniform_real_distribution<float> rndDist(0.0f, 1.0f);
-
-	std::vector<VirtualTexturePage> updatedPages;
+	std::vector<VirtualTexturePage*> bindingChangedPages;
 	for (auto& page : texture.pages)
 	{
-		if (rndDist(rndEngine) < 0.5f) {
-			continue;
+		if (page.resident())
+		{
+			texture.evict(page);
+			bindingChangedPages.push_back(&page);
 		}
-		page.release(device);
+	}
+
+	if (bindingChangedPages.empty())
+	{
+		return;
 	}
 
 	// Update sparse queue binding
-	texture.updateSparseBindInfo();
-	VkFenceCreateInfo fenceInfo = vks::initializers::fenceCreateInfo(VK_FLAGS_NONE);
-	VkFence fence;
-	VK_CHECK_RESULT(vkCreateFence(device, &fenceInfo, nullptr, &fence));
-	vkQueueBindSparse(queue, 1, &texture.bindSparseInfo, fence);
-	vkWaitForFences(device, 1, &fence, VK_TRUE, UINT64_MAX);
+	texture.updateSparseBindInfo(bindingChangedPages);
+	VK_CHECK_RESULT(vkQueueBindSparse(queue, 1, &texture.bindSparseInfo, pageUploadFence));
+	VK_CHECK_RESULT(vkWaitForFences(device, 1, &pageUploadFence, VK_TRUE, UINT64_MAX));
+	VK_CHECK_RESULT(vkResetFences(device, 1, &pageUploadFence));
 }
 
 void VulkanExample::OnUpdateUIOverlay(vks::UIOverlay* overlay)
@@ -896,21 +1138,18 @@ void VulkanExample::OnUpdateUIOverlay(vks::UIOverlay* overlay)
 		if (overlay->sliderFloat("LOD bias", &uboVS.lodBias, -(float)texture.mipLevels, (float)texture.mipLevels)) {
 			updateUniformBuffers();
 		}
-		if (overlay->button("Fill random pages")) {
-			fillRandomPages();
-		}
-		if (overlay->button("Flush random pages")) {
-			flushRandomPages();
-		}
-		if (overlay->button("Fill mip tail")) {
-			fillMipTail();
+		overlay->checkBox("Stream pages", &streaming.enabled);
+		overlay->sliderInt("Page uploads per frame", &streaming.maxPageUploadsPerFrame, 1, maxPageUploadsLimit);
+		if (overlay->button("Flush all pages")) {
+			flushAllPages();
 		}
 	}
 	if (overlay->header("Statistics")) {
-		uint32_t respages = 0;
-		std::for_each(texture.pages.begin(), texture.pages.end(), [&respages](VirtualTexturePage page) { respages += (page.resident()) ? 1 : 0; });
-		overlay->text("Resident pages: %d of %d", respages, static_cast<uint32_t>(texture.pages.size()));
+		overlay->text("Resident pages: %d of %d", texture.pagePool.usedSlots(), static_cast<uint32_t>(texture.pages.size()));
+		overlay->text("Page pool capacity: %d", texture.pagePool.capacity);
 		overlay->text("Mip tail starts at: %d", texture.mipTailStart);
+		overlay->text("Page requests: %d (%d unique)", feedbackStats.requests, feedbackStats.uniqueRequests);
+		overlay->text("Pages bound: %d, evicted: %d", feedbackStats.pagesBound, feedbackStats.pagesEvicted);
 	}
 
 }
@@ -10,6 +10,7 @@
 * Note : This sample is work-in-progress and works basically, but it's not yet finished
 */
 
+#include <list>
 #include "vulkanexamplebase.h"
 #include "VulkanglTFModel.h"
 
@@ -26,11 +27,32 @@ struct VirtualTexturePage
 	uint32_t mipLevel;													// Mip level that this page belongs to
 	uint32_t layer;														// Array layer that this page belongs to
 	uint32_t index;
+	uint32_t poolSlot;													// Slot of the page memory pool backing this page (if resident)
+	uint64_t lastRequested;												// Last frame in which this page has been requested by the feedback pass
+	std::list<uint32_t>::iterator lruPosition;							// Position of this page in the texture's LRU list (if resident)
 
 	VirtualTexturePage();
 	bool resident();
-	void allocate(VkDevice device, uint32_t memoryTypeIndex);
-	void release(VkDevice device);
+};
+
+// Pool of page sized memory slots sub-allocated from a few larger device memory blocks
+// Limits the amount of device memory a virtual texture can make resident at any time
+struct PageMemoryPool
+{
+	VkDevice device;
+	uint32_t memoryTypeIndex;
+	VkDeviceSize pageSize;												// Size of a single slot (sparse page alignment)
+	uint32_t pagesPerBlock;												// Number of slots per device memory block
+	uint32_t capacity;													// Max. number of slots that can be handed out
+	uint32_t slotCount = 0;												// Number of slots created from the allocated blocks so far
+	std::vector<VkDeviceMemory> blocks;
+	std::vector<uint32_t> freeSlots;
+
+	void create(VkDevice device, uint32_t memoryTypeIndex, VkDeviceSize pageSize, uint32_t capacity, uint32_t pagesPerBlock);
+	bool allocate(uint32_t &slot, VkDeviceMemory &memory, VkDeviceSize &memoryOffset);
+	void release(uint32_t slot);
+	uint32_t usedSlots();
+	void destroy();
 };
 
 // Virtual texture object containing all pages
@@ -40,13 +62,16 @@ struct VirtualTexture
 	VkImage image;														// Texture image handle
 	VkBindSparseInfo bindSparseInfo;									// Sparse queue binding information
 	std::vector<VirtualTexturePage> pages;								// Contains all virtual pages of the texture
-	std::vector<VkSparseImageMemoryBind> sparseImageMemoryBinds;		// Sparse image memory bindings of all memory-backed virtual tables
+	std::vector<VkSparseImageMemoryBind> sparseImageMemoryBinds;		// Sparse image memory bindings of all pages whose residency changed since the last bind
 	std::vector<VkSparseMemoryBind>	opaqueMemoryBinds;					// Sparse ópaque memory bindings for the mip tail (if present)
 	VkSparseImageMemoryBindInfo imageMemoryBindInfo;					// Sparse image memory bind info
 	VkSparseImageOpaqueMemoryBindInfo opaqueMemoryBindInfo;				// Sparse image opaque memory bind info (mip tail)
 	uint32_t mipTailStart;												// First mip level in mip tail
 	VkSparseImageMemoryRequirements sparseImageMemoryRequirements;		// @todo: Comment
 	uint32_t memoryTypeIndex;											// @todo: Comment
+	PageMemoryPool pagePool;											// Memory backing the resident pages
+	std::list<uint32_t> lruPages;										// Indices of all resident pages, most recently used first
+	std::vector<glm::uvec4> mipPageInfo;								// Per mip level: first page index, page count in x and y
 
 	// @todo: comment
 	struct MipTailInfo {
@@ -55,7 +80,10 @@ struct VirtualTexture
 	} mipTailInfo;
 
 	VirtualTexturePage *addPage(VkOffset3D offset, VkExtent3D extent, const VkDeviceSize size, const uint32_t mipLevel, uint32_t layer);
-	void updateSparseBindInfo();
+	bool makeResident(VirtualTexturePage &page);
+	void evict(VirtualTexturePage &page);
+	void touch(VirtualTexturePage &page);
+	void updateSparseBindInfo(const std::vector<VirtualTexturePage*> &bindingChangedPages, bool bindMipTail = false);
 	// @todo: replace with dtor?
 	void destroy();
 };
@@ -85,6 +113,47 @@ public:
 	} uboVS;
 	vks::Buffer uniformBufferVS;
 
+	// Max. number of page requests the fragment shader can write to the feedback buffer per frame
+	static const uint32_t maxFeedbackRequests = 4096;
+	// Max. number of mip levels described in the feedback uniform block
+	static const uint32_t maxFeedbackMipLevels = 16;
+	// Upper limit for the number of pages that can be uploaded per frame (sizes the staging buffer)
+	static const uint32_t maxPageUploadsLimit = 64;
+
+	// Describes the page layout of the virtual texture to the feedback pass
+	struct UboFeedback {
+		// x = page granularity width, y = page granularity height, z = first mip level in mip tail, w = frame index
+		glm::uvec4 pageInfo;
+		// Per mip level: x = index of first page, y = pages in x, z = pages in y
+		glm::uvec4 mips[maxFeedbackMipLevels];
+	} uboFeedback;
+	vks::Buffer uniformBufferFeedback;
+
+	// Host visible buffer the fragment shader appends requested page indices to
+	struct FeedbackHeader {
+		uint32_t requestCount;
+		uint32_t maxRequests;
+		uint32_t padding[2];
+	};
+	vks::Buffer feedbackBuffer;
+
+	// Streaming settings and per-frame statistics
+	struct {
+		bool enabled = true;
+		int32_t maxPageUploadsPerFrame = 32;
+		uint32_t maxResidentPages = 512;
+	} streaming;
+	struct {
+		uint32_t requests = 0;
+		uint32_t uniqueRequests = 0;
+		uint32_t pagesBound = 0;
+		uint32_t pagesEvicted = 0;
+	} feedbackStats;
+	uint64_t feedbackFrame = 0;
+	// Staging buffer for uploading the contents of newly resident pages
+	vks::Buffer pageStagingBuffer;
+	VkFence pageUploadFence = VK_NULL_HANDLE;
+
 	VkPipeline pipeline;
 	VkPipelineLayout pipelineLayout;
 	VkDescriptorSet descriptorSet;
@@ -109,11 +178,12 @@ public:
 	void preparePipelines();
 	void prepareUniformBuffers();
 	void updateUniformBuffers();
+	void updateFeedbackUniformBuffer();
 	void prepare();
 	virtual void render();
-	void uploadContent(VirtualTexturePage page, VkImage image);
-	void fillRandomPages();
+	void uploadPages(const std::vector<VirtualTexturePage*> &pages);
+	void processFeedback();
 	void fillMipTail();
-	void flushRandomPages();
+	void flushAllPages();
 	virtual void OnUpdateUIOverlay(vks::UIOverlay* overlay);
 };
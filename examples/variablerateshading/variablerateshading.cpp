@@ -25,16 +25,17 @@ VulkanExample::VulkanExample() : VulkanExampleBase(ENABLE_VALIDATION)
 
 VulkanExample::~VulkanExample()
 {
-	vkDestroyPipeline(device, basePipelines.masked, nullptr);
-	vkDestroyPipeline(device, basePipelines.opaque, nullptr);
-	vkDestroyPipeline(device, shadingRatePipelines.masked, nullptr);
-	vkDestroyPipeline(device, shadingRatePipelines.opaque, nullptr);
+	vks::ObjectCounters::destroyPipeline(device, basePipelines.masked, nullptr);
+	vks::ObjectCounters::destroyPipeline(device, basePipelines.opaque, nullptr);
+	vks::ObjectCounters::destroyPipeline(device, shadingRatePipelines.masked, nullptr);
+	vks::ObjectCounters::destroyPipeline(device, shadingRatePipelines.opaque, nullptr);
 	vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
 	vkDestroyDescriptorSetLayout(device, descriptorSetLayout, nullptr);
 	vkDestroyImageView(device, shadingRateImage.view, nullptr);
 	vkDestroyImage(device, shadingRateImage.image, nullptr);
 	vkFreeMemory(device, shadingRateImage.memory, nullptr);
 	shaderData.buffer.destroy();
+	threadCommandPools.destroy();
 }
 
 void VulkanExample::getEnabledFeatures()
@@ -60,18 +61,19 @@ void VulkanExample::handleResize()
 	prepareShadingRateImage();
 }
 
-void VulkanExample::buildCommandBuffers()
+/*
+	Record the command buffer of the current swap chain image
+	The scene's draws are recorded into secondary command buffers on the job system, or inline if parallel recording is disabled
+*/
+void VulkanExample::buildCommandBuffer()
 {
-	if (resized)
-	{
-		handleResize();
-	}
+	VkCommandBuffer commandBuffer = drawCmdBuffers[currentBuffer];
 
 	VkCommandBufferBeginInfo cmdBufInfo = vks::initializers::commandBufferBeginInfo();
+	cmdBufInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
 
 	VkClearValue clearValues[2];
-	clearValues[0].color = defaultClearColor;
-	clearValues[0].color = { { 0.25f, 0.25f, 0.25f, 1.0f } };;
+	clearValues[0].color = { { 0.25f, 0.25f, 0.25f, 1.0f } };
 	clearValues[1].depthStencil = { 1.0f, 0 };
 
 	VkRenderPassBeginInfo renderPassBeginInfo = vks::initializers::renderPassBeginInfo();
@@ -82,35 +84,56 @@ void VulkanExample::buildCommandBuffers()
 	renderPassBeginInfo.renderArea.extent.height = height;
 	renderPassBeginInfo.clearValueCount = 2;
 	renderPassBeginInfo.pClearValues = clearValues;
+	renderPassBeginInfo.framebuffer = frameBuffers[currentBuffer];
 
 	const VkViewport viewport = vks::initializers::viewport((float)width, (float)height, 0.0f, 1.0f);
 	const VkRect2D scissor = vks::initializers::rect2D(width, height, 0, 0);
+	const Pipelines& pipelines = enableShadingRate ? shadingRatePipelines : basePipelines;
 
-	for (int32_t i = 0; i < drawCmdBuffers.size(); ++i)
-	{
-		renderPassBeginInfo.framebuffer = frameBuffers[i];
-		VK_CHECK_RESULT(vkBeginCommandBuffer(drawCmdBuffers[i], &cmdBufInfo));
-		vkCmdBeginRenderPass(drawCmdBuffers[i], &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
-		vkCmdSetViewport(drawCmdBuffers[i], 0, 1, &viewport);
-		vkCmdSetScissor(drawCmdBuffers[i], 0, 1, &scissor);
-		vkCmdBindDescriptorSets(drawCmdBuffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
-
+	// Secondary command buffers don't inherit any state, so every one of them sets up the same state as the inline path
+	auto bindState = [&](VkCommandBuffer cmdBuffer) {
+		vkCmdSetViewport(cmdBuffer, 0, 1, &viewport);
+		vkCmdSetScissor(cmdBuffer, 0, 1, &scissor);
+		vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
 		// POI: Bind the image that contains the shading rate patterns
 		if (enableShadingRate) {
-			vkCmdBindShadingRateImageNV(drawCmdBuffers[i], shadingRateImage.view, VK_IMAGE_LAYOUT_SHADING_RATE_OPTIMAL_NV);
-		};
+			vkCmdBindShadingRateImageNV(cmdBuffer, shadingRateImage.view, VK_IMAGE_LAYOUT_SHADING_RATE_OPTIMAL_NV);
+		}
+	};
+
+	VK_CHECK_RESULT(vkBeginCommandBuffer(commandBuffer, &cmdBufInfo));
+
+	if (parallelRecording) {
+		vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+
+		VkCommandBufferInheritanceInfo inheritanceInfo = vks::initializers::commandBufferInheritanceInfo();
+		inheritanceInfo.renderPass = renderPass;
+		inheritanceInfo.subpass = 0;
+		inheritanceInfo.framebuffer = frameBuffers[currentBuffer];
 
 		// Render the scene
-		Pipelines& pipelines = enableShadingRate ? shadingRatePipelines : basePipelines;
-		vkCmdBindPipeline(drawCmdBuffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, pipelines.opaque);
-		scene.draw(drawCmdBuffers[i], vkglTF::RenderFlags::BindImages | vkglTF::RenderFlags::RenderOpaqueNodes, pipelineLayout);
-		vkCmdBindPipeline(drawCmdBuffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, pipelines.masked);
-		scene.draw(drawCmdBuffers[i], vkglTF::RenderFlags::BindImages | vkglTF::RenderFlags::RenderAlphaMaskedNodes, pipelineLayout);
-
-		drawUI(drawCmdBuffers[i]);
-		vkCmdEndRenderPass(drawCmdBuffers[i]);
-		VK_CHECK_RESULT(vkEndCommandBuffer(drawCmdBuffers[i]));
+		scene.drawParallel(commandBuffer, threadCommandPools, inheritanceInfo, [&](VkCommandBuffer cmdBuffer) {
+			bindState(cmdBuffer);
+			vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelines.opaque);
+		}, vkglTF::RenderFlags::BindImages | vkglTF::RenderFlags::RenderOpaqueNodes, pipelineLayout);
+		scene.drawParallel(commandBuffer, threadCommandPools, inheritanceInfo, [&](VkCommandBuffer cmdBuffer) {
+			bindState(cmdBuffer);
+			vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelines.masked);
+		}, vkglTF::RenderFlags::BindImages | vkglTF::RenderFlags::RenderAlphaMaskedNodes, pipelineLayout);
 	}
+	else {
+		vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+		bindState(commandBuffer);
+
+		// Render the scene
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelines.opaque);
+		scene.draw(commandBuffer, vkglTF::RenderFlags::BindImages | vkglTF::RenderFlags::RenderOpaqueNodes, pipelineLayout);
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelines.masked);
+		scene.draw(commandBuffer, vkglTF::RenderFlags::BindImages | vkglTF::RenderFlags::RenderAlphaMaskedNodes, pipelineLayout);
+	}
+
+	vkCmdEndRenderPass(commandBuffer);
+	VK_CHECK_RESULT(vkEndCommandBuffer(commandBuffer));
 }
 
 void VulkanExample::loadAssets()
@@ -145,7 +168,7 @@ void VulkanExample::setupDescriptors()
 
 	// Descriptor set
 	VkDescriptorSetAllocateInfo allocInfo = vks::initializers::descriptorSetAllocateInfo(descriptorPool, &descriptorSetLayout, 1);
-	VK_CHECK_RESULT(vkAllocateDescriptorSets(device, &allocInfo, &descriptorSet));
+	VK_CHECK_RESULT(vks::ObjectCounters::allocateDescriptorSets(device, &allocInfo, &descriptorSet));
 	std::vector<VkWriteDescriptorSet> writeDescriptorSets = {
 		vks::initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 0, &shaderData.buffer.descriptor),
 	};
@@ -339,10 +362,10 @@ void VulkanExample::preparePipelines()
 	shaderStages[1].pSpecializationInfo = &specializationInfo;
 
 	// Create pipeline without shading rate 
-	VK_CHECK_RESULT(vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &basePipelines.opaque));
+	VK_CHECK_RESULT(vks::ObjectCounters::createGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &basePipelines.opaque));
 	specializationData.alphaMask = true;
 	rasterizationStateCI.cullMode = VK_CULL_MODE_NONE;
-	VK_CHECK_RESULT(vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &basePipelines.masked));
+	VK_CHECK_RESULT(vks::ObjectCounters::createGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &basePipelines.masked));
 	rasterizationStateCI.cullMode = VK_CULL_MODE_BACK_BIT;
 	specializationData.alphaMask = false;
 
@@ -371,10 +394,10 @@ void VulkanExample::preparePipelines()
 	pipelineViewportShadingRateImageStateCI.viewportCount = 1;
 	pipelineViewportShadingRateImageStateCI.pShadingRatePalettes = &shadingRatePalette;
 	viewportStateCI.pNext = &pipelineViewportShadingRateImageStateCI;
-	VK_CHECK_RESULT(vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &shadingRatePipelines.opaque));
+	VK_CHECK_RESULT(vks::ObjectCounters::createGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &shadingRatePipelines.opaque));
 	specializationData.alphaMask = true;
 	rasterizationStateCI.cullMode = VK_CULL_MODE_NONE;
-	VK_CHECK_RESULT(vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &shadingRatePipelines.masked));
+	VK_CHECK_RESULT(vks::ObjectCounters::createGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &shadingRatePipelines.masked));
 }
 
 void VulkanExample::prepareUniformBuffers()
@@ -414,26 +437,42 @@ void VulkanExample::prepare()
 	prepareUniformBuffers();
 	setupDescriptors();
 	preparePipelines();
-	buildCommandBuffers();
+	threadCommandPools.create(vulkanDevice, &jobSystem, vulkanDevice->queueFamilyIndices.graphics, maxFramesInFlight);
 	prepared = true;
 }
 
+void VulkanExample::draw()
+{
+	VulkanExampleBase::prepareFrame();
+	// The device is done with the frame in flight at currentFrame, so it's secondary command buffers can be reused
+	threadCommandPools.beginFrame(currentFrame);
+	buildCommandBuffer();
+	submitInfo.commandBufferCount = 1;
+	submitInfo.pCommandBuffers = &drawCmdBuffers[currentBuffer];
+	VK_CHECK_RESULT(vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE));
+	VulkanExampleBase::submitFrame();
+}
+
 void VulkanExample::render()
 {
-	renderFrame();
+	draw();
 	if (camera.updated) {
 		updateUniformBuffers();
 	}
 }
 
+void VulkanExample::windowResized()
+{
+	handleResize();
+}
+
 void VulkanExample::OnUpdateUIOverlay(vks::UIOverlay* overlay)
 {
-	if (overlay->checkBox("Enable shading rate", &enableShadingRate)) {
-		buildCommandBuffers();
-	}
+	overlay->checkBox("Enable shading rate", &enableShadingRate);
 	if (overlay->checkBox("Color shading rates", &colorShadingRate)) {
 		updateUniformBuffers();
 	}
+	overlay->checkBox("Parallel command buffers", &parallelRecording);
 }
 
 VULKAN_EXAMPLE_MAIN()
@@ -8,6 +8,7 @@
 
 #include "vulkanexamplebase.h"
 #include "VulkanglTFModel.h"
+#include "VulkanThreadCommandPools.h"
 
 #define ENABLE_VALIDATION false
 
@@ -25,6 +26,11 @@ public:
 	bool enableShadingRate = true;
 	bool colorShadingRate = false;
 
+	// The scene is recorded every frame, split into secondary command buffers that are recorded in parallel on the job system
+	// Each frame in flight has it's own set of per-thread pools, which are reset once the device is done with that frame
+	vks::ThreadCommandPools threadCommandPools;
+	bool parallelRecording = true;
+
 	struct ShaderData {
 		vks::Buffer buffer;
 		struct Values {
@@ -57,7 +63,7 @@ public:
 	~VulkanExample();
 	virtual void getEnabledFeatures();
 	void handleResize();
-	void buildCommandBuffers();
+	void buildCommandBuffer();
 	void loadglTFFile(std::string filename);
 	void loadAssets();
 	void prepareShadingRateImage();
@@ -66,6 +72,8 @@ public:
 	void prepareUniformBuffers();
 	void updateUniformBuffers();
 	void prepare();
+	void draw();
 	virtual void render();
+	virtual void windowResized();
 	virtual void OnUpdateUIOverlay(vks::UIOverlay* overlay);
 };
\ No newline at end of file